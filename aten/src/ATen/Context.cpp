@@ -51,6 +51,14 @@ void Context::setUserEnabledMkldnn(bool e) {
   enabled_mkldnn = e;
 }
 
+bool Context::userEnabledWinogradConv() const {
+  return enabled_winograd_conv;
+}
+
+void Context::setUserEnabledWinogradConv(bool e) {
+  enabled_winograd_conv = e;
+}
+
 bool Context::deterministicCuDNN() const {
   return deterministic_cudnn;
 }
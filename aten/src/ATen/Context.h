@@ -102,6 +102,11 @@ class CAFFE2_API Context {
   void setUserEnabledCuDNN(bool e);
   bool userEnabledMkldnn() const;
   void setUserEnabledMkldnn(bool e);
+  // Whether CPU inference convolutions may use the Winograd kernel. It
+  // rounds differently from the im2col and direct kernels, so it is off
+  // unless the user asks for it.
+  bool userEnabledWinogradConv() const;
+  void setUserEnabledWinogradConv(bool e);
   bool benchmarkCuDNN() const;
   void setBenchmarkCuDNN(bool);
   bool deterministicCuDNN() const;
@@ -127,6 +132,7 @@ class CAFFE2_API Context {
   bool deterministic_cudnn = false;
   bool benchmark_cudnn = false;
   bool enabled_mkldnn = true;
+  bool enabled_winograd_conv = false;
   c10::optional<at::QEngine> quantized_engine = c10::nullopt;
   std::unique_ptr<THCState, void(*)(THCState*)> thc_state;
   std::unique_ptr<THHState, void(*)(THHState*)> thh_state;
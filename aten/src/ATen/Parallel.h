@@ -2,6 +2,9 @@
 #include <ATen/ATen.h>
 #include <ATen/core/ivalue.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace at {
 namespace internal {
 // This parameter is heuristically chosen to determine the minimum number of
@@ -10,6 +13,31 @@ namespace internal {
 // no parallel algorithm (such as parallel_reduce) should split work into
 // smaller than GRAIN_SIZE chunks.
 constexpr int64_t GRAIN_SIZE = 32768;
+
+// GRAIN_SIZE is tuned for element-wise loops costing about one cycle per
+// element. Loops with a cheaper or more expensive body should scale their
+// grain size so that every chunk still does about GRAIN_SIZE cycles of work:
+// cheap, memory-bound ops then stay serial on small inputs while expensive
+// ops (erf, pow, lgamma, ...) start using more threads much earlier. Since
+// parallel_for never runs more tasks than (end - begin) / grain_size, the
+// grain size also bounds the number of threads used.
+//
+// The cycles-per-element hints used by the kernels are estimates for AVX2
+// builds; binaries/parallel_grain_benchmark.cc measures them on the host.
+// Loops tuned with a different grain size for one-cycle elements pass it as
+// base_grain_size.
+inline int64_t grain_size_for_cost(
+    double cycles_per_element,
+    int64_t base_grain_size = GRAIN_SIZE) {
+  if (!(cycles_per_element > 0)) {
+    return base_grain_size;
+  }
+  const double grain_size = base_grain_size / cycles_per_element;
+  if (grain_size >= static_cast<double>(std::numeric_limits<int64_t>::max())) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  return std::max(static_cast<int64_t>(grain_size), static_cast<int64_t>(1));
+}
 } // namespace internal
 
 inline int64_t divup(int64_t x, int64_t y) {
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/SparseCsrTensorImpl.h>
+
+namespace at { namespace sparse_csr {
+
+// Just for documentary purposes
+using SparseCsrTensor = Tensor;
+
+// This is an internal utility function for getting at the SparseCsrTensorImpl,
+// so that we can write sparse CSR tensor specific accessors for special fields
+// in SparseCsrTensor. You should only use this for writing low level
+// setters/getters for SparseCsrTensorImpl fields; otherwise, you should use
+// the low level setters/getters that were implemented using this.
+inline SparseCsrTensorImpl* get_sparse_csr_impl(const SparseCsrTensor& self) {
+  TORCH_INTERNAL_ASSERT(at::impl::variable_excluded_from_dispatch());
+  AT_ASSERTM(self.is_sparse_csr(), "_internal_get_SparseCsrTensorImpl: not a sparse CSR tensor");
+  return static_cast<SparseCsrTensorImpl*>(self.unsafeGetTensorImpl());
+}
+
+// Creates an empty 0 x 0 sparse CSR tensor with the dtype and device of
+// `options`.
+inline SparseCsrTensor new_sparse_csr(const TensorOptions& options) {
+  TORCH_INTERNAL_ASSERT(impl::variable_excluded_from_dispatch());
+  TORCH_CHECK(options.device().is_cpu(), "sparse CSR tensors are only supported on CPU");
+  return detail::make_tensor<SparseCsrTensorImpl>(
+      TensorTypeSet(TensorTypeId::SparseCsrCPUTensorId), options.dtype());
+}
+
+}} // namespace at::sparse_csr
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <ATen/core/boxing/KernelFunction.h>
+#include <c10/core/TensorTypeId.h>
+#include <c10/util/Optional.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace c10 {
+
+class Dispatcher;
+
+/**
+ * A per-callsite inline cache for the dispatcher.
+ *
+ * It has one entry per dispatch key, which remembers the kernel that the
+ * last call through it with that key was dispatched to. Later calls with a
+ * key that has an entry skip the lookups in the dispatch table, the backend
+ * fallback kernels and the catch-all kernel. A callsite that is reached with
+ * several keys, e.g. first with VariableTensorId and then, when VariableType
+ * redispatches, with the backend key, keeps an entry for each of them.
+ * Registering or deregistering any kernel invalidates all caches.
+ *
+ * A cache must only ever be used with one operator, e.g. as a function-local
+ * static next to a static OperatorHandle. It can be used by several threads
+ * at once: lookups don't take locks, and a lookup that races with another
+ * thread updating the same entry is treated as a miss.
+ */
+class DispatchCache final {
+public:
+  DispatchCache() = default;
+
+  DispatchCache(const DispatchCache&) = delete;
+  DispatchCache& operator=(const DispatchCache&) = delete;
+
+private:
+  friend class Dispatcher;
+
+  // An entry is tagged with the dispatcher generation it was filled in.
+  // Generations start at 1, so neither the tag of an empty entry nor that of
+  // an entry being updated ever matches.
+  static constexpr uint64_t kEmpty = 0;
+  static constexpr uint64_t kUpdating = ~uint64_t(0);
+
+  struct Entry final {
+    std::atomic<uint64_t> generation_{kEmpty};
+    std::atomic<const KernelFunction*> kernel_{nullptr};
+  };
+
+  // TensorTypeIds fit into 8 bits, see impl::KernelFunctionTable. Calls
+  // without a dispatch key use the entry after the last TensorTypeId.
+  static constexpr size_t kNumEntries = static_cast<uint8_t>(TensorTypeId::NumTensorIds) + 1;
+
+  Entry& entry_(c10::optional<TensorTypeId> dispatchKey) {
+    return entries_[dispatchKey.has_value() ? static_cast<uint8_t>(*dispatchKey) : kNumEntries - 1];
+  }
+
+  const KernelFunction* lookup_(uint64_t generation, c10::optional<TensorTypeId> dispatchKey) {
+    Entry& entry = entry_(dispatchKey);
+    if (entry.generation_.load(std::memory_order_acquire) != generation) {
+      return nullptr;
+    }
+    const KernelFunction* kernel = entry.kernel_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // An update that started after the first load changed the tag. One
+    // that also finished stored a kernel for the same generation, which is
+    // just as good.
+    if (entry.generation_.load(std::memory_order_relaxed) != generation) {
+      return nullptr;
+    }
+    return kernel;
+  }
+
+  void update_(uint64_t generation, c10::optional<TensorTypeId> dispatchKey, const KernelFunction* kernel) {
+    Entry& entry = entry_(dispatchKey);
+    uint64_t old = entry.generation_.load(std::memory_order_relaxed);
+    // If another thread is updating the entry, let it win.
+    if (old == kUpdating || !entry.generation_.compare_exchange_strong(old, kUpdating, std::memory_order_acquire)) {
+      return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.kernel_.store(kernel, std::memory_order_relaxed);
+    entry.generation_.store(generation, std::memory_order_release);
+  }
+
+  Entry entries_[kNumEntries];
+};
+
+}
@@ -33,7 +33,8 @@ Dispatcher::Dispatcher()
 , operatorLookupTable_()
 , backendFallbackKernels_()
 , listeners_(std::make_unique<detail::RegistrationListenerList>())
-, mutex_() {}
+, mutex_()
+, dispatchCacheGeneration_(1) {}
 
 Dispatcher::~Dispatcher() {}
 
@@ -125,9 +126,9 @@ RegistrationHandleRAII Dispatcher::registerBackendFallbackKernel(TensorTypeId di
   auto inserted = backendFallbackKernels_.setKernel(dispatchKey, std::move(kernel));
   TORCH_CHECK(inserted == impl::KernelFunctionTable::SetKernelResult::ADDED_NEW_KERNEL, "Tried to register a backend fallback kernel for ", dispatchKey, " but there was already one registered.");
 
-  return RegistrationHandleRAII([this, dispatchKey] {
+  return invalidatingDispatchCaches_(RegistrationHandleRAII([this, dispatchKey] {
     deregisterBackendFallbackKernel_(dispatchKey);
-  });
+  }));
 }
 
 void Dispatcher::deregisterBackendFallbackKernel_(TensorTypeId dispatchKey) {
@@ -137,12 +138,29 @@ void Dispatcher::deregisterBackendFallbackKernel_(TensorTypeId dispatchKey) {
 
 RegistrationHandleRAII Dispatcher::registerKernel(const OperatorHandle& op, TensorTypeId dispatch_key, KernelFunction kernel) {
   // note: this doesn't need the mutex to protect the iterator because write operations on the list keep iterators intact.
-  return op.operatorIterator_->op.registerKernel(std::move(dispatch_key), std::move(kernel));
+  return invalidatingDispatchCaches_(op.operatorIterator_->op.registerKernel(std::move(dispatch_key), std::move(kernel)));
 }
 
 RegistrationHandleRAII Dispatcher::registerCatchallKernel(const OperatorHandle& op, KernelFunction kernel) {
   // note: this doesn't need the mutex to protect the iterator because write operations on the list keep iterators intact.
-  return op.operatorIterator_->op.registerCatchallKernel(std::move(kernel));
+  return invalidatingDispatchCaches_(op.operatorIterator_->op.registerCatchallKernel(std::move(kernel)));
+}
+
+RegistrationHandleRAII Dispatcher::invalidatingDispatchCaches_(RegistrationHandleRAII handle) {
+  invalidateDispatchCaches_();
+  // std::function needs a copyable functor
+  auto sharedHandle = std::make_shared<RegistrationHandleRAII>(std::move(handle));
+  return RegistrationHandleRAII([this, sharedHandle] {
+    {
+      // the moved-to handle deregisters the kernel when it goes out of scope
+      RegistrationHandleRAII deregistration(std::move(*sharedHandle));
+    }
+    invalidateDispatchCaches_();
+  });
+}
+
+void Dispatcher::invalidateDispatchCaches_() {
+  dispatchCacheGeneration_.fetch_add(1, std::memory_order_acq_rel);
 }
 
 void Dispatcher::addRegistrationListener(std::unique_ptr<OpRegistrationListener> listener) {
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <ATen/core/dispatch/DispatchCache.h>
 #include <ATen/core/dispatch/OperatorEntry.h>
 #include <ATen/core/dispatch/RegistrationHandleRAII.h>
 #include <c10/util/Exception.h>
 #include <c10/util/LeftRight.h>
+#include <atomic>
 #include <mutex>
 #include <list>
 
@@ -104,6 +106,16 @@ public:
 
   void callBoxed(const OperatorHandle& op, Stack* stack) const;
 
+  /**
+   * Like callUnboxed and callBoxed, but remember the kernel in a per-callsite
+   * cache, so that calls with an unchanged dispatch key don't need to look it
+   * up again. See DispatchCache.
+   */
+  template<class Return, class... Args>
+  Return callUnboxedWithCache(const OperatorHandle& op, DispatchCache& cache, Args... args) const;
+
+  void callBoxedWithCache(const OperatorHandle& op, DispatchCache& cache, Stack* stack) const;
+
   /**
    * Add a listener that gets called whenever a new op is registered or an existing
    * op is deregistered. Immediately after registering, this listener gets called
@@ -121,12 +133,22 @@ private:
   void deregisterBackendFallbackKernel_(TensorTypeId dispatchKey);
 
   const KernelFunction& dispatch_(const DispatchTable& dispatchTable, c10::optional<TensorTypeId> dispatch_key) const;
+  const KernelFunction& dispatchWithCache_(const DispatchTable& dispatchTable, DispatchCache& cache, c10::optional<TensorTypeId> dispatch_key) const;
+
+  // Invalidates all DispatchCaches for the registration that returned the
+  // given handle, and returns a handle that invalidates them again after
+  // deregistering.
+  RegistrationHandleRAII invalidatingDispatchCaches_(RegistrationHandleRAII handle);
+  void invalidateDispatchCaches_();
 
   std::list<OperatorDef> operators_;
   LeftRight<ska::flat_hash_map<OperatorName, OperatorHandle>> operatorLookupTable_;
   impl::KernelFunctionTable backendFallbackKernels_;
   std::unique_ptr<detail::RegistrationListenerList> listeners_;
   std::mutex mutex_;
+  // Incremented whenever a kernel is registered or deregistered. It is part
+  // of the tags of DispatchCache entries, so this invalidates all of them.
+  std::atomic<uint64_t> dispatchCacheGeneration_;
 };
 
 /**
@@ -158,6 +180,15 @@ public:
     c10::Dispatcher::singleton().callBoxed(*this, stack);
   }
 
+  template<class Return, class... Args>
+  Return callUnboxedWithCache(DispatchCache& cache, Args... args) const {
+    return c10::Dispatcher::singleton().callUnboxedWithCache<Return, Args...>(*this, cache, std::forward<Args>(args)...);
+  }
+
+  void callBoxedWithCache(DispatchCache& cache, Stack* stack) const {
+    c10::Dispatcher::singleton().callBoxedWithCache(*this, cache, stack);
+  }
+
 private:
   explicit OperatorHandle(std::list<Dispatcher::OperatorDef>::iterator operatorIterator)
   : operatorIterator_(std::move(operatorIterator)) {}
@@ -187,6 +218,36 @@ inline void Dispatcher::callBoxed(const OperatorHandle& op, Stack* stack) const
   kernel.callBoxed(op, stack);
 }
 
+template<class Return, class... Args>
+inline Return Dispatcher::callUnboxedWithCache(const OperatorHandle& op, DispatchCache& cache, Args... args) const {
+  detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
+  const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
+  c10::optional<TensorTypeId> dispatchKey = dispatchTable.dispatchKeyExtractor().getDispatchKeyUnboxed<Args...>(args...);
+  const KernelFunction& kernel = dispatchWithCache_(dispatchTable, cache, dispatchKey);
+  return kernel.template callUnboxed<Return, Args...>(op, std::forward<Args>(args)...);
+}
+
+inline void Dispatcher::callBoxedWithCache(const OperatorHandle& op, DispatchCache& cache, Stack* stack) const {
+  const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
+  c10::optional<TensorTypeId> dispatchKey = dispatchTable.dispatchKeyExtractor().getDispatchKeyBoxed(stack);
+  const KernelFunction& kernel = dispatchWithCache_(dispatchTable, cache, dispatchKey);
+  kernel.callBoxed(op, stack);
+}
+
+inline const KernelFunction& Dispatcher::dispatchWithCache_(const DispatchTable& dispatchTable, DispatchCache& cache, c10::optional<TensorTypeId> dispatchKey) const {
+  // Read the generation before looking up the kernel, so that a kernel
+  // looked up while another thread (de)registers one is cached with the
+  // generation that registration invalidates.
+  uint64_t generation = dispatchCacheGeneration_.load(std::memory_order_acquire);
+  const KernelFunction* cached = cache.lookup_(generation, dispatchKey);
+  if (C10_LIKELY(nullptr != cached)) {
+    return *cached;
+  }
+  const KernelFunction& kernel = dispatch_(dispatchTable, dispatchKey);
+  cache.update_(generation, dispatchKey, &kernel);
+  return kernel;
+}
+
 inline const KernelFunction& Dispatcher::dispatch_(const DispatchTable& dispatchTable, c10::optional<TensorTypeId> dispatchKey) const {
   if (C10_LIKELY(dispatchKey.has_value())) {
 
@@ -25,6 +25,8 @@ namespace c10 {
   _(namespaces, dimname)             \
   _(namespaces, namespaces)          \
   _(prim, Assign)                    \
+  _(prim, AllocateStorage)           \
+  _(prim, AllocateTensor)            \
   _(prim, BroadcastingChunk)         \
   _(prim, BroadcastSizes)            \
   _(prim, Constant)                  \
@@ -86,6 +88,7 @@ namespace c10 {
   _(prim, ConstantChunk)             \
   _(prim, MMTreeReduce)              \
   _(prim, MMBatchSide)               \
+  _(prim, MMBatchHorizontal)         \
   _(prim, min)                       \
   _(prim, max)                       \
   _(prim, abs)                       \
@@ -1623,6 +1623,11 @@ struct CAFFE2_API ClassType : public NamedType {
   void addMethod(Function* method);
   Function* getMethod(const std::string& name) const;
 
+  // [Internal Only] Remove method from the ClassType. The Function itself is
+  // still owned by the compilation unit; caller is responsible to make sure
+  // that no code calls the method anymore.
+  void unsafeRemoveMethod(const std::string& name);
+
   std::shared_ptr<CompilationUnit> compilation_unit();
   std::shared_ptr<const CompilationUnit> compilation_unit() const;
 
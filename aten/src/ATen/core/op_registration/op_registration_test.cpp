@@ -763,6 +763,83 @@ TEST(OperatorRegistrationTest, whenRegisteringBackendFallbackKernelAndCatchallKe
   EXPECT_EQ("hello _test::dummy", stack[1].toString()->string());
 }
 
+TEST(OperatorRegistrationTest, givenDispatchCache_whenCallingWithDifferentDispatchKeys_thenCallsMatchingKernels) {
+  bool called_cpu_kernel = false;
+  bool called_cuda_kernel = false;
+  auto registrar = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options()
+      .kernel<MockKernel>(c10::TensorTypeId::CPUTensorId, &called_cpu_kernel)
+      .kernel<MockKernel>(c10::TensorTypeId::CUDATensorId, &called_cuda_kernel));
+  auto op = Dispatcher::singleton().findSchema({"_test::dummy", ""});
+  ASSERT_TRUE(op.has_value());
+
+  c10::DispatchCache cache;
+  for (int i = 0; i < 2; ++i) {
+    called_cpu_kernel = called_cuda_kernel = false;
+    op->callUnboxedWithCache<void, Tensor>(cache, dummyTensor(c10::TensorTypeId::CPUTensorId));
+    EXPECT_TRUE(called_cpu_kernel);
+    EXPECT_FALSE(called_cuda_kernel);
+
+    called_cpu_kernel = called_cuda_kernel = false;
+    auto stack = makeStack(dummyTensor(c10::TensorTypeId::CUDATensorId));
+    op->callBoxedWithCache(cache, &stack);
+    EXPECT_FALSE(called_cpu_kernel);
+    EXPECT_TRUE(called_cuda_kernel);
+  }
+}
+
+TEST(OperatorRegistrationTest, givenDispatchCache_whenRegisteringAndDeregisteringNewerKernel_thenCallsCurrentKernel) {
+  bool called_kernel1 = false;
+  bool called_kernel2 = false;
+  auto registrar1 = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options().kernel<MockKernel>(c10::TensorTypeId::CPUTensorId, &called_kernel1));
+  auto op = Dispatcher::singleton().findSchema({"_test::dummy", ""});
+  ASSERT_TRUE(op.has_value());
+
+  c10::DispatchCache cache;
+  op->callUnboxedWithCache<void, Tensor>(cache, dummyTensor(c10::TensorTypeId::CPUTensorId));
+  EXPECT_TRUE(called_kernel1);
+
+  auto registrar2 = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options().kernel<MockKernel>(c10::TensorTypeId::CPUTensorId, &called_kernel2));
+  called_kernel1 = false;
+  op->callUnboxedWithCache<void, Tensor>(cache, dummyTensor(c10::TensorTypeId::CPUTensorId));
+  EXPECT_FALSE(called_kernel1);
+  EXPECT_TRUE(called_kernel2);
+
+  registrar2 = c10::RegisterOperators(); // destruct the registrar
+  called_kernel2 = false;
+  op->callUnboxedWithCache<void, Tensor>(cache, dummyTensor(c10::TensorTypeId::CPUTensorId));
+  EXPECT_TRUE(called_kernel1);
+  EXPECT_FALSE(called_kernel2);
+}
+
+TEST(OperatorRegistrationTest, givenDispatchCacheWithCatchallKernel_whenRegisteringBackendFallbackKernel_thenCallsFallbackKernel) {
+  auto registrar1 = c10::RegisterOperators().op("_test::dummy(Tensor dummy, str input) -> ()", c10::RegisterOperators::options()
+      .catchAllKernel([] (Tensor, std::string) {
+        called = true;
+      }));
+  auto op = Dispatcher::singleton().findSchema({"_test::dummy", ""});
+  ASSERT_TRUE(op.has_value());
+
+  c10::DispatchCache cache;
+  called = false;
+  auto stack = makeStack(dummyTensor(c10::TensorTypeId::CPUTensorId), "hello ");
+  op->callBoxedWithCache(cache, &stack);
+  EXPECT_TRUE(called);
+
+  {
+    auto registrar = c10::Dispatcher::singleton().registerBackendFallbackKernel(c10::TensorTypeId::CPUTensorId, c10::KernelFunction::makeFromBoxedFunction<&backend_fallback_kernel>());
+    called = false;
+    stack = makeStack(dummyTensor(c10::TensorTypeId::CPUTensorId), "hello ");
+    op->callBoxedWithCache(cache, &stack);
+    EXPECT_FALSE(called);
+    EXPECT_EQ("hello _test::dummy", stack[1].toString()->string());
+  }
+
+  called = false;
+  stack = makeStack(dummyTensor(c10::TensorTypeId::CPUTensorId), "hello ");
+  op->callBoxedWithCache(cache, &stack);
+  EXPECT_TRUE(called);
+}
+
 bool called_autograd = false;
 bool called_nonautograd = false;
 
@@ -0,0 +1,568 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#include <ATen/cpu/vec256/vec256_float.h>
+#include <c10/util/BFloat16.h>
+
+#include <tuple>
+
+// Vec256<BFloat16> holds 16 bfloat16 values. x86 has no bfloat16 arithmetic,
+// so every operation widens the two halves to Vec256<float>, computes in float
+// and rounds the result back to bfloat16 (round to nearest even, NaN to the
+// quiet NaN 0x7FC0), which is what the scalar c10::BFloat16 operators do.
+// Only abs, neg and the bitwise operators work on the raw bits.
+//
+// Rounding after every operation is fine for element-wise kernels, but kernels
+// that accumulate or chain many operations lose most of the precision that
+// way. Those should widen once with convert_bfloat16_float() (or
+// convert<BFloat16, float>() for a whole array), compute in float and round
+// once with convert_float_bfloat16().
+//
+// With AVX2 the values live in an __m256i and the conversions are done with
+// integer shifts; otherwise they are converted one by one.
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(__AVX2__) && !defined(_MSC_VER)
+
+static inline void cvtbf16_fp32(const __m256i& a, __m256& o1, __m256& o2) {
+  __m128i lo = _mm256_extractf128_si256(a, 0);
+  __m128i hi = _mm256_extractf128_si256(a, 1);
+  o1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(lo), 16));
+  o2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(hi), 16));
+}
+
+// Vectorized c10::detail::round_to_nearest_even.
+static inline __m256i cvtfp32_bf16(const __m256& a, const __m256& b) {
+  __m256i lo = _mm256_castps_si256(a);
+  __m256i hi = _mm256_castps_si256(b);
+  __m256i nan = _mm256_set1_epi32(0x7FC0);
+  __m256i mask_lo = _mm256_castps_si256(_mm256_cmp_ps(a, a, _CMP_ORD_Q));
+  __m256i mask_hi = _mm256_castps_si256(_mm256_cmp_ps(b, b, _CMP_ORD_Q));
+  __m256i ones = _mm256_set1_epi32(0x1);
+  __m256i vec_bias = _mm256_set1_epi32(0x7FFF);
+  // uint32_t lsb = (input >> 16) & 1;
+  auto t_lo = _mm256_and_si256(_mm256_srli_epi32(lo, 16), ones);
+  auto t_hi = _mm256_and_si256(_mm256_srli_epi32(hi, 16), ones);
+  // uint32_t rounding_bias = 0x7fff + lsb;
+  t_lo = _mm256_add_epi32(t_lo, vec_bias);
+  t_hi = _mm256_add_epi32(t_hi, vec_bias);
+  // input += rounding_bias;
+  t_lo = _mm256_add_epi32(t_lo, lo);
+  t_hi = _mm256_add_epi32(t_hi, hi);
+  // input = input >> 16;
+  t_lo = _mm256_srli_epi32(t_lo, 16);
+  t_hi = _mm256_srli_epi32(t_hi, 16);
+  // Check NaN before converting back to bf16
+  t_lo = _mm256_blendv_epi8(nan, t_lo, mask_lo);
+  t_hi = _mm256_blendv_epi8(nan, t_hi, mask_hi);
+
+  t_lo = _mm256_packus_epi32(t_lo, t_hi);      // t_hi[4-7] t_lo[4-7] t_hi[0-4] t_lo[0-4]
+  return _mm256_permute4x64_epi64(t_lo, 0xd8); // 11        01        10        00
+}
+
+// Narrows the all-ones / all-zeros lanes returned by float comparisons.
+// These are NaNs as floats, so they must not go through cvtfp32_bf16.
+static inline __m256i merge_compare_result(const __m256& a, const __m256& b) {
+  __m256i lo = _mm256_srli_epi32(_mm256_castps_si256(a), 16);
+  __m256i hi = _mm256_srli_epi32(_mm256_castps_si256(b), 16);
+  return _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8);
+}
+
+#endif
+
+template <> class Vec256<BFloat16> {
+private:
+#if defined(__AVX2__) && !defined(_MSC_VER)
+  __m256i values;
+#else
+  __at_align32__ uint16_t values[16];
+#endif
+
+  // Lane masks are all-ones / all-zeros 16-bit lanes, like the results of
+  // the comparison operators.
+  static Vec256<BFloat16> lane_mask(int64_t mask) {
+    __at_align32__ uint16_t tmp[size()];
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = (mask >> i) & 1 ? 0xFFFF : 0;
+    }
+    return loadu(tmp);
+  }
+  template <typename Op>
+  Vec256<BFloat16> map_as_fp32(const Op& op) const {
+    Vec256<float> lo, hi;
+    to_fp32(lo, hi);
+    return from_fp32(op(lo), op(hi));
+  }
+  template <typename Op>
+  Vec256<BFloat16> binary_as_fp32(const Vec256<BFloat16>& b, const Op& op) const {
+    Vec256<float> a_lo, a_hi, b_lo, b_hi;
+    to_fp32(a_lo, a_hi);
+    b.to_fp32(b_lo, b_hi);
+    return from_fp32(op(a_lo, b_lo), op(a_hi, b_hi));
+  }
+  template <typename Op>
+  Vec256<BFloat16> compare_as_fp32(const Vec256<BFloat16>& b, const Op& op) const {
+    Vec256<float> a_lo, a_hi, b_lo, b_hi;
+    to_fp32(a_lo, a_hi);
+    b.to_fp32(b_lo, b_hi);
+    Vec256<float> lo = op(a_lo, b_lo);
+    Vec256<float> hi = op(a_hi, b_hi);
+#if defined(__AVX2__) && !defined(_MSC_VER)
+    return merge_compare_result(lo, hi);
+#else
+    __at_align32__ uint32_t tmp[size()];
+    lo.store(tmp);
+    hi.store(tmp + Vec256<float>::size());
+    Vec256<BFloat16> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret.values[i] = tmp[i] >> 16;
+    }
+    return ret;
+#endif
+  }
+
+public:
+  using value_type = BFloat16;
+  static constexpr int size() {
+    return 16;
+  }
+  Vec256() {}
+#if defined(__AVX2__) && !defined(_MSC_VER)
+  Vec256(__m256i v) : values(v) {}
+  Vec256(BFloat16 val) {
+    values = _mm256_set1_epi16(val.x);
+  }
+  Vec256(BFloat16 val1, BFloat16 val2, BFloat16 val3, BFloat16 val4,
+         BFloat16 val5, BFloat16 val6, BFloat16 val7, BFloat16 val8,
+         BFloat16 val9, BFloat16 val10, BFloat16 val11, BFloat16 val12,
+         BFloat16 val13, BFloat16 val14, BFloat16 val15, BFloat16 val16) {
+    values = _mm256_setr_epi16(
+        val1.x, val2.x, val3.x, val4.x, val5.x, val6.x, val7.x, val8.x,
+        val9.x, val10.x, val11.x, val12.x, val13.x, val14.x, val15.x, val16.x);
+  }
+  operator __m256i() const {
+    return values;
+  }
+#else
+  Vec256(BFloat16 val) {
+    for (int64_t i = 0; i < size(); i++) {
+      values[i] = val.x;
+    }
+  }
+  Vec256(BFloat16 val1, BFloat16 val2, BFloat16 val3, BFloat16 val4,
+         BFloat16 val5, BFloat16 val6, BFloat16 val7, BFloat16 val8,
+         BFloat16 val9, BFloat16 val10, BFloat16 val11, BFloat16 val12,
+         BFloat16 val13, BFloat16 val14, BFloat16 val15, BFloat16 val16)
+    : values{val1.x, val2.x, val3.x, val4.x, val5.x, val6.x, val7.x, val8.x,
+             val9.x, val10.x, val11.x, val12.x, val13.x, val14.x, val15.x, val16.x} {}
+#endif
+
+  // Writes lanes 0-7 to lo and lanes 8-15 to hi.
+  void to_fp32(Vec256<float>& lo, Vec256<float>& hi) const {
+#if defined(__AVX2__) && !defined(_MSC_VER)
+    __m256 o1, o2;
+    cvtbf16_fp32(values, o1, o2);
+    lo = o1;
+    hi = o2;
+#else
+    __at_align32__ float tmp[size()];
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = c10::detail::f32_from_bits(values[i]);
+    }
+    lo = Vec256<float>::loadu(tmp);
+    hi = Vec256<float>::loadu(tmp + Vec256<float>::size());
+#endif
+  }
+  static Vec256<BFloat16> from_fp32(const Vec256<float>& lo, const Vec256<float>& hi) {
+#if defined(__AVX2__) && !defined(_MSC_VER)
+    return cvtfp32_bf16(lo, hi);
+#else
+    __at_align32__ float tmp[size()];
+    lo.store(tmp);
+    hi.store(tmp + Vec256<float>::size());
+    Vec256<BFloat16> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret.values[i] = c10::detail::round_to_nearest_even(tmp[i]);
+    }
+    return ret;
+#endif
+  }
+
+  template <int64_t mask>
+  static Vec256<BFloat16> blend(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+    return blendv(a, b, lane_mask(mask));
+  }
+  static Vec256<BFloat16> blendv(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b,
+                                 const Vec256<BFloat16>& mask) {
+#if defined(__AVX2__) && !defined(_MSC_VER)
+    return _mm256_blendv_epi8(a.values, b.values, mask.values);
+#else
+    Vec256<BFloat16> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret.values[i] = mask.values[i] ? b.values[i] : a.values[i];
+    }
+    return ret;
+#endif
+  }
+  static Vec256<BFloat16> arange(BFloat16 base = 0.f, BFloat16 step = 1.f) {
+    __at_align32__ BFloat16 tmp[size()];
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = static_cast<float>(base) + i * static_cast<float>(step);
+    }
+    return loadu(tmp);
+  }
+  static Vec256<BFloat16> set(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b,
+                              int64_t count = size()) {
+    if (count <= 0) {
+      return a;
+    } else if (count >= size()) {
+      return b;
+    }
+    return blendv(a, b, lane_mask((int64_t(1) << count) - 1));
+  }
+  static Vec256<BFloat16> loadu(const void* ptr, int64_t count = size()) {
+#if defined(__AVX2__) && !defined(_MSC_VER)
+    if (count == size())
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    __at_align32__ int16_t tmp_values[size()];
+    std::memcpy(tmp_values, ptr, count * sizeof(int16_t));
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tmp_values));
+#else
+    Vec256<BFloat16> ret;
+    std::memcpy(ret.values, ptr, count * sizeof(int16_t));
+    return ret;
+#endif
+  }
+  void store(void* ptr, int64_t count = size()) const {
+#if defined(__AVX2__) && !defined(_MSC_VER)
+    if (count == size()) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), values);
+    } else if (count > 0) {
+      __at_align32__ int16_t tmp_values[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp_values), values);
+      std::memcpy(ptr, tmp_values, count * sizeof(int16_t));
+    }
+#else
+    if (count > 0) {
+      std::memcpy(ptr, values, count * sizeof(int16_t));
+    }
+#endif
+  }
+  const BFloat16& operator[](int idx) const = delete;
+  BFloat16& operator[](int idx) = delete;
+  Vec256<BFloat16> map(BFloat16 (*f)(BFloat16)) const {
+    __at_align32__ BFloat16 tmp[size()];
+    store(tmp);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec256<BFloat16> abs() const {
+#if defined(__AVX2__) && !defined(_MSC_VER)
+    return _mm256_andnot_si256(_mm256_set1_epi16(0x8000), values);
+#else
+    Vec256<BFloat16> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret.values[i] = values[i] & 0x7FFF;
+    }
+    return ret;
+#endif
+  }
+  Vec256<BFloat16> angle() const {
+    return Vec256<BFloat16>(BFloat16(0));
+  }
+  Vec256<BFloat16> real() const {
+    return *this;
+  }
+  Vec256<BFloat16> imag() const {
+    return Vec256<BFloat16>(BFloat16(0));
+  }
+  Vec256<BFloat16> conj() const {
+    return *this;
+  }
+  Vec256<BFloat16> acos() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.acos(); });
+  }
+  Vec256<BFloat16> asin() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.asin(); });
+  }
+  Vec256<BFloat16> atan() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.atan(); });
+  }
+  Vec256<BFloat16> atan2(const Vec256<BFloat16>& b) const {
+    return binary_as_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) { return x.atan2(y); });
+  }
+  Vec256<BFloat16> erf() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.erf(); });
+  }
+  Vec256<BFloat16> erfc() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.erfc(); });
+  }
+  Vec256<BFloat16> erfinv() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.erfinv(); });
+  }
+  Vec256<BFloat16> exp() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.exp(); });
+  }
+  Vec256<BFloat16> expm1() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.expm1(); });
+  }
+  Vec256<BFloat16> log() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.log(); });
+  }
+  Vec256<BFloat16> log2() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.log2(); });
+  }
+  Vec256<BFloat16> log10() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.log10(); });
+  }
+  Vec256<BFloat16> log1p() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.log1p(); });
+  }
+  Vec256<BFloat16> frac() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.frac(); });
+  }
+  Vec256<BFloat16> sin() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.sin(); });
+  }
+  Vec256<BFloat16> sinh() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.sinh(); });
+  }
+  Vec256<BFloat16> cos() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.cos(); });
+  }
+  Vec256<BFloat16> cosh() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.cosh(); });
+  }
+  Vec256<BFloat16> ceil() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.ceil(); });
+  }
+  Vec256<BFloat16> floor() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.floor(); });
+  }
+  Vec256<BFloat16> neg() const {
+#if defined(__AVX2__) && !defined(_MSC_VER)
+    return _mm256_xor_si256(_mm256_set1_epi16(0x8000), values);
+#else
+    Vec256<BFloat16> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret.values[i] = values[i] ^ 0x8000;
+    }
+    return ret;
+#endif
+  }
+  Vec256<BFloat16> round() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.round(); });
+  }
+  Vec256<BFloat16> tan() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.tan(); });
+  }
+  Vec256<BFloat16> tanh() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.tanh(); });
+  }
+  Vec256<BFloat16> trunc() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.trunc(); });
+  }
+  Vec256<BFloat16> lgamma() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.lgamma(); });
+  }
+  Vec256<BFloat16> sqrt() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.sqrt(); });
+  }
+  Vec256<BFloat16> reciprocal() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.reciprocal(); });
+  }
+  Vec256<BFloat16> rsqrt() const {
+    return map_as_fp32([](const Vec256<float>& x) { return x.rsqrt(); });
+  }
+  Vec256<BFloat16> pow(const Vec256<BFloat16>& b) const {
+    return binary_as_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) { return x.pow(y); });
+  }
+  Vec256<BFloat16> operator==(const Vec256<BFloat16>& other) const {
+    return compare_as_fp32(other, [](const Vec256<float>& x, const Vec256<float>& y) { return x == y; });
+  }
+  Vec256<BFloat16> operator!=(const Vec256<BFloat16>& other) const {
+    return compare_as_fp32(other, [](const Vec256<float>& x, const Vec256<float>& y) { return x != y; });
+  }
+  Vec256<BFloat16> operator<(const Vec256<BFloat16>& other) const {
+    return compare_as_fp32(other, [](const Vec256<float>& x, const Vec256<float>& y) { return x < y; });
+  }
+  Vec256<BFloat16> operator<=(const Vec256<BFloat16>& other) const {
+    return compare_as_fp32(other, [](const Vec256<float>& x, const Vec256<float>& y) { return x <= y; });
+  }
+  Vec256<BFloat16> operator>(const Vec256<BFloat16>& other) const {
+    return compare_as_fp32(other, [](const Vec256<float>& x, const Vec256<float>& y) { return x > y; });
+  }
+  Vec256<BFloat16> operator>=(const Vec256<BFloat16>& other) const {
+    return compare_as_fp32(other, [](const Vec256<float>& x, const Vec256<float>& y) { return x >= y; });
+  }
+};
+
+template <typename Op>
+inline Vec256<BFloat16> binary_op_as_fp32(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b, const Op& op) {
+  Vec256<float> a_lo, a_hi, b_lo, b_hi;
+  a.to_fp32(a_lo, a_hi);
+  b.to_fp32(b_lo, b_hi);
+  return Vec256<BFloat16>::from_fp32(op(a_lo, b_lo), op(a_hi, b_hi));
+}
+
+// Widens a Vec256<BFloat16> to two Vec256<float> holding lanes 0-7 and 8-15.
+inline std::tuple<Vec256<float>, Vec256<float>> convert_bfloat16_float(const Vec256<BFloat16>& a) {
+  Vec256<float> lo, hi;
+  a.to_fp32(lo, hi);
+  return std::make_tuple(lo, hi);
+}
+
+// Rounds two Vec256<float> to nearest even bfloat16; the inverse of
+// convert_bfloat16_float.
+inline Vec256<BFloat16> convert_float_bfloat16(const Vec256<float>& lo, const Vec256<float>& hi) {
+  return Vec256<BFloat16>::from_fp32(lo, hi);
+}
+
+template <>
+Vec256<BFloat16> inline operator+(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return binary_op_as_fp32(a, b, [](const Vec256<float>& x, const Vec256<float>& y) { return x + y; });
+}
+
+template <>
+Vec256<BFloat16> inline operator-(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return binary_op_as_fp32(a, b, [](const Vec256<float>& x, const Vec256<float>& y) { return x - y; });
+}
+
+template <>
+Vec256<BFloat16> inline operator*(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return binary_op_as_fp32(a, b, [](const Vec256<float>& x, const Vec256<float>& y) { return x * y; });
+}
+
+template <>
+Vec256<BFloat16> inline operator/(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return binary_op_as_fp32(a, b, [](const Vec256<float>& x, const Vec256<float>& y) { return x / y; });
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec256<BFloat16> inline maximum(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return binary_op_as_fp32(a, b, [](const Vec256<float>& x, const Vec256<float>& y) { return maximum(x, y); });
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec256<BFloat16> inline minimum(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return binary_op_as_fp32(a, b, [](const Vec256<float>& x, const Vec256<float>& y) { return minimum(x, y); });
+}
+
+template <>
+Vec256<BFloat16> inline clamp(const Vec256<BFloat16>& a, const Vec256<BFloat16>& min, const Vec256<BFloat16>& max) {
+  Vec256<float> a_lo, a_hi, min_lo, min_hi, max_lo, max_hi;
+  a.to_fp32(a_lo, a_hi);
+  min.to_fp32(min_lo, min_hi);
+  max.to_fp32(max_lo, max_hi);
+  return Vec256<BFloat16>::from_fp32(clamp(a_lo, min_lo, max_lo), clamp(a_hi, min_hi, max_hi));
+}
+
+template <>
+Vec256<BFloat16> inline clamp_max(const Vec256<BFloat16>& a, const Vec256<BFloat16>& max) {
+  return binary_op_as_fp32(a, max, [](const Vec256<float>& x, const Vec256<float>& y) { return clamp_max(x, y); });
+}
+
+template <>
+Vec256<BFloat16> inline clamp_min(const Vec256<BFloat16>& a, const Vec256<BFloat16>& min) {
+  return binary_op_as_fp32(a, min, [](const Vec256<float>& x, const Vec256<float>& y) { return clamp_min(x, y); });
+}
+
+#if defined(__AVX2__) && !defined(_MSC_VER)
+
+template <>
+Vec256<BFloat16> inline operator&(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm256_and_si256(a, b);
+}
+
+template <>
+Vec256<BFloat16> inline operator|(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm256_or_si256(a, b);
+}
+
+template <>
+Vec256<BFloat16> inline operator^(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm256_xor_si256(a, b);
+}
+
+#else
+
+#define DEFINE_BFLOAT16_BITWISE_OP(op)                                                   \
+template <>                                                                              \
+Vec256<BFloat16> inline operator op(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) { \
+  __at_align32__ uint16_t a_bits[Vec256<BFloat16>::size()];                              \
+  __at_align32__ uint16_t b_bits[Vec256<BFloat16>::size()];                              \
+  a.store(a_bits);                                                                       \
+  b.store(b_bits);                                                                       \
+  for (int64_t i = 0; i < Vec256<BFloat16>::size(); i++) {                               \
+    a_bits[i] = a_bits[i] op b_bits[i];                                                  \
+  }                                                                                      \
+  return Vec256<BFloat16>::loadu(a_bits);                                                \
+}
+DEFINE_BFLOAT16_BITWISE_OP(&)
+DEFINE_BFLOAT16_BITWISE_OP(|)
+DEFINE_BFLOAT16_BITWISE_OP(^)
+#undef DEFINE_BFLOAT16_BITWISE_OP
+
+#endif
+
+// a * b + c is rounded once, not after the multiplication.
+template <>
+Vec256<BFloat16> inline fmadd(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b, const Vec256<BFloat16>& c) {
+  Vec256<float> a_lo, a_hi, b_lo, b_hi, c_lo, c_hi;
+  a.to_fp32(a_lo, a_hi);
+  b.to_fp32(b_lo, b_hi);
+  c.to_fp32(c_lo, c_hi);
+  return Vec256<BFloat16>::from_fp32(fmadd(a_lo, b_lo, c_lo), fmadd(a_hi, b_hi, c_hi));
+}
+
+template <>
+inline void convert(const BFloat16* src, float* dst, int64_t n) {
+  int64_t i;
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (i = 0; i <= (n - Vec256<BFloat16>::size()); i += Vec256<BFloat16>::size()) {
+    Vec256<float> lo, hi;
+    Vec256<BFloat16>::loadu(src + i).to_fp32(lo, hi);
+    lo.store(dst + i);
+    hi.store(dst + i + Vec256<float>::size());
+  }
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+inline void convert(const float* src, BFloat16* dst, int64_t n) {
+  int64_t i;
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (i = 0; i <= (n - Vec256<BFloat16>::size()); i += Vec256<BFloat16>::size()) {
+    Vec256<float> lo = Vec256<float>::loadu(src + i);
+    Vec256<float> hi = Vec256<float>::loadu(src + i + Vec256<float>::size());
+    Vec256<BFloat16>::from_fp32(lo, hi).store(dst + i);
+  }
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (; i < n; i++) {
+    dst[i] = static_cast<BFloat16>(src[i]);
+  }
+}
+
+}}}
@@ -0,0 +1,551 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec512/vec512_base.h>
+
+namespace at {
+namespace vec512 {
+namespace {
+
+#if defined(AT_VEC512_ENABLED)
+
+// Unlike AVX2, AVX-512 has native 64-bit multiply, min and max, so none of
+// the integer operations below need to be emulated.
+struct Vec512i {
+protected:
+  __m512i values;
+
+public:
+  Vec512i() {}
+  Vec512i(__m512i v) : values(v) {}
+  operator __m512i() const {
+    return values;
+  }
+};
+
+template <>
+struct Vec512<int64_t> : public Vec512i {
+private:
+  static Vec512<int64_t> mask_to_vec(__mmask8 mask) {
+    return _mm512_maskz_set1_epi64(mask, -1);
+  }
+  static constexpr __mmask8 first_n(int64_t count) {
+    return static_cast<__mmask8>((1ull << count) - 1);
+  }
+public:
+  using value_type = int64_t;
+  static constexpr int size() {
+    return 8;
+  }
+  using Vec512i::Vec512i;
+  Vec512() {}
+  Vec512(int64_t v) { values = _mm512_set1_epi64(v); }
+  Vec512(int64_t val1, int64_t val2, int64_t val3, int64_t val4,
+         int64_t val5, int64_t val6, int64_t val7, int64_t val8) {
+    __at_align64__ int64_t tmp_values[size()] = {val1, val2, val3, val4, val5, val6, val7, val8};
+    values = _mm512_load_si512(reinterpret_cast<const __m512i*>(tmp_values));
+  }
+  template <int64_t mask>
+  static Vec512<int64_t> blend(Vec512<int64_t> a, Vec512<int64_t> b) {
+    return _mm512_mask_blend_epi64(static_cast<__mmask8>(mask), a.values, b.values);
+  }
+  static Vec512<int64_t> blendv(const Vec512<int64_t>& a, const Vec512<int64_t>& b,
+                              const Vec512<int64_t>& mask) {
+    return _mm512_mask_blend_epi64(_mm512_movepi64_mask(mask.values), a.values, b.values);
+  }
+  static Vec512<int64_t> arange(int64_t base = 0, int64_t step = 1) {
+    __at_align64__ int64_t tmp_values[size()];
+    for (int64_t i = 0; i < size(); i++) {
+      tmp_values[i] = base + i * step;
+    }
+    return loadu(tmp_values);
+  }
+  static Vec512<int64_t>
+  set(Vec512<int64_t> a, Vec512<int64_t> b, int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    return _mm512_mask_blend_epi64(first_n(count), a.values, b.values);
+  }
+  static Vec512<int64_t> loadu(const void* ptr) {
+    return _mm512_loadu_si512(ptr);
+  }
+  static Vec512<int64_t> loadu(const void* ptr, int64_t count) {
+    return _mm512_maskz_loadu_epi64(first_n(count), ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_si512(ptr, values);
+    } else if (count > 0) {
+      _mm512_mask_storeu_epi64(ptr, first_n(count), values);
+    }
+  }
+  const int64_t& operator[](int idx) const  = delete;
+  int64_t& operator[](int idx)  = delete;
+  Vec512<int64_t> abs() const {
+    return _mm512_abs_epi64(values);
+  }
+  Vec512<int64_t> angle() const {
+    return _mm512_set1_epi64(0);
+  }
+  Vec512<int64_t> real() const {
+    return *this;
+  }
+  Vec512<int64_t> imag() const {
+    return _mm512_set1_epi64(0);
+  }
+  Vec512<int64_t> conj() const {
+    return *this;
+  }
+  Vec512<int64_t> frac() const;
+  Vec512<int64_t> neg() const;
+  Vec512<int64_t> operator==(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmpeq_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator!=(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmpneq_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator<(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmplt_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator<=(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmple_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator>(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmpgt_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator>=(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmpge_epi64_mask(values, other.values));
+  }
+};
+
+template <>
+struct Vec512<int32_t> : public Vec512i {
+private:
+  static Vec512<int32_t> mask_to_vec(__mmask16 mask) {
+    return _mm512_maskz_set1_epi32(mask, -1);
+  }
+  static constexpr __mmask16 first_n(int64_t count) {
+    return static_cast<__mmask16>((1ull << count) - 1);
+  }
+public:
+  using value_type = int32_t;
+  static constexpr int size() {
+    return 16;
+  }
+  using Vec512i::Vec512i;
+  Vec512() {}
+  Vec512(int32_t v) { values = _mm512_set1_epi32(v); }
+  Vec512(int32_t val1, int32_t val2, int32_t val3, int32_t val4,
+         int32_t val5, int32_t val6, int32_t val7, int32_t val8,
+         int32_t val9, int32_t val10, int32_t val11, int32_t val12,
+         int32_t val13, int32_t val14, int32_t val15, int32_t val16) {
+    __at_align64__ int32_t tmp_values[size()] = {val1, val2, val3, val4, val5, val6, val7, val8,
+        val9, val10, val11, val12, val13, val14, val15, val16};
+    values = _mm512_load_si512(reinterpret_cast<const __m512i*>(tmp_values));
+  }
+  template <int64_t mask>
+  static Vec512<int32_t> blend(Vec512<int32_t> a, Vec512<int32_t> b) {
+    return _mm512_mask_blend_epi32(static_cast<__mmask16>(mask), a.values, b.values);
+  }
+  static Vec512<int32_t> blendv(const Vec512<int32_t>& a, const Vec512<int32_t>& b,
+                              const Vec512<int32_t>& mask) {
+    return _mm512_mask_blend_epi32(_mm512_movepi32_mask(mask.values), a.values, b.values);
+  }
+  static Vec512<int32_t> arange(int32_t base = 0, int32_t step = 1) {
+    __at_align64__ int32_t tmp_values[size()];
+    for (int64_t i = 0; i < size(); i++) {
+      tmp_values[i] = base + i * step;
+    }
+    return loadu(tmp_values);
+  }
+  static Vec512<int32_t>
+  set(Vec512<int32_t> a, Vec512<int32_t> b, int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    return _mm512_mask_blend_epi32(first_n(count), a.values, b.values);
+  }
+  static Vec512<int32_t> loadu(const void* ptr) {
+    return _mm512_loadu_si512(ptr);
+  }
+  static Vec512<int32_t> loadu(const void* ptr, int64_t count) {
+    return _mm512_maskz_loadu_epi32(first_n(count), ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_si512(ptr, values);
+    } else if (count > 0) {
+      _mm512_mask_storeu_epi32(ptr, first_n(count), values);
+    }
+  }
+  const int32_t& operator[](int idx) const  = delete;
+  int32_t& operator[](int idx)  = delete;
+  Vec512<int32_t> abs() const {
+    return _mm512_abs_epi32(values);
+  }
+  Vec512<int32_t> angle() const {
+    return _mm512_set1_epi32(0);
+  }
+  Vec512<int32_t> real() const {
+    return *this;
+  }
+  Vec512<int32_t> imag() const {
+    return _mm512_set1_epi32(0);
+  }
+  Vec512<int32_t> conj() const {
+    return *this;
+  }
+  Vec512<int32_t> frac() const;
+  Vec512<int32_t> neg() const;
+  Vec512<int32_t> operator==(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmpeq_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator!=(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmpneq_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator<(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmplt_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator<=(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmple_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator>(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmpgt_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator>=(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmpge_epi32_mask(values, other.values));
+  }
+};
+
+template <>
+struct Vec512<int16_t> : public Vec512i {
+private:
+  static Vec512<int16_t> mask_to_vec(__mmask32 mask) {
+    return _mm512_maskz_set1_epi16(mask, -1);
+  }
+  static constexpr __mmask32 first_n(int64_t count) {
+    return static_cast<__mmask32>((1ull << count) - 1);
+  }
+public:
+  using value_type = int16_t;
+  static constexpr int size() {
+    return 32;
+  }
+  using Vec512i::Vec512i;
+  Vec512() {}
+  Vec512(int16_t v) { values = _mm512_set1_epi16(v); }
+  Vec512(int16_t val1, int16_t val2, int16_t val3, int16_t val4,
+         int16_t val5, int16_t val6, int16_t val7, int16_t val8,
+         int16_t val9, int16_t val10, int16_t val11, int16_t val12,
+         int16_t val13, int16_t val14, int16_t val15, int16_t val16,
+         int16_t val17, int16_t val18, int16_t val19, int16_t val20,
+         int16_t val21, int16_t val22, int16_t val23, int16_t val24,
+         int16_t val25, int16_t val26, int16_t val27, int16_t val28,
+         int16_t val29, int16_t val30, int16_t val31, int16_t val32) {
+    __at_align64__ int16_t tmp_values[size()] = {val1, val2, val3, val4, val5, val6, val7, val8,
+        val9, val10, val11, val12, val13, val14, val15, val16,
+        val17, val18, val19, val20, val21, val22, val23, val24,
+        val25, val26, val27, val28, val29, val30, val31, val32};
+    values = _mm512_load_si512(reinterpret_cast<const __m512i*>(tmp_values));
+  }
+  template <int64_t mask>
+  static Vec512<int16_t> blend(Vec512<int16_t> a, Vec512<int16_t> b) {
+    return _mm512_mask_blend_epi16(static_cast<__mmask32>(mask), a.values, b.values);
+  }
+  static Vec512<int16_t> blendv(const Vec512<int16_t>& a, const Vec512<int16_t>& b,
+                              const Vec512<int16_t>& mask) {
+    return _mm512_mask_blend_epi16(_mm512_movepi16_mask(mask.values), a.values, b.values);
+  }
+  static Vec512<int16_t> arange(int16_t base = 0, int16_t step = 1) {
+    __at_align64__ int16_t tmp_values[size()];
+    for (int64_t i = 0; i < size(); i++) {
+      tmp_values[i] = base + i * step;
+    }
+    return loadu(tmp_values);
+  }
+  static Vec512<int16_t>
+  set(Vec512<int16_t> a, Vec512<int16_t> b, int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    return _mm512_mask_blend_epi16(first_n(count), a.values, b.values);
+  }
+  static Vec512<int16_t> loadu(const void* ptr) {
+    return _mm512_loadu_si512(ptr);
+  }
+  static Vec512<int16_t> loadu(const void* ptr, int64_t count) {
+    return _mm512_maskz_loadu_epi16(first_n(count), ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_si512(ptr, values);
+    } else if (count > 0) {
+      _mm512_mask_storeu_epi16(ptr, first_n(count), values);
+    }
+  }
+  const int16_t& operator[](int idx) const  = delete;
+  int16_t& operator[](int idx)  = delete;
+  Vec512<int16_t> abs() const {
+    return _mm512_abs_epi16(values);
+  }
+  Vec512<int16_t> angle() const {
+    return _mm512_set1_epi16(0);
+  }
+  Vec512<int16_t> real() const {
+    return *this;
+  }
+  Vec512<int16_t> imag() const {
+    return _mm512_set1_epi16(0);
+  }
+  Vec512<int16_t> conj() const {
+    return *this;
+  }
+  Vec512<int16_t> frac() const;
+  Vec512<int16_t> neg() const;
+  Vec512<int16_t> operator==(const Vec512<int16_t>& other) const {
+    return mask_to_vec(_mm512_cmpeq_epi16_mask(values, other.values));
+  }
+  Vec512<int16_t> operator!=(const Vec512<int16_t>& other) const {
+    return mask_to_vec(_mm512_cmpneq_epi16_mask(values, other.values));
+  }
+  Vec512<int16_t> operator<(const Vec512<int16_t>& other) const {
+    return mask_to_vec(_mm512_cmplt_epi16_mask(values, other.values));
+  }
+  Vec512<int16_t> operator<=(const Vec512<int16_t>& other) const {
+    return mask_to_vec(_mm512_cmple_epi16_mask(values, other.values));
+  }
+  Vec512<int16_t> operator>(const Vec512<int16_t>& other) const {
+    return mask_to_vec(_mm512_cmpgt_epi16_mask(values, other.values));
+  }
+  Vec512<int16_t> operator>=(const Vec512<int16_t>& other) const {
+    return mask_to_vec(_mm512_cmpge_epi16_mask(values, other.values));
+  }
+};
+
+template <>
+Vec512<int64_t> inline operator+(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_add_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline operator-(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_sub_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline operator*(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_mullo_epi64(a, b);
+}
+
+// Negation. Defined here so we can utilize operator-
+Vec512<int64_t> Vec512<int64_t>::neg() const {
+  return Vec512<int64_t>(0) - *this;
+}
+
+template <>
+Vec512<int64_t> inline minimum(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_min_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline maximum(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_max_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline clamp(const Vec512<int64_t>& a, const Vec512<int64_t>& min_val, const Vec512<int64_t>& max_val) {
+  return _mm512_min_epi64(max_val, _mm512_max_epi64(a, min_val));
+}
+
+template <>
+Vec512<int64_t> inline clamp_max(const Vec512<int64_t>& a, const Vec512<int64_t>& max_val) {
+  return _mm512_min_epi64(max_val, a);
+}
+
+template <>
+Vec512<int64_t> inline clamp_min(const Vec512<int64_t>& a, const Vec512<int64_t>& min_val) {
+  return _mm512_max_epi64(min_val, a);
+}
+
+template <>
+Vec512<int32_t> inline operator+(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_add_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline operator-(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_sub_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline operator*(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_mullo_epi32(a, b);
+}
+
+// Negation. Defined here so we can utilize operator-
+Vec512<int32_t> Vec512<int32_t>::neg() const {
+  return Vec512<int32_t>(0) - *this;
+}
+
+template <>
+Vec512<int32_t> inline minimum(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_min_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline maximum(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_max_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline clamp(const Vec512<int32_t>& a, const Vec512<int32_t>& min_val, const Vec512<int32_t>& max_val) {
+  return _mm512_min_epi32(max_val, _mm512_max_epi32(a, min_val));
+}
+
+template <>
+Vec512<int32_t> inline clamp_max(const Vec512<int32_t>& a, const Vec512<int32_t>& max_val) {
+  return _mm512_min_epi32(max_val, a);
+}
+
+template <>
+Vec512<int32_t> inline clamp_min(const Vec512<int32_t>& a, const Vec512<int32_t>& min_val) {
+  return _mm512_max_epi32(min_val, a);
+}
+
+template <>
+Vec512<int16_t> inline operator+(const Vec512<int16_t>& a, const Vec512<int16_t>& b) {
+  return _mm512_add_epi16(a, b);
+}
+
+template <>
+Vec512<int16_t> inline operator-(const Vec512<int16_t>& a, const Vec512<int16_t>& b) {
+  return _mm512_sub_epi16(a, b);
+}
+
+template <>
+Vec512<int16_t> inline operator*(const Vec512<int16_t>& a, const Vec512<int16_t>& b) {
+  return _mm512_mullo_epi16(a, b);
+}
+
+// Negation. Defined here so we can utilize operator-
+Vec512<int16_t> Vec512<int16_t>::neg() const {
+  return Vec512<int16_t>(0) - *this;
+}
+
+template <>
+Vec512<int16_t> inline minimum(const Vec512<int16_t>& a, const Vec512<int16_t>& b) {
+  return _mm512_min_epi16(a, b);
+}
+
+template <>
+Vec512<int16_t> inline maximum(const Vec512<int16_t>& a, const Vec512<int16_t>& b) {
+  return _mm512_max_epi16(a, b);
+}
+
+template <>
+Vec512<int16_t> inline clamp(const Vec512<int16_t>& a, const Vec512<int16_t>& min_val, const Vec512<int16_t>& max_val) {
+  return _mm512_min_epi16(max_val, _mm512_max_epi16(a, min_val));
+}
+
+template <>
+Vec512<int16_t> inline clamp_max(const Vec512<int16_t>& a, const Vec512<int16_t>& max_val) {
+  return _mm512_min_epi16(max_val, a);
+}
+
+template <>
+Vec512<int16_t> inline clamp_min(const Vec512<int16_t>& a, const Vec512<int16_t>& min_val) {
+  return _mm512_max_epi16(min_val, a);
+}
+
+template <>
+inline void convert(const int32_t *src, float *dst, int64_t n) {
+  int64_t i;
+  // int32_t and float have same size
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (i = 0; i <= (n - Vec512<int32_t>::size()); i += Vec512<int32_t>::size()) {
+    auto input_vec = _mm512_loadu_si512(src + i);
+    auto output_vec = _mm512_cvtepi32_ps(input_vec);
+    _mm512_storeu_ps(dst + i, output_vec);
+  }
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+inline void convert(const int32_t *src, double *dst, int64_t n) {
+  int64_t i;
+  // int32_t has half the size of double
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (i = 0; i <= (n - Vec512<double>::size()); i += Vec512<double>::size()) {
+    auto input_256_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    auto output_vec = _mm512_cvtepi32_pd(input_256_vec);
+    _mm512_storeu_pd(dst + i, output_vec);
+  }
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (; i < n; i++) {
+    dst[i] = static_cast<double>(src[i]);
+  }
+}
+
+template<typename T>
+Vec512<int32_t> inline convert_to_int32(const T* ptr) {
+  return Vec512<int32_t>::loadu(ptr);
+}
+
+template<>
+Vec512<int32_t> inline convert_to_int32<int8_t>(const int8_t* ptr) {
+  return _mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+}
+
+template<>
+Vec512<int32_t> inline convert_to_int32<uint8_t>(const uint8_t* ptr) {
+  return _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+}
+
+template <typename T>
+Vec512<T> inline intdiv_512(const Vec512<T>& a, const Vec512<T>& b) {
+  T values_a[Vec512<T>::size()];
+  T values_b[Vec512<T>::size()];
+  a.store(values_a);
+  b.store(values_b);
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    values_a[i] /= values_b[i];
+  }
+  return Vec512<T>::loadu(values_a);
+}
+
+#define DEFINE_INTEGER_BINARY_OP(op, func)                                                \
+template <>                                                                               \
+Vec512<int64_t> inline operator op(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {  \
+  return func(a, b);                                                                      \
+}                                                                                         \
+template <>                                                                               \
+Vec512<int32_t> inline operator op(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {  \
+  return func(a, b);                                                                      \
+}                                                                                         \
+template <>                                                                               \
+Vec512<int16_t> inline operator op(const Vec512<int16_t>& a, const Vec512<int16_t>& b) {  \
+  return func(a, b);                                                                      \
+}
+
+DEFINE_INTEGER_BINARY_OP(/, intdiv_512)
+DEFINE_INTEGER_BINARY_OP(&, _mm512_and_si512)
+DEFINE_INTEGER_BINARY_OP(|, _mm512_or_si512)
+DEFINE_INTEGER_BINARY_OP(^, _mm512_xor_si512)
+
+#undef DEFINE_INTEGER_BINARY_OP
+
+#endif
+
+}}}
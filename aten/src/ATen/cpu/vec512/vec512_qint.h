@@ -0,0 +1,356 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec512/vec512_base.h>
+#include <ATen/quantized/Quantizer.h>
+#include <c10/util/qint8.h>
+#include <c10/util/quint8.h>
+#include <c10/util/qint32.h>
+
+#include <array>
+
+// This file defines Vec512<> for the quantized types, following
+// vec256_qint.h: the classes are converters between the quantized types and
+// Vec512<float>, and the arithmetic is carried out in full precision.
+//
+// Conversions are as follows:
+//  Vec512<qint8> -> 4x Vec512<float>
+//  Vec512<quint8> -> 4x Vec512<float>
+//  Vec512<qint32> -> 1x Vec512<float>
+//
+// Unlike Vec256, there is no emulated fallback: these specializations only
+// exist when compiling for CPUCapability::AVX512.
+
+namespace at {
+namespace vec512 {
+namespace {
+
+#if defined(AT_VEC512_ENABLED)
+
+// Rounds zero_point + src * inverse_scale to the nearest integer (ties to
+// even, like QuantizeAvx2) for 4 x 16 floats and saturates the result to the
+// range of T.
+template <typename T>
+inline __m512i quantize_avx512(
+    const float* src,
+    float inverse_scale,
+    int64_t zero_point);
+
+template <>
+inline __m512i quantize_avx512<int8_t>(
+    const float* src,
+    float inverse_scale,
+    int64_t zero_point) {
+  __m512 inverse_scale_v = _mm512_set1_ps(inverse_scale);
+  __m512 zero_point_v = _mm512_set1_ps(zero_point);
+  __m512i result = _mm512_setzero_si512();
+  for (int i = 0; i < 4; i++) {
+    __m512 transformed =
+        _mm512_fmadd_ps(_mm512_loadu_ps(src + 16 * i), inverse_scale_v, zero_point_v);
+    __m128i packed = _mm512_cvtsepi32_epi8(_mm512_cvtps_epi32(transformed));
+    result = _mm512_inserti32x4(result, packed, 0);
+    result = _mm512_alignr_epi32(result, result, 4);
+  }
+  return result;
+}
+
+template <>
+inline __m512i quantize_avx512<uint8_t>(
+    const float* src,
+    float inverse_scale,
+    int64_t zero_point) {
+  __m512 inverse_scale_v = _mm512_set1_ps(inverse_scale);
+  __m512 zero_point_v = _mm512_set1_ps(zero_point);
+  __m512i zero = _mm512_setzero_si512();
+  __m512i result = _mm512_setzero_si512();
+  for (int i = 0; i < 4; i++) {
+    __m512 transformed =
+        _mm512_fmadd_ps(_mm512_loadu_ps(src + 16 * i), inverse_scale_v, zero_point_v);
+    // cvtusepi32 saturates unsigned inputs, so clamp negatives to 0 first.
+    __m512i rounded = _mm512_max_epi32(_mm512_cvtps_epi32(transformed), zero);
+    __m128i packed = _mm512_cvtusepi32_epi8(rounded);
+    result = _mm512_inserti32x4(result, packed, 0);
+    result = _mm512_alignr_epi32(result, result, 4);
+  }
+  return result;
+}
+
+template <typename T>
+struct Vec512QuantizedConverter {
+  static constexpr int size() {
+    return 64;
+  }
+
+  static constexpr int float_num_vecs() {
+    return 4;
+  }
+
+  using float_vec_return_type = std::array<Vec512<float>, 4>;
+  using value_type = typename T::underlying;
+
+ protected:
+  __m512i vals __attribute__((aligned(64)));
+
+  Vec512QuantizedConverter() {}
+  Vec512QuantizedConverter(__m512i vals_) : vals(vals_) {}
+
+  // Loads 16 consecutive 8-bit values starting at lane 16 * i.
+  __m128i quarter(int i) const {
+    switch (i) {
+      case 0:
+        return _mm512_extracti32x4_epi32(vals, 0);
+      case 1:
+        return _mm512_extracti32x4_epi32(vals, 1);
+      case 2:
+        return _mm512_extracti32x4_epi32(vals, 2);
+    }
+    return _mm512_extracti32x4_epi32(vals, 3);
+  }
+
+ public:
+  void store(void* ptr, int count = size()) const {
+    if (count != size()) {
+      _mm512_mask_storeu_epi8(ptr, (__mmask64)((1ull << count) - 1), vals);
+    } else {
+      _mm512_storeu_si512(ptr, vals);
+    }
+  }
+
+  void dump() const {
+    for (size_t i = 0; i < size(); ++i) {
+      std::cout << (int)((value_type*)&vals)[i] << " ";
+    }
+    std::cout << std::endl;
+  }
+};
+
+template<>
+struct Vec512<c10::qint8> : public Vec512QuantizedConverter<c10::qint8> {
+  // Broadcast constructor
+  Vec512(const c10::qint8& val) {
+    value_type uw = val.val_;
+    vals = _mm512_set1_epi8(uw);
+  }
+
+  Vec512(const Vec512<c10::qint8>& other) : Vec512QuantizedConverter(other.vals) {}
+
+  static Vec512<c10::qint8> loadu(const void* ptr) {
+    return Vec512<c10::qint8>(_mm512_loadu_si512(ptr));
+  }
+
+  float_vec_return_type dequantize(
+      Vec512<float> scale,
+      Vec512<float> zero_point,
+      Vec512<float> scale_neg_zp_premul) const {
+    float_vec_return_type result;
+    for (int i = 0; i < float_num_vecs(); i++) {
+      __m512 float_vals = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(quarter(i)));
+      result[i] = vec512::fmadd(scale, Vec512<float>(float_vals), scale_neg_zp_premul);
+    }
+    return result;
+  }
+
+  static Vec512<c10::qint8> quantize(
+      const float_vec_return_type& rhs,
+      float scale,
+      int32_t zero_point,
+      float inverse_scale) {
+    __at_align64__ float float_vals[64];
+    for (int i = 0; i < float_num_vecs(); i++) {
+      rhs[i].store(float_vals + 16 * i);
+    }
+    return Vec512<c10::qint8>(
+        quantize_avx512<int8_t>(float_vals, inverse_scale, zero_point));
+  }
+
+  Vec512<c10::qint8> maximum(Vec512<c10::qint8> b) const {
+    return Vec512<c10::qint8>(_mm512_max_epi8(vals, b.vals));
+  }
+
+  Vec512<c10::qint8> minimum(Vec512<c10::qint8> b) const {
+    return Vec512<c10::qint8>(_mm512_min_epi8(vals, b.vals));
+  }
+
+  Vec512<c10::qint8> relu(Vec512<c10::qint8> zero_point) const {
+    return maximum(zero_point);
+  }
+
+  Vec512<c10::qint8> relu6(
+      Vec512<c10::qint8> zero_point,
+      Vec512<c10::qint8> q_six) {
+    return Vec512<c10::qint8>(
+        _mm512_min_epi8(_mm512_max_epi8(vals, zero_point.vals), q_six.vals));
+  }
+
+ private:
+  Vec512() {}
+  Vec512(__m512i vals_) : Vec512QuantizedConverter(vals_) {}
+};
+
+template <>
+Vec512<c10::qint8> inline maximum(const Vec512<c10::qint8>& a, const Vec512<c10::qint8>& b) {
+  return a.maximum(b);
+}
+
+template<>
+struct Vec512<c10::quint8> : public Vec512QuantizedConverter<c10::quint8> {
+  // Broadcast constructor
+  Vec512(const c10::quint8& val) {
+    value_type uw = val.val_;
+    vals = _mm512_set1_epi8(uw);
+  }
+
+  Vec512(const Vec512<c10::quint8>& other) : Vec512QuantizedConverter(other.vals) {}
+
+  static Vec512<c10::quint8> loadu(const void* ptr) {
+    return Vec512<c10::quint8>(_mm512_loadu_si512(ptr));
+  }
+
+  float_vec_return_type dequantize(
+      Vec512<float> scale,
+      Vec512<float> zero_point,
+      Vec512<float> scale_zp_premul) const {
+    float_vec_return_type result;
+    for (int i = 0; i < float_num_vecs(); i++) {
+      __m512 float_vals = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(quarter(i)));
+      result[i] = vec512::fmadd(scale, Vec512<float>(float_vals), scale_zp_premul);
+    }
+    return result;
+  }
+
+  static Vec512<c10::quint8> quantize(
+      const float_vec_return_type& rhs,
+      float scale,
+      int32_t zero_point,
+      float inverse_scale) {
+    __at_align64__ float float_vals[64];
+    for (int i = 0; i < float_num_vecs(); i++) {
+      rhs[i].store(float_vals + 16 * i);
+    }
+    return Vec512<c10::quint8>(
+        quantize_avx512<uint8_t>(float_vals, inverse_scale, zero_point));
+  }
+
+  Vec512<c10::quint8> maximum(Vec512<c10::quint8> b) const {
+    return Vec512<c10::quint8>(_mm512_max_epu8(vals, b.vals));
+  }
+
+  Vec512<c10::quint8> minimum(Vec512<c10::quint8> b) const {
+    return Vec512<c10::quint8>(_mm512_min_epu8(vals, b.vals));
+  }
+
+  Vec512<c10::quint8> relu(Vec512<c10::quint8> zero_point) const {
+    return maximum(zero_point);
+  }
+
+  Vec512<c10::quint8> relu6(
+      Vec512<c10::quint8> zero_point,
+      Vec512<c10::quint8> q_six) {
+    return Vec512<c10::quint8>(
+        _mm512_min_epu8(_mm512_max_epu8(vals, zero_point.vals), q_six.vals));
+  }
+
+ private:
+  Vec512() {}
+  Vec512(__m512i vals_) : Vec512QuantizedConverter(vals_) {}
+};
+
+template <>
+Vec512<c10::quint8> inline maximum(const Vec512<c10::quint8>& a, const Vec512<c10::quint8>& b) {
+  return a.maximum(b);
+}
+
+template<>
+struct Vec512<c10::qint32> {
+  static constexpr int size() {
+    return 16;
+  }
+
+  static constexpr int float_num_vecs() {
+    return 1;
+  }
+
+  using float_vec_return_type = std::array<Vec512<float>, 1>;
+  using value_type = c10::qint32::underlying;
+
+ private:
+  __m512i vals __attribute__((aligned(64)));
+
+ public:
+  Vec512(const c10::qint32& val) {
+    value_type uw = val.val_;
+    vals = _mm512_set1_epi32(uw);
+  }
+
+  void store(void* ptr, int count = size()) const {
+    if (count != size()) {
+      _mm512_mask_storeu_epi32(ptr, (__mmask16)((1u << count) - 1), vals);
+    } else {
+      _mm512_storeu_si512(ptr, vals);
+    }
+  }
+
+  static Vec512<c10::qint32> loadu(const void* ptr) {
+    return Vec512<c10::qint32>(_mm512_loadu_si512(ptr));
+  }
+
+  float_vec_return_type dequantize(
+      Vec512<float> scale,
+      Vec512<float> zero_point,
+      Vec512<float> scale_zp_premul) const {
+    __m512 float_vals = _mm512_cvtepi32_ps(vals);
+    return {vec512::fmadd(scale, Vec512<float>(float_vals), scale_zp_premul)};
+  }
+
+  static Vec512<c10::qint32> quantize(
+      const float_vec_return_type& rhs,
+      float scale,
+      int32_t zero_point,
+      float inverse_scale) {
+    Vec512<c10::qint32> retval;
+    __at_align64__ float float_vals[16];
+    rhs[0].store(float_vals);
+    at::quantize_vec<c10::qint32, /*precision=*/32>(
+        scale, zero_point, float_vals, (c10::qint32*)&retval.vals, 16);
+    return retval;
+  }
+
+  Vec512<c10::qint32> maximum(Vec512<c10::qint32> b) const {
+    return Vec512<c10::qint32>(_mm512_max_epi32(vals, b.vals));
+  }
+
+  Vec512<c10::qint32> minimum(Vec512<c10::qint32> b) const {
+    return Vec512<c10::qint32>(_mm512_min_epi32(vals, b.vals));
+  }
+
+  Vec512<c10::qint32> relu(Vec512<c10::qint32> zero_point) const {
+    return maximum(zero_point);
+  }
+
+  Vec512<c10::qint32> relu6(
+      Vec512<c10::qint32> zero_point,
+      Vec512<c10::qint32> q_six) {
+    return Vec512<c10::qint32>(
+        _mm512_min_epi32(_mm512_max_epi32(vals, zero_point.vals), q_six.vals));
+  }
+
+  void dump() const {
+    for (size_t i = 0; i < 16; ++i) {
+      std::cout << ((int32_t*)&vals)[i] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+ private:
+  Vec512() {}
+  Vec512(__m512i vals_) : vals(vals_) {}
+};
+
+template <>
+Vec512<c10::qint32> inline maximum(const Vec512<c10::qint32>& a, const Vec512<c10::qint32>& b) {
+  return a.maximum(b);
+}
+
+#endif
+
+}}}
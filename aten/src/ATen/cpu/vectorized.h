@@ -0,0 +1,174 @@
+#pragma once
+
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/cpu/vec512/functional.h>
+#include <ATen/cpu/vec512/vec512.h>
+
+#include <type_traits>
+
+// This header lets a kernel in native/cpu be written once against
+// at::vec::Vectorized<T> and compiled for every CPU capability.
+//
+// Vectorized<T> is Vec512<T> when the translation unit is compiled for
+// CPUCapability::AVX512 and Vec512 has an AVX-512 implementation for T, and
+// Vec256<T> otherwise (e.g. for complex types, whose Vec256 is still faster
+// than the emulated Vec512). Code that uses it must not assume a particular
+// Vectorized<T>::size().
+//
+// The free functions are re-exported so that kernels do not depend on the
+// namespace of the vector type they end up with.
+//
+// Only kernels registered with ALSO_REGISTER_AVX512_DISPATCH are compiled
+// for AVX512; see Note [AVX512 opt-in] in DispatchStub.h.
+
+namespace at {
+namespace vec {
+
+// See Note [Acceptable use of anonymous namespace in header]. In particular
+// has_native_vec512 differs between capabilities.
+namespace {
+
+template <typename T>
+struct has_native_vec512 : std::false_type {};
+
+#if defined(CPU_CAPABILITY_AVX512) && defined(AT_VEC512_ENABLED)
+template <> struct has_native_vec512<float> : std::true_type {};
+template <> struct has_native_vec512<double> : std::true_type {};
+template <> struct has_native_vec512<int64_t> : std::true_type {};
+template <> struct has_native_vec512<int32_t> : std::true_type {};
+template <> struct has_native_vec512<int16_t> : std::true_type {};
+template <> struct has_native_vec512<c10::qint8> : std::true_type {};
+template <> struct has_native_vec512<c10::quint8> : std::true_type {};
+template <> struct has_native_vec512<c10::qint32> : std::true_type {};
+#endif
+
+template <typename T>
+using Vectorized = typename std::conditional<
+    has_native_vec512<T>::value,
+    vec512::Vec512<T>,
+    vec256::Vec256<T>>::type;
+
+// Element-wise functions are overloaded on the vector type.
+using vec256::cast;
+using vec256::clamp;
+using vec256::clamp_max;
+using vec256::clamp_min;
+using vec256::convert_to_int_of_same_size;
+using vec256::maximum;
+using vec256::minimum;
+using vec512::cast;
+using vec512::clamp;
+using vec512::clamp_max;
+using vec512::clamp_min;
+using vec512::convert_to_int_of_same_size;
+using vec512::maximum;
+using vec512::minimum;
+
+// The generic fmadd of both namespaces takes any T, so it is forwarded
+// explicitly to avoid an ambiguous overload.
+template <typename T>
+inline vec256::Vec256<T> fmadd(const vec256::Vec256<T>& a, const vec256::Vec256<T>& b, const vec256::Vec256<T>& c) {
+  return vec256::fmadd(a, b, c);
+}
+
+template <typename T>
+inline vec512::Vec512<T> fmadd(const vec512::Vec512<T>& a, const vec512::Vec512<T>& b, const vec512::Vec512<T>& c) {
+  return vec512::fmadd(a, b, c);
+}
+
+// Array functions only take scalar pointers, so they pick the implementation
+// that matches Vectorized<scalar_t>.
+template <bool use_vec512>
+struct ArrayFunctions {
+  template <typename scalar_t, typename Op>
+  static scalar_t reduce_all(const Op& vec_fun, scalar_t* data, int64_t size) {
+    return vec256::reduce_all(vec_fun, data, size);
+  }
+  template <typename scalar_t, typename MapOp, typename ReduceOp>
+  static scalar_t map_reduce_all(const MapOp& map_fun, const ReduceOp& red_fun, scalar_t* data, int64_t size) {
+    return vec256::map_reduce_all(map_fun, red_fun, data, size);
+  }
+  template <typename scalar_t, typename MapOp, typename ReduceOp>
+  static scalar_t map2_reduce_all(const MapOp& map_fun, const ReduceOp& red_fun, const scalar_t* data, const scalar_t* data2, int64_t size) {
+    return vec256::map2_reduce_all(map_fun, red_fun, data, data2, size);
+  }
+  template <typename scalar_t, typename Op>
+  static void map(const Op& vec_fun, scalar_t* output_data, const scalar_t* input_data, int64_t size) {
+    vec256::map(vec_fun, output_data, input_data, size);
+  }
+  template <typename scalar_t, typename Op>
+  static void map2(const Op& vec_fun, scalar_t* output_data, scalar_t* input_data, scalar_t* input_data2, int64_t size) {
+    vec256::map2(vec_fun, output_data, input_data, input_data2, size);
+  }
+};
+
+template <>
+struct ArrayFunctions<true> {
+  template <typename scalar_t, typename Op>
+  static scalar_t reduce_all(const Op& vec_fun, scalar_t* data, int64_t size) {
+    return vec512::reduce_all(vec_fun, data, size);
+  }
+  template <typename scalar_t, typename MapOp, typename ReduceOp>
+  static scalar_t map_reduce_all(const MapOp& map_fun, const ReduceOp& red_fun, scalar_t* data, int64_t size) {
+    return vec512::map_reduce_all(map_fun, red_fun, data, size);
+  }
+  template <typename scalar_t, typename MapOp, typename ReduceOp>
+  static scalar_t map2_reduce_all(const MapOp& map_fun, const ReduceOp& red_fun, const scalar_t* data, const scalar_t* data2, int64_t size) {
+    return vec512::map2_reduce_all(map_fun, red_fun, data, data2, size);
+  }
+  template <typename scalar_t, typename Op>
+  static void map(const Op& vec_fun, scalar_t* output_data, const scalar_t* input_data, int64_t size) {
+    vec512::map(vec_fun, output_data, input_data, size);
+  }
+  template <typename scalar_t, typename Op>
+  static void map2(const Op& vec_fun, scalar_t* output_data, scalar_t* input_data, scalar_t* input_data2, int64_t size) {
+    vec512::map2(vec_fun, output_data, input_data, input_data2, size);
+  }
+};
+
+template <typename scalar_t, typename Op>
+inline scalar_t reduce_all(const Op& vec_fun, scalar_t* data, int64_t size) {
+  return ArrayFunctions<has_native_vec512<scalar_t>::value>::reduce_all(vec_fun, data, size);
+}
+
+template <typename scalar_t, typename MapOp, typename ReduceOp>
+inline scalar_t map_reduce_all(
+    const MapOp& map_fun,
+    const ReduceOp& red_fun,
+    scalar_t* data,
+    int64_t size) {
+  return ArrayFunctions<has_native_vec512<scalar_t>::value>::map_reduce_all(map_fun, red_fun, data, size);
+}
+
+template <typename scalar_t, typename MapOp, typename ReduceOp>
+inline scalar_t map2_reduce_all(
+    const MapOp& map_fun,
+    const ReduceOp& red_fun,
+    const scalar_t* data,
+    const scalar_t* data2,
+    int64_t size) {
+  return ArrayFunctions<has_native_vec512<scalar_t>::value>::map2_reduce_all(map_fun, red_fun, data, data2, size);
+}
+
+template <typename scalar_t, typename Op>
+inline void map(
+    const Op& vec_fun,
+    scalar_t* output_data,
+    const scalar_t* input_data,
+    int64_t size) {
+  ArrayFunctions<has_native_vec512<scalar_t>::value>::map(vec_fun, output_data, input_data, size);
+}
+
+template <typename scalar_t, typename Op>
+inline void map2(
+    const Op& vec_fun,
+    scalar_t* output_data,
+    scalar_t* input_data,
+    scalar_t* input_data2,
+    int64_t size) {
+  ArrayFunctions<has_native_vec512<scalar_t>::value>::map2(vec_fun, output_data, input_data, input_data2, size);
+}
+
+} // namespace
+}} // namespace at::vec
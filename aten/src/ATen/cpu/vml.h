@@ -37,10 +37,14 @@
 // [Note SSE-AVX transitions]
 // There is a bug in Glibc2.23
 // https://bugs.launchpad.net/ubuntu/+source/glibc/+bug/1663280. Calling zeroall
-// when using AVX/AVX2 code resolves this.
+// when using AVX/AVX2 code resolves this. BFloat16 functions are computed in
+// float, so they call the float version.
 #if defined(__AVX__) && defined(__GLIBC__) && __GLIBC_MINOR__ == 23
 #define DL_RUNTIME_BUG(op, type)                              \
-  using value_t = typename at::native::ztype<type>::value_t;  \
+  using value_t = typename std::conditional<                  \
+      std::is_same<type, c10::BFloat16>::value,               \
+      float,                                                  \
+      typename at::native::ztype<type>::value_t>::type;       \
   volatile value_t x = (value_t)(1);                          \
   x = std::op(x);                                             \
   _mm256_zeroall();
@@ -54,9 +58,21 @@ namespace {
 
 using namespace vec256;
 
+// The loops below used to split their work into chunks of a fixed 2048
+// elements. The cost hints of the ops only ever make chunks smaller than
+// that: expensive ops start using more threads on smaller inputs, while the
+// cheap ones keep the old chunks.
+constexpr int64_t kVmlGrainSize = 2048;
+
+inline int64_t vml_grain_size(double cycles_per_element) {
+  return std::min(
+      kVmlGrainSize,
+      internal::grain_size_for_cost(cycles_per_element, kVmlGrainSize));
+}
+
 template <typename scalar_t>
 inline void vrsqrt(scalar_t* out, scalar_t* in, int64_t size) {
-  parallel_for(0, size, 2048, [out, in](int64_t begin, int64_t end) {
+  parallel_for(0, size, vml_grain_size(1.5), [out, in](int64_t begin, int64_t end) {
     map(
         [](const Vec256<scalar_t>& x) {
           return Vec256<scalar_t>((scalar_t)(1)) / x.sqrt();
@@ -74,12 +90,21 @@ inline void vrsqrt(scalar_t* out, scalar_t* in, int64_t size) {
 // users to use a version of glibc newer than 2.23 we will be able to ditch
 // this. This duplication is also necessary since not all functions (e.g. rsqrt)
 // might be part of cmath.
+//
+// The second argument is the estimated cost of the op in cycles per element,
+// which determines how many elements each thread gets (see vml_grain_size).
+// It is also available as v<op>_cost, e.g. for benchmarks.
 
-#define IMPLEMENT_VML_BUG(op)                                          \
+#define IMPLEMENT_VML_BUG(op, cost)                                    \
+  constexpr double v##op##_cost = cost;                                \
   template <typename scalar_t>                                          \
   inline void v##op(scalar_t* out, const scalar_t* in, int64_t size) {  \
     DL_RUNTIME_BUG(op, scalar_t)                                        \
-    parallel_for(0, size, 2048, [out, in](int64_t begin, int64_t end) { \
+    parallel_for(                                                       \
+        0,                                                              \
+        size,                                                           \
+        vml_grain_size(cost),                                           \
+        [out, in](int64_t begin, int64_t end) {                         \
       map([](const Vec256<scalar_t>& x) { return x.op(); },             \
           out + begin,                                                  \
           in + begin,                                                   \
@@ -87,10 +112,15 @@ inline void vrsqrt(scalar_t* out, scalar_t* in, int64_t size) {
     });                                                                 \
   }
 
-#define IMPLEMENT_VML(op)                                              \
+#define IMPLEMENT_VML(op, cost)                                        \
+  constexpr double v##op##_cost = cost;                                \
   template <typename scalar_t>                                          \
   inline void v##op(scalar_t* out, const scalar_t* in, int64_t size) {  \
-    parallel_for(0, size, 2048, [out, in](int64_t begin, int64_t end) { \
+    parallel_for(                                                       \
+        0,                                                              \
+        size,                                                           \
+        vml_grain_size(cost),                                           \
+        [out, in](int64_t begin, int64_t end) {                         \
       map([](const Vec256<scalar_t>& x) { return x.op(); },             \
           out + begin,                                                  \
           in + begin,                                                   \
@@ -98,34 +128,34 @@ inline void vrsqrt(scalar_t* out, scalar_t* in, int64_t size) {
     });                                                                 \
   }
 
-IMPLEMENT_VML_BUG(abs)
-IMPLEMENT_VML_BUG(acos)
-IMPLEMENT_VML_BUG(asin)
-IMPLEMENT_VML_BUG(atan)
-IMPLEMENT_VML_BUG(ceil)
-IMPLEMENT_VML_BUG(cos)
+IMPLEMENT_VML_BUG(abs, 0.5)
+IMPLEMENT_VML_BUG(acos, 8)
+IMPLEMENT_VML_BUG(asin, 8)
+IMPLEMENT_VML_BUG(atan, 8)
+IMPLEMENT_VML_BUG(ceil, 0.5)
+IMPLEMENT_VML_BUG(cos, 8)
 // IMPLEMENT_VML_BUG(cosh)
-IMPLEMENT_VML_BUG(erf)
-IMPLEMENT_VML_BUG(erfc)
-IMPLEMENT_VML(erfinv)
-IMPLEMENT_VML_BUG(exp)
-IMPLEMENT_VML_BUG(expm1)
-IMPLEMENT_VML_BUG(floor)
-IMPLEMENT_VML(reciprocal)
-IMPLEMENT_VML_BUG(log)
-IMPLEMENT_VML_BUG(log10)
-IMPLEMENT_VML_BUG(log1p)
-IMPLEMENT_VML_BUG(log2)
-IMPLEMENT_VML(neg)
-IMPLEMENT_VML_BUG(sin)
+IMPLEMENT_VML_BUG(erf, 6)
+IMPLEMENT_VML_BUG(erfc, 8)
+IMPLEMENT_VML(erfinv, 30)
+IMPLEMENT_VML_BUG(exp, 3)
+IMPLEMENT_VML_BUG(expm1, 5)
+IMPLEMENT_VML_BUG(floor, 0.5)
+IMPLEMENT_VML(reciprocal, 1)
+IMPLEMENT_VML_BUG(log, 4)
+IMPLEMENT_VML_BUG(log10, 5)
+IMPLEMENT_VML_BUG(log1p, 6)
+IMPLEMENT_VML_BUG(log2, 5)
+IMPLEMENT_VML(neg, 0.5)
+IMPLEMENT_VML_BUG(sin, 8)
 // IMPLEMENT_VML_BUG(sinh)
-IMPLEMENT_VML_BUG(sqrt)
-IMPLEMENT_VML_BUG(round)
-IMPLEMENT_VML(rsqrt)
-IMPLEMENT_VML_BUG(tan)
-IMPLEMENT_VML_BUG(tanh)
-IMPLEMENT_VML_BUG(trunc)
-IMPLEMENT_VML_BUG(lgamma)
+IMPLEMENT_VML_BUG(sqrt, 1.5)
+IMPLEMENT_VML_BUG(round, 0.5)
+IMPLEMENT_VML(rsqrt, 1.5)
+IMPLEMENT_VML_BUG(tan, 10)
+IMPLEMENT_VML_BUG(tanh, 6)
+IMPLEMENT_VML_BUG(trunc, 0.5)
+IMPLEMENT_VML_BUG(lgamma, 40)
 
 
 #if AT_MKL_ENABLED() && !defined(__APPLE__)
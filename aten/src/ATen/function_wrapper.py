@@ -143,7 +143,8 @@ inline ${return_type} Tensor::${api_name}(${method_formals}) const {
     ${static_dispatch_method_body}
 #else
     static c10::OperatorHandle op = c10::Dispatcher::singleton().findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return op.callUnboxed<${formals_types_with_return}>(${method_actuals});
+    static c10::DispatchCache cache;
+    return op.callUnboxedWithCache<${formals_types_with_return}>(cache${,method_actuals});
 #endif
 }
 """)
@@ -163,7 +164,8 @@ static inline ${return_type} ${api_name}(${formals}) {
 #else
     static c10::OperatorHandle op = c10::Dispatcher::singleton()
         .findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return op.callUnboxed<${formals_types_with_return}>(${native_actuals});
+    static c10::DispatchCache cache;
+    return op.callUnboxedWithCache<${formals_types_with_return}>(cache${,native_actuals});
 #endif
 }
 """)
@@ -207,7 +209,8 @@ static inline ${return_type} ${api_name}(${formals}) {
     globalLegacyTypeDispatch().initForTensorTypeSet(${inferred_type_set});
     static c10::OperatorHandle op = c10::Dispatcher::singleton()
         .findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return op.callUnboxed<${formals_types_with_return}>(${native_actuals});
+    static c10::DispatchCache cache;
+    return op.callUnboxedWithCache<${formals_types_with_return}>(cache${,native_actuals});
 #endif
 }
 """)
@@ -1,6 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/Parallel.h>
+#include <ATen/native/Pool.h>
 #include <tuple>
 
 
@@ -128,6 +129,14 @@ namespace {
     auto osizeH = output_size[0];
     auto osizeW = output_size[1];
 
+    if (cpu_2d_use_channels_last(input)) {
+      output.resize_({input.size(0), sizeD, osizeH, osizeW},
+                     at::MemoryFormat::ChannelsLast);
+      adaptive_avg_pool2d_channels_last_stub(
+        kCPU, output, input.contiguous(at::MemoryFormat::ChannelsLast));
+      return;
+    }
+
     /* resize output */
     if (input.ndimension() == 3 || input.size(-4) == 1)
     {
@@ -301,6 +310,8 @@ namespace {
 
 } // namespace
 
+  DEFINE_DISPATCH(adaptive_avg_pool2d_channels_last_stub);
+
   Tensor& adaptive_avg_pool2d_out_cpu(
     Tensor& output,
     const Tensor& input,
@@ -326,7 +337,8 @@ namespace {
       return at::mkldnn_adaptive_avg_pool2d(input, output_size);
     }
 
-    // TODO: fastpath for Channels_last should be explored later;
+    // Channels last inputs take _adaptive_avg_pool2d, whose NHWC kernel
+    // already reduces over contiguous rows of channels.
     if (input.suggest_memory_format() == at::MemoryFormat::Contiguous && !input.is_quantized() && output_size[0] == 1 && output_size[1] == 1) {
       // in this case, adaptive pooling is just computing mean over hw
       // dimensions, which can be done more efficiently
@@ -1,5 +1,6 @@
 #include "ATen/ATen.h"
 #include <ATen/Parallel.h>
+#include <ATen/native/Pool.h>
 #include "ATen/NativeFunctions.h"
 #include <tuple>
 
@@ -166,6 +167,16 @@ void adaptive_max_pool2d_out_cpu_template(
   int64_t osizeH = output_size[0];
   int64_t osizeW = output_size[1];
 
+  if (cpu_2d_use_channels_last(input)) {
+    output.resize_({sizeB, sizeD, osizeH, osizeW},
+                   at::MemoryFormat::ChannelsLast);
+    indices.resize_({sizeB, sizeD, osizeH, osizeW},
+                    at::MemoryFormat::ChannelsLast);
+    adaptive_max_pool2d_channels_last_stub(
+      kCPU, output, indices, input.contiguous(at::MemoryFormat::ChannelsLast));
+    return;
+  }
+
   /* resize output */
   if (input.ndimension() == 3)
   {
@@ -274,7 +285,7 @@ Tensor& adaptive_max_pool2d_backward_out_cpu_template(
           Tensor& gradInput,
           const Tensor& gradOutput_,
           const Tensor& input,
-          const Tensor& indices)
+          const Tensor& indices_)
 {
   int dimW = 2;
   int dimH = 1;
@@ -285,8 +296,9 @@ Tensor& adaptive_max_pool2d_backward_out_cpu_template(
   int osizeH;
   int osizeW;
 
-  /* get contiguous gradOutput */
+  /* get contiguous gradOutput and indices */
   auto gradOutput = gradOutput_.contiguous();
+  auto indices = indices_.contiguous();
 
   /* resize */
   gradInput.resize_as_(input);
@@ -346,6 +358,8 @@ Tensor& adaptive_max_pool2d_backward_out_cpu_template(
 
 } // namespace
 
+DEFINE_DISPATCH(adaptive_max_pool2d_channels_last_stub);
+
 std::tuple<Tensor&, Tensor&> adaptive_max_pool2d_out_cpu(
   Tensor& output,
   Tensor& indices,
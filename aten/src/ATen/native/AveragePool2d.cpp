@@ -136,6 +136,17 @@ void avg_pool2d_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  if (cpu_2d_use_channels_last(input_)) {
+    Tensor input = input_.contiguous(at::MemoryFormat::ChannelsLast);
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+                   at::MemoryFormat::ChannelsLast);
+    avg_pool2d_channels_last_stub(
+      kCPU, output, input,
+      kW, kH, dW, dH, padW, padH,
+      count_include_pad, divisor_override);
+    return;
+  }
+
   if (input_.ndimension() == 3) {
     output.resize_({nInputPlane, outputHeight, outputWidth});
   }
@@ -330,6 +341,8 @@ Tensor& avg_pool2d_backward_out_cpu_template(
 
 } // namespace
 
+DEFINE_DISPATCH(avg_pool2d_channels_last_stub);
+
 Tensor& avg_pool2d_out_cpu(
   Tensor& output,
   const Tensor& input,
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at { namespace native {
+
+// Whether a 2d pooling or upsampling op on CPU runs its NHWC kernel and
+// returns a channels last output, instead of converting the input to NCHW.
+// The NHWC kernels are only instantiated for float and double.
+static inline bool cpu_2d_use_channels_last(const Tensor& input) {
+  return input.suggest_memory_format() == at::MemoryFormat::ChannelsLast &&
+      (input.scalar_type() == kFloat || input.scalar_type() == kDouble);
+}
+
+}} // namespace at::native
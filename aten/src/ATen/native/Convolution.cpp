@@ -1,11 +1,13 @@
 #include <limits>
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/native/cpu/Conv2dKernel.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
 #include <ATen/native/utils/ParamUtils.h>
 #include <ATen/native/ConvUtils.h>
 
 #include <ATen/Config.h>
+#include <ATen/core/grad_mode.h>
 #if AT_NNPACK_ENABLED()
 #include "nnpack.h"
 #endif
@@ -15,6 +17,8 @@ static const int MIOPEN_DIM_MAX = 4;
 namespace at { namespace native {
 
 DEFINE_DISPATCH(convolution_depthwise3x3_winograd_stub);
+DEFINE_DISPATCH(convolution_direct2d_stub);
+DEFINE_DISPATCH(convolution_winograd3x3_stub);
 
 struct ConvParams {
   std::vector<int64_t> stride;
@@ -36,6 +40,9 @@ struct ConvParams {
   bool is_stride_nonpos() const;
   void view1d_as_2d();
   bool use_cpu_depthwise3x3_winograd(const at::Tensor& input, const at::Tensor& weight) const;
+  bool use_cpu_inference_conv2d(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
+  bool use_cpu_winograd3x3(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
+  bool use_cpu_direct_conv2d(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
   bool needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
@@ -149,6 +156,59 @@ auto ConvParams::use_cpu_depthwise3x3_winograd(
 #endif
 }
 
+// The direct and Winograd kernels replace thnn_conv2d, whose im2col buffer is
+// kernel_h * kernel_w times the size of the output per input channel. They
+// are forward-only, so they are used only when no gradient is required.
+// Batches that are large enough for NNPACK still go to NNPACK.
+auto ConvParams::use_cpu_inference_conv2d(
+    const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const -> bool {
+  const bool requires_grad = GradMode::is_enabled() &&
+      (input.requires_grad() || weight.requires_grad() ||
+       (bias.defined() && bias.requires_grad()));
+  return (input.device().type() == c10::DeviceType::CPU) &&
+         (input.layout() == at::kStrided) &&
+         (input.ndimension() == 4) &&
+         (weight.ndimension() == 4) &&
+         (input.scalar_type() == at::kFloat || input.scalar_type() == at::kDouble) &&
+         (weight.scalar_type() == input.scalar_type()) &&
+         (!bias.defined() || bias.scalar_type() == input.scalar_type()) &&
+         (weight.layout() == at::kStrided) &&
+         input.numel() > 0 &&
+         groups == 1 &&
+         !is_dilated() &&
+         !transposed &&
+         !requires_grad &&
+         !use_nnpack(input);
+}
+
+// Winograd pays for its transforms in the channel GEMMs, so it needs a few
+// channels on both sides to win over im2col. Its transforms round
+// differently from a direct sum, increasingly so for F(4x4, 3x3), so it is
+// only used when enabled with torch.backends.winograd.
+auto ConvParams::use_cpu_winograd3x3(
+    const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const -> bool {
+  return at::globalContext().userEnabledWinogradConv() &&
+         use_cpu_inference_conv2d(input, weight, bias) &&
+         (input.scalar_type() == at::kFloat) &&
+         (weight.size(2) == 3) &&
+         (weight.size(3) == 3) &&
+         !is_strided() &&
+         (input.size(1) >= 8) &&
+         (weight.size(0) >= 8);
+}
+
+// For small kernels over few input channels the GEMM after im2col is too
+// small to be efficient, and the im2col copy dominates. Pointwise stride-1
+// convolutions are left to thnn_conv2d, whose im2col is then a plain copy.
+auto ConvParams::use_cpu_direct_conv2d(
+    const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const -> bool {
+  const int64_t kernel_area = weight.size(2) * weight.size(3);
+  return use_cpu_inference_conv2d(input, weight, bias) &&
+         (kernel_area <= 9) &&
+         (input.size(1) * kernel_area <= 256) &&
+         (kernel_area > 1 || is_strided() || is_padded());
+}
+
 auto ConvParams::needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const -> bool {
   constexpr int64_t int_max = std::numeric_limits<int>::max();
   int64_t numel_input = input.numel();
@@ -682,6 +742,12 @@ at::Tensor _convolution(
     if (params.use_cpu_depthwise3x3_winograd(input, weight)) {
       output = convolution_depthwise3x3_winograd_stub(
         input.device().type(), input, weight, bias, params.stride, params.padding, params.groups);
+    } else if (params.use_cpu_winograd3x3(input, weight, bias)) {
+      output = convolution_winograd3x3_stub(
+        input.device().type(), input.contiguous(), weight.contiguous(), bias, params.padding);
+    } else if (params.use_cpu_direct_conv2d(input, weight, bias)) {
+      output = convolution_direct2d_stub(
+        input.device().type(), input.contiguous(), weight.contiguous(), bias, params.stride, params.padding);
     } else if (params.groups == 1) {
       output = at::_convolution_nogroup(
           input.contiguous(), weight, bias, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
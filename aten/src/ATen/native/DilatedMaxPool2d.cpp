@@ -170,6 +170,18 @@ void max_pool2d_with_indices_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  if (cpu_2d_use_channels_last(input_)) {
+    Tensor input = input_.contiguous(at::MemoryFormat::ChannelsLast);
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+                   at::MemoryFormat::ChannelsLast);
+    indices.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+                    at::MemoryFormat::ChannelsLast);
+    max_pool2d_channels_last_stub(
+      kCPU, output, indices, input,
+      kW, kH, dW, dH, padW, padH, dilationW, dilationH);
+    return;
+  }
+
   /* get contiguous input */
   Tensor input = input_.contiguous();
 
@@ -298,7 +310,7 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
           Tensor& gradInput,
           const Tensor& gradOutput_,
           const Tensor& input,
-          const Tensor& indices,
+          const Tensor& indices_,
           IntArrayRef kernel_size,
           IntArrayRef stride,
           IntArrayRef padding,
@@ -332,8 +344,9 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
   TORCH_CHECK((input.ndimension() == 3 || input.ndimension() == 4),
     "non-empty 3D or 4D (batch mode) tensor expected for input");
 
-  /* get contiguous gradOutput */
+  /* get contiguous gradOutput and indices */
   const Tensor gradOutput = gradOutput_.contiguous();
+  const Tensor indices = indices_.contiguous();
 
   /* resize */
   gradInput.resize_as_(input);
@@ -409,6 +422,8 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
 
 } // namespace
 
+DEFINE_DISPATCH(max_pool2d_channels_last_stub);
+
 std::tuple<Tensor&, Tensor&> max_pool2d_with_indices_out_cpu(
   Tensor& output,
   Tensor& indices,
@@ -29,6 +29,9 @@
 //   }
 //   REGISTER_DISPATCH(stub, &kernel);
 //
+// Kernels are not compiled for AVX512 unless they opt in; see
+// Note [AVX512 opt-in] below.
+//
 // To call:
 //   stub(kCPU, tensor);
 //
@@ -47,6 +50,7 @@ enum class CPUCapability {
   DEFAULT = 0,
   AVX = 1,
   AVX2 = 2,
+  AVX512 = 3,
   NUM_OPTIONS
 };
 
@@ -84,6 +88,11 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
   FnPtr choose_cpu_impl() {
     auto capability = static_cast<int>(get_cpu_capability());
     (void)capability;
+#ifdef HAVE_AVX512_CPU_DEFINITION
+    if (capability >= static_cast<int>(CPUCapability::AVX512) && avx512_dispatch_ptr) {
+      return avx512_dispatch_ptr;
+    }
+#endif
 #ifdef HAVE_AVX2_CPU_DEFINITION
     if (capability >= static_cast<int>(CPUCapability::AVX2)) {
       AT_ASSERTM(AVX2, "DispatchStub: missing AVX2 kernel");
@@ -106,10 +115,12 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
   FnPtr cpu_dispatch_ptr;
   FnPtr cuda_dispatch_ptr;
   FnPtr hip_dispatch_ptr;
+  FnPtr avx512_dispatch_ptr;
 #else
   FnPtr cpu_dispatch_ptr = nullptr;
   FnPtr cuda_dispatch_ptr = nullptr;
   FnPtr hip_dispatch_ptr = nullptr;
+  FnPtr avx512_dispatch_ptr = nullptr;
 #endif
   static FnPtr DEFAULT;
 #ifdef HAVE_AVX_CPU_DEFINITION
@@ -135,6 +146,13 @@ struct RegisterHIPDispatch {
     stub.cuda_dispatch_ptr = value;
   }
 };
+
+template <typename FnPtr, typename T>
+struct RegisterAVX512Dispatch {
+  RegisterAVX512Dispatch(DispatchStub<FnPtr, T>& stub, FnPtr value) {
+    stub.avx512_dispatch_ptr = value;
+  }
+};
 } // anonymous namespace
 
 // Compiler will complain if you put things like std::tuple<Tensor, Tensor> in
@@ -187,10 +205,30 @@ struct RegisterHIPDispatch {
 // is HIP in the PyTorch HIPify build.
 #define REGISTER_DISPATCH(name, fn) REGISTER_CUDA_DISPATCH(name, fn)
 // #define REGISTER_DISPATCH(name, fn) REGISTER_HIP_DISPATCH(name, fn)
+#elif defined(CPU_CAPABILITY_AVX512)
+// See Note [AVX512 opt-in]
+#define REGISTER_DISPATCH(name, fn)
 #elif defined(CPU_CAPABILITY)
 #define REGISTER_DISPATCH(name, fn) REGISTER_ARCH_DISPATCH(name, CPU_CAPABILITY, fn)
 #endif
 
+// Note [AVX512 opt-in]
+// ~~~~~~~~~~~~~~~~~~~~
+// Unlike the other capabilities, a kernel is only used on AVX512 machines if
+// it was written for it (usually against at::vec::Vectorized<T>, which is
+// 512 bits wide there) and registered with ALSO_REGISTER_AVX512_DISPATCH
+// instead of REGISTER_DISPATCH. Only the files in native/cpu that use this
+// macro are compiled with the AVX512 flags; every other stub falls back to
+// its AVX2 kernel. Since there is no static AVX512 member to define, the
+// AVX512 kernel is stored in avx512_dispatch_ptr by a registrar object, the
+// same way CUDA kernels are.
+#if defined(CPU_CAPABILITY_AVX512)
+#define ALSO_REGISTER_AVX512_DISPATCH(name, fn) \
+  static RegisterAVX512Dispatch<decltype(fn), struct name> name ## __register(name, fn);
+#else
+#define ALSO_REGISTER_AVX512_DISPATCH(name, fn) REGISTER_DISPATCH(name, fn)
+#endif
+
 
 }} // namespace at::native
 
@@ -140,14 +140,13 @@ void batch_norm_cpu_inference_contiguous(Tensor& output, const Tensor& input,
   }
 }
 
-/// A fast path for CPU inference when all tensors are channels last contiguous.
-/// This code achieves machine bandwidth peak without AVX support.
-/// If this changes for future architectures, we can move it to the cpu/
-/// directory.
+/// Applies the per-channel linear terms to a channels last contiguous input,
+/// output(n, c, h, w) = input(n, c, h, w) * alpha(c) + beta(c)
+/// No need to use parallel_for as this function is supposed to be
+/// memory-limited.
 template<typename scalar_t>
-void batch_norm_cpu_inference_channels_last(Tensor& output, const Tensor& input,
-    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
-    const Tensor& mean, const Tensor& variance, double eps) {
+void batch_norm_cpu_channels_last_transform(Tensor& output, const Tensor& input,
+    const scalar_t* alpha_data, const scalar_t* beta_data) {
 
   int64_t n_batch = input.size(0);
   int64_t n_channel = input.size(1);
@@ -156,18 +155,6 @@ void batch_norm_cpu_inference_channels_last(Tensor& output, const Tensor& input,
   scalar_t* output_data = output.data_ptr<scalar_t>();
   const scalar_t* input_data = input.data_ptr<scalar_t>();
 
-  Tensor alpha = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  Tensor beta = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
-  scalar_t* beta_data = beta.data_ptr<scalar_t>();
-
-  batch_norm_cpu_inference_collect_liner_and_constant_terms<scalar_t>(
-      alpha_data, beta_data, n_channel, weight, bias, mean, variance, eps);
-
-  // Apply the linear terms to the input,
-  // output(n, c, h, w) = input(n, c, h, w) * alpha(c) + beta(c)
-  // No need to use parallel_for as this function is supposed to be
-  // memory-limited.
   // Keep the loop struture simple to make sure compiler vetorization kicks in.
   if (n_channel != 1) {
     for (int64_t n = 0; n < n_batch; ++n) {
@@ -192,6 +179,59 @@ void batch_norm_cpu_inference_channels_last(Tensor& output, const Tensor& input,
   }
 }
 
+/// A fast path for CPU inference when all tensors are channels last contiguous.
+/// This code achieves machine bandwidth peak without AVX support.
+/// If this changes for future architectures, we can move it to the cpu/
+/// directory.
+template<typename scalar_t>
+void batch_norm_cpu_inference_channels_last(Tensor& output, const Tensor& input,
+    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
+    const Tensor& mean, const Tensor& variance, double eps) {
+
+  int64_t n_channel = input.size(1);
+
+  Tensor alpha = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor beta = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
+  scalar_t* beta_data = beta.data_ptr<scalar_t>();
+
+  batch_norm_cpu_inference_collect_liner_and_constant_terms<scalar_t>(
+      alpha_data, beta_data, n_channel, weight, bias, mean, variance, eps);
+
+  batch_norm_cpu_channels_last_transform<scalar_t>(
+      output, input, alpha_data, beta_data);
+}
+
+/// The training mode counterpart of batch_norm_cpu_inference_channels_last,
+/// which folds the batch statistics instead of the running ones.
+template<typename scalar_t>
+void batch_norm_cpu_train_channels_last(Tensor& output, const Tensor& input,
+    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
+    const Tensor& save_mean, const Tensor& save_invstd) {
+
+  int64_t n_channel = input.size(1);
+
+  Tensor alpha = at::empty_like(save_mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor beta = at::empty_like(save_mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
+  scalar_t* beta_data = beta.data_ptr<scalar_t>();
+
+  const scalar_t* weight_data = weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
+  const scalar_t* bias_data = bias.defined() ? bias.data_ptr<scalar_t>() : nullptr;
+  const scalar_t* mean_data = save_mean.data_ptr<scalar_t>();
+  const scalar_t* invstd_data = save_invstd.data_ptr<scalar_t>();
+
+  for (int64_t c = 0; c < n_channel; c++) {
+    scalar_t weight_v = weight_data ? weight_data[c] : 1;
+    scalar_t bias_v = bias_data ? bias_data[c] : 0;
+    alpha_data[c] = invstd_data[c] * weight_v;
+    beta_data[c] = bias_v - mean_data[c] * invstd_data[c] * weight_v;
+  }
+
+  batch_norm_cpu_channels_last_transform<scalar_t>(
+      output, input, alpha_data, beta_data);
+}
+
 template<typename scalar_t>
 std::tuple<Tensor,Tensor,Tensor> batch_norm_cpu_transform_input_template(
     const Tensor& input, const Tensor& weight, const Tensor& bias,
@@ -225,6 +265,19 @@ std::tuple<Tensor,Tensor,Tensor> batch_norm_cpu_transform_input_template(
     return std::make_tuple(output, save_mean, save_invstd);
   }
 
+  // Check if we should use the fast path for channel last memory format in
+  // training mode
+  if (train && input.suggest_memory_format() == at::MemoryFormat::ChannelsLast
+      && input.is_contiguous(at::MemoryFormat::ChannelsLast)
+      && (!weight.defined() || weight.is_contiguous())
+      && (!bias.defined() || bias.is_contiguous())) {
+
+    Tensor output = at::empty_like(input, at::MemoryFormat::ChannelsLast);
+    batch_norm_cpu_train_channels_last<scalar_t>(
+      output, input, weight, bias, save_mean, save_invstd);
+    return std::make_tuple(output, save_mean, save_invstd);
+  }
+
   Tensor output = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
 
   int64_t n_input = input.size(1);
@@ -262,11 +315,94 @@ std::tuple<Tensor,Tensor,Tensor> batch_norm_cpu_transform_input_template(
   return std::make_tuple(output, save_mean, save_invstd);
 }
 
+/// Batch statistics of a channels last contiguous input, which is a
+/// [n, n_input] matrix with one row per pixel. The rows are split into one
+/// chunk per thread, each summing whole contiguous rows into its own buffer,
+/// instead of striding through the input once per channel.
+template<typename scalar_t, template<typename T> class VarTransform>
+std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_channels_last_template(
+    const Tensor& input, const Tensor& running_mean, const Tensor& running_var,
+    double momentum, double eps) {
+
+  using accscalar_t = at::acc_type<scalar_t, false>;
+
+  int64_t n_input = input.size(1);
+  int64_t n = input.numel() / n_input;
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+
+  Tensor save_mean = at::empty({n_input}, input.options());
+  Tensor save_var_transform = at::empty({n_input}, input.options());
+  auto save_mean_a = save_mean.accessor<scalar_t, 1>();
+  auto save_var_transform_a = save_var_transform.accessor<scalar_t, 1>();
+
+  auto running_mean_a = conditional_accessor_1d<scalar_t>(running_mean);
+  auto running_var_a = conditional_accessor_1d<scalar_t>(running_var);
+
+  int64_t n_chunks = std::max<int64_t>(std::min<int64_t>(at::get_num_threads(), n), 1);
+  std::vector<accscalar_t> buffer(n_chunks * n_input);
+  std::vector<accscalar_t> mean(n_input);
+
+  // Sums the per-row values of f into buffer, one partial sum per chunk, and
+  // reduces the chunks in order so the result does not depend on scheduling.
+  auto reduce_rows = [&](std::vector<accscalar_t>& result, auto f) {
+    std::fill(buffer.begin(), buffer.end(), accscalar_t(0));
+    parallel_for(0, n_chunks, 1, [&](int64_t c_begin, int64_t c_end) {
+      for (int64_t chunk = c_begin; chunk < c_end; ++chunk) {
+        accscalar_t* sum = buffer.data() + chunk * n_input;
+        for (int64_t row = chunk * n / n_chunks; row < (chunk + 1) * n / n_chunks; ++row) {
+          const scalar_t* in = input_data + row * n_input;
+          for (int64_t f_idx = 0; f_idx < n_input; ++f_idx) {
+            sum[f_idx] += f(in[f_idx], f_idx);
+          }
+        }
+      }
+    });
+    std::fill(result.begin(), result.end(), accscalar_t(0));
+    for (int64_t chunk = 0; chunk < n_chunks; ++chunk) {
+      for (int64_t f_idx = 0; f_idx < n_input; ++f_idx) {
+        result[f_idx] += buffer[chunk * n_input + f_idx];
+      }
+    }
+  };
+
+  std::vector<accscalar_t> sum(n_input);
+  reduce_rows(sum, [](scalar_t i, int64_t) -> accscalar_t { return i; });
+  for (int64_t f = 0; f < n_input; ++f) {
+    mean[f] = static_cast<scalar_t>(sum[f] / n);
+  }
+
+  std::vector<accscalar_t> var_sum(n_input);
+  reduce_rows(var_sum, [&](scalar_t i, int64_t f) -> accscalar_t {
+    return (i - mean[f]) * (i - mean[f]);
+  });
+
+  for (int64_t f = 0; f < n_input; ++f) {
+    save_mean_a[f] = mean[f];
+    save_var_transform_a[f] = VarTransform<accscalar_t>{}(var_sum[f] / n, eps);
+
+    // update running averages
+    if (running_mean.defined()) {
+      running_mean_a[f] = momentum * mean[f] + (1 - momentum) * running_mean_a[f];
+    }
+    if (running_var.defined()) {
+      accscalar_t unbiased_var = var_sum[f] / (n - 1);
+      running_var_a[f] = momentum * unbiased_var + (1 - momentum) * running_var_a[f];
+    }
+  }
+  return std::make_tuple(save_mean, save_var_transform);
+}
+
 template<typename scalar_t, template<typename T> class VarTransform>
 std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_template(
     const Tensor& input, const Tensor& running_mean, const Tensor& running_var,
     double momentum, double eps) {
 
+  if (input.suggest_memory_format() == at::MemoryFormat::ChannelsLast
+      && input.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    return batch_norm_cpu_update_stats_channels_last_template<scalar_t, VarTransform>(
+        input, running_mean, running_var, momentum, eps);
+  }
+
   using accscalar_t = at::acc_type<scalar_t, false>;
 
   int64_t n_input = input.size(1);
@@ -570,51 +706,6 @@ Tensor instance_norm(
   return out.view(input.sizes());
 }
 
-Tensor group_norm(const Tensor& input, int64_t num_groups,
-    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
-    double eps, bool cudnn_enabled) {
-
-    auto input_shape = input.sizes();
-    int64_t b = input.size(0);
-    int64_t c = input.size(1);
-
-    TORCH_CHECK(c % num_groups == 0,
-             "Expected number of channels in input to be divisible by ",
-             "num_groups, but got input of shape ", input.sizes(), " and "
-             "num_groups=", num_groups);
-
-    TORCH_CHECK(!weight.defined() || (weight.dim() == 1 && weight.numel() == c),
-             "Expected weight to be a vector of size equal to the number of ",
-             "channels in input, but got weight of shape ", weight.sizes(),
-             " and input of shape ", input.sizes());
-    TORCH_CHECK(!bias.defined() || (bias.dim() == 1 && bias.numel() == c),
-             "Expected bias to be a vector of size equal to the number of ",
-             "channels in input, but got bias of shape ", weight.sizes(),
-             " and input of shape ", input.sizes());
-
-    // Apply group norm
-    auto input_reshaped = input.contiguous().view({1, b * num_groups, -1});
-
-    auto out = at::batch_norm(input_reshaped, {}, {}, {}, {}, true, 0, eps,
-                              cudnn_enabled);
-    out = out.view(input_shape);
-
-    if (!weight.defined() && !bias.defined()) {
-      return out;
-    }
-
-    std::vector<int64_t> affine_param_shape(input.dim(), 1);
-    affine_param_shape[1] = c;
-
-    if (weight.defined() && bias.defined()) {
-      return bias.view(affine_param_shape).addcmul(out, weight.view(affine_param_shape), 1);
-    } else if (weight.defined()) {
-      return out.mul(weight.view(affine_param_shape));
-    } else {
-      return out.add(bias.view(affine_param_shape));
-    }
-}
-
 std::tuple<Tensor, Tensor> batch_norm_update_stats_cpu(
         const Tensor& self, const Tensor& running_mean, const Tensor& running_var, double momentum) {
   return AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "batch_norm_update_stats_cpu", [&] {
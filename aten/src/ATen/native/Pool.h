@@ -2,6 +2,8 @@
 #include <ATen/Parallel.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/div_rtn.h>
+#include <ATen/native/ChannelsLastUtils.h>
+#include <ATen/native/DispatchStub.h>
 #include <tuple>
 
 #pragma once
@@ -258,5 +260,25 @@ avg_pool3d_backward_shape_check(
 
 } // namespace
 
+// Forward kernels for 4d inputs that are contiguous in channels last memory
+// format. The output (and indices) must already be resized to channels last;
+// the output size is taken from it.
+using max_pool2d_fn = void(*)(
+    Tensor& output, Tensor& indices, const Tensor& input,
+    int kW, int kH, int dW, int dH, int padW, int padH,
+    int dilationW, int dilationH);
+using avg_pool2d_fn = void(*)(
+    Tensor& output, const Tensor& input,
+    int kW, int kH, int dW, int dH, int padW, int padH,
+    bool count_include_pad, c10::optional<int64_t> divisor_override);
+using adaptive_avg_pool2d_fn = void(*)(Tensor& output, const Tensor& input);
+using adaptive_max_pool2d_fn = void(*)(
+    Tensor& output, Tensor& indices, const Tensor& input);
+
+DECLARE_DISPATCH(max_pool2d_fn, max_pool2d_channels_last_stub);
+DECLARE_DISPATCH(avg_pool2d_fn, avg_pool2d_channels_last_stub);
+DECLARE_DISPATCH(adaptive_avg_pool2d_fn, adaptive_avg_pool2d_channels_last_stub);
+DECLARE_DISPATCH(adaptive_max_pool2d_fn, adaptive_max_pool2d_channels_last_stub);
+
 } // at::native
 } // at
@@ -2,7 +2,9 @@
 
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/TensorUtils.h>
 #include <ATen/cpp_custom_type_hack.h>
+#include <ATen/core/grad_mode.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 
 #include <ATen/native/c10_utils.h>
@@ -20,6 +22,26 @@ bool use_miopen(const at::Tensor& input, const double dropout_state) {
     return is_miopen_acceptable;
 }
 
+// Check if the fused CPU cell kernels can be used for this input.
+bool use_fused_cpu_cell(const at::Tensor& input) {
+  return input.device().is_cpu() &&
+         input.layout() == at::kStrided &&
+         (input.scalar_type() == at::kFloat || input.scalar_type() == at::kDouble);
+}
+
+// Autograd only needs to see the individual steps of an RNN if some of its
+// inputs require grad. Otherwise the CPU layers run with grad mode off, which
+// lets them update their state buffers in place (see FullLayer::run_inplace).
+bool rnn_requires_grad(const Tensor& input, TensorList hx, TensorList params) {
+  if (!at::GradMode::is_enabled()) {
+    return false;
+  }
+  auto requires_grad = [](const Tensor& t) { return t.defined() && t.requires_grad(); };
+  return requires_grad(input) ||
+         std::any_of(hx.begin(), hx.end(), requires_grad) ||
+         std::any_of(params.begin(), params.end(), requires_grad);
+}
+
 template<typename T>
 using pair_of = std::pair<T, T>;
 
@@ -171,11 +193,21 @@ struct QuantizedCellParamsDynamic {
     TORCH_CHECK(false, "matmul is not supported with quantized cell params");
   }
 
+  // The hidden projection runs once per timestep, so look the operator up
+  // once instead of searching the dispatcher by name on every call.
+  static const c10::OperatorHandle& linear_dynamic_op() {
+    static const c10::OperatorHandle op = [] {
+      auto handle = c10::Dispatcher::singleton().findSchema(
+          {"quantized::linear_dynamic", ""});
+      TORCH_CHECK(handle.has_value(), "quantized::linear_dynamic is not registered");
+      return handle.value();
+    }();
+    return op;
+  }
+
   Tensor linear_ih(const Tensor& input_ih) const {
-    const auto kFuncName = "quantized::linear_dynamic";
-    const auto kOvrldName = "";
     const std::vector<c10::IValue> output_ih_list =
-        callOp(kFuncName, kOvrldName, input_ih, w_ih);
+        callOp(linear_dynamic_op(), input_ih, w_ih);
     TORCH_INTERNAL_ASSERT(
         output_ih_list.size() == 1,
         "The output vector should have exact one element");
@@ -183,10 +215,8 @@ struct QuantizedCellParamsDynamic {
     return output_ih;
   }
   Tensor linear_hh(const Tensor& input_hh) const {
-    const auto kFuncName = "quantized::linear_dynamic";
-    const auto kOvrldName = "";
     const std::vector<c10::IValue> output_hh_list =
-        callOp(kFuncName, kOvrldName, input_hh, w_hh);
+        callOp(linear_dynamic_op(), input_hh, w_hh);
     TORCH_INTERNAL_ASSERT(
         output_hh_list.size() == 1,
         "The output vector should have exact one element");
@@ -346,6 +376,23 @@ tpair_of<Tensor> hidden_slice(const tpair_of<Tensor>& t, int64_t start, int64_t
                          hidden_slice(std::get<1>(t), start, end));
 }
 
+// Cell::step_inplace overwrites the LSTM cell state, so copy it before the
+// first step to keep the caller's tensors intact. The output part of the
+// state is only ever read.
+Tensor hidden_own_state(const Tensor& t) { return t; }
+tpair_of<Tensor> hidden_own_state(const tpair_of<Tensor>& t) {
+  return std::make_tuple(std::get<0>(t), std::get<1>(t).clone(at::MemoryFormat::Contiguous));
+}
+
+// Returns the first `rows` rows of a [rows, cols] scratch buffer that is kept
+// across steps, growing it if a step needs more rows than the previous ones.
+Tensor workspace_rows(Tensor& buffer, int64_t rows, int64_t cols, const TensorOptions& options) {
+  if (!buffer.defined() || buffer.size(0) < rows) {
+    buffer = at::empty({rows, cols}, options);
+  }
+  return buffer.narrow(0, 0, rows);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // CELL IMPLEMENTATIONS
 //
@@ -371,6 +418,23 @@ struct Cell {
       const hidden_type& hidden,
       const cell_params& params,
       bool pre_compute_input = false) const = 0;
+
+  // Inference-only variant of operator() taking pre-computed input gates.
+  // Writes the step output into `output` (a contiguous slice of the layer
+  // output) and updates `hidden` in place, reusing `workspace` across steps.
+  // Only valid with grad mode off and when can_step_inplace(input) is true.
+  virtual bool can_step_inplace(const Tensor& input) const {
+    return false;
+  }
+
+  virtual void step_inplace(
+      const Tensor& input,
+      hidden_type& hidden,
+      const cell_params& params,
+      Tensor& output,
+      Tensor& workspace) const {
+    TORCH_INTERNAL_ASSERT(false, "this RNN cell has no in-place step");
+  }
 };
 
 template<typename nonlinearity, typename cell_params>
@@ -409,6 +473,15 @@ struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
       return std::make_tuple(std::move(std::get<0>(result)), std::move(std::get<1>(result)));
     }
 
+    if (use_fused_cpu_cell(input)) {
+      // The biases are already folded into the projections, which lets every
+      // cell_params flavour (including the quantized ones) share the kernel.
+      auto igates = pre_compute_input ? input : params.linear_ih(input);
+      auto hgates = params.linear_hh(hx);
+      auto result = at::_thnn_fused_lstm_cell(igates, hgates, cx);
+      return std::make_tuple(std::move(std::get<0>(result)), std::move(std::get<1>(result)));
+    }
+
     const auto gates = params.linear_hh(hx).add_(
         pre_compute_input ? input : params.linear_ih(input));
     auto chunked_gates = gates.chunk(4, 1);
@@ -421,6 +494,26 @@ struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
     return std::make_tuple(std::move(hy), std::move(cy));
   }
 
+  bool can_step_inplace(const Tensor& input) const override {
+    return use_fused_cpu_cell(input);
+  }
+
+  void step_inplace(
+      const Tensor& input,
+      hidden_type& hidden,
+      const cell_params& params,
+      Tensor& output,
+      Tensor& workspace) const override {
+    auto& hx = std::get<0>(hidden);
+    auto& cx = std::get<1>(hidden);
+    TORCH_CHECK(hx.scalar_type() == input.scalar_type() && cx.scalar_type() == input.scalar_type(),
+                "LSTM: expected hidden states of type ", input.scalar_type());
+    auto hgates = params.linear_hh(hx);
+    auto ws = workspace_rows(workspace, input.size(0), input.size(1), input.options());
+    // The kernel reads each element of cx before writing it back as cy.
+    lstm_cell_stub(kCPU, output, cx, ws, input.contiguous(), hgates, Tensor(), Tensor(), cx);
+    hx = output;
+  }
 };
 
 template <typename cell_params>
@@ -441,6 +534,12 @@ struct GRUCell : Cell<Tensor, cell_params> {
       // Slice off the workspace argument (it's needed only for AD).
       return std::move(std::get<0>(result));
     }
+    if (use_fused_cpu_cell(input)) {
+      auto igates = pre_compute_input ? input : params.linear_ih(input);
+      auto hgates = params.linear_hh(hidden);
+      auto result = at::_thnn_fused_gru_cell(igates, hgates, hidden);
+      return std::move(std::get<0>(result));
+    }
     const auto chunked_igates = pre_compute_input
         ? input.chunk(3, 1)
         : params.linear_ih(input).chunk(3, 1);
@@ -453,6 +552,24 @@ struct GRUCell : Cell<Tensor, cell_params> {
         chunked_igates[2].add(chunked_hgates[2].mul_(reset_gate)).tanh_();
     return (hidden - new_gate).mul_(input_gate).add_(new_gate);
   }
+
+  bool can_step_inplace(const Tensor& input) const override {
+    return use_fused_cpu_cell(input);
+  }
+
+  void step_inplace(
+      const Tensor& input,
+      hidden_type& hidden,
+      const cell_params& params,
+      Tensor& output,
+      Tensor& workspace) const override {
+    TORCH_CHECK(hidden.scalar_type() == input.scalar_type(),
+                "GRU: expected hidden state of type ", input.scalar_type());
+    auto hgates = params.linear_hh(hidden);
+    auto ws = workspace_rows(workspace, input.size(0), input.size(1) / 3 * 5, input.options());
+    gru_cell_stub(kCPU, output, ws, input.contiguous(), hgates, Tensor(), Tensor(), hidden.contiguous());
+    hidden = output;
+  }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -507,12 +624,41 @@ struct FullLayer : Layer<Tensor, hidden_type, cell_params> {
     return {step_outputs, hidden};
   }
 
+  // The input projection for all steps is one GEMM; when no gradient is
+  // needed, the steps then write straight into a single preallocated output
+  // and reuse the state and workspace buffers, instead of allocating a hidden
+  // state per step and stacking them at the end.
+  bool use_inplace(const Tensor& inputs_w) const {
+    return !at::GradMode::is_enabled() && cell_.can_step_inplace(inputs_w);
+  }
+
+  output_type run_inplace(
+      const Tensor& inputs_w,
+      const hidden_type& input_hidden,
+      const cell_params& params,
+      bool reverse = false) const {
+    const int64_t num_steps = inputs_w.size(0);
+    auto hidden = hidden_own_state(input_hidden);
+    const auto h0 = hidden_as_output(hidden);
+    auto output = at::empty({num_steps, h0.size(0), h0.size(1)}, h0.options());
+    Tensor workspace;
+    for (int64_t i = 0; i < num_steps; ++i) {
+      const int64_t t = reverse ? num_steps - 1 - i : i;
+      Tensor step_output = output[t];
+      cell_.step_inplace(inputs_w[t], hidden, params, step_output, workspace);
+    }
+    return {output, hidden};
+  }
+
   output_type operator()(
       const Tensor& inputs,
       const hidden_type& input_hidden,
       const cell_params& params) const override {
     if (inputs.device().is_cpu()) {
       const auto inputs_w = params.linear_ih(inputs);
+      if (use_inplace(inputs_w)) {
+        return run_inplace(inputs_w, input_hidden, params);
+      }
       auto unstacked_output =
           (*this)(inputs_w.unbind(0), input_hidden, params, true);
       return {at::stack(unstacked_output.outputs, 0),
@@ -543,6 +689,13 @@ struct FullBidirectionalLayer
     std::vector<Tensor> step_inputs;
     if (input.device().is_cpu()) {
       auto input_w = params.first.linear_ih(input);
+      if (layer_.use_inplace(input_w)) {
+        auto fw_result = layer_.run_inplace(input_w, input_hidden.first, params.first);
+        auto rev_result = layer_.run_inplace(
+            params.second.linear_ih(input), input_hidden.second, params.second, /*reverse=*/true);
+        return {at::cat({fw_result.outputs, rev_result.outputs}, fw_result.outputs.dim() - 1),
+                std::make_pair(fw_result.final_hidden, rev_result.final_hidden)};
+      }
       step_inputs = input_w.unbind(0);
       auto fw_result = layer_(
           step_inputs, input_hidden.first, params.first, true);
@@ -605,6 +758,9 @@ struct PackedLayer : Layer<PackedSequence, hidden_type, cell_params> {
       input_w = params.linear_ih(input.data);
       input_ptr = &input_w;
       pre_compute_input = true;
+      if (!at::GradMode::is_enabled() && cell_.can_step_inplace(input_w)) {
+        return run_inplace(input, input_w, input_hidden, params);
+      }
     }
 
     // Batch sizes is a sequence of decreasing lengths, which are offsets
@@ -636,6 +792,45 @@ struct PackedLayer : Layer<PackedSequence, hidden_type, cell_params> {
             hidden_concat(hiddens)};
   }
 
+  // Same as above without the per-step allocations (see
+  // FullLayer::run_inplace). Each step works on the leading batch_size rows
+  // of the state buffers, so the active batch shrinks as sequences finish,
+  // and the rows of finished sequences are never written again.
+  output_type run_inplace(
+      const PackedSequence& input,
+      const Tensor& input_w,
+      const hidden_type& input_hidden,
+      const cell_params& params) const {
+    std::vector<hidden_type> hiddens;
+    int64_t input_offset = 0;
+    int64_t num_steps = input.batch_sizes.size(0);
+    int64_t* batch_sizes = input.batch_sizes.data_ptr<int64_t>();
+    int64_t last_batch_size = batch_sizes[0];
+
+    auto hidden = hidden_own_state(input_hidden);
+    const auto h0 = hidden_as_output(hidden);
+    auto output = at::empty({input_w.size(0), h0.size(1)}, h0.options());
+    Tensor workspace;
+    for (int64_t i = 0; i < num_steps; ++i) {
+      const int64_t batch_size = batch_sizes[i];
+      const int64_t dec = last_batch_size - batch_size;
+      if (dec > 0) {
+        hiddens.emplace_back(
+            hidden_slice(hidden, last_batch_size - dec, last_batch_size));
+        hidden = hidden_slice(hidden, 0, last_batch_size - dec);
+      }
+      last_batch_size = batch_size;
+      Tensor step_output = output.narrow(0, input_offset, batch_size);
+      cell_.step_inplace(input_w.narrow(0, input_offset, batch_size), hidden,
+                         params, step_output, workspace);
+      input_offset += batch_size;
+    }
+    hiddens.emplace_back(hidden);
+    std::reverse(hiddens.begin(), hiddens.end());
+
+    return {PackedSequence{output, input.batch_sizes}, hidden_concat(hiddens)};
+  }
+
   Cell<hidden_type, cell_params>& cell_;
 };
 
@@ -664,6 +859,9 @@ struct ReversedPackedLayer : Layer<PackedSequence, hidden_type, cell_params> {
       input_w = params.linear_ih(input.data);
       input_ptr = &input_w;
       pre_compute_input = true;
+      if (!at::GradMode::is_enabled() && cell_.can_step_inplace(input_w)) {
+        return run_inplace(input, input_w, input_hidden, params);
+      }
     }
 
     // Here the situation is similar to that above, except we start out with
@@ -690,6 +888,40 @@ struct ReversedPackedLayer : Layer<PackedSequence, hidden_type, cell_params> {
             hidden};
   }
 
+  // In-place variant of the above, see PackedLayer::run_inplace. The active
+  // batch grows here; the few steps that add sequences concatenate their
+  // initial states, which also gives the new state buffers.
+  output_type run_inplace(
+      const PackedSequence& input,
+      const Tensor& input_w,
+      const hidden_type& input_hidden,
+      const cell_params& params) const {
+    int64_t input_offset = input_w.size(0);
+    int64_t num_steps = input.batch_sizes.size(0);
+    int64_t* batch_sizes = input.batch_sizes.data_ptr<int64_t>();
+    int64_t last_batch_size = batch_sizes[num_steps - 1];
+
+    auto hidden = hidden_own_state(
+        hidden_slice(input_hidden, 0, batch_sizes[num_steps - 1]));
+    const auto h0 = hidden_as_output(hidden);
+    auto output = at::empty({input_w.size(0), h0.size(1)}, h0.options());
+    Tensor workspace;
+    for (int64_t i = num_steps - 1; i >= 0; --i) {
+      const int64_t batch_size = batch_sizes[i];
+      const int64_t inc = batch_size - last_batch_size;
+      if (inc > 0) {
+        hidden = hidden_concat(ArrayRef<hidden_type>{
+            hidden, hidden_slice(input_hidden, last_batch_size, batch_size)});
+      }
+      input_offset -= batch_size;
+      last_batch_size = batch_size;
+      Tensor step_output = output.narrow(0, input_offset, batch_size);
+      cell_.step_inplace(input_w.narrow(0, input_offset, batch_size), hidden,
+                         params, step_output, workspace);
+    }
+    return {PackedSequence{output, input.batch_sizes}, hidden};
+  }
+
   Cell<hidden_type, cell_params>& cell_;
 };
 
@@ -861,6 +1093,7 @@ std::tuple<Tensor, Tensor> NAME(                                               \
     return std::make_tuple(std::move(output), std::move(hy));                  \
   }                                                                            \
   check_device(_input, _params, hx);                                           \
+  at::AutoGradMode grad_mode(rnn_requires_grad(_input, hx, _params));          \
   auto input = batch_first ? _input.transpose(0, 1) : _input;                  \
   auto params = gather_params(_params, has_biases);                            \
   auto results = _rnn_impl_with_concat<CELL, FullLayer, FullBidirectionalLayer>( \
@@ -893,6 +1126,7 @@ std::tuple<Tensor, Tensor> NAME(                                               \
             _params, has_biases, num_layers, dropout_p, train, bidirectional); \
     return std::make_tuple(std::move(output), std::move(hy));                  \
   }                                                                            \
+  at::AutoGradMode grad_mode(rnn_requires_grad(data, hx, _params));            \
   PackedSequence input { data, batch_sizes };                                  \
   auto params = gather_params(_params, has_biases);                            \
   auto result = _rnn_impl_with_concat<CELL, PackedLayer, PackedBidirectionalLayer>( \
@@ -901,60 +1135,7 @@ std::tuple<Tensor, Tensor> NAME(                                               \
   return std::make_tuple(std::move(packed_output.data), std::move(std::get<1>(result)));             \
 }
 
-#define ONE_HIDDEN_QRNN(NAME, CELL)                                             \
-std::tuple<Tensor, Tensor> NAME(                                               \
-    const Tensor& _input, \
-    const Tensor& hx, \
-    TensorList _params, \
-    bool has_biases, \
-    int64_t num_layers, \
-    double dropout_p,  \
-    bool train, \
-    bool bidirectional, \
-    bool batch_first) { \
-  if (at::cudnn_is_acceptable(_input)) {                                       \
-    Tensor output, hy;                                                         \
-    gru_cudnn_stub(_input.device().type(), output, hy, _input, hx, _params, has_biases, \
-            num_layers, dropout_p, train, bidirectional, batch_first);         \
-    return std::make_tuple(std::move(output), std::move(hy));                  \
-  }                                                                            \
-  check_device(_input, _params, hx); \
-  auto input = batch_first ? _input.transpose(0, 1) : _input;                  \
-  auto params = gather_quantized_params(_params);                            \
-  auto results = _rnn_impl_with_concat<CELL, FullLayer, FullBidirectionalLayer>( \
-      input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional); \
-  if (batch_first) {                                                           \
-    std::get<0>(results).transpose_(0, 1);               \
-  }                                                                            \
-  return results;                                                              \
-}                                                                              \
-                                                                               \
-std::tuple<Tensor, Tensor> NAME(                                               \
-    const Tensor& data, \
-    const Tensor& batch_sizes, \
-    const Tensor& hx, \
-    TensorList _params, \
-    bool has_biases, \
-    int64_t num_layers, \
-    double dropout_p, \
-    bool train, \
-    bool bidirectional) {  \
-  if (at::cudnn_is_acceptable(data)) {                                         \
-    Tensor output, hy;                                                         \
-    gru_packed_cudnn_stub(data.device().type(), output, hy, data, batch_sizes, hx, \
-            _params, has_biases, num_layers, dropout_p, train, bidirectional); \
-    return std::make_tuple(std::move(output), std::move(hy));                                        \
-  }                                                                            \
-  PackedSequence input { data, batch_sizes };                                  \
-  auto params = gather_quantized_params(_params);                            \
-  auto result = _rnn_impl_with_concat<CELL, PackedLayer, PackedBidirectionalLayer>( \
-          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional); \
-  auto & packed_output = std::get<0>(result);                                  \
-  return std::make_tuple(std::move(packed_output.data), std::move(std::get<1>(result)));             \
-}
-
 ONE_HIDDEN_RNN(gru, GRUCell<CellParams>)
-ONE_HIDDEN_QRNN(quantized_gru, GRUCell<QuantizedCellParams>)
 using tanf_cell_type = SimpleCell<tanh_f, CellParams>;
 ONE_HIDDEN_RNN(rnn_tanh, tanf_cell_type)
 using relu_cell_type = SimpleCell<relu_f, CellParams>;
@@ -988,6 +1169,7 @@ std::tuple<Tensor, Tensor, Tensor> lstm(
     return std::make_tuple(std::move(output), std::move(hy), std::move(cy));
   }
   check_device(_input, _params, hx);
+  at::AutoGradMode grad_mode(rnn_requires_grad(_input, hx, _params));
   auto input = batch_first ? _input.transpose(0, 1) : _input;
   auto params = gather_params(_params, has_biases);
   auto results = _lstm_impl<FullLayer, FullBidirectionalLayer>(
@@ -1017,6 +1199,7 @@ std::tuple<Tensor, Tensor, Tensor> lstm(
     return std::make_tuple(std::move(output), std::move(hy), std::move(cy));
   }
 
+  at::AutoGradMode grad_mode(rnn_requires_grad(data, hx, _params));
   PackedSequence input { data, batch_sizes };
   auto params = gather_params(_params, has_biases);
   auto result = _lstm_impl<PackedLayer, PackedBidirectionalLayer>(
@@ -1122,6 +1305,138 @@ std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor> _thnn_differentiable_gru_cell
                          std::move(grad_hx), std::move(grad_input_bias), std::move(grad_hidden_bias));
 }
 
+namespace {
+
+void check_fused_cell_cpu(CheckedFrom c,
+                          const TensorArg& input_gates, const TensorArg& hidden_gates,
+                          const TensorArg& input_bias, const TensorArg& hidden_bias,
+                          int64_t factor, const TensorArg& prev_hidden) {
+  checkDim(c, input_gates, 2);
+  checkSameSize(c, input_gates, hidden_gates);
+  int64_t gates_size = input_gates->size(1);
+
+  TORCH_CHECK(input_bias->defined() == hidden_bias->defined(),
+              c, ": expected either both or neither of the biases to be defined");
+  if (input_bias->defined()) {
+    checkDim(c, input_bias, 1);
+    checkNumel(c, input_bias, gates_size);
+    checkSameSize(c, input_bias, hidden_bias);
+  }
+
+  checkDim(c, prev_hidden, 2);
+  checkSize(c, input_gates, {prev_hidden->size(0), prev_hidden->size(1) * factor});
+
+  checkAllSameType(c, {input_gates, hidden_gates, input_bias, hidden_bias, prev_hidden});
+  checkDeviceType(c, {*input_gates, *hidden_gates, *input_bias, *hidden_bias, *prev_hidden}, kCPU);
+}
+
+Tensor contiguous_if_defined(const Tensor& t) {
+  return t.defined() ? t.contiguous() : t;
+}
+
+} // namespace
+
+std::tuple<Tensor, Tensor, Tensor> _thnn_fused_lstm_cell_cpu(
+      const Tensor& input_gates, const Tensor& hidden_gates,
+      const Tensor& cx,
+      const Tensor& input_bias, const Tensor& hidden_bias) {
+  check_fused_cell_cpu("_thnn_fused_lstm_cell_cpu",
+                       {input_gates, "input_gates", 1}, {hidden_gates, "hidden_gates", 2},
+                       {input_bias, "input_bias", 4}, {hidden_bias, "hidden_bias", 5},
+                       /*factor=*/4, {cx, "prev_hidden", 3});
+
+  auto workspace = at::empty_like(input_gates, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto hy = at::empty_like(cx, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto cy = at::empty_like(cx, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  lstm_cell_stub(
+      kCPU, hy, cy, workspace,
+      input_gates.contiguous(), hidden_gates.contiguous(),
+      contiguous_if_defined(input_bias), contiguous_if_defined(hidden_bias),
+      cx.contiguous());
+  return std::make_tuple(hy, cy, workspace);
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor> _thnn_fused_lstm_cell_backward_cpu(
+      const Tensor& grad_hy, const Tensor& grad_cy,
+      const Tensor& cx, const Tensor& cy,
+      const Tensor& workspace, bool has_bias) {
+  TORCH_CHECK(grad_hy.defined() || grad_cy.defined(),
+              "_thnn_fused_lstm_cell_backward_cpu: either gradient with respect to hy or cy should be defined");
+  CheckedFrom c = "_thnn_fused_lstm_cell_backward_cpu";
+  TensorArg grad_hy_arg{grad_hy, "grad_hy", 1}, grad_cy_arg{grad_cy, "grad_cy", 2},
+            cx_arg{cx, "cx", 3}, cy_arg{cy, "cy", 4}, workspace_arg{workspace, "workspace", 5};
+  checkDim(c, cx_arg, 2);
+  const auto exp_size = cx.sizes();
+  if (grad_hy.defined()) {
+    checkSize(c, grad_hy_arg, exp_size);
+  }
+  if (grad_cy.defined()) {
+    checkSize(c, grad_cy_arg, exp_size);
+  }
+  checkSize(c, cy_arg, exp_size);
+  checkSize(c, workspace_arg, {exp_size[0], exp_size[1] * 4});
+
+  auto grad_gates = at::empty_like(workspace, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto grad_cx = at::empty_like(cx, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  lstm_cell_backward_stub(
+      kCPU, grad_gates, grad_cx,
+      contiguous_if_defined(grad_hy), contiguous_if_defined(grad_cy),
+      cx.contiguous(), cy.contiguous(), workspace.contiguous());
+
+  auto grad_bias = has_bias ? grad_gates.sum(0, /*keepdim=*/false) : at::Tensor{};
+  return std::make_tuple(grad_gates, grad_gates, grad_cx, grad_bias, grad_bias);
+}
+
+static constexpr int64_t GRU_WORKSPACE_MULTIPLIER = 5;
+
+std::tuple<Tensor, Tensor> _thnn_fused_gru_cell_cpu(
+      const Tensor& input_gates, const Tensor& hidden_gates,
+      const Tensor& hx,
+      const Tensor& input_bias, const Tensor& hidden_bias) {
+  check_fused_cell_cpu("_thnn_fused_gru_cell_cpu",
+                       {input_gates, "input_gates", 1}, {hidden_gates, "hidden_gates", 2},
+                       {input_bias, "input_bias", 4}, {hidden_bias, "hidden_bias", 5},
+                       /*factor=*/3, {hx, "prev_hidden", 3});
+
+  auto workspace = at::empty({hx.size(0), hx.size(1) * GRU_WORKSPACE_MULTIPLIER}, hx.options());
+  auto hy = at::empty_like(hx, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  gru_cell_stub(
+      kCPU, hy, workspace,
+      input_gates.contiguous(), hidden_gates.contiguous(),
+      contiguous_if_defined(input_bias), contiguous_if_defined(hidden_bias),
+      hx.contiguous());
+  return std::make_tuple(hy, workspace);
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor> _thnn_fused_gru_cell_backward_cpu(
+      const Tensor& grad_hy, const Tensor& workspace, bool has_bias) {
+  CheckedFrom c = "_thnn_fused_gru_cell_backward_cpu";
+  TensorArg grad_hy_arg{grad_hy, "grad_hy", 1}, workspace_arg{workspace, "workspace", 2};
+  checkDim(c, grad_hy_arg, 2);
+  checkSize(c, workspace_arg, {grad_hy.size(0), grad_hy.size(1) * GRU_WORKSPACE_MULTIPLIER});
+
+  int64_t hidden_size = workspace.size(1) / GRU_WORKSPACE_MULTIPLIER;
+  auto grad_input_gates = at::empty({workspace.size(0), hidden_size * 3}, workspace.options());
+  auto grad_hidden_gates = at::empty({workspace.size(0), hidden_size * 3}, workspace.options());
+  auto grad_hx = at::empty_like(grad_hy, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  gru_cell_backward_stub(
+      kCPU, grad_input_gates, grad_hidden_gates, grad_hx,
+      grad_hy.contiguous(), workspace.contiguous());
+
+  at::Tensor grad_input_bias, grad_hidden_bias;
+  if (has_bias) {
+    grad_input_bias = grad_input_gates.sum(0, /*keepdim=*/false);
+    grad_hidden_bias = grad_hidden_gates.sum(0, /*keepdim=*/false);
+  }
+
+  return std::make_tuple(grad_input_gates, grad_hidden_gates, grad_hx, grad_input_bias, grad_hidden_bias);
+}
+
+DEFINE_DISPATCH(lstm_cell_stub);
+DEFINE_DISPATCH(lstm_cell_backward_stub);
+DEFINE_DISPATCH(gru_cell_stub);
+DEFINE_DISPATCH(gru_cell_backward_stub);
+
 Tensor gru_cell(
     const Tensor& input, const Tensor& hx,
     const Tensor& w_ih, const Tensor& w_hh, const Tensor& b_ih, const Tensor& b_hh) {
@@ -1160,6 +1475,7 @@ std::tuple<Tensor, Tensor, Tensor> quantized_lstm(
   }
   auto result_dtype = dtype.has_value() ? dtype.value() : at::kChar;
   check_device(_input, _params, hx);
+  at::AutoGradMode grad_mode(rnn_requires_grad(_input, hx, _params));
   auto input = batch_first ? _input.transpose(0, 1) : _input;
   TORCH_CHECK(has_biases, "quantized LSTM requires biases");
   TORCH_CHECK(
@@ -1208,6 +1524,7 @@ std::tuple<Tensor, Tensor, Tensor> quantized_lstm(
   }
 
   auto result_dtype = dtype.has_value() ? dtype.value() : at::kChar;
+  at::AutoGradMode grad_mode(rnn_requires_grad(data, hx, _params));
 
   PackedSequence input { data, batch_sizes };
   std::tuple<PackedSequence, Tensor, Tensor> results;
@@ -1235,6 +1552,89 @@ std::tuple<Tensor, Tensor, Tensor> quantized_lstm(
                          std::move(std::get<2>(results)));
 }
 
+std::tuple<Tensor, Tensor> quantized_gru(
+      const Tensor& _input, const Tensor& hx,
+      TensorList _params, bool has_biases,
+      int64_t num_layers, double dropout_p, bool train, bool bidirectional,
+      bool batch_first, c10::optional<ScalarType> dtype, bool use_dynamic) {
+  if (at::cudnn_is_acceptable(_input)) {
+    Tensor output, hy;
+    gru_cudnn_stub(_input.device().type(), output, hy, _input, hx, _params, has_biases,
+            num_layers, dropout_p, train, bidirectional, batch_first);
+    return std::make_tuple(std::move(output), std::move(hy));
+  }
+  auto result_dtype = dtype.has_value() ? dtype.value() : at::kChar;
+  check_device(_input, _params, hx);
+  at::AutoGradMode grad_mode(rnn_requires_grad(_input, hx, _params));
+  auto input = batch_first ? _input.transpose(0, 1) : _input;
+  TORCH_CHECK(
+      result_dtype == at::kChar || result_dtype == at::kQInt8 ||
+          result_dtype == at::kHalf,
+      "dtype is not supported");
+
+  std::tuple<Tensor, Tensor> results;
+  if (result_dtype == at::kChar || result_dtype == at::kQInt8) {
+    if (use_dynamic) {
+      TORCH_CHECK(has_biases, "dynamic quantized GRU requires biases");
+      auto params = gather_quantized_params_dynamic(_params);
+      results = _rnn_impl_with_concat<GRUCell<QuantizedCellParamsDynamic>, FullLayer, FullBidirectionalLayer>(
+          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+    } else {
+      auto params = gather_quantized_params(_params);
+      results = _rnn_impl_with_concat<GRUCell<QuantizedCellParams>, FullLayer, FullBidirectionalLayer>(
+          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+    }
+  } else {
+    TORCH_CHECK(has_biases, "float16 quantized GRU requires biases");
+    auto params = gather_quantized_params_fp16(_params);
+    results = _rnn_impl_with_concat<GRUCell<QuantizedCellParamsFP16>, FullLayer, FullBidirectionalLayer>(
+        input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+  }
+
+  if (batch_first) {
+    std::get<0>(results).transpose_(0, 1);
+  }
+  return results;
+}
+
+std::tuple<Tensor, Tensor> quantized_gru(
+      const Tensor& data, const Tensor& batch_sizes, const Tensor& hx,
+      TensorList _params, bool has_biases,
+      int64_t num_layers, double dropout_p, bool train, bool bidirectional,
+      c10::optional<ScalarType> dtype, bool use_dynamic) {
+  if (at::cudnn_is_acceptable(data)) {
+    Tensor output, hy;
+    gru_packed_cudnn_stub(data.device().type(), output, hy, data, batch_sizes, hx,
+            _params, has_biases, num_layers, dropout_p, train, bidirectional);
+    return std::make_tuple(std::move(output), std::move(hy));
+  }
+
+  auto result_dtype = dtype.has_value() ? dtype.value() : at::kChar;
+  at::AutoGradMode grad_mode(rnn_requires_grad(data, hx, _params));
+
+  PackedSequence input { data, batch_sizes };
+  std::tuple<PackedSequence, Tensor> results;
+  if (result_dtype == at::kChar || result_dtype == at::kQInt8) {
+    if (use_dynamic) {
+      TORCH_CHECK(has_biases, "dynamic quantized GRU requires biases");
+      auto params = gather_quantized_params_dynamic(_params);
+      results = _rnn_impl_with_concat<GRUCell<QuantizedCellParamsDynamic>, PackedLayer, PackedBidirectionalLayer>(
+          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+    } else {
+      auto params = gather_quantized_params(_params);
+      results = _rnn_impl_with_concat<GRUCell<QuantizedCellParams>, PackedLayer, PackedBidirectionalLayer>(
+          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+    }
+  } else {
+    TORCH_CHECK(has_biases, "float16 quantized GRU requires biases");
+    auto params = gather_quantized_params_fp16(_params);
+    results = _rnn_impl_with_concat<GRUCell<QuantizedCellParamsFP16>, PackedLayer, PackedBidirectionalLayer>(
+        input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+  }
+  auto & packed_output = std::get<0>(results);
+  return std::make_tuple(std::move(packed_output.data), std::move(std::get<1>(results)));
+}
+
 #define DEFINE_QUANTIZED_RNN_CELL(name, hx_type, cell_type, return_type, prepare_hx_fn) \
 return_type name( \
     const Tensor& input, \
@@ -10,6 +10,14 @@ using rnn_fn = void(*)(Tensor&, Tensor&, const Tensor&, const Tensor&, TensorLis
 using lstm_packed_fn = void(*)(Tensor&, Tensor&, Tensor&, const Tensor&, const Tensor&, TensorList, TensorList, bool, int64_t, double, bool, bool);
 using rnn_packed_fn = void(*)(Tensor&, Tensor&, const Tensor&, const Tensor&, const Tensor&, TensorList, bool, int64_t, double, bool, bool);
 
+// Fused pointwise cells: the gate projections are computed by the caller and
+// the kernels apply every activation in a single pass, see
+// native/cpu/RNNCellKernel.cpp for the workspace layouts.
+using lstm_cell_fn = void(*)(Tensor&, Tensor&, Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&);
+using lstm_cell_backward_fn = void(*)(Tensor&, Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&);
+using gru_cell_fn = void(*)(Tensor&, Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&);
+using gru_cell_backward_fn = void(*)(Tensor&, Tensor&, Tensor&, const Tensor&, const Tensor&);
+
 DECLARE_DISPATCH(lstm_fn, lstm_cudnn_stub);
 DECLARE_DISPATCH(lstm_fn, lstm_miopen_stub);
 DECLARE_DISPATCH(rnn_fn, gru_cudnn_stub);
@@ -26,6 +34,10 @@ DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_miopen_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_miopen_stub);
+DECLARE_DISPATCH(lstm_cell_fn, lstm_cell_stub);
+DECLARE_DISPATCH(lstm_cell_backward_fn, lstm_cell_backward_stub);
+DECLARE_DISPATCH(gru_cell_fn, gru_cell_stub);
+DECLARE_DISPATCH(gru_cell_backward_fn, gru_cell_backward_stub);
 
 inline void check_device(const Tensor& input, const TensorList& params, const TensorList& hiddens) {
   auto input_device = input.device();
@@ -233,12 +233,27 @@ static ScalarType get_dtype(Tensor& result, const Tensor& self, optional<ScalarT
   return src_type;
 }
 
+// bf16 only keeps 8 bits of mantissa, so a running bf16 sum stops changing
+// once it is ~256x larger than the elements. On CPU, sum, mean and prod of
+// bf16 reduce into a float result, which the kernels accumulate while reading
+// the bf16 input, and round it once.
+static Tensor bfloat16_reduction_in_float(const char* name, reduce_fn stub,
+                                          const Tensor& self, IntArrayRef dim, bool keepdim) {
+  Tensor result_float;
+  auto iter = make_reduction(name, result_float, self, dim, keepdim, kBFloat16, kFloat);
+  stub(iter);
+  return result_float;
+}
+
 Tensor& sum_out(Tensor& result, const Tensor& self, IntArrayRef dim,
                        bool keepdim, optional<ScalarType> opt_dtype) {
   ScalarType dtype = get_dtype(result, self, opt_dtype, true);
   auto iter = make_reduction("sum", result, self, dim, keepdim, dtype);
   if (iter.numel() == 0) {
     result.zero_();
+  } else if (iter.device_type() == kCPU && dtype == kBFloat16) {
+    result.copy_(bfloat16_reduction_in_float(
+        "sum", [](TensorIterator& it) { sum_stub(kCPU, it); }, self, dim, keepdim));
   } else {
     sum_stub(iter.device_type(), iter);
   }
@@ -267,6 +282,9 @@ static Tensor& prod_out_impl(Tensor& result, const Tensor& self, IntArrayRef dim
   auto iter = make_reduction("prod", result, self, dim, keepdim, dtype);
   if (iter.numel() == 0) {
     result.fill_(1);
+  } else if (iter.device_type() == kCPU && dtype == kBFloat16) {
+    result.copy_(bfloat16_reduction_in_float(
+        "prod", [](TensorIterator& it) { prod_stub(kCPU, it); }, self, dim, keepdim));
   } else {
     prod_stub(iter.device_type(), iter);
   }
@@ -319,6 +337,17 @@ Tensor &mean_out_cpu_gpu(Tensor &result, const Tensor &self, IntArrayRef dim,
         dim_prod *= self.size(d);
       }
     }
+    if (dtype == kBFloat16) {
+      // Divides the float sum, so that the mean is only rounded once.
+      auto iter = make_reduction("mean", result, self, dim, keepdim, dtype);
+      if (iter.numel() == 0) {
+        result.fill_(std::numeric_limits<double>::quiet_NaN());
+      } else {
+        result.copy_(bfloat16_reduction_in_float(
+            "mean", [](TensorIterator& it) { sum_stub(kCPU, it); }, self, dim, keepdim).div_(dim_prod));
+      }
+      return result;
+    }
     at::sum_out(result, self, dim, keepdim, dtype).div_(dim_prod);
     return result;
   }
@@ -98,6 +98,11 @@ Tensor to_dense_backward(const Tensor& grad, const Tensor& input_) {
     return grad.sparse_mask(input);
   } else if (input_.layout() == c10::kMkldnn) {
     return grad.to_mkldnn();
+  } else if (input_.layout() == c10::kSparseCsr) {
+    // Keep the sparsity pattern of the input.
+    auto indices = input_.to_sparse()._indices();
+    auto values = grad.index({indices[0], indices[1]});
+    return at::_sparse_csr_tensor_unsafe(input_.crow_indices(), input_.col_indices(), values, input_.sizes());
   } else {
     AT_ERROR("Unsupported input layout: ", input_.layout());
   }
@@ -257,8 +257,18 @@ struct CAFFE2_API TensorIterator {
 
   void for_each(loop_t loop);
   void for_each(loop2d_t loop);
+  /// Same as above, but with the minimum number of elements handed to a
+  /// thread given by `grain_size` instead of at::internal::GRAIN_SIZE. Use
+  /// at::internal::grain_size_for_cost to derive it from the cost of `loop`.
+  void for_each(loop_t loop, int64_t grain_size);
+  void for_each(loop2d_t loop, int64_t grain_size);
 
   void parallel_reduce(loop2d_t loop);
+  /// Same as above, but full reductions of large inputs combine their partial
+  /// results with `combine`, which reduces an output-typed input into the
+  /// output. Required when `loop` reads an input of a different dtype than
+  /// the output.
+  void parallel_reduce(loop2d_t loop, loop2d_t combine);
 
   void serial_for_each(loop_t loop, Range range) const;
   void serial_for_each(loop2d_t loop, Range range) const;
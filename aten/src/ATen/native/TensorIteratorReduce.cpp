@@ -1,7 +1,6 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
 #include <algorithm>
-#include <memory>
 
 /// Contains the implementation of parallel reductions in TensorIterator.
 
@@ -9,58 +8,120 @@ namespace at {
 
 using loop2d_t = TensorIterator::loop2d_t;
 
-static bool use_two_pass_reduction(TensorIterator& iter);
-static void two_pass_reduction(TensorIterator& iter, loop2d_t loop);
+static bool use_tree_reduction(TensorIterator& iter);
+static void tree_reduction(TensorIterator& iter, loop2d_t loop, loop2d_t combine);
+static int64_t reduced_block_size(TensorIterator& iter);
+static void parallel_output_reduction(TensorIterator& iter, loop2d_t loop, int64_t reduced_size);
 static void parallel_dim_reduction(TensorIterator& iter, loop2d_t loop);
 
+/// Number of input elements folded into each partial result of a tree
+/// reduction. The block boundaries depend only on the size of the input, never
+/// on the number of threads, so a reduction always combines its elements in the
+/// same order and produces bit-identical results for any thread count.
+static constexpr int64_t TREE_BLOCK_SIZE = internal::GRAIN_SIZE;
+
 void TensorIterator::parallel_reduce(loop2d_t loop) {
+  parallel_reduce(loop, loop);
+}
+
+void TensorIterator::parallel_reduce(loop2d_t loop, loop2d_t combine) {
   TORCH_CHECK(ntensors() == 2, "parallel_reduce only supports one input and one output");
   int64_t numel = this->numel();
-  if (numel < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
+  if (use_tree_reduction(*this)) {
+    // Full reductions take the same path when running serially so that the
+    // result does not depend on the number of threads.
+    tree_reduction(*this, loop, combine);
+  } else if (numel < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
       at::in_parallel_region()) {
     serial_for_each(loop, {0, numel});
-  } else if (use_two_pass_reduction(*this)) {
-    two_pass_reduction(*this, loop);
   } else {
-    parallel_dim_reduction(*this, loop);
+    int64_t reduced_size = reduced_block_size(*this);
+    if (reduced_size > 0 && numel / reduced_size >= at::get_num_threads()) {
+      parallel_output_reduction(*this, loop, reduced_size);
+    } else {
+      parallel_dim_reduction(*this, loop);
+    }
   }
 }
 
-static bool use_two_pass_reduction(TensorIterator& iter) {
+static bool use_tree_reduction(TensorIterator& iter) {
   return iter.output(0).numel() == 1;
 }
 
-static void two_pass_reduction(TensorIterator& iter, loop2d_t loop) {
-  int max_threads = at::get_num_threads();
+/// Reduces fixed-size blocks of the input into their own partial results, then
+/// reduces the partial results the same way until they fit in a single block.
+/// Only needs memory for one partial result per block, independently of the
+/// number of threads. The partial results have the dtype of the output, so
+/// every level above the first reduces them with `combine` instead of `loop`.
+static void tree_reduction(TensorIterator& iter, loop2d_t loop, loop2d_t combine) {
+  int64_t numel = iter.numel();
+  if (numel <= TREE_BLOCK_SIZE) {
+    iter.serial_for_each(loop, {0, numel});
+    return;
+  }
 
   auto dst = iter.output(0);
+  int64_t num_blocks = divup(numel, TREE_BLOCK_SIZE);
   auto buffer_shape = DimVector(dst.sizes());
-  buffer_shape.insert(buffer_shape.begin(), max_threads);
+  buffer_shape.insert(buffer_shape.begin(), num_blocks);
   auto buffer = at::empty(buffer_shape, dst.options());
-
-  std::unique_ptr<bool[]> written(new bool[max_threads]);
-  std::fill(written.get(), written.get() + max_threads, false);
-
-  at::parallel_for(0, iter.numel(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
-    int thread_num = at::get_thread_num();
-    written[thread_num] = true;
-    auto slice = buffer[thread_num];
-    slice.copy_(dst);
-
-    auto sub_iter = TensorIterator::reduce_op(slice, iter.input(0));
-    sub_iter.serial_for_each(loop, {begin, end});
+  // dst holds the identity of the reduction
+  buffer.copy_(dst.unsqueeze(0).expand(buffer_shape));
+
+  char* buffer_data = static_cast<char*>(buffer.data_ptr());
+  int64_t element_size = buffer.element_size();
+  at::parallel_for(0, num_blocks, 1, [&](int64_t begin, int64_t end) {
+    // The output of a full reduction has zero strides, so each block only
+    // needs to point the output at its own slot of the buffer.
+    auto sub_iter = TensorIterator(iter);
+    for (int64_t block = begin; block < end; block++) {
+      sub_iter.unsafe_replace_operand(0, buffer_data + block * element_size);
+      sub_iter.serial_for_each(
+          loop, {block * TREE_BLOCK_SIZE, std::min(numel, (block + 1) * TREE_BLOCK_SIZE)});
+    }
   });
 
-  // fill any unwritten slices of the buffer with the identity
-  for (int thread_num = 0; thread_num < max_threads; thread_num++) {
-    if (!written[thread_num]) {
-      buffer[thread_num].copy_(dst);
+  auto unsqueezed = dst.unsqueeze(0);
+  auto next_level = TensorIterator::reduce_op(unsqueezed, buffer);
+  tree_reduction(next_level, combine, combine);
+}
+
+/// Returns the number of input elements reduced into each output element if
+/// the reduced dimensions are the inner-most ones, which TensorIterator
+/// normally arranges for reductions, or 0 otherwise.
+static int64_t reduced_block_size(TensorIterator& iter) {
+  auto shape = iter.shape();
+  auto out_strides = iter.strides(0);
+  int64_t reduced_size = 1;
+  int dim = 0;
+  for (; dim < iter.ndim() && out_strides[dim] == 0; dim++) {
+    reduced_size *= shape[dim];
+  }
+  for (; dim < iter.ndim(); dim++) {
+    if (out_strides[dim] == 0 && shape[dim] > 1) {
+      return 0;
     }
   }
+  return reduced_size;
+}
 
-  auto unsqueezed = dst.unsqueeze(0);
-  auto final_reduce = TensorIterator::reduce_op(unsqueezed, buffer);
-  final_reduce.for_each(loop);
+/// Parallelizes over blocks of output elements. Each output element is
+/// reduced by a single thread, which keeps all threads busy when the output is
+/// large but the reduced dimensions are small.
+static void parallel_output_reduction(TensorIterator& iter, loop2d_t loop, int64_t reduced_size) {
+  int64_t num_outputs = iter.numel() / reduced_size;
+  // Give each task at least GRAIN_SIZE input elements, in multiples of
+  // 128 bytes of output so that threads do not write to the same cache lines.
+  int64_t outputs_per_128_bytes = std::max<int64_t>(128 / iter.element_size(0), 1);
+  int64_t outputs_per_task = divup(internal::GRAIN_SIZE, reduced_size);
+  outputs_per_task = divup(outputs_per_task, outputs_per_128_bytes) * outputs_per_128_bytes;
+  int64_t num_tasks = divup(num_outputs, outputs_per_task);
+
+  at::parallel_for(0, num_tasks, 1, [&](int64_t begin, int64_t end) {
+    int64_t first = begin * outputs_per_task;
+    int64_t last = std::min(num_outputs, end * outputs_per_task);
+    iter.serial_for_each(loop, {first * reduced_size, last * reduced_size});
+  });
 }
 
 /// Chooses a dimension over which to parallelize. Prefers the outer-most
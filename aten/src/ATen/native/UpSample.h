@@ -2,6 +2,8 @@
 
 #include <ATen/ATen.h>
 #include <ATen/TensorUtils.h>
+#include <ATen/native/ChannelsLastUtils.h>
+#include <ATen/native/DispatchStub.h>
 
 
 /**
@@ -43,6 +45,17 @@
 namespace at {
 namespace native {
 
+// Forward kernels for 4d inputs that are contiguous in channels last memory
+// format. The output must already be resized to channels last.
+using upsample_nearest2d_fn = void(*)(
+    Tensor& output, const Tensor& input, double scales_h, double scales_w);
+using upsample_bilinear2d_fn = void(*)(
+    Tensor& output, const Tensor& input, bool align_corners,
+    double scales_h, double scales_w);
+
+DECLARE_DISPATCH(upsample_nearest2d_fn, upsample_nearest2d_channels_last_stub);
+DECLARE_DISPATCH(upsample_bilinear2d_fn, upsample_bilinear2d_channels_last_stub);
+
 static inline void upsample_1d_shape_check(
     const Tensor& input,
     const Tensor& grad_output,
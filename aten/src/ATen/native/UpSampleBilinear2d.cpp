@@ -188,6 +188,17 @@ static void upsample_bilinear2d_out_cpu_template(
       output_height,
       output_width);
 
+  if (cpu_2d_use_channels_last(input_)) {
+    output.resize_({nbatch, channels, output_height, output_width},
+                   at::MemoryFormat::ChannelsLast);
+    upsample_bilinear2d_channels_last_stub(
+        kCPU,
+        output,
+        input_.contiguous(at::MemoryFormat::ChannelsLast),
+        align_corners, scales_h, scales_w);
+    return;
+  }
+
   auto input = input_.contiguous();
 
   output.resize_({nbatch, channels, output_height, output_width});
@@ -278,6 +289,8 @@ static void upsample_bilinear2d_backward_out_cpu_template(
 }
 } // namespace
 
+DEFINE_DISPATCH(upsample_bilinear2d_channels_last_stub);
+
 Tensor& upsample_bilinear2d_out_cpu(
     Tensor& output,
     const Tensor& input,
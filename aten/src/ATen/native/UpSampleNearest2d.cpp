@@ -149,6 +149,17 @@ static void upsample_nearest2d_out_cpu_template(
       output_height,
       output_width);
 
+  if (cpu_2d_use_channels_last(input_)) {
+    output.resize_({nbatch, channels, output_height, output_width},
+                   at::MemoryFormat::ChannelsLast);
+    upsample_nearest2d_channels_last_stub(
+        kCPU,
+        output,
+        input_.contiguous(at::MemoryFormat::ChannelsLast),
+        scales_h, scales_w);
+    return;
+  }
+
   auto input = input_.contiguous();
 
   output.resize_({nbatch, channels, output_height, output_width});
@@ -234,6 +245,8 @@ static void upsample_nearest2d_backward_out_cpu_template(
 }
 } // namespace
 
+DEFINE_DISPATCH(upsample_nearest2d_channels_last_stub);
+
 Tensor& upsample_nearest2d_out_cpu(
     Tensor& output,
     const Tensor& input,
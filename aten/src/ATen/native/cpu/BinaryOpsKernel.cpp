@@ -4,8 +4,10 @@
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vectorized.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/BinaryOps.h>
+#include <ATen/native/cpu/CostHints.h>
 #include <ATen/native/cpu/Loops.h>
 
 namespace at { namespace native {
@@ -22,12 +24,13 @@ void add_kernel(TensorIterator& iter, Scalar alpha_scalar) {
   } else {
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kBFloat16, iter.dtype(), "add_cpu/sub_cpu", [&]() {
       auto alpha = alpha_scalar.to<scalar_t>();
-      auto alpha_vec = Vec256<scalar_t>(alpha);
+      auto alpha_vec = vec::Vectorized<scalar_t>(alpha);
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) -> scalar_t { return a + alpha * b; },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
-          return vec256::fmadd(b, alpha_vec, a);
-        });
+        [=](vec::Vectorized<scalar_t> a, vec::Vectorized<scalar_t> b) {
+          return vec::fmadd(b, alpha_vec, a);
+        },
+        at::internal::grain_size_for_cost(kAddCost));
       });
   }
 } 
@@ -39,7 +42,8 @@ void atan2_kernel(TensorIterator& iter) {
   },
     [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
       return a.atan2(b);
-    });
+    },
+    at::internal::grain_size_for_cost(kAtan2Cost));
   });
 }
 
@@ -54,9 +58,10 @@ void mul_kernel(TensorIterator& iter) {
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kBFloat16, iter.dtype(), "mul_cpu", [&]() {
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) -> scalar_t { return a * b; },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](vec::Vectorized<scalar_t> a, vec::Vectorized<scalar_t> b) {
           return a * b;
-        });
+        },
+        at::internal::grain_size_for_cost(kMulCost));
     });
   }
 }
@@ -86,7 +91,7 @@ void div_kernel(TensorIterator& iter) {
         [=](scalar_t a, scalar_t b) __ubsan_ignore_float_divide_by_zero__ -> scalar_t {
            return a / b;
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](vec::Vectorized<scalar_t> a, vec::Vectorized<scalar_t> b) {
           return a / b;
         });
     });
@@ -336,10 +341,10 @@ void mse_kernel(TensorIterator& iter) {
 } // anonymous namespace
 
 
-REGISTER_DISPATCH(add_stub, &add_kernel);
-REGISTER_DISPATCH(sub_stub, &sub_kernel);
-REGISTER_DISPATCH(mul_stub, &mul_kernel);
-REGISTER_DISPATCH(div_stub, &div_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(add_stub, &add_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(sub_stub, &sub_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(mul_stub, &mul_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(div_stub, &div_kernel);
 REGISTER_DISPATCH(atan2_stub, &atan2_kernel);
 REGISTER_DISPATCH(bitwise_xor_stub, &bitwise_xor_kernel);
 REGISTER_DISPATCH(logical_xor_stub, &logical_xor_kernel);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+/*
+  Forward-only 2d convolution operators that do not materialize the im2col
+  buffer of thnn_conv2d: a direct convolution for small kernels and a
+  Winograd convolution for stride-1 3x3 kernels. Both take a contiguous NCHW
+  input and OIHW weight, and support groups == 1 and dilation == 1 only.
+*/
+
+namespace at {
+namespace native {
+
+using convolution_direct2d_fn = Tensor (*)(
+    const Tensor& /* input */,
+    const Tensor& /* weight */,
+    const Tensor& /* bias */,
+    IntArrayRef /* stride */,
+    IntArrayRef /* padding */);
+
+using convolution_winograd3x3_fn = Tensor (*)(
+    const Tensor& /* input */,
+    const Tensor& /* weight */,
+    const Tensor& /* bias */,
+    IntArrayRef /* padding */);
+
+DECLARE_DISPATCH(convolution_direct2d_fn, convolution_direct2d_stub);
+DECLARE_DISPATCH(convolution_winograd3x3_fn, convolution_winograd3x3_stub);
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,24 @@
+#pragma once
+
+// Estimated costs, in cycles per element, of the element-wise CPU kernels
+// that pass at::internal::grain_size_for_cost(<cost>) to cpu_kernel or
+// cpu_kernel_vec. The kernels built on the at::vml loops use the costs in
+// ATen/cpu/vml.h instead.
+//
+// binaries/parallel_grain_benchmark.cc prints the grain sizes these give
+// next to the ones measured on the host, so keep the kernels using these
+// constants rather than literals.
+
+namespace at { namespace native {
+
+constexpr double kAddCost = 0.5;
+constexpr double kMulCost = 0.5;
+constexpr double kAtan2Cost = 20;
+constexpr double kPowCost = 20;
+constexpr double kSigmoidCost = 4;
+// sinh and cosh
+constexpr double kHyperbolicCost = 20;
+// digamma and trigamma
+constexpr double kPolygammaCost = 40;
+
+}} // namespace at::native
@@ -0,0 +1,191 @@
+#include <ATen/native/cpu/Conv2dKernel.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vectorized.h>
+
+#include <algorithm>
+
+namespace at {
+namespace native {
+namespace {
+
+// Number of output channels computed together, so that every input row
+// loaded from memory feeds this many accumulations.
+constexpr int64_t kOutputChannelBlock = 4;
+
+// First output column ow for which ow * stride - pad + k >= 0.
+inline int64_t first_valid_output(int64_t k, int64_t stride, int64_t pad) {
+  const int64_t offset = pad - k;
+  return offset <= 0 ? 0 : (offset + stride - 1) / stride;
+}
+
+// One past the last output column for which ow * stride - pad + k < size.
+inline int64_t last_valid_output(
+    int64_t k,
+    int64_t stride,
+    int64_t pad,
+    int64_t size,
+    int64_t output_size) {
+  const int64_t limit = size - 1 + pad - k;
+  return limit < 0 ? 0 : std::min(output_size, limit / stride + 1);
+}
+
+// out[b][j] += w[b] * in[j * stride] for b < num_blocks and j < n.
+template <typename scalar_t>
+inline void accumulate_rows(
+    scalar_t* const* out,
+    const scalar_t* in,
+    const scalar_t* w,
+    int64_t num_blocks,
+    int64_t n,
+    int64_t stride) {
+  using Vec = vec::Vectorized<scalar_t>;
+  int64_t j = 0;
+  if (stride == 1) {
+    Vec w_vec[kOutputChannelBlock];
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      w_vec[b] = Vec(w[b]);
+    }
+    for (; j + Vec::size() <= n; j += Vec::size()) {
+      const Vec x = Vec::loadu(in + j);
+      for (int64_t b = 0; b < num_blocks; ++b) {
+        vec::fmadd(w_vec[b], x, Vec::loadu(out[b] + j)).store(out[b] + j);
+      }
+    }
+  }
+  for (; j < n; ++j) {
+    const scalar_t x = in[j * stride];
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      out[b][j] += w[b] * x;
+    }
+  }
+}
+
+template <typename scalar_t>
+void direct_conv2d_block(
+    const scalar_t* input, // [C, H, W]
+    const scalar_t* weight, // [K, C, KH, KW]
+    const scalar_t* bias, // [K] or nullptr
+    scalar_t* output, // [K, OH, OW]
+    int64_t k_begin,
+    int64_t k_end,
+    int64_t C,
+    int64_t H,
+    int64_t W,
+    int64_t KH,
+    int64_t KW,
+    int64_t OH,
+    int64_t OW,
+    int64_t stride_h,
+    int64_t stride_w,
+    int64_t pad_h,
+    int64_t pad_w) {
+  const int64_t num_blocks = k_end - k_begin;
+  for (int64_t b = 0; b < num_blocks; ++b) {
+    scalar_t* out = output + (k_begin + b) * OH * OW;
+    std::fill(out, out + OH * OW, bias ? bias[k_begin + b] : scalar_t(0));
+  }
+
+  scalar_t w[kOutputChannelBlock];
+  scalar_t* out_rows[kOutputChannelBlock];
+  for (int64_t c = 0; c < C; ++c) {
+    const scalar_t* in_plane = input + c * H * W;
+    for (int64_t kh = 0; kh < KH; ++kh) {
+      const int64_t oh_begin = first_valid_output(kh, stride_h, pad_h);
+      const int64_t oh_end = last_valid_output(kh, stride_h, pad_h, H, OH);
+      for (int64_t kw = 0; kw < KW; ++kw) {
+        const int64_t ow_begin = first_valid_output(kw, stride_w, pad_w);
+        const int64_t ow_end = last_valid_output(kw, stride_w, pad_w, W, OW);
+        if (ow_begin >= ow_end) {
+          continue;
+        }
+        for (int64_t b = 0; b < num_blocks; ++b) {
+          w[b] = weight[(((k_begin + b) * C + c) * KH + kh) * KW + kw];
+        }
+        for (int64_t oh = oh_begin; oh < oh_end; ++oh) {
+          const int64_t ih = oh * stride_h - pad_h + kh;
+          const int64_t iw = ow_begin * stride_w - pad_w + kw;
+          for (int64_t b = 0; b < num_blocks; ++b) {
+            out_rows[b] = output + ((k_begin + b) * OH + oh) * OW + ow_begin;
+          }
+          accumulate_rows(
+              out_rows,
+              in_plane + ih * W + iw,
+              w,
+              num_blocks,
+              ow_end - ow_begin,
+              stride_w);
+        }
+      }
+    }
+  }
+}
+
+Tensor convolution_direct2d_kernel(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding) {
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  const int64_t H = input.size(2);
+  const int64_t W = input.size(3);
+  const int64_t K = weight.size(0);
+  const int64_t KH = weight.size(2);
+  const int64_t KW = weight.size(3);
+  const int64_t OH = (H + 2 * padding[0] - KH) / stride[0] + 1;
+  const int64_t OW = (W + 2 * padding[1] - KW) / stride[1] + 1;
+  Tensor output = at::empty({N, K, OH, OW}, input.options());
+  if (output.numel() == 0) {
+    return output;
+  }
+
+  const Tensor bias_contig = bias.defined() ? bias.contiguous() : bias;
+  const int64_t k_blocks =
+      (K + kOutputChannelBlock - 1) / kOutputChannelBlock;
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "conv2d_direct", [&] {
+    const scalar_t* input_data = input.data_ptr<scalar_t>();
+    const scalar_t* weight_data = weight.data_ptr<scalar_t>();
+    const scalar_t* bias_data =
+        bias_contig.defined() ? bias_contig.data_ptr<scalar_t>() : nullptr;
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+    at::parallel_for(0, N * k_blocks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        const int64_t n = i / k_blocks;
+        const int64_t k_begin = (i % k_blocks) * kOutputChannelBlock;
+        const int64_t k_end = std::min(K, k_begin + kOutputChannelBlock);
+        direct_conv2d_block<scalar_t>(
+            input_data + n * C * H * W,
+            weight_data,
+            bias_data,
+            output_data + n * K * OH * OW,
+            k_begin,
+            k_end,
+            C,
+            H,
+            W,
+            KH,
+            KW,
+            OH,
+            OW,
+            stride[0],
+            stride[1],
+            padding[0],
+            padding[1]);
+      }
+    });
+  });
+  return output;
+}
+
+} // namespace
+
+ALSO_REGISTER_AVX512_DISPATCH(
+    convolution_direct2d_stub,
+    &convolution_direct2d_kernel);
+
+} // namespace native
+} // namespace at
@@ -22,12 +22,23 @@
 //     [](float a, float b) { return a * b; },
 //     [](Vec256<float> a, Vec256<float> b) { return a * b; });
 //
-// See BinaryOpsKernel.cpp for the complete implementation
+// See BinaryOpsKernel.cpp for the complete implementation. Kernels that
+// opt in to AVX512 write the vectorized lambda against at::vec::Vectorized<T>
+// (see ATen/cpu/vectorized.h) instead of Vec256<T>.
 //
+// Both functions take an optional grain size, the minimum number of elements
+// handed to a thread. Kernels whose per-element cost is far from one cycle
+// should pass at::internal::grain_size_for_cost(<cycles per element>), e.g.
+//
+//   cpu_kernel(iter, [](float a) { return std::lgamma(a); },
+//              at::internal::grain_size_for_cost(40));
+//
+// Kernels with such a hint keep their cost in CostHints.h.
 //
 
 #include <stdint.h>
 #include <c10/util/C++17.h>
+#include <ATen/Parallel.h>
 #include <ATen/detail/FunctionTraits.h>
 #include <ATen/native/cpu/IsContiguous.h>
 #include <ATen/native/TensorIterator.h>
@@ -135,7 +146,9 @@ static inline void
 vectorized_loop(char** C10_RESTRICT data_, int64_t n, int64_t S, func_t&& op, vec_func_t&& vop) {
   using traits = function_traits<vec_func_t>;
   using scalar_t = typename function_traits<func_t>::result_type;
-  using Vec = Vec256<scalar_t>;
+  // Vec256<scalar_t>, or Vec512<scalar_t> for kernels written against
+  // at::vec::Vectorized that are compiled for AVX512.
+  using Vec = typename traits::result_type;
   constexpr int ntensors = traits::arity + 1;
 
   char* C10_RESTRICT data[ntensors];
@@ -184,7 +197,7 @@ static inline void unroll_contiguous_scalar_checks(
 }
 
 template <typename func_t>
-void cpu_kernel(TensorIterator& iter, func_t&& op) {
+void cpu_kernel(TensorIterator& iter, func_t&& op, int64_t grain_size = at::internal::GRAIN_SIZE) {
   using traits = function_traits<func_t>;
   TORCH_INTERNAL_ASSERT(iter.ntensors() >= traits::arity + 1);
 
@@ -197,12 +210,12 @@ void cpu_kernel(TensorIterator& iter, func_t&& op) {
         basic_loop(data, strides, 0, n, std::forward<func_t>(op));
       });
     }
-  });
+  }, grain_size);
   iter.cast_outputs();
 }
 
 template <typename func_t, typename vec_func_t>
-void cpu_kernel_vec(TensorIterator& iter, func_t&& op, vec_func_t&& vop) {
+void cpu_kernel_vec(TensorIterator& iter, func_t&& op, vec_func_t&& vop, int64_t grain_size = at::internal::GRAIN_SIZE) {
   using traits = function_traits<func_t>;
   TORCH_INTERNAL_ASSERT(iter.ntensors() >= traits::arity + 1);
 
@@ -219,7 +232,7 @@ void cpu_kernel_vec(TensorIterator& iter, func_t&& op, vec_func_t&& vop) {
         }
       });
     }
-  });
+  }, grain_size);
   iter.cast_outputs();
 }
 
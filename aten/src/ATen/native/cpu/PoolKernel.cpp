@@ -0,0 +1,317 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vectorized.h>
+#include <ATen/native/Pool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*
+  Channels last (NHWC) pooling. Every output pixel is a row of C contiguous
+  values computed from rows of C contiguous input values, so the inner loops
+  run over channels and are vectorized across them.
+*/
+
+namespace at {
+namespace native {
+namespace {
+
+inline int64_t start_index(int64_t a, int64_t b, int64_t c) {
+  return (int64_t)std::floor((float)(a * c) / b);
+}
+
+inline int64_t end_index(int64_t a, int64_t b, int64_t c) {
+  return (int64_t)std::ceil((float)((a + 1) * c) / b);
+}
+
+// out[c] += in[c] for c < size
+template <typename scalar_t>
+inline void add_row(scalar_t* out, const scalar_t* in, int64_t size) {
+  using Vec = vec::Vectorized<scalar_t>;
+  int64_t c = 0;
+  for (; c + Vec::size() <= size; c += Vec::size()) {
+    (Vec::loadu(out + c) + Vec::loadu(in + c)).store(out + c);
+  }
+  for (; c < size; ++c) {
+    out[c] += in[c];
+  }
+}
+
+// Max over the rows at the given positions of a window, keeping the position
+// of the maximum. A NaN is always taken, matching the NCHW kernels. The
+// vectorized loop tracks positions as scalar_t, so it is only used when every
+// position is exactly representable.
+template <typename scalar_t>
+inline void max_row(
+    scalar_t* out,
+    int64_t* ind,
+    const scalar_t* in, // [H, W, C] of one image
+    int64_t C,
+    int64_t IW,
+    int64_t h_begin,
+    int64_t h_end,
+    int64_t h_step,
+    int64_t w_begin,
+    int64_t w_end,
+    int64_t w_step,
+    scalar_t init_val,
+    int64_t init_ind,
+    bool vectorize) {
+  using Vec = vec::Vectorized<scalar_t>;
+  int64_t c = 0;
+  if (vectorize) {
+    scalar_t ind_buf[Vec::size()];
+    for (; c + Vec::size() <= C; c += Vec::size()) {
+      Vec max_val(init_val);
+      Vec max_ind(static_cast<scalar_t>(init_ind));
+      for (int64_t ih = h_begin; ih < h_end; ih += h_step) {
+        for (int64_t iw = w_begin; iw < w_end; iw += w_step) {
+          const Vec val = Vec::loadu(in + (ih * IW + iw) * C + c);
+          const Vec pos(static_cast<scalar_t>(ih * IW + iw));
+          const Vec greater = val > max_val;
+          max_val = Vec::blendv(max_val, val, greater);
+          max_ind = Vec::blendv(max_ind, pos, greater);
+          // Not `val != val`: the ordered AVX comparison is false for NaN.
+          const Vec not_nan = val == val;
+          max_val = Vec::blendv(val, max_val, not_nan);
+          max_ind = Vec::blendv(pos, max_ind, not_nan);
+        }
+      }
+      max_val.store(out + c);
+      max_ind.store(ind_buf);
+      for (int64_t i = 0; i < Vec::size(); ++i) {
+        ind[c + i] = static_cast<int64_t>(ind_buf[i]);
+      }
+    }
+  }
+  std::fill(out + c, out + C, init_val);
+  std::fill(ind + c, ind + C, init_ind);
+  for (int64_t ih = h_begin; ih < h_end; ih += h_step) {
+    for (int64_t iw = w_begin; iw < w_end; iw += w_step) {
+      const scalar_t* in_row = in + (ih * IW + iw) * C;
+      for (int64_t k = c; k < C; ++k) {
+        const scalar_t val = in_row[k];
+        if ((val > out[k]) || std::isnan(val)) {
+          out[k] = val;
+          ind[k] = ih * IW + iw;
+        }
+      }
+    }
+  }
+}
+
+template <typename scalar_t>
+inline bool positions_fit(int64_t IH, int64_t IW) {
+  return IH * IW <= (int64_t(1) << std::numeric_limits<scalar_t>::digits);
+}
+
+void max_pool2d_channels_last_kernel(
+    Tensor& output,
+    Tensor& indices,
+    const Tensor& input,
+    int kW, int kH, int dW, int dH, int padW, int padH,
+    int dilationW, int dilationH) {
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  const int64_t IH = input.size(2);
+  const int64_t IW = input.size(3);
+  const int64_t OH = output.size(2);
+  const int64_t OW = output.size(3);
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "max_pool2d_channels_last", [&] {
+    const scalar_t* input_data = input.data_ptr<scalar_t>();
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+    int64_t* indices_data = indices.data_ptr<int64_t>();
+    const bool vectorize = positions_fit<scalar_t>(IH, IW);
+
+    at::parallel_for(0, N * OH * OW, 0, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        const int64_t n = i / (OH * OW);
+        const int64_t oh = (i / OW) % OH;
+        const int64_t ow = i % OW;
+
+        int64_t hstart = oh * dH - padH;
+        int64_t wstart = ow * dW - padW;
+        const int64_t hend = std::min(hstart + (kH - 1) * dilationH + 1, IH);
+        const int64_t wend = std::min(wstart + (kW - 1) * dilationW + 1, IW);
+        while (hstart < 0)
+          hstart += dilationH;
+        while (wstart < 0)
+          wstart += dilationW;
+
+        max_row(
+            output_data + i * C,
+            indices_data + i * C,
+            input_data + n * IH * IW * C,
+            C, IW,
+            hstart, hend, dilationH,
+            wstart, wend, dilationW,
+            -std::numeric_limits<scalar_t>::infinity(),
+            hstart * IW + wstart,
+            vectorize);
+      }
+    });
+  });
+}
+
+void avg_pool2d_channels_last_kernel(
+    Tensor& output,
+    const Tensor& input,
+    int kW, int kH, int dW, int dH, int padW, int padH,
+    bool count_include_pad,
+    c10::optional<int64_t> divisor_override) {
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  const int64_t IH = input.size(2);
+  const int64_t IW = input.size(3);
+  const int64_t OH = output.size(2);
+  const int64_t OW = output.size(3);
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "avg_pool2d_channels_last", [&] {
+    using Vec = vec::Vectorized<scalar_t>;
+    const scalar_t* input_data = input.data_ptr<scalar_t>();
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+
+    at::parallel_for(0, N * OH * OW, 0, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        const int64_t n = i / (OH * OW);
+        const int64_t oh = (i / OW) % OH;
+        const int64_t ow = i % OW;
+
+        int64_t hstart = oh * dH - padH;
+        int64_t wstart = ow * dW - padW;
+        int64_t hend = std::min(hstart + kH, IH + padH);
+        int64_t wend = std::min(wstart + kW, IW + padW);
+        const int64_t pool_size = (hend - hstart) * (wend - wstart);
+        hstart = std::max(hstart, (int64_t) 0);
+        wstart = std::max(wstart, (int64_t) 0);
+        hend = std::min(hend, IH);
+        wend = std::min(wend, IW);
+
+        int64_t divide_factor;
+        if (divisor_override.has_value()) {
+          divide_factor = divisor_override.value();
+        } else if (count_include_pad) {
+          divide_factor = pool_size;
+        } else {
+          divide_factor = (hend - hstart) * (wend - wstart);
+        }
+
+        scalar_t* out = output_data + i * C;
+        std::fill(out, out + C, scalar_t(0));
+        for (int64_t ih = hstart; ih < hend; ++ih) {
+          for (int64_t iw = wstart; iw < wend; ++iw) {
+            add_row(out, input_data + ((n * IH + ih) * IW + iw) * C, C);
+          }
+        }
+
+        const scalar_t divisor = static_cast<scalar_t>(divide_factor);
+        int64_t c = 0;
+        for (; c + Vec::size() <= C; c += Vec::size()) {
+          (Vec::loadu(out + c) / Vec(divisor)).store(out + c);
+        }
+        for (; c < C; ++c) {
+          out[c] = out[c] / divisor;
+        }
+      }
+    });
+  });
+}
+
+void adaptive_avg_pool2d_channels_last_kernel(
+    Tensor& output,
+    const Tensor& input) {
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  const int64_t IH = input.size(2);
+  const int64_t IW = input.size(3);
+  const int64_t OH = output.size(2);
+  const int64_t OW = output.size(3);
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "adaptive_avg_pool2d_channels_last", [&] {
+    using Vec = vec::Vectorized<scalar_t>;
+    const scalar_t* input_data = input.data_ptr<scalar_t>();
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+
+    at::parallel_for(0, N * OH * OW, 0, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        const int64_t n = i / (OH * OW);
+        const int64_t oh = (i / OW) % OH;
+        const int64_t ow = i % OW;
+
+        const int64_t ih0 = start_index(oh, OH, IH);
+        const int64_t ih1 = end_index(oh, OH, IH);
+        const int64_t iw0 = start_index(ow, OW, IW);
+        const int64_t iw1 = end_index(ow, OW, IW);
+
+        scalar_t* out = output_data + i * C;
+        std::fill(out, out + C, scalar_t(0));
+        for (int64_t ih = ih0; ih < ih1; ++ih) {
+          for (int64_t iw = iw0; iw < iw1; ++iw) {
+            add_row(out, input_data + ((n * IH + ih) * IW + iw) * C, C);
+          }
+        }
+
+        const scalar_t kH = static_cast<scalar_t>(ih1 - ih0);
+        const scalar_t kW = static_cast<scalar_t>(iw1 - iw0);
+        int64_t c = 0;
+        for (; c + Vec::size() <= C; c += Vec::size()) {
+          (Vec::loadu(out + c) / Vec(kW) / Vec(kH)).store(out + c);
+        }
+        for (; c < C; ++c) {
+          out[c] = out[c] / kW / kH;
+        }
+      }
+    });
+  });
+}
+
+void adaptive_max_pool2d_channels_last_kernel(
+    Tensor& output,
+    Tensor& indices,
+    const Tensor& input) {
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  const int64_t IH = input.size(2);
+  const int64_t IW = input.size(3);
+  const int64_t OH = output.size(2);
+  const int64_t OW = output.size(3);
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "adaptive_max_pool2d_channels_last", [&] {
+    const scalar_t* input_data = input.data_ptr<scalar_t>();
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+    int64_t* indices_data = indices.data_ptr<int64_t>();
+    const bool vectorize = positions_fit<scalar_t>(IH, IW);
+
+    at::parallel_for(0, N * OH * OW, 0, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        const int64_t n = i / (OH * OW);
+        const int64_t oh = (i / OW) % OH;
+        const int64_t ow = i % OW;
+
+        max_row(
+            output_data + i * C,
+            indices_data + i * C,
+            input_data + n * IH * IW * C,
+            C, IW,
+            start_index(oh, OH, IH), end_index(oh, OH, IH), 1,
+            start_index(ow, OW, IW), end_index(ow, OW, IW), 1,
+            static_cast<scalar_t>(-std::numeric_limits<float>::max()),
+            -1,
+            vectorize);
+      }
+    });
+  });
+}
+
+} // namespace
+
+ALSO_REGISTER_AVX512_DISPATCH(max_pool2d_channels_last_stub, &max_pool2d_channels_last_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(avg_pool2d_channels_last_stub, &avg_pool2d_channels_last_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(adaptive_avg_pool2d_channels_last_stub, &adaptive_avg_pool2d_channels_last_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(adaptive_max_pool2d_channels_last_stub, &adaptive_max_pool2d_channels_last_kernel);
+
+} // namespace native
+} // namespace at
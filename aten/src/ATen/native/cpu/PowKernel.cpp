@@ -4,6 +4,7 @@
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/Pow.h>
+#include <ATen/native/cpu/CostHints.h>
 #include <ATen/native/cpu/Loops.h>
 
 namespace at { namespace native {
@@ -20,7 +21,8 @@ void pow_tensor_tensor_kernel(TensorIterator& iter) {
         },
         [&](Vec base, Vec exp) -> Vec {
           return base.pow(exp);
-        }
+        },
+        at::internal::grain_size_for_cost(kPowCost)
       );
     });
   } else {
@@ -87,7 +89,8 @@ void pow_tensor_scalar_kernel(TensorIterator& iter, Scalar exp_scalar) {
           [=](scalar_t base) -> scalar_t {
             return std::pow(base, exp);
           },
-          [=](Vec base) -> Vec { return base.pow(exp); }
+          [=](Vec base) -> Vec { return base.pow(exp); },
+          at::internal::grain_size_for_cost(kPowCost)
         );
       }
     });
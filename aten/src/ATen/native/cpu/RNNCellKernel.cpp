@@ -0,0 +1,344 @@
+#include <ATen/native/RNN.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vectorized.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// The fused cells below compute every gate of one batch row in a single pass
+// over the hidden dimension. The workspace layouts match the CUDA kernels in
+// native/cuda/RNN.cu, so the same backward formulas (and derivatives.yaml
+// entries) apply on both devices:
+//
+//   LSTM: [B, 4H] holding the activated gates (i, f, g, o)
+//   GRU:  [B, 5H] holding (r, z, n, hx, hn + b_hn)
+
+template <typename T>
+inline vec::Vectorized<T> load(const T* ptr, int64_t count) {
+  using Vec = vec::Vectorized<T>;
+  return count == Vec::size() ? Vec::loadu(ptr) : Vec::loadu(ptr, count);
+}
+
+template <typename T>
+inline vec::Vectorized<T> load_or_zero(const T* ptr, int64_t count) {
+  return ptr == nullptr ? vec::Vectorized<T>(T(0)) : load(ptr, count);
+}
+
+template <typename T>
+inline void store(T* ptr, const vec::Vectorized<T>& x, int64_t count) {
+  using Vec = vec::Vectorized<T>;
+  if (count == Vec::size()) {
+    x.store(ptr);
+  } else {
+    x.store(ptr, count);
+  }
+}
+
+template <typename Vec>
+inline Vec sigmoid(const Vec& x) {
+  using T = typename Vec::value_type;
+  return (Vec(T(1)) + (Vec(T(0)) - x).exp()).reciprocal();
+}
+
+// Rows are independent, so small batches (the common batch-1 inference case)
+// run on the calling thread instead of paying for a parallel region per step.
+inline int64_t row_grain_size(int64_t row_size) {
+  return std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(1, row_size));
+}
+
+template <typename T>
+const T* data_or_null(const Tensor& t) {
+  return t.defined() ? t.data_ptr<T>() : nullptr;
+}
+
+template <typename T>
+void LSTMCellKernelImplInternal(
+    Tensor& hy,
+    Tensor& cy,
+    Tensor& workspace,
+    const Tensor& input_gates,
+    const Tensor& hidden_gates,
+    const Tensor& input_bias,
+    const Tensor& hidden_bias,
+    const Tensor& cx) {
+  using Vec = vec::Vectorized<T>;
+  const int64_t B = cx.size(0);
+  const int64_t H = cx.size(1);
+  const T* ig_data = input_gates.data_ptr<T>();
+  const T* hg_data = hidden_gates.data_ptr<T>();
+  const T* cx_data = cx.data_ptr<T>();
+  T* hy_data = hy.data_ptr<T>();
+  T* cy_data = cy.data_ptr<T>();
+  T* ws_data = workspace.data_ptr<T>();
+
+  // Both biases are broadcast over the batch, so sum them once.
+  std::vector<T> bias;
+  if (input_bias.defined()) {
+    const T* b_ih = input_bias.data_ptr<T>();
+    const T* b_hh = hidden_bias.data_ptr<T>();
+    bias.resize(4 * H);
+    for (int64_t d = 0; d < 4 * H; ++d) {
+      bias[d] = b_ih[d] + b_hh[d];
+    }
+  }
+  const T* bias_data = bias.empty() ? nullptr : bias.data();
+
+  at::parallel_for(0, B, row_grain_size(4 * H), [&](int64_t start, int64_t end) {
+    for (int64_t b = start; b < end; ++b) {
+      const T* ig = ig_data + b * 4 * H;
+      const T* hg = hg_data + b * 4 * H;
+      const T* c_prev = cx_data + b * H;
+      T* ws = ws_data + b * 4 * H;
+      T* h_out = hy_data + b * H;
+      T* c_out = cy_data + b * H;
+      for (int64_t d = 0; d < H; d += Vec::size()) {
+        const int64_t n = std::min<int64_t>(Vec::size(), H - d);
+        Vec i = load(ig + d, n) + load(hg + d, n);
+        Vec f = load(ig + H + d, n) + load(hg + H + d, n);
+        Vec g = load(ig + 2 * H + d, n) + load(hg + 2 * H + d, n);
+        Vec o = load(ig + 3 * H + d, n) + load(hg + 3 * H + d, n);
+        if (bias_data != nullptr) {
+          i = i + load(bias_data + d, n);
+          f = f + load(bias_data + H + d, n);
+          g = g + load(bias_data + 2 * H + d, n);
+          o = o + load(bias_data + 3 * H + d, n);
+        }
+        i = sigmoid(i);
+        f = sigmoid(f);
+        g = g.tanh();
+        o = sigmoid(o);
+        const Vec c = vec::fmadd(f, load(c_prev + d, n), i * g);
+        store(ws + d, i, n);
+        store(ws + H + d, f, n);
+        store(ws + 2 * H + d, g, n);
+        store(ws + 3 * H + d, o, n);
+        store(c_out + d, c, n);
+        store(h_out + d, o * c.tanh(), n);
+      }
+    }
+  });
+}
+
+template <typename T>
+void LSTMCellBackwardKernelImplInternal(
+    Tensor& grad_gates,
+    Tensor& grad_cx,
+    const Tensor& grad_hy,
+    const Tensor& grad_cy,
+    const Tensor& cx,
+    const Tensor& cy,
+    const Tensor& workspace) {
+  using Vec = vec::Vectorized<T>;
+  const int64_t B = cx.size(0);
+  const int64_t H = cx.size(1);
+  const T* ghy_data = data_or_null<T>(grad_hy);
+  const T* gcy_data = data_or_null<T>(grad_cy);
+  const T* cx_data = cx.data_ptr<T>();
+  const T* cy_data = cy.data_ptr<T>();
+  const T* ws_data = workspace.data_ptr<T>();
+  T* gg_data = grad_gates.data_ptr<T>();
+  T* gcx_data = grad_cx.data_ptr<T>();
+  const Vec one(T(1));
+
+  at::parallel_for(0, B, row_grain_size(4 * H), [&](int64_t start, int64_t end) {
+    for (int64_t b = start; b < end; ++b) {
+      const T* ghy = ghy_data == nullptr ? nullptr : ghy_data + b * H;
+      const T* gcy = gcy_data == nullptr ? nullptr : gcy_data + b * H;
+      const T* c_prev = cx_data + b * H;
+      const T* c_next = cy_data + b * H;
+      const T* ws = ws_data + b * 4 * H;
+      T* gg = gg_data + b * 4 * H;
+      T* gcx = gcx_data + b * H;
+      for (int64_t d = 0; d < H; d += Vec::size()) {
+        const int64_t n = std::min<int64_t>(Vec::size(), H - d);
+        const Vec i = load(ws + d, n);
+        const Vec f = load(ws + H + d, n);
+        const Vec g = load(ws + 2 * H + d, n);
+        const Vec o = load(ws + 3 * H + d, n);
+        const Vec go = load_or_zero(ghy == nullptr ? nullptr : ghy + d, n);
+        const Vec goc = load_or_zero(gcy == nullptr ? nullptr : gcy + d, n);
+        const Vec tanh_cy = load(c_next + d, n).tanh();
+        const Vec gc = vec::fmadd(go * o, one - tanh_cy * tanh_cy, goc);
+        store(gg + d, gc * g * (one - i) * i, n);
+        store(gg + H + d, gc * load(c_prev + d, n) * (one - f) * f, n);
+        store(gg + 2 * H + d, gc * i * (one - g * g), n);
+        store(gg + 3 * H + d, go * tanh_cy * (one - o) * o, n);
+        store(gcx + d, gc * f, n);
+      }
+    }
+  });
+}
+
+template <typename T>
+void GRUCellKernelImplInternal(
+    Tensor& hy,
+    Tensor& workspace,
+    const Tensor& input_gates,
+    const Tensor& hidden_gates,
+    const Tensor& input_bias,
+    const Tensor& hidden_bias,
+    const Tensor& hx) {
+  using Vec = vec::Vectorized<T>;
+  const int64_t B = hx.size(0);
+  const int64_t H = hx.size(1);
+  const T* ig_data = input_gates.data_ptr<T>();
+  const T* hg_data = hidden_gates.data_ptr<T>();
+  const T* hx_data = hx.data_ptr<T>();
+  const T* b_ih = data_or_null<T>(input_bias);
+  const T* b_hh = data_or_null<T>(hidden_bias);
+  T* hy_data = hy.data_ptr<T>();
+  T* ws_data = workspace.data_ptr<T>();
+
+  at::parallel_for(0, B, row_grain_size(5 * H), [&](int64_t start, int64_t end) {
+    for (int64_t b = start; b < end; ++b) {
+      const T* ig = ig_data + b * 3 * H;
+      const T* hg = hg_data + b * 3 * H;
+      const T* h_prev = hx_data + b * H;
+      T* ws = ws_data + b * 5 * H;
+      T* h_out = hy_data + b * H;
+      for (int64_t d = 0; d < H; d += Vec::size()) {
+        const int64_t n = std::min<int64_t>(Vec::size(), H - d);
+        Vec r = load(ig + d, n) + load(hg + d, n);
+        Vec z = load(ig + H + d, n) + load(hg + H + d, n);
+        Vec in = load(ig + 2 * H + d, n);
+        Vec hn = load(hg + 2 * H + d, n);
+        if (b_ih != nullptr) {
+          r = r + load(b_ih + d, n) + load(b_hh + d, n);
+          z = z + load(b_ih + H + d, n) + load(b_hh + H + d, n);
+          in = in + load(b_ih + 2 * H + d, n);
+          hn = hn + load(b_hh + 2 * H + d, n);
+        }
+        r = sigmoid(r);
+        z = sigmoid(z);
+        const Vec ng = vec::fmadd(r, hn, in).tanh();
+        const Vec h = load(h_prev + d, n);
+        store(ws + d, r, n);
+        store(ws + H + d, z, n);
+        store(ws + 2 * H + d, ng, n);
+        store(ws + 3 * H + d, h, n);
+        store(ws + 4 * H + d, hn, n);
+        store(h_out + d, vec::fmadd(z, h - ng, ng), n);
+      }
+    }
+  });
+}
+
+template <typename T>
+void GRUCellBackwardKernelImplInternal(
+    Tensor& grad_input_gates,
+    Tensor& grad_hidden_gates,
+    Tensor& grad_hx,
+    const Tensor& grad_hy,
+    const Tensor& workspace) {
+  using Vec = vec::Vectorized<T>;
+  const int64_t B = grad_hy.size(0);
+  const int64_t H = grad_hy.size(1);
+  const T* ghy_data = grad_hy.data_ptr<T>();
+  const T* ws_data = workspace.data_ptr<T>();
+  T* gig_data = grad_input_gates.data_ptr<T>();
+  T* ghg_data = grad_hidden_gates.data_ptr<T>();
+  T* ghx_data = grad_hx.data_ptr<T>();
+  const Vec one(T(1));
+
+  at::parallel_for(0, B, row_grain_size(5 * H), [&](int64_t start, int64_t end) {
+    for (int64_t b = start; b < end; ++b) {
+      const T* ghy = ghy_data + b * H;
+      const T* ws = ws_data + b * 5 * H;
+      T* gig = gig_data + b * 3 * H;
+      T* ghg = ghg_data + b * 3 * H;
+      T* ghx = ghx_data + b * H;
+      for (int64_t d = 0; d < H; d += Vec::size()) {
+        const int64_t n = std::min<int64_t>(Vec::size(), H - d);
+        const Vec r = load(ws + d, n);
+        const Vec z = load(ws + H + d, n);
+        const Vec ng = load(ws + 2 * H + d, n);
+        const Vec h = load(ws + 3 * H + d, n);
+        const Vec hn = load(ws + 4 * H + d, n);
+        const Vec go = load(ghy + d, n);
+        const Vec gz = go * (h - ng) * (one - z) * z;
+        const Vec gn = go * (one - z) * (one - ng * ng);
+        const Vec gr = gn * hn * (one - r) * r;
+        store(gig + d, gr, n);
+        store(gig + H + d, gz, n);
+        store(gig + 2 * H + d, gn, n);
+        store(ghg + d, gr, n);
+        store(ghg + H + d, gz, n);
+        store(ghg + 2 * H + d, gn * r, n);
+        store(ghx + d, go * z, n);
+      }
+    }
+  });
+}
+
+void LSTMCellKernelImpl(
+    Tensor& hy,
+    Tensor& cy,
+    Tensor& workspace,
+    const Tensor& input_gates,
+    const Tensor& hidden_gates,
+    const Tensor& input_bias,
+    const Tensor& hidden_bias,
+    const Tensor& cx) {
+  AT_DISPATCH_FLOATING_TYPES(input_gates.scalar_type(), "LSTMCellKernelImpl", [&]() {
+    LSTMCellKernelImplInternal<scalar_t>(
+        hy, cy, workspace, input_gates, hidden_gates, input_bias, hidden_bias, cx);
+  });
+}
+
+void LSTMCellBackwardKernelImpl(
+    Tensor& grad_gates,
+    Tensor& grad_cx,
+    const Tensor& grad_hy,
+    const Tensor& grad_cy,
+    const Tensor& cx,
+    const Tensor& cy,
+    const Tensor& workspace) {
+  AT_DISPATCH_FLOATING_TYPES(workspace.scalar_type(), "LSTMCellBackwardKernelImpl", [&]() {
+    LSTMCellBackwardKernelImplInternal<scalar_t>(
+        grad_gates, grad_cx, grad_hy, grad_cy, cx, cy, workspace);
+  });
+}
+
+void GRUCellKernelImpl(
+    Tensor& hy,
+    Tensor& workspace,
+    const Tensor& input_gates,
+    const Tensor& hidden_gates,
+    const Tensor& input_bias,
+    const Tensor& hidden_bias,
+    const Tensor& hx) {
+  AT_DISPATCH_FLOATING_TYPES(input_gates.scalar_type(), "GRUCellKernelImpl", [&]() {
+    GRUCellKernelImplInternal<scalar_t>(
+        hy, workspace, input_gates, hidden_gates, input_bias, hidden_bias, hx);
+  });
+}
+
+void GRUCellBackwardKernelImpl(
+    Tensor& grad_input_gates,
+    Tensor& grad_hidden_gates,
+    Tensor& grad_hx,
+    const Tensor& grad_hy,
+    const Tensor& workspace) {
+  AT_DISPATCH_FLOATING_TYPES(workspace.scalar_type(), "GRUCellBackwardKernelImpl", [&]() {
+    GRUCellBackwardKernelImplInternal<scalar_t>(
+        grad_input_gates, grad_hidden_gates, grad_hx, grad_hy, workspace);
+  });
+}
+
+} // namespace
+
+ALSO_REGISTER_AVX512_DISPATCH(lstm_cell_stub, &LSTMCellKernelImpl);
+ALSO_REGISTER_AVX512_DISPATCH(lstm_cell_backward_stub, &LSTMCellBackwardKernelImpl);
+ALSO_REGISTER_AVX512_DISPATCH(gru_cell_stub, &GRUCellKernelImpl);
+ALSO_REGISTER_AVX512_DISPATCH(gru_cell_backward_stub, &GRUCellBackwardKernelImpl);
+
+} // namespace native
+} // namespace at
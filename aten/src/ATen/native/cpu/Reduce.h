@@ -10,9 +10,11 @@ namespace at { namespace native { namespace {
 
 using namespace vec256;
 
-#define VEC_LOOP_HEADER(func_t, data) \
+// Vec is deduced from the vectorized op so that kernels written against
+// at::vec::Vectorized reduce with Vec512 when compiled for AVX512.
+#define VEC_LOOP_HEADER(func_t, vec_func_t, data) \
   using scalar_t = typename function_traits<func_t>::result_type; \
-  using Vec = Vec256<scalar_t>; \
+  using Vec = typename function_traits<vec_func_t>::result_type; \
   char* out_ptr = data[0]; \
   (void) out_ptr;
 
@@ -33,7 +35,7 @@ static inline bool is_outer_reduction(const int64_t* strides) {
 
 template <typename func_t, typename vec_func_t>
 static inline void reduction128(char** data, int64_t n, int64_t stride, func_t op, vec_func_t vop, bool reduce) {
-  VEC_LOOP_HEADER(func_t, data)
+  VEC_LOOP_HEADER(func_t, vec_func_t, data)
   const char* in1_ptr = data[1];
   Vec acc[4];
   for  (int j = 0; j < 4; j++) {
@@ -76,7 +78,7 @@ static inline void UNARY_OUTER_LOOP(char* data[2], const int64_t strides[2], int
 // computes the reduction out = op(out, in)
 template <typename func_t, typename vec_func_t>
 static inline void vectorized_inner_reduction(char** data, int64_t n, func_t op, vec_func_t vop) {
-  VEC_LOOP_HEADER(func_t, data)
+  VEC_LOOP_HEADER(func_t, vec_func_t, data)
   int64_t vector_stride = 4 * Vec::size() * sizeof(scalar_t);
   int64_t count = n / (4 * Vec::size());
   if (count > 0) {
@@ -90,10 +92,12 @@ static inline void vectorized_inner_reduction(char** data, int64_t n, func_t op,
 // computes the reduction out = op(out, in)
 template <typename func_t, typename vec_func_t>
 static inline void vectorized_outer_reduction(char** data, int64_t inner_stride, int64_t size0, int64_t size1, func_t op, vec_func_t vop) {
-  VEC_LOOP_HEADER(func_t, data)
+  VEC_LOOP_HEADER(func_t, vec_func_t, data)
 
-  // reduce down each column of 4 * Vec::size() elements (128 bytes)
-  int64_t outer_stride[2] = { 128, 128 };
+  // reduce down each column of 4 * Vec::size() elements (128 bytes, or 256
+  // bytes with Vec512)
+  constexpr int64_t column_bytes = 4 * Vec::size() * sizeof(scalar_t);
+  int64_t outer_stride[2] = { column_bytes, column_bytes };
   UNARY_OUTER_LOOP(data, outer_stride, size1 / (4 * Vec::size()), [&] {
     reduction128(data, size0, inner_stride, op, vop, /*reduce=*/false);
   });
@@ -218,26 +222,31 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
     };
     acc_t total_acc = init;
     auto numel = sub_iter.numel();
-    if (numel < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
-        at::in_parallel_region()) {
+    if (numel < at::internal::GRAIN_SIZE) {
       total_acc = reduction_body(total_acc, 0, numel);
     } else {
-      int max_threads = at::get_num_threads();
-      AT_ASSERT(max_threads > 0);
+      // Accumulate fixed-size blocks separately and combine them pairwise in
+      // a fixed order, so the result does not depend on the number of threads.
+      int64_t num_blocks = divup(numel, internal::GRAIN_SIZE);
       static_assert(
         !std::is_same<acc_t, bool>::value,
         "Concurrently modifying different references into std::vector<bool> is UB."
       );
-      std::vector<acc_t> buffer((unsigned)max_threads, init);
-      at::parallel_for(0, numel, internal::GRAIN_SIZE,
-        [&](int64_t begin, int64_t end) {
-          auto& acc = buffer[at::get_thread_num()];
-          acc = reduction_body(acc, begin, end);
+      std::vector<acc_t> buffer((unsigned)num_blocks, init);
+      at::parallel_for(0, num_blocks, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t block = begin; block < end; ++block) {
+          buffer[block] = reduction_body(
+              buffer[block],
+              block * internal::GRAIN_SIZE,
+              std::min(numel, (block + 1) * internal::GRAIN_SIZE));
+        }
+      });
+      for (int64_t step = 1; step < num_blocks; step *= 2) {
+        for (int64_t i = 0; i + step < num_blocks; i += 2 * step) {
+          buffer[i] = ops.combine(buffer[i], buffer[i + step]);
         }
-      );
-      for (int i = 0; i < max_threads; ++i) {
-        total_acc = ops.combine(total_acc, buffer[i]);
       }
+      total_acc = ops.combine(total_acc, buffer[0]);
     }
     set_results<r_traits>(ops.project(total_acc), sub_iter, num_outputs);
   });
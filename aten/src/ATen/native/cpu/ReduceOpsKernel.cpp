@@ -5,6 +5,7 @@
 
 #include <ATen/Dispatch.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <ATen/cpu/vectorized.h>
 #include <ATen/native/ReduceOps.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/SharedReduceOps.h>
@@ -15,12 +16,108 @@ namespace at { namespace native { namespace {
 
 using namespace vec256;
 
+// Reduces a bfloat16 input into a float output. Sums and products lose most
+// of their precision when they accumulate in bfloat16, so ReduceOps.cpp
+// reduces bfloat16 tensors into a float result and rounds it once. Each
+// element is widened as it is loaded; the input is never copied to float.
+template <typename func_t, typename vec_func_t>
+static void bfloat16_reduce_in_float(TensorIterator& iter, func_t op, vec_func_t vop, float ident) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  iter.output().fill_(ident);
+  auto loop = [&](char** data, const int64_t* strides, int64_t size0, int64_t size1) {
+    auto load = [](const char* ptr, fVec& lo, fVec& hi) {
+      bVec::loadu(ptr).to_fp32(lo, hi);
+    };
+    if (strides[0] == 0 && strides[1] == sizeof(BFloat16)) {
+      // input is contiguous in dim 0, output is reduced in dim 0
+      for (int64_t j = 0; j < size1; j++) {
+        const char* in = data[1] + j * strides[3];
+        float* out = reinterpret_cast<float*>(data[0] + j * strides[2]);
+        fVec acc_lo(ident), acc_hi(ident);
+        int64_t i = 0;
+        for (; i + bVec::size() <= size0; i += bVec::size()) {
+          fVec lo, hi;
+          load(in + i * sizeof(BFloat16), lo, hi);
+          acc_lo = vop(acc_lo, lo);
+          acc_hi = vop(acc_hi, hi);
+        }
+        float buffer[fVec::size()];
+        vop(acc_lo, acc_hi).store(buffer);
+        float acc = *out;
+        for (int k = 0; k < fVec::size(); k++) {
+          acc = op(acc, buffer[k]);
+        }
+        for (; i < size0; i++) {
+          acc = op(acc, static_cast<float>(reinterpret_cast<const BFloat16*>(in)[i]));
+        }
+        *out = acc;
+      }
+    } else if (strides[0] == 0 && strides[2] == sizeof(float) && strides[3] == sizeof(BFloat16)) {
+      // input and output are contiguous in dim 1; reduce down columns of
+      // bVec::size() elements
+      int64_t j = 0;
+      for (; j + bVec::size() <= size1; j += bVec::size()) {
+        float* out = reinterpret_cast<float*>(data[0]) + j;
+        fVec acc_lo = fVec::loadu(out);
+        fVec acc_hi = fVec::loadu(out + fVec::size());
+        for (int64_t i = 0; i < size0; i++) {
+          fVec lo, hi;
+          load(data[1] + i * strides[1] + j * sizeof(BFloat16), lo, hi);
+          acc_lo = vop(acc_lo, lo);
+          acc_hi = vop(acc_hi, hi);
+        }
+        acc_lo.store(out);
+        acc_hi.store(out + fVec::size());
+      }
+      for (; j < size1; j++) {
+        float* out = reinterpret_cast<float*>(data[0]) + j;
+        for (int64_t i = 0; i < size0; i++) {
+          *out = op(*out, static_cast<float>(
+              *reinterpret_cast<const BFloat16*>(data[1] + i * strides[1] + j * sizeof(BFloat16))));
+        }
+      }
+    } else {
+      for (int64_t j = 0; j < size1; j++) {
+        for (int64_t i = 0; i < size0; i++) {
+          auto out = reinterpret_cast<float*>(data[0] + i * strides[0] + j * strides[2]);
+          auto in = reinterpret_cast<const BFloat16*>(data[1] + i * strides[1] + j * strides[3]);
+          *out = op(*out, static_cast<float>(*in));
+        }
+      }
+    }
+  };
+  // Full reductions of large inputs reduce blocks into float partial results
+  // and then reduce those, which `loop` cannot read.
+  auto combine = [&](char** data, const int64_t* strides, int64_t size0, int64_t size1) {
+    for (int64_t j = 0; j < size1; j++) {
+      for (int64_t i = 0; i < size0; i++) {
+        auto out = reinterpret_cast<float*>(data[0] + i * strides[0] + j * strides[2]);
+        auto in = reinterpret_cast<const float*>(data[1] + i * strides[1] + j * strides[3]);
+        *out = op(*out, *in);
+      }
+    }
+  };
+  iter.parallel_reduce(loop, combine);
+}
+
+static bool is_bfloat16_to_float(const TensorIterator& iter) {
+  return iter.dtype(0) == kFloat && iter.dtype(1) == kBFloat16;
+}
+
 static void sum_kernel_impl(TensorIterator& iter) {
+  if (is_bfloat16_to_float(iter)) {
+    bfloat16_reduce_in_float(
+        iter, [=](float a, float b) -> float { return a + b; },
+        [=](Vec256<float> a, Vec256<float> b) { return a + b; },
+        /*ident=*/0);
+    return;
+  }
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(
       ScalarType::BFloat16, ScalarType::Bool, iter.dtype(), "sum_cpu", [&] {
         binary_kernel_reduce_vec(
             iter, [=](scalar_t a, scalar_t b) -> scalar_t { return a + b; },
-            [=](Vec256<scalar_t> a, Vec256<scalar_t> b) { return a + b; });
+            [=](vec::Vectorized<scalar_t> a, vec::Vectorized<scalar_t> b) { return a + b; });
       });
 }
 
@@ -46,6 +143,13 @@ static void std_var_kernel_impl(TensorIterator &iter, bool unbiased, bool take_s
 }
 
 static void prod_kernel_impl(TensorIterator& iter) {
+  if (is_bfloat16_to_float(iter)) {
+    bfloat16_reduce_in_float(
+        iter, [=](float a, float b) -> float { return a * b; },
+        [=](Vec256<float> a, Vec256<float> b) { return a * b; },
+        /*ident=*/1);
+    return;
+  }
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX(iter.dtype(), "prod_cpu", [&] {
     binary_kernel_reduce_vec(
       iter,
@@ -201,7 +305,7 @@ static void argmin_kernel_impl(TensorIterator &iter) {
 
 }  // anonymous namespace
 
-REGISTER_DISPATCH(sum_stub, &sum_kernel_impl);
+ALSO_REGISTER_AVX512_DISPATCH(sum_stub, &sum_kernel_impl);
 REGISTER_DISPATCH(std_var_stub, &std_var_kernel_impl);
 REGISTER_DISPATCH(prod_stub, &prod_kernel_impl);
 REGISTER_DISPATCH(mean_stub, &mean_kernel_impl);
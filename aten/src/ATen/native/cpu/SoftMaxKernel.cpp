@@ -2,12 +2,14 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <numeric>
 
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <ATen/cpu/vectorized.h>
 #include <c10/util/Optional.h>
 
 // [Note AVX-SSE transitions] In general we avoid calls into cmath for code
@@ -28,7 +30,7 @@ inline void _vec_log_softmax_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
-  using Vec = vec256::Vec256<scalar_t>;
+  using Vec = vec::Vectorized<scalar_t>;
   static constexpr int64_t CHUNK_SIZE = (128 / sizeof(scalar_t)) * Vec::size();
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size * CHUNK_SIZE);
   if (grain_size < CHUNK_SIZE)
@@ -48,8 +50,8 @@ inline void _vec_log_softmax_lastdim(
           for (int64_t j = 0; j < loop_end; j++) {
             int64_t i = ii + j;
             scalar_t* input_data = input_data_base + i * dim_size;
-            max_input_arr[j] = vec256::reduce_all<scalar_t>(
-                [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+            max_input_arr[j] = vec::reduce_all<scalar_t>(
+                [](Vec& x, Vec& y) { return vec::maximum(x, y); },
                 input_data,
                 dim_size);
           }
@@ -57,7 +59,7 @@ inline void _vec_log_softmax_lastdim(
             int64_t i = ii + j;
             scalar_t* input_data = input_data_base + i * dim_size;
             scalar_t max_input = max_input_arr[j];
-            tmp_sum_scalar[j] = vec256::map_reduce_all<scalar_t>(
+            tmp_sum_scalar[j] = vec::map_reduce_all<scalar_t>(
                 [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
                 [](Vec x, Vec y) { return x + y; },
                 input_data,
@@ -65,7 +67,7 @@ inline void _vec_log_softmax_lastdim(
           }
           // See [Note AVX-SSE transitions] for why this should call the
           // vectorized version (aside from perf improvements).
-          vec256::map(
+          vec::map(
               [](Vec x) { return x.log(); },
               tmp_sum_scalar,
               tmp_sum_scalar,
@@ -82,7 +84,7 @@ inline void _vec_log_softmax_lastdim(
             // is small, if we compute `max_input` plus `tmp_sum` before,
             // there would be a numerical problem. See an example in
             // https://github.com/pytorch/pytorch/issues/11752#issuecomment-422883379
-            vec256::map(
+            vec::map(
                 [tmp_sum, max_input](Vec x) { return x - Vec(max_input) - Vec(tmp_sum); },
                 output_data,
                 input_data,
@@ -98,7 +100,7 @@ inline void _vec_softmax_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
-  using Vec = vec256::Vec256<scalar_t>;
+  using Vec = vec::Vectorized<scalar_t>;
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
   if (grain_size < 1)
     grain_size = 1;
@@ -111,19 +113,19 @@ inline void _vec_softmax_lastdim(
         for (int64_t i = begin; i < end; i++) {
           scalar_t* input_data = input_data_base + i * dim_size;
           scalar_t* output_data = output_data_base + i * dim_size;
-          scalar_t max_input = vec256::reduce_all<scalar_t>(
-              [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+          scalar_t max_input = vec::reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return vec::maximum(x, y); },
               input_data,
               dim_size);
-          vec256::map(
+          vec::map(
               [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
               output_data,
               input_data,
               dim_size);
-          scalar_t tmp_sum = vec256::reduce_all<scalar_t>(
+          scalar_t tmp_sum = vec::reduce_all<scalar_t>(
               [](Vec x, Vec y) { return x + y; }, output_data, dim_size);
           tmp_sum = 1 / tmp_sum;
-          vec256::map(
+          vec::map(
               [tmp_sum](Vec x) { return x * Vec(tmp_sum); },
               output_data,
               output_data,
@@ -139,7 +141,7 @@ inline void _vec_host_softmax_backward_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
-  using Vec = vec256::Vec256<scalar_t>;
+  using Vec = vec::Vectorized<scalar_t>;
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
   if (grain_size < 1)
     grain_size = 1;
@@ -155,10 +157,10 @@ inline void _vec_host_softmax_backward_lastdim(
           scalar_t* output_data = output_data_base + i * dim_size;
           scalar_t sum;
           if (log_softmax) {
-            sum = vec256::reduce_all<scalar_t>(
+            sum = vec::reduce_all<scalar_t>(
                 [](Vec& x, Vec& y) { return x + y; }, grad_data, dim_size);
           } else {
-            sum = vec256::map2_reduce_all<scalar_t>(
+            sum = vec::map2_reduce_all<scalar_t>(
                 [](Vec x, Vec y) { return x * y; },
                 [](Vec x, Vec y) { return x + y; },
                 grad_data,
@@ -166,14 +168,14 @@ inline void _vec_host_softmax_backward_lastdim(
                 dim_size);
           }
           if (log_softmax) {
-            vec256::map2(
+            vec::map2(
                 [sum](Vec x, Vec y) { return x - ((y.exp()) * Vec(sum)); },
                 grad_input_data,
                 grad_data,
                 output_data,
                 dim_size);
           } else {
-            vec256::map2(
+            vec::map2(
                 [sum](Vec x, Vec y) { return (x - Vec(sum)) * y; },
                 grad_input_data,
                 grad_data,
@@ -223,10 +225,138 @@ struct vec_host_softmax_backward_lastdim {
   }
 };
 
+// BFloat16 keeps only 8 bits of mantissa, so rounding the running max, the
+// exponentials and in particular the sum back to bf16 after every vector op
+// loses most of the precision of long rows. The specializations below widen
+// each row into a float buffer once, do all the work in float and round once
+// when writing the result.
+template <bool LogSoftMax>
+struct vec_host_softmax_lastdim<BFloat16, LogSoftMax> {
+  static void apply(Tensor& output, const Tensor& input) {
+    using fVec = vec::Vectorized<float>;
+    int64_t outer_size = 1;
+    int64_t dim_size = input.size(input.ndimension() - 1);
+    for (int64_t i = 0; i < input.ndimension() - 1; ++i)
+      outer_size *= input.size(i);
+    BFloat16* input_data_base = input.data_ptr<BFloat16>();
+    BFloat16* output_data_base = output.data_ptr<BFloat16>();
+    int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+    if (grain_size < 1)
+      grain_size = 1;
+
+    parallel_for(
+        0,
+        outer_size,
+        grain_size,
+        [&](int64_t begin, int64_t end) {
+          std::unique_ptr<float[]> buffer(new float[dim_size]);
+          float* buffer_data = buffer.get();
+          for (int64_t i = begin; i < end; i++) {
+            BFloat16* input_data = input_data_base + i * dim_size;
+            BFloat16* output_data = output_data_base + i * dim_size;
+            vec256::convert(input_data, buffer_data, dim_size);
+            float max_input = vec::reduce_all<float>(
+                [](fVec& x, fVec& y) { return vec::maximum(x, y); },
+                buffer_data,
+                dim_size);
+            if (LogSoftMax) {
+              float tmp_sum = vec::map_reduce_all<float>(
+                  [max_input](fVec x) { return (x - fVec(max_input)).exp(); },
+                  [](fVec x, fVec y) { return x + y; },
+                  buffer_data,
+                  dim_size);
+              // See [Note AVX-SSE transitions].
+              vec::map([](fVec x) { return x.log(); }, &tmp_sum, &tmp_sum, 1);
+              vec::map(
+                  [tmp_sum, max_input](fVec x) {
+                    return x - fVec(max_input) - fVec(tmp_sum);
+                  },
+                  buffer_data,
+                  buffer_data,
+                  dim_size);
+            } else {
+              vec::map(
+                  [max_input](fVec x) { return (x - fVec(max_input)).exp(); },
+                  buffer_data,
+                  buffer_data,
+                  dim_size);
+              float tmp_sum = vec::reduce_all<float>(
+                  [](fVec x, fVec y) { return x + y; }, buffer_data, dim_size);
+              tmp_sum = 1 / tmp_sum;
+              vec::map(
+                  [tmp_sum](fVec x) { return x * fVec(tmp_sum); },
+                  buffer_data,
+                  buffer_data,
+                  dim_size);
+            }
+            vec256::convert(buffer_data, output_data, dim_size);
+          }
+        });
+  }
+};
+
+template <bool LogSoftMax>
+struct vec_host_softmax_backward_lastdim<BFloat16, LogSoftMax> {
+  static void
+  apply(Tensor& grad_input, const Tensor& grad, const Tensor& output) {
+    using fVec = vec::Vectorized<float>;
+    int64_t outer_size = 1;
+    int64_t dim_size = grad.size(grad.ndimension() - 1);
+    for (int64_t i = 0; i < grad.ndimension() - 1; ++i)
+      outer_size *= grad.size(i);
+    BFloat16* grad_input_data_base = grad_input.data_ptr<BFloat16>();
+    BFloat16* grad_data_base = grad.data_ptr<BFloat16>();
+    BFloat16* output_data_base = output.data_ptr<BFloat16>();
+    int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+    if (grain_size < 1)
+      grain_size = 1;
+
+    parallel_for(
+        0,
+        outer_size,
+        grain_size,
+        [&](int64_t begin, int64_t end) {
+          std::unique_ptr<float[]> buffer(new float[2 * dim_size]);
+          float* grad_buffer = buffer.get();
+          float* output_buffer = buffer.get() + dim_size;
+          for (int64_t i = begin; i < end; i++) {
+            vec256::convert(grad_data_base + i * dim_size, grad_buffer, dim_size);
+            vec256::convert(output_data_base + i * dim_size, output_buffer, dim_size);
+            float sum;
+            if (LogSoftMax) {
+              sum = vec::reduce_all<float>(
+                  [](fVec& x, fVec& y) { return x + y; }, grad_buffer, dim_size);
+              vec::map2(
+                  [sum](fVec x, fVec y) { return x - ((y.exp()) * fVec(sum)); },
+                  grad_buffer,
+                  grad_buffer,
+                  output_buffer,
+                  dim_size);
+            } else {
+              sum = vec::map2_reduce_all<float>(
+                  [](fVec x, fVec y) { return x * y; },
+                  [](fVec x, fVec y) { return x + y; },
+                  grad_buffer,
+                  output_buffer,
+                  dim_size);
+              vec::map2(
+                  [sum](fVec x, fVec y) { return (x - fVec(sum)) * y; },
+                  grad_buffer,
+                  grad_buffer,
+                  output_buffer,
+                  dim_size);
+            }
+            vec256::convert(grad_buffer, grad_input_data_base + i * dim_size, dim_size);
+          }
+        });
+  }
+};
+
 static void softmax_lastdim_kernel_impl(Tensor& result, const Tensor& self) {
-  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "softmax_lastdim_kernel_impl", [&] {
-    vec_host_softmax_lastdim<scalar_t, false>::apply(result, self);
-  });
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, self.scalar_type(),
+      "softmax_lastdim_kernel_impl",
+      [&] { vec_host_softmax_lastdim<scalar_t, false>::apply(result, self); });
 }
 
 static void log_softmax_lastdim_kernel_impl(
@@ -242,8 +372,9 @@ static void softmax_backward_lastdim_kernel_impl(
     Tensor& grad_input,
     const Tensor& grad,
     const Tensor& output) {
-  AT_DISPATCH_FLOATING_TYPES(
-      grad.scalar_type(), "softmax_backward_lastdim_kernel_impl", [&] {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, grad.scalar_type(),
+      "softmax_backward_lastdim_kernel_impl", [&] {
         vec_host_softmax_backward_lastdim<scalar_t, false>::apply(
             grad_input, grad, output);
       });
@@ -263,12 +394,12 @@ static void log_softmax_backward_lastdim_kernel_impl(
 
 } // anonymous namespace
 
-REGISTER_DISPATCH(softmax_lastdim_kernel, &softmax_lastdim_kernel_impl);
-REGISTER_DISPATCH(log_softmax_lastdim_kernel, &log_softmax_lastdim_kernel_impl);
-REGISTER_DISPATCH(
+ALSO_REGISTER_AVX512_DISPATCH(softmax_lastdim_kernel, &softmax_lastdim_kernel_impl);
+ALSO_REGISTER_AVX512_DISPATCH(log_softmax_lastdim_kernel, &log_softmax_lastdim_kernel_impl);
+ALSO_REGISTER_AVX512_DISPATCH(
     softmax_backward_lastdim_kernel,
     &softmax_backward_lastdim_kernel_impl);
-REGISTER_DISPATCH(
+ALSO_REGISTER_AVX512_DISPATCH(
     log_softmax_backward_lastdim_kernel,
     &log_softmax_backward_lastdim_kernel_impl);
 
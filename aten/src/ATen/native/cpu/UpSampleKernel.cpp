@@ -0,0 +1,143 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vectorized.h>
+#include <ATen/native/UpSample.h>
+
+#include <algorithm>
+
+/*
+  Channels last (NHWC) upsampling. Each output pixel is a row of C contiguous
+  values interpolated from whole input rows, so the inner loops are copies or
+  vectorized blends over channels.
+*/
+
+namespace at {
+namespace native {
+namespace {
+
+void upsample_nearest2d_channels_last_kernel(
+    Tensor& output,
+    const Tensor& input,
+    double scales_h,
+    double scales_w) {
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  const int64_t IH = input.size(2);
+  const int64_t IW = input.size(3);
+  const int64_t OH = output.size(2);
+  const int64_t OW = output.size(3);
+
+  const float height_scale = compute_scales_value<float>(scales_h, IH, OH);
+  const float width_scale = compute_scales_value<float>(scales_w, IW, OW);
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "upsample_nearest2d_channels_last", [&] {
+    const scalar_t* input_data = input.data_ptr<scalar_t>();
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+
+    at::parallel_for(0, N * OH, 0, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        const int64_t n = i / OH;
+        const int64_t oh = i % OH;
+        const int64_t ih = (IH == OH)
+            ? oh
+            : nearest_neighbor_compute_source_index(height_scale, oh, IH);
+        const scalar_t* in = input_data + (n * IH + ih) * IW * C;
+        scalar_t* out = output_data + i * OW * C;
+        for (int64_t ow = 0; ow < OW; ++ow) {
+          const int64_t iw = (IW == OW)
+              ? ow
+              : nearest_neighbor_compute_source_index(width_scale, ow, IW);
+          std::copy(in + iw * C, in + (iw + 1) * C, out + ow * C);
+        }
+      }
+    });
+  });
+}
+
+void upsample_bilinear2d_channels_last_kernel(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    double scales_h,
+    double scales_w) {
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  const int64_t IH = input.size(2);
+  const int64_t IW = input.size(3);
+  const int64_t OH = output.size(2);
+  const int64_t OW = output.size(3);
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "upsample_bilinear2d_channels_last", [&] {
+    using Vec = vec::Vectorized<scalar_t>;
+    const scalar_t* input_data = input.data_ptr<scalar_t>();
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+
+    // special case: just copy
+    if (IH == OH && IW == OW) {
+      at::parallel_for(0, N * OH * OW, at::internal::GRAIN_SIZE / std::max<int64_t>(C, 1),
+          [&](int64_t start, int64_t end) {
+        std::copy(input_data + start * C, input_data + end * C, output_data + start * C);
+      });
+      return;
+    }
+
+    const scalar_t rheight = area_pixel_compute_scale<scalar_t>(
+        IH, OH, align_corners, scales_h);
+    const scalar_t rwidth = area_pixel_compute_scale<scalar_t>(
+        IW, OW, align_corners, scales_w);
+
+    at::parallel_for(0, N * OH, 0, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        const int64_t n = i / OH;
+        const int64_t oh = i % OH;
+
+        const scalar_t h1r = area_pixel_compute_source_index<scalar_t>(
+            rheight, oh, align_corners, /*cubic=*/false);
+        const int64_t h1 = h1r;
+        const int64_t h1p = (h1 < IH - 1) ? 1 : 0;
+        const scalar_t h1lambda = h1r - h1;
+        const scalar_t h0lambda = static_cast<scalar_t>(1.) - h1lambda;
+
+        const scalar_t* in_top = input_data + (n * IH + h1) * IW * C;
+        const scalar_t* in_bottom = in_top + h1p * IW * C;
+        scalar_t* out_row = output_data + i * OW * C;
+
+        for (int64_t ow = 0; ow < OW; ++ow) {
+          const scalar_t w1r = area_pixel_compute_source_index<scalar_t>(
+              rwidth, ow, align_corners, /*cubic=*/false);
+          const int64_t w1 = w1r;
+          const int64_t w1p = (w1 < IW - 1) ? 1 : 0;
+          const scalar_t w1lambda = w1r - w1;
+          const scalar_t w0lambda = static_cast<scalar_t>(1.) - w1lambda;
+
+          const scalar_t* p00 = in_top + w1 * C;
+          const scalar_t* p01 = p00 + w1p * C;
+          const scalar_t* p10 = in_bottom + w1 * C;
+          const scalar_t* p11 = p10 + w1p * C;
+          scalar_t* out = out_row + ow * C;
+
+          const Vec h0(h0lambda), h1v(h1lambda), w0(w0lambda), w1v(w1lambda);
+          int64_t c = 0;
+          for (; c + Vec::size() <= C; c += Vec::size()) {
+            const Vec top = w0 * Vec::loadu(p00 + c) + w1v * Vec::loadu(p01 + c);
+            const Vec bottom = w0 * Vec::loadu(p10 + c) + w1v * Vec::loadu(p11 + c);
+            (h0 * top + h1v * bottom).store(out + c);
+          }
+          for (; c < C; ++c) {
+            out[c] = h0lambda * (w0lambda * p00[c] + w1lambda * p01[c]) +
+                h1lambda * (w0lambda * p10[c] + w1lambda * p11[c]);
+          }
+        }
+      }
+    });
+  });
+}
+
+} // namespace
+
+ALSO_REGISTER_AVX512_DISPATCH(upsample_nearest2d_channels_last_stub, &upsample_nearest2d_channels_last_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(upsample_bilinear2d_channels_last_stub, &upsample_bilinear2d_channels_last_kernel);
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,244 @@
+#include <ATen/native/cpu/Conv2dKernel.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+
+namespace at {
+namespace native {
+namespace {
+
+// Winograd F(m x m, 3 x 3): each m x m output tile is computed from an
+// alpha x alpha input tile (alpha = m + 2) as
+//
+//   Y = A^T [(G g G^T) .* (B^T d B)] A
+//
+// The element-wise product summed over input channels is alpha^2 independent
+// [K x C] x [C x tiles] matrix products, done with one bmm per image. The
+// transformed input of an image is (alpha / m)^2 times its size, i.e. 4x for
+// F(2x2, 3x3) and 2.25x for F(4x4, 3x3), instead of the 9x of im2col.
+template <int64_t m>
+struct WinogradF3;
+
+template <>
+struct WinogradF3<2> {
+  static constexpr int64_t alpha = 4;
+  static constexpr float BT[4][4] = {
+      {1, 0, -1, 0},
+      {0, 1, 1, 0},
+      {0, -1, 1, 0},
+      {0, 1, 0, -1}};
+  static constexpr float G[4][3] = {
+      {1, 0, 0},
+      {0.5f, 0.5f, 0.5f},
+      {0.5f, -0.5f, 0.5f},
+      {0, 0, 1}};
+  static constexpr float AT[2][4] = {{1, 1, 1, 0}, {0, 1, -1, -1}};
+};
+
+template <>
+struct WinogradF3<4> {
+  static constexpr int64_t alpha = 6;
+  static constexpr float BT[6][6] = {
+      {4, 0, -5, 0, 1, 0},
+      {0, -4, -4, 1, 1, 0},
+      {0, 4, -4, -1, 1, 0},
+      {0, -2, -1, 2, 1, 0},
+      {0, 2, -1, -2, 1, 0},
+      {0, 4, 0, -5, 0, 1}};
+  static constexpr float G[6][3] = {
+      {1.0f / 4, 0, 0},
+      {-1.0f / 6, -1.0f / 6, -1.0f / 6},
+      {-1.0f / 6, 1.0f / 6, -1.0f / 6},
+      {1.0f / 24, 1.0f / 12, 1.0f / 6},
+      {1.0f / 24, -1.0f / 12, 1.0f / 6},
+      {0, 0, 1}};
+  static constexpr float AT[4][6] = {
+      {1, 1, 1, 1, 1, 0},
+      {0, 1, -1, 2, -2, 0},
+      {0, 1, 1, 4, 4, 0},
+      {0, 1, -1, 8, -8, 1}};
+};
+
+constexpr float WinogradF3<2>::BT[4][4];
+constexpr float WinogradF3<2>::G[4][3];
+constexpr float WinogradF3<2>::AT[2][4];
+constexpr float WinogradF3<4>::BT[6][6];
+constexpr float WinogradF3<4>::G[6][3];
+constexpr float WinogradF3<4>::AT[4][6];
+
+// out = L * in * L^T, where L is [P x Q] and in is [Q x Q].
+template <int64_t P, int64_t Q>
+inline void sandwich(
+    const float (&L)[P][Q],
+    const float* in,
+    float* out) {
+  float tmp[P][Q];
+  for (int64_t i = 0; i < P; ++i) {
+    for (int64_t j = 0; j < Q; ++j) {
+      float sum = 0;
+      for (int64_t k = 0; k < Q; ++k) {
+        sum += L[i][k] * in[k * Q + j];
+      }
+      tmp[i][j] = sum;
+    }
+  }
+  for (int64_t i = 0; i < P; ++i) {
+    for (int64_t j = 0; j < P; ++j) {
+      float sum = 0;
+      for (int64_t k = 0; k < Q; ++k) {
+        sum += tmp[i][k] * L[j][k];
+      }
+      out[i * P + j] = sum;
+    }
+  }
+}
+
+template <int64_t m>
+Tensor winograd3x3_impl(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef padding) {
+  using F = WinogradF3<m>;
+  constexpr int64_t alpha = F::alpha;
+  constexpr int64_t alpha2 = alpha * alpha;
+
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  const int64_t H = input.size(2);
+  const int64_t W = input.size(3);
+  const int64_t K = weight.size(0);
+  const int64_t pad_h = padding[0];
+  const int64_t pad_w = padding[1];
+  const int64_t OH = H + 2 * pad_h - 2;
+  const int64_t OW = W + 2 * pad_w - 2;
+  const int64_t tiles_h = (OH + m - 1) / m;
+  const int64_t tiles_w = (OW + m - 1) / m;
+  const int64_t T = tiles_h * tiles_w;
+
+  Tensor output = at::empty({N, K, OH, OW}, input.options());
+  if (output.numel() == 0) {
+    return output;
+  }
+
+  // Weight transform: U[xi][k][c] = (G g[k][c] G^T)[xi]
+  Tensor U = at::empty({alpha2, K, C}, input.options());
+  const float* weight_data = weight.data_ptr<float>();
+  float* U_data = U.data_ptr<float>();
+  at::parallel_for(0, K * C, 64, [&](int64_t begin, int64_t end) {
+    float u[alpha2];
+    for (int64_t kc = begin; kc < end; ++kc) {
+      const float* g = weight_data + kc * 9;
+      float tmp[alpha][3];
+      for (int64_t i = 0; i < alpha; ++i) {
+        for (int64_t j = 0; j < 3; ++j) {
+          tmp[i][j] = F::G[i][0] * g[j] + F::G[i][1] * g[3 + j] +
+              F::G[i][2] * g[6 + j];
+        }
+      }
+      for (int64_t i = 0; i < alpha; ++i) {
+        for (int64_t j = 0; j < alpha; ++j) {
+          u[i * alpha + j] = tmp[i][0] * F::G[j][0] + tmp[i][1] * F::G[j][1] +
+              tmp[i][2] * F::G[j][2];
+        }
+      }
+      for (int64_t xi = 0; xi < alpha2; ++xi) {
+        U_data[xi * K * C + kc] = u[xi];
+      }
+    }
+  });
+
+  const Tensor bias_contig = bias.defined() ? bias.contiguous() : bias;
+  const float* bias_data =
+      bias_contig.defined() ? bias_contig.data_ptr<float>() : nullptr;
+  const float* input_data = input.data_ptr<float>();
+  float* output_data = output.data_ptr<float>();
+
+  // The transformed input and the products are reused across the batch.
+  Tensor V = at::empty({alpha2, C, T}, input.options());
+  Tensor M = at::empty({alpha2, K, T}, input.options());
+  float* V_data = V.data_ptr<float>();
+  const float* M_data = M.data_ptr<float>();
+
+  for (int64_t n = 0; n < N; ++n) {
+    // Input transform: V[xi][c][t] = (B^T d[c][t] B)[xi]
+    const float* in_n = input_data + n * C * H * W;
+    at::parallel_for(0, C * T, 16, [&](int64_t begin, int64_t end) {
+      float d[alpha2];
+      float v[alpha2];
+      for (int64_t ct = begin; ct < end; ++ct) {
+        const int64_t c = ct / T;
+        const int64_t t = ct % T;
+        const int64_t ih0 = (t / tiles_w) * m - pad_h;
+        const int64_t iw0 = (t % tiles_w) * m - pad_w;
+        const float* in_c = in_n + c * H * W;
+        for (int64_t i = 0; i < alpha; ++i) {
+          const int64_t ih = ih0 + i;
+          for (int64_t j = 0; j < alpha; ++j) {
+            const int64_t iw = iw0 + j;
+            d[i * alpha + j] = (ih >= 0 && ih < H && iw >= 0 && iw < W)
+                ? in_c[ih * W + iw]
+                : 0.0f;
+          }
+        }
+        sandwich(F::BT, d, v);
+        for (int64_t xi = 0; xi < alpha2; ++xi) {
+          V_data[(xi * C + c) * T + t] = v[xi];
+        }
+      }
+    });
+
+    at::bmm_out(M, U, V);
+
+    // Output transform: y = A^T M[k][t] A, plus bias
+    float* out_n = output_data + n * K * OH * OW;
+    at::parallel_for(0, K * T, 16, [&](int64_t begin, int64_t end) {
+      float mt[alpha2];
+      float y[m * m];
+      for (int64_t kt = begin; kt < end; ++kt) {
+        const int64_t k = kt / T;
+        const int64_t t = kt % T;
+        for (int64_t xi = 0; xi < alpha2; ++xi) {
+          mt[xi] = M_data[(xi * K + k) * T + t];
+        }
+        sandwich(F::AT, mt, y);
+        const float b = bias_data ? bias_data[k] : 0.0f;
+        const int64_t oh0 = (t / tiles_w) * m;
+        const int64_t ow0 = (t % tiles_w) * m;
+        float* out_k = out_n + k * OH * OW;
+        for (int64_t i = 0; i < m && oh0 + i < OH; ++i) {
+          for (int64_t j = 0; j < m && ow0 + j < OW; ++j) {
+            out_k[(oh0 + i) * OW + ow0 + j] = y[i * m + j] + b;
+          }
+        }
+      }
+    });
+  }
+  return output;
+}
+
+Tensor convolution_winograd3x3_kernel(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef padding) {
+  const int64_t OH = input.size(2) + 2 * padding[0] - 2;
+  const int64_t OW = input.size(3) + 2 * padding[1] - 2;
+  // F(4x4, 3x3) does fewer multiplications per output, but pads small
+  // outputs up to whole 4x4 tiles.
+  if (OH >= 8 && OW >= 8) {
+    return winograd3x3_impl<4>(input, weight, bias, padding);
+  }
+  return winograd3x3_impl<2>(input, weight, bias, padding);
+}
+
+} // namespace
+
+ALSO_REGISTER_AVX512_DISPATCH(
+    convolution_winograd3x3_stub,
+    &convolution_winograd3x3_kernel);
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,417 @@
+#include <ATen/native/group_norm.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vectorized.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Welford's online mean/variance. Every vector lane keeps its own running
+// (mean, m2); all lanes see the same number of elements, so they share one
+// count and the update vectorizes. Elements that do not fill a whole vector go
+// to a scalar accumulator, and the partial results are merged with Chan's
+// formula at the end.
+template <typename T>
+struct WelfordMoments {
+  using Vec = vec::Vectorized<T>;
+
+  Vec mean_vec = Vec(T(0));
+  Vec m2_vec = Vec(T(0));
+  int64_t vec_count = 0;
+  T mean = T(0);
+  T m2 = T(0);
+  int64_t count = 0;
+
+  void update(const T* X, int64_t size) {
+    int64_t d = 0;
+    for (; d + Vec::size() <= size; d += Vec::size()) {
+      ++vec_count;
+      const Vec x = Vec::loadu(X + d);
+      const Vec delta = x - mean_vec;
+      mean_vec = mean_vec + delta * Vec(T(1) / static_cast<T>(vec_count));
+      m2_vec = m2_vec + delta * (x - mean_vec);
+    }
+    for (; d < size; ++d) {
+      ++count;
+      const T delta = X[d] - mean;
+      mean += delta / static_cast<T>(count);
+      m2 += delta * (X[d] - mean);
+    }
+  }
+
+  // Returns the mean and the biased variance.
+  std::pair<T, T> finalize() const {
+    T lane_mean[Vec::size()];
+    T lane_m2[Vec::size()];
+    mean_vec.store(lane_mean);
+    m2_vec.store(lane_m2);
+    T total_mean = mean;
+    T total_m2 = m2;
+    int64_t total = count;
+    if (vec_count > 0) {
+      for (int64_t j = 0; j < Vec::size(); ++j) {
+        const int64_t n = total + vec_count;
+        const T delta = lane_mean[j] - total_mean;
+        const T ratio = static_cast<T>(vec_count) / static_cast<T>(n);
+        total_mean += delta * ratio;
+        total_m2 += lane_m2[j] + delta * delta * static_cast<T>(total) * ratio;
+        total = n;
+      }
+    }
+    const T var = total == 0 ? T(0) : total_m2 / static_cast<T>(total);
+    return std::make_pair(total_mean, std::max(var, T(0)));
+  }
+};
+
+// Y[d] = X[d] * scale[d] + bias[d] for d in [0, size).
+template <typename T>
+inline void ScaleShift(
+    const T* X,
+    const T* scale,
+    const T* bias,
+    int64_t size,
+    T* Y) {
+  using Vec = vec::Vectorized<T>;
+  int64_t d = 0;
+  for (; d + Vec::size() <= size; d += Vec::size()) {
+    const Vec x = Vec::loadu(X + d);
+    vec::fmadd(x, Vec::loadu(scale + d), Vec::loadu(bias + d)).store(Y + d);
+  }
+  if (d < size) {
+    const int64_t count = size - d;
+    const Vec x = Vec::loadu(X + d, count);
+    vec::fmadd(x, Vec::loadu(scale + d, count), Vec::loadu(bias + d, count))
+        .store(Y + d, count);
+  }
+}
+
+// X is either contiguous (N, C, HxW) or channels last (N, HxW, C). Each of the
+// N * G groups gets its statistics in one pass and is normalized and scaled in
+// a second one; gamma and beta are folded into a per-channel scale and bias.
+template <typename T>
+void GroupNormKernelImplInternal(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    T eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  using Vec = vec::Vectorized<T>;
+  DCHECK_EQ(X.numel(), N * C * HxW);
+  DCHECK(!gamma.defined() || gamma.numel() == C);
+  DCHECK(!beta.defined() || beta.numel() == C);
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const bool channels_last =
+      X.suggest_memory_format() == MemoryFormat::ChannelsLast;
+  const T* X_data = X.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* Y_data = Y->data_ptr<T>();
+  T* mean_data = mean->data_ptr<T>();
+  T* rstd_data = rstd->data_ptr<T>();
+  at::parallel_for(0, N * G, 1, [&](int64_t start, int64_t end) {
+    std::vector<T> buffer(2 * D);
+    T* scale = buffer.data();
+    T* bias = buffer.data() + D;
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / G;
+      const int64_t g = i % G;
+      WelfordMoments<T> moments;
+      if (channels_last) {
+        const T* X_ptr = X_data + n * HxW * C + g * D;
+        for (int64_t m = 0; m < HxW; ++m) {
+          moments.update(X_ptr + m * C, D);
+        }
+      } else {
+        moments.update(X_data + i * D * HxW, D * HxW);
+      }
+      const auto stats = moments.finalize();
+      const T mean_val = stats.first;
+      const T rstd_val = T(1) / std::sqrt(stats.second + eps);
+      for (int64_t d = 0; d < D; ++d) {
+        const int64_t c = g * D + d;
+        const T gamma_v = gamma_data == nullptr ? T(1) : gamma_data[c];
+        const T beta_v = beta_data == nullptr ? T(0) : beta_data[c];
+        scale[d] = rstd_val * gamma_v;
+        bias[d] = beta_v - scale[d] * mean_val;
+      }
+      if (channels_last) {
+        const T* X_ptr = X_data + n * HxW * C + g * D;
+        T* Y_ptr = Y_data + n * HxW * C + g * D;
+        for (int64_t m = 0; m < HxW; ++m) {
+          ScaleShift(X_ptr + m * C, scale, bias, D, Y_ptr + m * C);
+        }
+      } else {
+        for (int64_t d = 0; d < D; ++d) {
+          const T* X_ptr = X_data + (i * D + d) * HxW;
+          T* Y_ptr = Y_data + (i * D + d) * HxW;
+          const T scale_v = scale[d];
+          const T bias_v = bias[d];
+          vec::map(
+              [scale_v, bias_v](Vec x) {
+                return vec::fmadd(x, Vec(scale_v), Vec(bias_v));
+              },
+              Y_ptr,
+              X_ptr,
+              HxW);
+        }
+      }
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+}
+
+void GroupNormKernelImpl(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "GroupNormKernelImpl", [&]() {
+    GroupNormKernelImplInternal<scalar_t>(
+        X,
+        gamma,
+        beta,
+        N,
+        C,
+        HxW,
+        group,
+        static_cast<scalar_t>(eps),
+        Y,
+        mean,
+        rstd);
+  });
+}
+
+// ds[n, c] = sum(dY * X) and db[n, c] = sum(dY) over the HxW positions.
+template <typename T>
+void ComputeInternalGradients(
+    const T* dY_data,
+    const T* X_data,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    bool channels_last,
+    T* ds,
+    T* db) {
+  using Vec = vec::Vectorized<T>;
+  if (channels_last) {
+    at::parallel_for(0, N, 1, [&](int64_t start, int64_t end) {
+      for (int64_t n = start; n < end; ++n) {
+        T* ds_ptr = ds + n * C;
+        T* db_ptr = db + n * C;
+        std::fill(ds_ptr, ds_ptr + C, T(0));
+        std::fill(db_ptr, db_ptr + C, T(0));
+        for (int64_t m = 0; m < HxW; ++m) {
+          const T* dY_ptr = dY_data + (n * HxW + m) * C;
+          const T* X_ptr = X_data + (n * HxW + m) * C;
+          int64_t c = 0;
+          for (; c + Vec::size() <= C; c += Vec::size()) {
+            const Vec dy = Vec::loadu(dY_ptr + c);
+            vec::fmadd(dy, Vec::loadu(X_ptr + c), Vec::loadu(ds_ptr + c))
+                .store(ds_ptr + c);
+            (dy + Vec::loadu(db_ptr + c)).store(db_ptr + c);
+          }
+          for (; c < C; ++c) {
+            ds_ptr[c] += dY_ptr[c] * X_ptr[c];
+            db_ptr[c] += dY_ptr[c];
+          }
+        }
+      }
+    });
+  } else {
+    at::parallel_for(0, N * C, 1, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        const T* dY_ptr = dY_data + i * HxW;
+        const T* X_ptr = X_data + i * HxW;
+        ds[i] = vec::map2_reduce_all<T>(
+            [](Vec x, Vec y) { return x * y; },
+            [](Vec x, Vec y) { return x + y; },
+            dY_ptr,
+            X_ptr,
+            HxW);
+        db[i] = vec::reduce_all<T>(
+            [](Vec& x, Vec& y) { return x + y; },
+            const_cast<T*>(dY_ptr),
+            HxW);
+      }
+    });
+  }
+}
+
+template <typename T>
+void GroupNormBackwardKernelImplInternal(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    Tensor* dX,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  using Vec = vec::Vectorized<T>;
+  DCHECK_EQ(dY.numel(), N * C * HxW);
+  DCHECK_EQ(X.numel(), N * C * HxW);
+  DCHECK_EQ(mean.numel(), N * group);
+  DCHECK_EQ(rstd.numel(), N * group);
+  DCHECK(!gamma.defined() || gamma.numel() == C);
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const bool channels_last =
+      X.suggest_memory_format() == MemoryFormat::ChannelsLast;
+  const T* dY_data = dY.data_ptr<T>();
+  const T* X_data = X.data_ptr<T>();
+  const T* mean_data = mean.data_ptr<T>();
+  const T* rstd_data = rstd.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  T* dX_data = dX->defined() ? dX->data_ptr<T>() : nullptr;
+  T* dgamma_data = dgamma->defined() ? dgamma->data_ptr<T>() : nullptr;
+  T* dbeta_data = dbeta->defined() ? dbeta->data_ptr<T>() : nullptr;
+
+  std::vector<T> ds(N * C);
+  std::vector<T> db(N * C);
+  ComputeInternalGradients<T>(
+      dY_data, X_data, N, C, HxW, channels_last, ds.data(), db.data());
+
+  if (dX_data != nullptr) {
+    const T s = T(1) / static_cast<T>(D * HxW);
+    at::parallel_for(0, N * G, 1, [&](int64_t start, int64_t end) {
+      std::vector<T> buffer(2 * D);
+      T* scale = buffer.data();
+      T* bias = buffer.data() + D;
+      for (int64_t i = start; i < end; ++i) {
+        const int64_t n = i / G;
+        const int64_t g = i % G;
+        T ds_val = 0;
+        T db_val = 0;
+        for (int64_t d = 0; d < D; ++d) {
+          const int64_t c = g * D + d;
+          const T gamma_v = gamma_data == nullptr ? T(1) : gamma_data[c];
+          ds_val += ds[n * C + c] * gamma_v;
+          db_val += db[n * C + c] * gamma_v;
+        }
+        const T mean_val = mean_data[i];
+        const T rstd_val = rstd_data[i];
+        // dX = rstd * gamma * dY + b * X + c
+        const T b = (db_val * mean_val - ds_val) * rstd_val * rstd_val *
+            rstd_val * s;
+        const T c = -b * mean_val - db_val * rstd_val * s;
+        for (int64_t d = 0; d < D; ++d) {
+          const T gamma_v =
+              gamma_data == nullptr ? T(1) : gamma_data[g * D + d];
+          scale[d] = rstd_val * gamma_v;
+        }
+        if (channels_last) {
+          const Vec b_vec(b);
+          const Vec c_vec(c);
+          for (int64_t m = 0; m < HxW; ++m) {
+            const int64_t offset = (n * HxW + m) * C + g * D;
+            const T* dY_ptr = dY_data + offset;
+            const T* X_ptr = X_data + offset;
+            T* dX_ptr = dX_data + offset;
+            int64_t d = 0;
+            for (; d + Vec::size() <= D; d += Vec::size()) {
+              const Vec x = vec::fmadd(b_vec, Vec::loadu(X_ptr + d), c_vec);
+              vec::fmadd(Vec::loadu(scale + d), Vec::loadu(dY_ptr + d), x)
+                  .store(dX_ptr + d);
+            }
+            for (; d < D; ++d) {
+              dX_ptr[d] = scale[d] * dY_ptr[d] + b * X_ptr[d] + c;
+            }
+          }
+        } else {
+          for (int64_t d = 0; d < D; ++d) {
+            const int64_t offset = (i * D + d) * HxW;
+            const T a = scale[d];
+            vec::map2(
+                [a, b, c](Vec dy, Vec x) {
+                  return vec::fmadd(Vec(a), dy, vec::fmadd(Vec(b), x, Vec(c)));
+                },
+                dX_data + offset,
+                const_cast<T*>(dY_data + offset),
+                const_cast<T*>(X_data + offset),
+                HxW);
+          }
+        }
+      }
+    });
+  }
+
+  if (dgamma_data != nullptr || dbeta_data != nullptr) {
+    at::parallel_for(0, C, 1, [&](int64_t start, int64_t end) {
+      for (int64_t c = start; c < end; ++c) {
+        const int64_t g = c / D;
+        T dgamma_v = 0;
+        T dbeta_v = 0;
+        for (int64_t n = 0; n < N; ++n) {
+          const T mean_val = mean_data[n * G + g];
+          const T rstd_val = rstd_data[n * G + g];
+          dgamma_v += (ds[n * C + c] - db[n * C + c] * mean_val) * rstd_val;
+          dbeta_v += db[n * C + c];
+        }
+        if (dgamma_data != nullptr) {
+          dgamma_data[c] = dgamma_v;
+        }
+        if (dbeta_data != nullptr) {
+          dbeta_data[c] = dbeta_v;
+        }
+      }
+    });
+  }
+}
+
+void GroupNormBackwardKernelImpl(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    Tensor* dX,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  AT_DISPATCH_FLOATING_TYPES(
+      X.scalar_type(), "GroupNormBackwardKernelImpl", [&]() {
+        GroupNormBackwardKernelImplInternal<scalar_t>(
+            dY, X, mean, rstd, gamma, N, C, HxW, group, dX, dgamma, dbeta);
+      });
+}
+
+} // namespace
+
+ALSO_REGISTER_AVX512_DISPATCH(GroupNormKernel, &GroupNormKernelImpl);
+ALSO_REGISTER_AVX512_DISPATCH(
+    GroupNormBackwardKernel,
+    &GroupNormBackwardKernelImpl);
+
+} // namespace native
+} // namespace at
@@ -1,6 +1,7 @@
 #include <ATen/native/layer_norm.h>
 
 #include <cmath>
+#include <vector>
 
 #include <ATen/ATen.h>
 #include <ATen/CPUApplyUtils.h>
@@ -66,6 +67,66 @@ void LayerNormKernelImplInternal(
   });
 }
 
+// BFloat16 only keeps 8 bits of mantissa, so the row statistics are computed
+// on a float copy of each row and the output is rounded to bf16 once.
+template <>
+void LayerNormKernelImplInternal<BFloat16>(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    BFloat16 eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  using Vec = vec256::Vec256<float>;
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const BFloat16* X_data = X.data_ptr<BFloat16>();
+  BFloat16* Y_data = Y->data_ptr<BFloat16>();
+  BFloat16* mean_data = mean->data_ptr<BFloat16>();
+  BFloat16* rstd_data = rstd->data_ptr<BFloat16>();
+  std::vector<float> gamma_f(N, 1.0f);
+  std::vector<float> beta_f(N, 0.0f);
+  if (gamma.defined()) {
+    vec256::convert(gamma.data_ptr<BFloat16>(), gamma_f.data(), N);
+  }
+  if (beta.defined()) {
+    vec256::convert(beta.data_ptr<BFloat16>(), beta_f.data(), N);
+  }
+  const float c = 1.0f / static_cast<float>(N);
+  const float eps_f = static_cast<float>(eps);
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    std::vector<float> buffer(N);
+    float* X_ptr = buffer.data();
+    for (int64_t i = start; i < end; ++i) {
+      vec256::convert(X_data + i * N, X_ptr, N);
+      float mean_val = vec256::reduce_all<float>(
+          [](Vec& x, Vec& y) { return x + y; },
+          X_ptr,
+          N);
+      float rstd_val = vec256::map_reduce_all<float>(
+          [](Vec x) { return x * x; },
+          [](Vec x, Vec y) { return x + y; },
+          X_ptr,
+          N);
+      mean_val *= c;
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, 0.0f);
+      rstd_val = 1.0f / std::sqrt(rstd_val + eps_f);
+      const float scale = rstd_val;
+      const float bias = -rstd_val * mean_val;
+      for (int64_t j = 0; j < N; ++j) {
+        X_ptr[j] = (X_ptr[j] * scale + bias) * gamma_f[j] + beta_f[j];
+      }
+      vec256::convert(X_ptr, Y_data + i * N, N);
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+}
+
 void LayerNormKernelImpl(
     const Tensor& X,
     const Tensor& gamma,
@@ -76,10 +137,11 @@ void LayerNormKernelImpl(
     Tensor* Y,
     Tensor* mean,
     Tensor* rstd) {
-  AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "LayerNormKernelImpl", [&]() {
-    LayerNormKernelImplInternal<scalar_t>(
-        X, gamma, beta, M, N, static_cast<scalar_t>(eps), Y, mean, rstd);
-  });
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, X.scalar_type(), "LayerNormKernelImpl", [&]() {
+        LayerNormKernelImplInternal<scalar_t>(
+            X, gamma, beta, M, N, static_cast<scalar_t>(eps), Y, mean, rstd);
+      });
 }
 
 template <typename T>
@@ -151,6 +213,85 @@ void LayerNormBackwardKernelImplInternal(
   }
 }
 
+template <>
+void LayerNormBackwardKernelImplInternal<BFloat16>(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    Tensor* dX,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  DCHECK_EQ(dY.numel(), M * N);
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK_EQ(mean.numel(), M);
+  DCHECK_EQ(rstd.numel(), M);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  const BFloat16* dY_data = dY.data_ptr<BFloat16>();
+  const BFloat16* X_data = X.data_ptr<BFloat16>();
+  const BFloat16* mean_data = mean.data_ptr<BFloat16>();
+  const BFloat16* rstd_data = rstd.data_ptr<BFloat16>();
+  BFloat16* dX_data = dX->defined() ? dX->data_ptr<BFloat16>() : nullptr;
+  BFloat16* dgamma_data =
+      dgamma->defined() ? dgamma->data_ptr<BFloat16>() : nullptr;
+  BFloat16* dbeta_data =
+      dbeta->defined() ? dbeta->data_ptr<BFloat16>() : nullptr;
+  // dgamma and dbeta are sums over all M rows, so they are accumulated in
+  // float and rounded once at the end.
+  std::vector<float> gamma_f(N, 1.0f);
+  if (gamma.defined()) {
+    vec256::convert(gamma.data_ptr<BFloat16>(), gamma_f.data(), N);
+  }
+  std::vector<float> dgamma_f(dgamma_data != nullptr ? N : 0, 0.0f);
+  std::vector<float> dbeta_f(dbeta_data != nullptr ? N : 0, 0.0f);
+  std::vector<float> buffer(2 * N);
+  float* dY_ptr = buffer.data();
+  float* X_ptr = buffer.data() + N;
+  const float scale = 1.0f / static_cast<float>(N);
+  for (int64_t i = 0; i < M; ++i) {
+    vec256::convert(dY_data + i * N, dY_ptr, N);
+    vec256::convert(X_data + i * N, X_ptr, N);
+    const float mean_val = static_cast<float>(mean_data[i]);
+    const float rstd_val = static_cast<float>(rstd_data[i]);
+    if (dX_data != nullptr) {
+      float ds = 0;
+      float db = 0;
+      for (int64_t j = 0; j < N; ++j) {
+        ds += dY_ptr[j] * X_ptr[j] * gamma_f[j];
+        db += dY_ptr[j] * gamma_f[j];
+      }
+      const float a = rstd_val;
+      const float b = (db * mean_val - ds) * a * a * a * scale;
+      const float c = -b * mean_val - db * a * scale;
+      BFloat16* dX_ptr = dX_data + i * N;
+      for (int64_t j = 0; j < N; ++j) {
+        dX_ptr[j] = a * dY_ptr[j] * gamma_f[j] + b * X_ptr[j] + c;
+      }
+    }
+    if (dgamma_data != nullptr) {
+      const float a = rstd_val;
+      const float b = -a * mean_val;
+      for (int64_t j = 0; j < N; ++j) {
+        dgamma_f[j] += dY_ptr[j] * (a * X_ptr[j] + b);
+      }
+    }
+    if (dbeta_data != nullptr) {
+      for (int64_t j = 0; j < N; ++j) {
+        dbeta_f[j] += dY_ptr[j];
+      }
+    }
+  }
+  if (dgamma_data != nullptr) {
+    vec256::convert(dgamma_f.data(), dgamma_data, N);
+  }
+  if (dbeta_data != nullptr) {
+    vec256::convert(dbeta_f.data(), dbeta_data, N);
+  }
+}
+
 void LayerNormBackwardKernelImpl(
     const Tensor& dY,
     const Tensor& X,
@@ -162,8 +303,8 @@ void LayerNormBackwardKernelImpl(
     Tensor* dX,
     Tensor* dgamma,
     Tensor* dbeta) {
-  AT_DISPATCH_FLOATING_TYPES(
-      X.scalar_type(), "LayerNormBackwardKernelImpl", [&]() {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, X.scalar_type(), "LayerNormBackwardKernelImpl", [&]() {
         LayerNormBackwardKernelImplInternal<scalar_t>(
             dY, X, mean, rstd, gamma, M, N, dX, dgamma, dbeta);
       });
@@ -1,5 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vectorized.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/UpSample.h>
 #include <ATen/native/cpu/Loops.h>
@@ -154,7 +156,7 @@ void qrelu_kernel(const Tensor& qx, Tensor& qy) {
         qx.q_scale(),
         qx.q_zero_point(),
         qx.suggest_memory_format());
-    using Vec = Vec256<scalar_t>;
+    using Vec = vec::Vectorized<scalar_t>;
     auto zero_point_vec = Vec(scalar_t(zero_point));
     auto iter = TensorIterator::unary_op(qy, qx);
     cpu_kernel_vec(
@@ -175,7 +177,7 @@ void qrelu6_kernel(const Tensor& qx, Tensor& qy) {
         qx.q_scale(),
         qx.q_zero_point(),
         qx.suggest_memory_format());
-    using Vec = Vec256<scalar_t>;
+    using Vec = vec::Vectorized<scalar_t>;
     auto iter = TensorIterator::unary_op(qy, qx);
     scalar_t six =
         at::quantize_val<scalar_t>(qx.q_scale(), qx.q_zero_point(), 6.0);
@@ -846,10 +848,290 @@ void qtopk_kernel(Tensor& values,
   });
 }
 
+// Requantizes n floats from src into dst with the output scale and zero
+// point, 32 (or 8 for qint32) values per vector.
+template <typename scalar_t>
+void quantize_row(
+    const float* src,
+    typename scalar_t::underlying* dst,
+    int64_t n,
+    float scale,
+    int64_t zero_point,
+    float inv_scale) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t kVLen = Vec::size();
+  constexpr int64_t kFloatVLen = Vec256<float>::size();
+  int64_t i = 0;
+  for (; i + kVLen <= n; i += kVLen) {
+    typename Vec::float_vec_return_type float_vals;
+    for (int j = 0; j < Vec::float_num_vecs(); ++j) {
+      float_vals[j] = Vec256<float>::loadu(src + i + j * kFloatVLen);
+    }
+    Vec::quantize(float_vals, scale, zero_point, inv_scale).store(dst + i);
+  }
+  for (; i < n; ++i) {
+    dst[i] = at::quantize_val<scalar_t>(scale, zero_point, src[i]).val_;
+  }
+}
+
+// Computes y = x * a + b in place over n floats.
+inline void scale_shift_row(float* x, int64_t n, float a, float b) {
+  using fVec = Vec256<float>;
+  const fVec a_vec(a);
+  const fVec b_vec(b);
+  int64_t i = 0;
+  for (; i + fVec::size() <= n; i += fVec::size()) {
+    vec256::fmadd(fVec::loadu(x + i), a_vec, b_vec).store(x + i);
+  }
+  for (; i < n; ++i) {
+    x[i] = x[i] * a + b;
+  }
+}
+
+// Normalizes each of the M rows of N elements of X and applies the affine
+// transform, reading and writing quantized values directly. Each row is
+// dequantized once into a per-thread float buffer while its moments are
+// accumulated, then scaled in place and requantized with Y's qparams.
+//
+// gamma and beta are float tensors. For layer norm (affine_per_channel is
+// false) they hold N values, one per element of the row. For group norm a
+// row is one group of num_channels / num_groups channels, and gamma and beta
+// hold one value per channel.
+void qnormalize_kernel(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    bool affine_per_channel,
+    int64_t num_channels,
+    int64_t num_groups,
+    int64_t M,
+    int64_t N,
+    double eps,
+    Tensor* Y) {
+  AT_DISPATCH_QINT_TYPES(X.scalar_type(), "qnormalize", [&]() {
+    using Vec = Vec256<scalar_t>;
+    using fVec = Vec256<float>;
+    constexpr int64_t kVLen = Vec::size();
+    constexpr int64_t kFloatVLen = fVec::size();
+
+    const float x_scale = X.q_scale();
+    const int64_t x_zero_point = X.q_zero_point();
+    const float y_scale = Y->q_scale();
+    const int64_t y_zero_point = Y->q_zero_point();
+    const float y_inv_scale = 1.0f / y_scale;
+    const fVec x_scale_vec(x_scale);
+    const fVec x_zero_point_vec(static_cast<float>(x_zero_point));
+    const fVec x_scale_neg_zp_premul_vec = x_scale_vec * x_zero_point_vec.neg();
+
+    const underlying_t* X_data =
+        reinterpret_cast<const underlying_t*>(X.data_ptr());
+    underlying_t* Y_data = reinterpret_cast<underlying_t*>(Y->data_ptr());
+    const float* gamma_data = gamma.data_ptr<float>();
+    const float* beta_data = beta.data_ptr<float>();
+    const int64_t channels_per_group = num_channels / num_groups;
+    const int64_t inner_size = affine_per_channel ? N / channels_per_group : 0;
+
+    at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+      std::vector<float> buffer(N);
+      float* buf = buffer.data();
+      for (int64_t i = start; i < end; ++i) {
+        const underlying_t* X_ptr = X_data + i * N;
+
+        // Dequantize the row and accumulate sum and sum of squares.
+        fVec sum_vec(0.0f);
+        fVec sum_sq_vec(0.0f);
+        int64_t j = 0;
+        for (; j + kVLen <= N; j += kVLen) {
+          const auto float_vals = Vec::loadu(X_ptr + j).dequantize(
+              x_scale_vec, x_zero_point_vec, x_scale_neg_zp_premul_vec);
+          for (int k = 0; k < Vec::float_num_vecs(); ++k) {
+            float_vals[k].store(buf + j + k * kFloatVLen);
+            sum_vec = sum_vec + float_vals[k];
+            sum_sq_vec = vec256::fmadd(float_vals[k], float_vals[k], sum_sq_vec);
+          }
+        }
+        float sum_arr[kFloatVLen];
+        float sum_sq_arr[kFloatVLen];
+        sum_vec.store(sum_arr);
+        sum_sq_vec.store(sum_sq_arr);
+        double sum = 0;
+        double sum_sq = 0;
+        for (int64_t k = 0; k < kFloatVLen; ++k) {
+          sum += sum_arr[k];
+          sum_sq += sum_sq_arr[k];
+        }
+        for (; j < N; ++j) {
+          const float x = at::dequantize_val(
+              x_scale, x_zero_point, reinterpret_cast<const scalar_t*>(X_ptr)[j]);
+          buf[j] = x;
+          sum += x;
+          sum_sq += x * x;
+        }
+        const double mean = sum / N;
+        const double var = std::max(sum_sq / N - mean * mean, 0.0);
+        const float rstd = 1.0 / std::sqrt(var + eps);
+
+        // Normalize and apply the affine transform in place.
+        if (affine_per_channel) {
+          const int64_t g = i % num_groups;
+          for (int64_t c = 0; c < channels_per_group; ++c) {
+            const int64_t ch = g * channels_per_group + c;
+            const float a = rstd * gamma_data[ch];
+            const float b = beta_data[ch] - mean * a;
+            scale_shift_row(buf + c * inner_size, inner_size, a, b);
+          }
+        } else {
+          const fVec mean_vec(static_cast<float>(mean));
+          const fVec rstd_vec(rstd);
+          int64_t k = 0;
+          for (; k + kFloatVLen <= N; k += kFloatVLen) {
+            const fVec x = (fVec::loadu(buf + k) - mean_vec) * rstd_vec;
+            vec256::fmadd(
+                x, fVec::loadu(gamma_data + k), fVec::loadu(beta_data + k))
+                .store(buf + k);
+          }
+          for (; k < N; ++k) {
+            buf[k] = (buf[k] - mean) * rstd * gamma_data[k] + beta_data[k];
+          }
+        }
+
+        quantize_row<scalar_t>(
+            buf, Y_data + i * N, N, y_scale, y_zero_point, y_inv_scale);
+      }
+    });
+  });
+}
+
+// Softmax over the middle dimension of a contiguous [outer, dim, inner]
+// quantized tensor. Since x_i - max(x) only takes the values
+// scale * -(0..255) for 8-bit inputs, the exponentials come from a 256-entry
+// table instead of being evaluated per element.
+void qsoftmax_kernel(
+    const Tensor& qx,
+    int64_t outer_size,
+    int64_t dim_size,
+    int64_t inner_size,
+    Tensor& qy) {
+  AT_DISPATCH_QINT_TYPES(qx.scalar_type(), "qsoftmax", [&]() {
+    using Vec = Vec256<scalar_t>;
+    using fVec = Vec256<float>;
+    constexpr int64_t kVLen = Vec::size();
+    constexpr int64_t kTableSize =
+        static_cast<int64_t>(std::numeric_limits<underlying_t>::max()) -
+        std::numeric_limits<underlying_t>::min() + 1;
+    TORCH_CHECK(
+        kTableSize <= 256, "quantized::softmax only supports 8-bit inputs");
+
+    const float x_scale = qx.q_scale();
+    std::vector<float> exp_table(kTableSize);
+    for (int64_t d = 0; d < kTableSize; ++d) {
+      exp_table[d] = std::exp(-x_scale * d);
+    }
+    const float* table = exp_table.data();
+
+    const float y_scale = qy.q_scale();
+    const int64_t y_zero_point = qy.q_zero_point();
+    const float y_inv_scale = 1.0f / y_scale;
+    const underlying_t* X_data =
+        reinterpret_cast<const underlying_t*>(qx.data_ptr());
+    underlying_t* Y_data = reinterpret_cast<underlying_t*>(qy.data_ptr());
+
+    if (inner_size == 1) {
+      at::parallel_for(0, outer_size, 1, [&](int64_t start, int64_t end) {
+        std::vector<float> buffer(dim_size);
+        float* buf = buffer.data();
+        for (int64_t i = start; i < end; ++i) {
+          const underlying_t* X_ptr = X_data + i * dim_size;
+          underlying_t max_val = std::numeric_limits<underlying_t>::min();
+          int64_t j = 0;
+          if (dim_size >= kVLen) {
+            auto max_vec = Vec::loadu(X_ptr);
+            for (j = kVLen; j + kVLen <= dim_size; j += kVLen) {
+              max_vec = vec256::maximum(max_vec, Vec::loadu(X_ptr + j));
+            }
+            underlying_t max_arr[kVLen];
+            max_vec.store(max_arr);
+            max_val = *std::max_element(max_arr, max_arr + kVLen);
+          }
+          for (; j < dim_size; ++j) {
+            max_val = std::max(max_val, X_ptr[j]);
+          }
+
+          float sum = 0;
+          for (j = 0; j < dim_size; ++j) {
+            buf[j] = table[max_val - X_ptr[j]];
+            sum += buf[j];
+          }
+          const fVec inv_sum_vec(1.0f / sum);
+          for (j = 0; j + fVec::size() <= dim_size; j += fVec::size()) {
+            (fVec::loadu(buf + j) * inv_sum_vec).store(buf + j);
+          }
+          for (; j < dim_size; ++j) {
+            buf[j] /= sum;
+          }
+          quantize_row<scalar_t>(
+              buf,
+              Y_data + i * dim_size,
+              dim_size,
+              y_scale,
+              y_zero_point,
+              y_inv_scale);
+        }
+      });
+      return;
+    }
+
+    // Reduce across dim for a whole row of inner positions at a time so the
+    // accesses stay contiguous.
+    at::parallel_for(0, outer_size, 1, [&](int64_t start, int64_t end) {
+      std::vector<underlying_t> max_buf(inner_size);
+      std::vector<float> sum_buf(inner_size);
+      std::vector<float> out_buf(inner_size);
+      for (int64_t i = start; i < end; ++i) {
+        const underlying_t* X_ptr = X_data + i * dim_size * inner_size;
+        underlying_t* Y_ptr = Y_data + i * dim_size * inner_size;
+        std::fill(
+            max_buf.begin(),
+            max_buf.end(),
+            std::numeric_limits<underlying_t>::min());
+        std::fill(sum_buf.begin(), sum_buf.end(), 0.0f);
+        for (int64_t d = 0; d < dim_size; ++d) {
+          const underlying_t* x = X_ptr + d * inner_size;
+          for (int64_t k = 0; k < inner_size; ++k) {
+            max_buf[k] = std::max(max_buf[k], x[k]);
+          }
+        }
+        for (int64_t d = 0; d < dim_size; ++d) {
+          const underlying_t* x = X_ptr + d * inner_size;
+          for (int64_t k = 0; k < inner_size; ++k) {
+            sum_buf[k] += table[max_buf[k] - x[k]];
+          }
+        }
+        for (int64_t k = 0; k < inner_size; ++k) {
+          sum_buf[k] = 1.0f / sum_buf[k];
+        }
+        for (int64_t d = 0; d < dim_size; ++d) {
+          const underlying_t* x = X_ptr + d * inner_size;
+          for (int64_t k = 0; k < inner_size; ++k) {
+            out_buf[k] = table[max_buf[k] - x[k]] * sum_buf[k];
+          }
+          quantize_row<scalar_t>(
+              out_buf.data(),
+              Y_ptr + d * inner_size,
+              inner_size,
+              y_scale,
+              y_zero_point,
+              y_inv_scale);
+        }
+      }
+    });
+  });
+}
+
 } // namespace
 
-REGISTER_DISPATCH(qrelu_stub, &qrelu_kernel);
-REGISTER_DISPATCH(qrelu6_stub, &qrelu6_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(qrelu_stub, &qrelu_kernel);
+ALSO_REGISTER_AVX512_DISPATCH(qrelu6_stub, &qrelu6_kernel);
 REGISTER_DISPATCH(qclamp_stub, &qclamp_kernel);
 REGISTER_DISPATCH(qadd_relu_stub, &qadd_kernel<true>);
 REGISTER_DISPATCH(qadd_stub, &qadd_kernel<false>);
@@ -864,6 +1146,8 @@ REGISTER_DISPATCH(
 REGISTER_DISPATCH(qcat_nhwc_stub, &qcat_nhwc_kernel<false>);
 REGISTER_DISPATCH(qcat_relu_nhwc_stub, &qcat_nhwc_kernel<true>);
 REGISTER_DISPATCH(qtopk_stub, &qtopk_kernel);
+REGISTER_DISPATCH(qnormalize_stub, &qnormalize_kernel);
+REGISTER_DISPATCH(qsoftmax_stub, &qsoftmax_kernel);
 
 } // namespace native
 } // namespace at
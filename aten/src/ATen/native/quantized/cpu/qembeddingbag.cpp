@@ -0,0 +1,529 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <caffe2/perfkernels/fused_8bit_rowwise_conversion.h>
+#include <caffe2/perfkernels/fused_8bit_rowwise_embedding_lookup_idx.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+// Same encoding of `mode` as at::embedding_bag.
+constexpr int64_t MODE_SUM = 0;
+constexpr int64_t MODE_MEAN = 1;
+
+// Row-wise quantized embedding tables store every row as the quantized
+// values followed by the scale and bias needed to dequantize them:
+//
+//   8-bit: [uint8_t x D][float scale][float bias]
+//   4-bit: [uint8_t x ceil(D / 2)][at::Half scale][at::Half bias]
+//
+// The 8-bit layout is the one produced by caffe2's
+// FloatToFused8BitRowwiseQuantized, so the AVX2 lookup kernels in
+// caffe2/perfkernels can be used on these tensors directly. In the 4-bit
+// layout the element at column j lives in the low (j even) or high (j odd)
+// nibble of byte j / 2.
+constexpr int64_t kByteScaleBiasBytes = 2 * sizeof(float);
+constexpr int64_t k4BitScaleBiasBytes = 2 * sizeof(at::Half);
+
+// Rows converted per task when (de)quantizing a table.
+constexpr int64_t kRowsPerTask = 64;
+
+void check_prepack_input(const Tensor& weight, const char* op_name) {
+  TORCH_CHECK(
+      weight.dim() == 2,
+      op_name, ": expected a 2-D weight, but got ", weight.dim(), "-D");
+  TORCH_CHECK(
+      weight.scalar_type() == kFloat,
+      op_name, ": expected a float weight, but got ", weight.scalar_type());
+  TORCH_CHECK(
+      weight.size(1) > 0, op_name, ": the embedding dimension must be non-empty");
+}
+
+void check_packed_weight(
+    const Tensor& packed_weight,
+    int64_t scale_bias_bytes,
+    const char* op_name) {
+  TORCH_CHECK(
+      packed_weight.dim() == 2,
+      op_name, ": expected a 2-D packed weight, but got ",
+      packed_weight.dim(), "-D");
+  TORCH_CHECK(
+      packed_weight.scalar_type() == kByte,
+      op_name, ": expected a uint8 packed weight, but got ",
+      packed_weight.scalar_type());
+  TORCH_CHECK(
+      packed_weight.size(1) > scale_bias_bytes,
+      op_name, ": packed rows must hold at least ", scale_bias_bytes + 1,
+      " bytes, but got ", packed_weight.size(1));
+}
+
+Tensor embedding_bag_byte_prepack(const Tensor& weight) {
+  check_prepack_input(weight, "embedding_bag_byte_prepack");
+  auto weight_contig = weight.contiguous();
+  const int64_t rows = weight_contig.size(0);
+  const int64_t cols = weight_contig.size(1);
+  const int64_t output_cols = cols + kByteScaleBiasBytes;
+
+  auto output = at::empty(
+      {rows, output_cols}, weight_contig.options().dtype(kByte));
+  const float* weight_data = weight_contig.data_ptr<float>();
+  uint8_t* output_data = output.data_ptr<uint8_t>();
+  at::parallel_for(0, rows, kRowsPerTask, [&](int64_t start, int64_t end) {
+    caffe2::FloatToFused8BitRowwiseQuantized(
+        weight_data + start * cols,
+        end - start,
+        cols,
+        output_data + start * output_cols);
+  });
+  return output;
+}
+
+Tensor embedding_bag_byte_unpack(const Tensor& packed_weight) {
+  check_packed_weight(
+      packed_weight, kByteScaleBiasBytes, "embedding_bag_byte_unpack");
+  auto packed_contig = packed_weight.contiguous();
+  const int64_t rows = packed_contig.size(0);
+  const int64_t input_cols = packed_contig.size(1);
+  const int64_t output_cols = input_cols - kByteScaleBiasBytes;
+
+  auto output = at::empty(
+      {rows, output_cols}, packed_contig.options().dtype(kFloat));
+  const uint8_t* input_data = packed_contig.data_ptr<uint8_t>();
+  float* output_data = output.data_ptr<float>();
+  at::parallel_for(0, rows, kRowsPerTask, [&](int64_t start, int64_t end) {
+    caffe2::Fused8BitRowwiseQuantizedToFloat(
+        input_data + start * input_cols,
+        end - start,
+        input_cols,
+        output_data + start * output_cols);
+  });
+  return output;
+}
+
+Tensor embedding_bag_4bit_prepack(const Tensor& weight) {
+  check_prepack_input(weight, "embedding_bag_4bit_prepack");
+  auto weight_contig = weight.contiguous();
+  const int64_t rows = weight_contig.size(0);
+  const int64_t cols = weight_contig.size(1);
+  const int64_t packed_cols = (cols + 1) / 2;
+  const int64_t output_cols = packed_cols + k4BitScaleBiasBytes;
+
+  // Zero-filled so the unused high nibble of an odd-sized row stays 0.
+  auto output = at::zeros(
+      {rows, output_cols}, weight_contig.options().dtype(kByte));
+  const float* weight_data = weight_contig.data_ptr<float>();
+  uint8_t* output_data = output.data_ptr<uint8_t>();
+  at::parallel_for(0, rows, kRowsPerTask, [&](int64_t start, int64_t end) {
+    for (int64_t row = start; row < end; ++row) {
+      const float* input_row = weight_data + row * cols;
+      uint8_t* output_row = output_data + row * output_cols;
+      at::Half* output_row_scale_bias =
+          reinterpret_cast<at::Half*>(output_row + packed_cols);
+
+      const float minimum_element =
+          *std::min_element(input_row, input_row + cols);
+      const float maximum_element =
+          *std::max_element(input_row, input_row + cols);
+      // Quantize against the half-precision scale and bias that are stored,
+      // otherwise the rounding error of the conversion adds up with the
+      // quantization error.
+      const at::Half bias = minimum_element;
+      float scale = at::Half((maximum_element - minimum_element) / 15.0f);
+      // A constant row quantizes to all zeros with any scale.
+      if (scale == 0.0f || std::isinf(1.0f / scale)) {
+        scale = 1.0f;
+      }
+      const float inverse_scale = 1.0f / scale;
+      output_row_scale_bias[0] = scale;
+      output_row_scale_bias[1] = bias;
+
+      for (int64_t col = 0; col < cols; ++col) {
+        long quantized =
+            std::lrintf((input_row[col] - static_cast<float>(bias)) * inverse_scale);
+        quantized = std::max(0L, std::min(quantized, 15L));
+        output_row[col / 2] |= static_cast<uint8_t>(quantized << ((col % 2) * 4));
+      }
+    }
+  });
+  return output;
+}
+
+Tensor embedding_bag_4bit_unpack(const Tensor& packed_weight) {
+  check_packed_weight(
+      packed_weight, k4BitScaleBiasBytes, "embedding_bag_4bit_unpack");
+  auto packed_contig = packed_weight.contiguous();
+  const int64_t rows = packed_contig.size(0);
+  const int64_t input_cols = packed_contig.size(1);
+  const int64_t packed_cols = input_cols - k4BitScaleBiasBytes;
+  // The packed format cannot tell an odd embedding dimension apart from the
+  // next even one, so the unpacked table always has an even number of columns.
+  const int64_t output_cols = packed_cols * 2;
+
+  auto output = at::empty(
+      {rows, output_cols}, packed_contig.options().dtype(kFloat));
+  const uint8_t* input_data = packed_contig.data_ptr<uint8_t>();
+  float* output_data = output.data_ptr<float>();
+  at::parallel_for(0, rows, kRowsPerTask, [&](int64_t start, int64_t end) {
+    for (int64_t row = start; row < end; ++row) {
+      const uint8_t* input_row = input_data + row * input_cols;
+      const at::Half* input_row_scale_bias =
+          reinterpret_cast<const at::Half*>(input_row + packed_cols);
+      const float scale = input_row_scale_bias[0];
+      const float bias = input_row_scale_bias[1];
+      float* output_row = output_data + row * output_cols;
+      for (int64_t col = 0; col < output_cols; ++col) {
+        const uint8_t quantized = (input_row[col / 2] >> ((col % 2) * 4)) & 0xF;
+        output_row[col] = scale * quantized + bias;
+      }
+    }
+  });
+  return output;
+}
+
+// Validates the bag description shared by the row-wise lookups. This follows
+// the checks done by at::embedding_bag so that a quantized table can be
+// swapped in for a float one without changing the call site.
+void check_embedding_bag_args(
+    const Tensor& indices,
+    const Tensor& offsets,
+    int64_t mode,
+    const c10::optional<Tensor>& per_sample_weights,
+    const char* op_name) {
+  TORCH_CHECK(
+      indices.dim() == 1,
+      op_name, ": expected 1-D indices, but got ", indices.dim(), "-D");
+  TORCH_CHECK(
+      indices.scalar_type() == kLong || indices.scalar_type() == kInt,
+      op_name, ": expected int64 or int32 indices, but got ",
+      indices.scalar_type());
+  TORCH_CHECK(
+      offsets.dim() == 1,
+      op_name, ": expected 1-D offsets, but got ", offsets.dim(), "-D");
+  TORCH_CHECK(
+      offsets.scalar_type() == kLong,
+      op_name, ": expected int64 offsets, but got ", offsets.scalar_type());
+  TORCH_CHECK(
+      mode == MODE_SUM || mode == MODE_MEAN,
+      op_name, ": only the 'sum' (0) and 'mean' (1) modes are supported, "
+      "but got mode ", mode);
+  if (per_sample_weights.has_value()) {
+    const auto& weights = per_sample_weights.value();
+    TORCH_CHECK(
+        mode == MODE_SUM,
+        op_name, ": per_sample_weights is only supported for mode='sum'");
+    TORCH_CHECK(
+        weights.scalar_type() == kFloat,
+        op_name, ": expected float per_sample_weights, but got ",
+        weights.scalar_type());
+    TORCH_CHECK(
+        weights.dim() == 1 && weights.numel() == indices.numel(),
+        op_name, ": expected per_sample_weights to be 1-D with the same "
+        "number of elements as indices, but got ", weights.sizes());
+  }
+  if (offsets.numel() > 0) {
+    TORCH_CHECK(
+        offsets[0].item<int64_t>() == 0,
+        op_name, ": offsets[0] has to be 0, i.e., the first sequence in the "
+        "mini-batch has to start from position 0. However, got ",
+        offsets[0].item<int64_t>());
+    TORCH_CHECK(
+        offsets[-1].item<int64_t>() <= indices.numel(),
+        op_name, ": offsets[-1] can not be greater than input's length ",
+        indices.numel(), ", but got offsets[-1] of ",
+        offsets[-1].item<int64_t>());
+  }
+}
+
+// Bags handed to a single task of the parallel lookups.
+constexpr int64_t kBagsPerTask = 16;
+
+template <typename IndexType>
+void embedding_bag_byte_impl(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    bool normalize_by_lengths,
+    const float* per_sample_weights_data,
+    Tensor& output) {
+  const int64_t block_size = output.size(1);
+  const int64_t num_bags = offsets.numel();
+  const int64_t num_indices = indices.numel();
+  const int64_t data_size = weight.size(0);
+  const uint8_t* weight_data = weight.data_ptr<uint8_t>();
+  const IndexType* indices_data = indices.data_ptr<IndexType>();
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  float* output_data = output.data_ptr<float>();
+
+  at::parallel_for(0, num_bags, kBagsPerTask, [&](int64_t start, int64_t end) {
+    // The caffe2 kernel expects the offsets of the bags it reduces to start
+    // at 0, so every task rebases its slice of the offsets.
+    const int64_t index_begin = offsets_data[start];
+    const int64_t index_end =
+        end == num_bags ? num_indices : offsets_data[end];
+    // The caffe2 kernel walks the indices of a bag up to the next offset
+    // before it checks them, so the bags are validated here first, with the
+    // same errors as the 4-bit lookup.
+    std::vector<int64_t> local_offsets(end - start);
+    for (int64_t bag = start; bag < end; ++bag) {
+      const int64_t bag_end =
+          bag == num_bags - 1 ? num_indices : offsets_data[bag + 1];
+      TORCH_CHECK(
+          offsets_data[bag] <= bag_end,
+          "embedding_bag_byte_rowwise_offsets: offsets have to be "
+          "non-decreasing, but got offsets[", bag, "] = ", offsets_data[bag],
+          " and offsets[", bag + 1, "] = ", bag_end);
+      local_offsets[bag - start] = offsets_data[bag] - index_begin;
+    }
+    for (int64_t i = index_begin; i < index_end; ++i) {
+      const int64_t idx = indices_data[i];
+      TORCH_CHECK(
+          idx >= 0 && idx < data_size,
+          "embedding_bag_byte_rowwise_offsets: index ", i,
+          " is out of bounds: ", idx, ", range 0 to ", data_size);
+    }
+    caffe2::Fused8BitRowwiseEmbeddingLookupIdx<IndexType, uint8_t, float>(
+        /*block_size=*/block_size,
+        /*output_size=*/end - start,
+        /*index_size=*/index_end - index_begin,
+        /*data_size=*/data_size,
+        /*input=*/weight_data,
+        /*indices=*/indices_data + index_begin,
+        /*offsets=*/local_offsets.data(),
+        /*weights=*/per_sample_weights_data
+            ? per_sample_weights_data + index_begin
+            : nullptr,
+        /*normalize_by_lengths=*/normalize_by_lengths,
+        /*out=*/output_data + start * block_size);
+  });
+}
+
+template <typename IndexType>
+void embedding_bag_4bit_impl(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    bool normalize_by_lengths,
+    const float* per_sample_weights_data,
+    Tensor& output) {
+  const int64_t block_size = output.size(1);
+  const int64_t num_bags = offsets.numel();
+  const int64_t num_indices = indices.numel();
+  const int64_t data_size = weight.size(0);
+  const int64_t fused_block_size = weight.size(1);
+  const int64_t packed_block_size = fused_block_size - k4BitScaleBiasBytes;
+  const uint8_t* weight_data = weight.data_ptr<uint8_t>();
+  const IndexType* indices_data = indices.data_ptr<IndexType>();
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  float* output_data = output.data_ptr<float>();
+
+  at::parallel_for(0, num_bags, kBagsPerTask, [&](int64_t start, int64_t end) {
+    for (int64_t bag = start; bag < end; ++bag) {
+      float* out = output_data + bag * block_size;
+      std::memset(out, 0, sizeof(float) * block_size);
+      const int64_t index_begin = offsets_data[bag];
+      const int64_t index_end =
+          bag == num_bags - 1 ? num_indices : offsets_data[bag + 1];
+      TORCH_CHECK(
+          index_begin <= index_end,
+          "embedding_bag_4bit_rowwise_offsets: offsets have to be "
+          "non-decreasing, but got offsets[", bag, "] = ", index_begin,
+          " and offsets[", bag + 1, "] = ", index_end);
+
+      for (int64_t i = index_begin; i < index_end; ++i) {
+        const int64_t idx = indices_data[i];
+        TORCH_CHECK(
+            idx >= 0 && idx < data_size,
+            "embedding_bag_4bit_rowwise_offsets: index ", i,
+            " is out of bounds: ", idx, ", range 0 to ", data_size);
+        const uint8_t* input_row = weight_data + idx * fused_block_size;
+        const at::Half* input_row_scale_bias =
+            reinterpret_cast<const at::Half*>(input_row + packed_block_size);
+        const float weight =
+            per_sample_weights_data ? per_sample_weights_data[i] : 1.0f;
+        const float scale = weight * input_row_scale_bias[0];
+        const float bias = weight * input_row_scale_bias[1];
+        for (int64_t j = 0; j < block_size; ++j) {
+          const uint8_t quantized = (input_row[j / 2] >> ((j % 2) * 4)) & 0xF;
+          out[j] += scale * quantized + bias;
+        }
+      }
+
+      const int64_t length = index_end - index_begin;
+      if (normalize_by_lengths && length > 0) {
+        const float inverse_length = 1.0f / length;
+        for (int64_t j = 0; j < block_size; ++j) {
+          out[j] *= inverse_length;
+        }
+      }
+    }
+  });
+}
+
+Tensor embedding_bag_byte_rowwise_offsets(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    int64_t mode,
+    const c10::optional<Tensor>& per_sample_weights) {
+  const char* op_name = "embedding_bag_byte_rowwise_offsets";
+  check_packed_weight(weight, kByteScaleBiasBytes, op_name);
+  check_embedding_bag_args(indices, offsets, mode, per_sample_weights, op_name);
+
+  auto weight_contig = weight.contiguous();
+  auto indices_contig = indices.contiguous();
+  auto offsets_contig = offsets.contiguous();
+  Tensor per_sample_weights_contig;
+  if (per_sample_weights.has_value()) {
+    per_sample_weights_contig = per_sample_weights.value().contiguous();
+  }
+  const float* per_sample_weights_data = per_sample_weights_contig.defined()
+      ? per_sample_weights_contig.data_ptr<float>()
+      : nullptr;
+
+  auto output = at::empty(
+      {offsets.numel(), weight.size(1) - kByteScaleBiasBytes},
+      weight.options().dtype(kFloat));
+  if (indices.scalar_type() == kInt) {
+    embedding_bag_byte_impl<int32_t>(
+        weight_contig, indices_contig, offsets_contig, mode == MODE_MEAN,
+        per_sample_weights_data, output);
+  } else {
+    embedding_bag_byte_impl<int64_t>(
+        weight_contig, indices_contig, offsets_contig, mode == MODE_MEAN,
+        per_sample_weights_data, output);
+  }
+  return output;
+}
+
+Tensor embedding_bag_4bit_rowwise_offsets(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    int64_t mode,
+    const c10::optional<Tensor>& per_sample_weights) {
+  const char* op_name = "embedding_bag_4bit_rowwise_offsets";
+  check_packed_weight(weight, k4BitScaleBiasBytes, op_name);
+  check_embedding_bag_args(indices, offsets, mode, per_sample_weights, op_name);
+
+  auto weight_contig = weight.contiguous();
+  auto indices_contig = indices.contiguous();
+  auto offsets_contig = offsets.contiguous();
+  Tensor per_sample_weights_contig;
+  if (per_sample_weights.has_value()) {
+    per_sample_weights_contig = per_sample_weights.value().contiguous();
+  }
+  const float* per_sample_weights_data = per_sample_weights_contig.defined()
+      ? per_sample_weights_contig.data_ptr<float>()
+      : nullptr;
+
+  auto output = at::empty(
+      {offsets.numel(), (weight.size(1) - k4BitScaleBiasBytes) * 2},
+      weight.options().dtype(kFloat));
+  if (indices.scalar_type() == kInt) {
+    embedding_bag_4bit_impl<int32_t>(
+        weight_contig, indices_contig, offsets_contig, mode == MODE_MEAN,
+        per_sample_weights_data, output);
+  } else {
+    embedding_bag_4bit_impl<int64_t>(
+        weight_contig, indices_contig, offsets_contig, mode == MODE_MEAN,
+        per_sample_weights_data, output);
+  }
+  return output;
+}
+
+class QEmbeddingBagBytePrepack final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor weight) {
+    return embedding_bag_byte_prepack(weight);
+  }
+};
+
+class QEmbeddingBagByteUnpack final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor packed_weight) {
+    return embedding_bag_byte_unpack(packed_weight);
+  }
+};
+
+class QEmbeddingBag4BitPrepack final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor weight) {
+    return embedding_bag_4bit_prepack(weight);
+  }
+};
+
+class QEmbeddingBag4BitUnpack final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor packed_weight) {
+    return embedding_bag_4bit_unpack(packed_weight);
+  }
+};
+
+class QEmbeddingBagByteRowwiseOffsets final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor weight,
+      Tensor indices,
+      Tensor offsets,
+      bool /* scale_grad_by_freq */,
+      int64_t mode,
+      bool /* sparse */,
+      c10::optional<Tensor> per_sample_weights) {
+    return embedding_bag_byte_rowwise_offsets(
+        weight, indices, offsets, mode, per_sample_weights);
+  }
+};
+
+class QEmbeddingBag4BitRowwiseOffsets final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor weight,
+      Tensor indices,
+      Tensor offsets,
+      bool /* scale_grad_by_freq */,
+      int64_t mode,
+      bool /* sparse */,
+      c10::optional<Tensor> per_sample_weights) {
+    return embedding_bag_4bit_rowwise_offsets(
+        weight, indices, offsets, mode, per_sample_weights);
+  }
+};
+
+static auto registry =
+    c10::RegisterOperators()
+        .op("quantized::embedding_bag_byte_prepack(Tensor weight) -> Tensor",
+            c10::RegisterOperators::options()
+                .kernel<QEmbeddingBagBytePrepack>(TensorTypeId::CPUTensorId))
+        .op("quantized::embedding_bag_byte_unpack(Tensor weight) -> Tensor",
+            c10::RegisterOperators::options()
+                .kernel<QEmbeddingBagByteUnpack>(TensorTypeId::CPUTensorId))
+        .op("quantized::embedding_bag_4bit_prepack(Tensor weight) -> Tensor",
+            c10::RegisterOperators::options()
+                .kernel<QEmbeddingBag4BitPrepack>(TensorTypeId::CPUTensorId))
+        .op("quantized::embedding_bag_4bit_unpack(Tensor weight) -> Tensor",
+            c10::RegisterOperators::options()
+                .kernel<QEmbeddingBag4BitUnpack>(TensorTypeId::CPUTensorId))
+        .op("quantized::embedding_bag_byte_rowwise_offsets(Tensor weight, "
+            "Tensor indices, Tensor offsets, bool scale_grad_by_freq=False, "
+            "int mode=0, bool sparse=False, Tensor? per_sample_weights=None) "
+            "-> Tensor",
+            c10::RegisterOperators::options()
+                .kernel<QEmbeddingBagByteRowwiseOffsets>(
+                    TensorTypeId::CPUTensorId))
+        .op("quantized::embedding_bag_4bit_rowwise_offsets(Tensor weight, "
+            "Tensor indices, Tensor offsets, bool scale_grad_by_freq=False, "
+            "int mode=0, bool sparse=False, Tensor? per_sample_weights=None) "
+            "-> Tensor",
+            c10::RegisterOperators::options()
+                .kernel<QEmbeddingBag4BitRowwiseOffsets>(
+                    TensorTypeId::CPUTensorId));
+
+} // namespace
+} // namespace native
+} // namespace at
@@ -0,0 +1,213 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
+#include <ATen/quantized/Quantizer.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(qnormalize_stub);
+
+namespace {
+
+void check_normalize_input(const Tensor& qx, const char* op_name) {
+  TORCH_CHECK(
+      qx.qscheme() == kPerTensorAffine,
+      op_name,
+      " only supports per tensor affine quantized inputs.");
+  TORCH_CHECK(
+      qx.scalar_type() == kQUInt8 || qx.scalar_type() == kQInt8,
+      op_name,
+      " only supports quint8 and qint8 inputs, got ",
+      toString(qx.scalar_type()));
+}
+
+// Returns the affine parameter as a contiguous float tensor of the given
+// size, filled with `value` when it is not given.
+Tensor affine_param_or(
+    const c10::optional<Tensor>& param,
+    int64_t size,
+    double value,
+    const char* name) {
+  if (!param.has_value() || !param->defined()) {
+    return at::full({size}, value, at::device(kCPU).dtype(kFloat));
+  }
+  TORCH_CHECK(
+      param->numel() == size,
+      "Expected ",
+      name,
+      " to have ",
+      size,
+      " elements, but got ",
+      param->numel());
+  return param->to(kFloat).contiguous();
+}
+
+Tensor quantized_layer_norm_impl(
+    const Tensor& input,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& bias,
+    double eps,
+    double output_scale,
+    int64_t output_zero_point) {
+  check_normalize_input(input, "quantized::layer_norm");
+  const int normalized_ndim = normalized_shape.size();
+  TORCH_CHECK(
+      normalized_ndim >= 1,
+      "Expected normalized_shape to be at least 1-dimensional, i.e., ",
+      "containing at least one element, but got normalized_shape = ",
+      normalized_shape);
+  const int axis = input.dim() - normalized_ndim;
+  TORCH_CHECK(
+      axis >= 0 && input.sizes().slice(axis).equals(normalized_shape),
+      "Given normalized_shape=",
+      normalized_shape,
+      ", expected input with shape [*, ",
+      normalized_shape,
+      "], but got input of size",
+      input.sizes());
+
+  const auto input_shape = input.sizes();
+  const int64_t M = std::accumulate(
+      input_shape.cbegin(),
+      input_shape.cbegin() + axis,
+      1LL,
+      std::multiplies<int64_t>());
+  const int64_t N = std::accumulate(
+      input_shape.cbegin() + axis,
+      input_shape.cend(),
+      1LL,
+      std::multiplies<int64_t>());
+
+  const Tensor X = input.contiguous();
+  const Tensor gamma = affine_param_or(weight, N, 1.0, "weight");
+  const Tensor beta = affine_param_or(bias, N, 0.0, "bias");
+  Tensor Y = at::_empty_affine_quantized(
+      X.sizes(), X.options(), output_scale, output_zero_point);
+  if (M > 0 && N > 0) {
+    qnormalize_stub(
+        X.device().type(),
+        X,
+        gamma,
+        beta,
+        /*affine_per_channel=*/false,
+        /*num_channels=*/1,
+        /*num_groups=*/1,
+        M,
+        N,
+        eps,
+        &Y);
+  }
+  return Y;
+}
+
+Tensor quantized_group_norm_impl(
+    const Tensor& input,
+    int64_t num_groups,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& bias,
+    double eps,
+    double output_scale,
+    int64_t output_zero_point) {
+  check_normalize_input(input, "quantized::group_norm");
+  TORCH_CHECK(
+      input.dim() >= 2,
+      "Expected input of at least 2 dimensions for quantized::group_norm, "
+      "but got input of size ",
+      input.sizes());
+  const int64_t batch_size = input.size(0);
+  const int64_t num_channels = input.size(1);
+  TORCH_CHECK(
+      num_groups > 0 && num_channels % num_groups == 0,
+      "Expected number of channels in input to be divisible by ",
+      "num_groups, but got input of shape ",
+      input.sizes(),
+      " and "
+      "num_groups=",
+      num_groups);
+  const int64_t HxW =
+      input.numel() / std::max<int64_t>(batch_size * num_channels, 1);
+
+  const Tensor X = input.contiguous();
+  const Tensor gamma = affine_param_or(weight, num_channels, 1.0, "weight");
+  const Tensor beta = affine_param_or(bias, num_channels, 0.0, "bias");
+  Tensor Y = at::_empty_affine_quantized(
+      X.sizes(), X.options(), output_scale, output_zero_point);
+  const int64_t M = batch_size * num_groups;
+  const int64_t N = num_channels / num_groups * HxW;
+  if (M > 0 && N > 0) {
+    qnormalize_stub(
+        X.device().type(),
+        X,
+        gamma,
+        beta,
+        /*affine_per_channel=*/true,
+        num_channels,
+        num_groups,
+        M,
+        N,
+        eps,
+        &Y);
+  }
+  return Y;
+}
+
+class QLayerNorm final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor input,
+      std::vector<int64_t> normalized_shape,
+      c10::optional<Tensor> weight,
+      c10::optional<Tensor> bias,
+      double eps,
+      double output_scale,
+      int64_t output_zero_point) {
+    return quantized_layer_norm_impl(
+        input,
+        normalized_shape,
+        weight,
+        bias,
+        eps,
+        output_scale,
+        output_zero_point);
+  }
+};
+
+class QGroupNorm final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor input,
+      int64_t num_groups,
+      c10::optional<Tensor> weight,
+      c10::optional<Tensor> bias,
+      double eps,
+      double output_scale,
+      int64_t output_zero_point) {
+    return quantized_group_norm_impl(
+        input, num_groups, weight, bias, eps, output_scale, output_zero_point);
+  }
+};
+
+static auto registry =
+    c10::RegisterOperators()
+        .op("quantized::layer_norm(Tensor input, int[] normalized_shape, "
+            "Tensor? weight, Tensor? bias, float eps, float output_scale, "
+            "int output_zero_point) -> Tensor",
+            c10::RegisterOperators::options().kernel<QLayerNorm>(
+                TensorTypeId::QuantizedCPUTensorId))
+        .op("quantized::group_norm(Tensor input, int num_groups, "
+            "Tensor? weight, Tensor? bias, float eps, float output_scale, "
+            "int output_zero_point) -> Tensor",
+            c10::RegisterOperators::options().kernel<QGroupNorm>(
+                TensorTypeId::QuantizedCPUTensorId));
+} // namespace
+
+} // namespace native
+} // namespace at
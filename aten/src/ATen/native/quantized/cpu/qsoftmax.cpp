@@ -0,0 +1,68 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/WrapDimUtils.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
+#include <ATen/quantized/Quantizer.h>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(qsoftmax_stub);
+
+namespace {
+
+Tensor quantized_softmax_impl(
+    const Tensor& qx,
+    int64_t dim,
+    double output_scale,
+    int64_t output_zero_point) {
+  TORCH_CHECK(
+      qx.qscheme() == kPerTensorAffine,
+      "quantized::softmax only supports per tensor affine quantized inputs.");
+  TORCH_CHECK(
+      qx.scalar_type() == kQUInt8 || qx.scalar_type() == kQInt8,
+      "quantized::softmax only supports quint8 and qint8 inputs, got ",
+      toString(qx.scalar_type()));
+  const Tensor X = qx.contiguous();
+  Tensor Y = at::_empty_affine_quantized(
+      X.sizes(), X.options(), output_scale, output_zero_point);
+  if (X.numel() == 0) {
+    return Y;
+  }
+  dim = maybe_wrap_dim(dim, X.dim());
+  int64_t outer_size = 1;
+  int64_t inner_size = 1;
+  for (int64_t i = 0; i < dim; ++i) {
+    outer_size *= X.size(i);
+  }
+  for (int64_t i = dim + 1; i < X.dim(); ++i) {
+    inner_size *= X.size(i);
+  }
+  // A 0-dim tensor is treated as a single element along dim.
+  const int64_t dim_size = X.dim() > 0 ? X.size(dim) : 1;
+  qsoftmax_stub(X.device().type(), X, outer_size, dim_size, inner_size, Y);
+  return Y;
+}
+
+class QSoftmax final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor qx,
+      int64_t dim,
+      double output_scale,
+      int64_t output_zero_point) {
+    return quantized_softmax_impl(qx, dim, output_scale, output_zero_point);
+  }
+};
+
+static auto registry = c10::RegisterOperators().op(
+    "quantized::softmax(Tensor qx, int dim, float output_scale, "
+    "int output_zero_point) -> Tensor",
+    c10::RegisterOperators::options().kernel<QSoftmax>(
+        TensorTypeId::QuantizedCPUTensorId));
+
+} // namespace
+
+} // namespace native
+} // namespace at
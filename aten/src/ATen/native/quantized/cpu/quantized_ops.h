@@ -80,6 +80,23 @@ using qcat_nhwc_fn = Tensor (*)(
     double scale,
     int64_t zero_point);
 using qtopk_fn = void(*)(Tensor&, Tensor&, const Tensor&, int64_t, int64_t, bool, bool);
+using qnormalize_fn = void (*)(
+    const Tensor& /* X */,
+    const Tensor& /* gamma */,
+    const Tensor& /* beta */,
+    bool /* affine_per_channel */,
+    int64_t /* num_channels */,
+    int64_t /* num_groups */,
+    int64_t /* M */,
+    int64_t /* N */,
+    double /* eps */,
+    Tensor* /* Y */);
+using qsoftmax_fn = void (*)(
+    const Tensor& /* qx */,
+    int64_t /* outer_size */,
+    int64_t /* dim_size */,
+    int64_t /* inner_size */,
+    Tensor& /* qy */);
 
 // using qavg_pool2d_fn
 DECLARE_DISPATCH(qrelu_fn, qrelu_stub);
@@ -94,6 +111,8 @@ DECLARE_DISPATCH(qupsample_bilinear2d_fn, qupsample_bilinear2d_nhwc_stub);
 DECLARE_DISPATCH(qcat_nhwc_fn, qcat_nhwc_stub);
 DECLARE_DISPATCH(qcat_nhwc_fn, qcat_relu_nhwc_stub);
 DECLARE_DISPATCH(qtopk_fn, qtopk_stub);
+DECLARE_DISPATCH(qnormalize_fn, qnormalize_stub);
+DECLARE_DISPATCH(qsoftmax_fn, qsoftmax_stub);
 
 } // namespace native
 } // namespace at
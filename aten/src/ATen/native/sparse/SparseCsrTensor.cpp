@@ -0,0 +1,178 @@
+// Basic functions on sparse CSR tensors
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/SparseCsrTensorImpl.h>
+#include <ATen/SparseCsrTensorUtils.h>
+#include <ATen/SparseTensorUtils.h>
+
+namespace at { namespace native {
+
+using namespace at::sparse_csr;
+
+namespace {
+
+// Computes the CSR row pointers of `nrows` rows from the row index of every
+// entry. The row indices must be sorted.
+Tensor crow_indices_from_sorted_rows(const Tensor& rows_, int64_t nrows) {
+  Tensor rows = rows_.contiguous();
+  Tensor crow_indices = at::zeros({nrows + 1}, rows.options());
+  const int64_t* rows_ptr = rows.data_ptr<int64_t>();
+  int64_t* crow_ptr = crow_indices.data_ptr<int64_t>();
+  int64_t nnz = rows.numel();
+  for (int64_t i = 0; i < nnz; i++) {
+    crow_ptr[rows_ptr[i] + 1]++;
+  }
+  for (int64_t row = 0; row < nrows; row++) {
+    crow_ptr[row + 1] += crow_ptr[row];
+  }
+  return crow_indices;
+}
+
+Tensor shallow_copy_without_autograd(const Tensor& t) {
+  return Tensor(t.unsafeGetTensorImpl()->shallow_copy_and_detach(
+    /*version_counter=*/t.unsafeGetTensorImpl()->version_counter(),
+    /*allow_tensor_metadata_change=*/true));
+}
+
+} // namespace
+
+/******************************************************************************
+ * access methods
+ ******************************************************************************/
+
+Tensor crow_indices_sparse_csr(const Tensor& self) {
+  return get_sparse_csr_impl(self)->crow_indices().alias();
+}
+
+Tensor col_indices_sparse_csr(const Tensor& self) {
+  return get_sparse_csr_impl(self)->col_indices().alias();
+}
+
+Tensor values_sparse_csr(const Tensor& self) {
+  return get_sparse_csr_impl(self)->values().alias();
+}
+
+int64_t _nnz_sparse_csr(const Tensor& self) {
+  return get_sparse_csr_impl(self)->nnz();
+}
+
+/******************************************************************************
+ * creation methods
+ ******************************************************************************/
+
+Tensor _sparse_csr_tensor_unsafe_cpu(const Tensor& crow_indices, const Tensor& col_indices, const Tensor& values, IntArrayRef size) {
+  SparseCsrTensor self = new_sparse_csr(values.options());
+  // NOTE: As for sparse COO tensors, the member tensors of a sparse CSR tensor
+  // must not contain AutogradMeta, so they are shallow-copied here.
+  get_sparse_csr_impl(self)->set_member_tensors_unsafe(
+      shallow_copy_without_autograd(crow_indices.contiguous()),
+      shallow_copy_without_autograd(col_indices.contiguous()),
+      shallow_copy_without_autograd(values.contiguous()),
+      size);
+  return self;
+}
+
+Tensor sparse_csr_tensor(const Tensor& crow_indices, const Tensor& col_indices, const Tensor& values, IntArrayRef size) {
+  TORCH_CHECK(size.size() == 2, "sparse CSR tensors must be 2-D, but got size ", size);
+  TORCH_CHECK(!crow_indices.is_cuda() && !col_indices.is_cuda() && !values.is_cuda(),
+      "sparse CSR tensors are only supported on CPU");
+  TORCH_CHECK(crow_indices.scalar_type() == kLong && col_indices.scalar_type() == kLong,
+      "crow_indices and col_indices must be int64 tensors");
+  TORCH_CHECK(crow_indices.dim() == 1 && crow_indices.size(0) == size[0] + 1,
+      "crow_indices must have shape (nrows + 1,) = (", size[0] + 1, ",), but got ", crow_indices.sizes());
+  TORCH_CHECK(col_indices.dim() == 1 && values.dim() == 1 && col_indices.size(0) == values.size(0),
+      "col_indices and values must be 1-D with the same number of entries, but got col_indices of shape ",
+      col_indices.sizes(), " and values of shape ", values.sizes());
+
+  int64_t nnz = col_indices.size(0);
+  auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+  TORCH_CHECK(crow_accessor[0] == 0, "crow_indices must start at 0, but got ", crow_accessor[0]);
+  TORCH_CHECK(crow_accessor[size[0]] == nnz,
+      "crow_indices must end at the number of entries (", nnz, "), but got ", crow_accessor[size[0]]);
+  for (int64_t row = 0; row < size[0]; row++) {
+    TORCH_CHECK(crow_accessor[row] <= crow_accessor[row + 1],
+        "crow_indices must be non-decreasing, but crow_indices[", row, "] = ", crow_accessor[row],
+        " > crow_indices[", row + 1, "] = ", crow_accessor[row + 1]);
+  }
+  if (nnz > 0) {
+    int64_t min_col = col_indices.min().item<int64_t>();
+    int64_t max_col = col_indices.max().item<int64_t>();
+    TORCH_CHECK(min_col >= 0, "found negative column index ", min_col);
+    TORCH_CHECK(max_col < size[1],
+        "size is inconsistent with col_indices: there are ", size[1], " columns but found column index ", max_col);
+  }
+
+  return at::_sparse_csr_tensor_unsafe(crow_indices, col_indices, values, size);
+}
+
+/******************************************************************************
+ * conversions
+ ******************************************************************************/
+
+Tensor dense_to_sparse_csr(const Tensor& self) {
+  TORCH_CHECK(self.dim() == 2, "to_sparse_csr: expected a 2-D tensor, but got a ", self.dim(), "-D tensor");
+  // nonzero() returns the indices in row-major order, i.e. already grouped by
+  // row and sorted by column within a row.
+  Tensor nz = self.nonzero();
+  Tensor rows = nz.select(1, 0);
+  Tensor cols = nz.select(1, 1).contiguous();
+  Tensor values = self.index({rows, cols});
+  return at::_sparse_csr_tensor_unsafe(
+      crow_indices_from_sorted_rows(rows, self.size(0)), cols, values, self.sizes());
+}
+
+Tensor sparse_to_sparse_csr(const Tensor& self) {
+  TORCH_CHECK(self.sparse_dim() == 2 && self.dense_dim() == 0,
+      "to_sparse_csr: expected a sparse matrix with scalar values, but got sparse_dim ",
+      self.sparse_dim(), " and dense_dim ", self.dense_dim());
+  Tensor coalesced = self.coalesce();
+  Tensor indices = coalesced._indices();
+  return at::_sparse_csr_tensor_unsafe(
+      crow_indices_from_sorted_rows(indices.select(0, 0), self.size(0)),
+      indices.select(0, 1).contiguous(),
+      coalesced._values(),
+      self.sizes());
+}
+
+Tensor sparse_csr_to_dense(const Tensor& self) {
+  auto impl = get_sparse_csr_impl(self);
+  Tensor dst = at::zeros(self.sizes(), self.options().layout(kStrided));
+  if (impl->nnz() == 0) {
+    return dst;
+  }
+  const int64_t* crow_ptr = impl->crow_indices().data_ptr<int64_t>();
+  const int64_t* col_ptr = impl->col_indices().data_ptr<int64_t>();
+  int64_t ncols = self.size(1);
+  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "sparse_csr_to_dense", [&] {
+    const scalar_t* values_ptr = impl->values().data_ptr<scalar_t>();
+    scalar_t* dst_ptr = dst.data_ptr<scalar_t>();
+    at::parallel_for(0, self.size(0), 1, [&](int64_t start, int64_t end) {
+      for (int64_t row = start; row < end; row++) {
+        for (int64_t p = crow_ptr[row]; p < crow_ptr[row + 1]; p++) {
+          dst_ptr[row * ncols + col_ptr[p]] += values_ptr[p];
+        }
+      }
+    });
+  });
+  return dst;
+}
+
+Tensor sparse_csr_to_sparse(const Tensor& self) {
+  auto impl = get_sparse_csr_impl(self);
+  int64_t nnz = impl->nnz();
+  Tensor indices = at::empty({2, nnz}, impl->col_indices().options());
+  const int64_t* crow_ptr = impl->crow_indices().data_ptr<int64_t>();
+  int64_t* rows_ptr = indices.data_ptr<int64_t>();
+  at::parallel_for(0, self.size(0), 1, [&](int64_t start, int64_t end) {
+    for (int64_t row = start; row < end; row++) {
+      std::fill(rows_ptr + crow_ptr[row], rows_ptr + crow_ptr[row + 1], row);
+    }
+  });
+  indices.select(0, 1).copy_(impl->col_indices());
+  return at::_sparse_coo_tensor_unsafe(indices, impl->values(), self.sizes(), impl->values().options().layout(kSparse));
+}
+
+}} // namespace at::native
@@ -0,0 +1,182 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/ExpandUtils.h>
+#include <ATen/Parallel.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/ScalarOps.h>
+#include <ATen/SparseCsrTensorImpl.h>
+#include <ATen/SparseCsrTensorUtils.h>
+
+#include <TH/THBlasUtils.h>
+
+#include <algorithm>
+
+namespace at { namespace native {
+
+using namespace at::sparse_csr;
+
+namespace {
+
+// Number of rows handed to each thread so that every task does roughly
+// GRAIN_SIZE multiply-adds, assuming the entries are spread evenly.
+int64_t rows_per_task(int64_t nrows, int64_t nnz, int64_t work_per_entry) {
+  if (nrows == 0) {
+    return 1;
+  }
+  int64_t work_per_row = std::max<int64_t>(1, divup(nnz, nrows) * work_per_entry);
+  return std::max<int64_t>(1, internal::GRAIN_SIZE / work_per_row);
+}
+
+void check_sparse_csr_matmul_args(const char* name, const Tensor& sparse, const Tensor& dense) {
+  TORCH_CHECK(sparse.is_sparse_csr(), name, ": expected the first matrix to be a sparse CSR tensor, but got layout ", sparse.layout());
+  TORCH_CHECK(dense.layout() == kStrided, name, ": expected the second argument to be a strided tensor, but got layout ", dense.layout());
+  TORCH_CHECK(!dense.is_cuda(), name, ": expected the second argument to be a CPU tensor, but got a CUDA tensor");
+  TORCH_CHECK(sparse.scalar_type() == dense.scalar_type(),
+      name, ": expected both arguments to have the same dtype, but got ", sparse.scalar_type(), " and ", dense.scalar_type());
+}
+
+} // namespace
+
+// --------------------------------------------------------------------
+// addmm(Tensor, SparseCsrTensor, Tensor, Scalar, Scalar)  [broadcasts]
+// --------------------------------------------------------------------
+
+// Computes r = beta * t + alpha * sparse @ dense, one row of r per iteration.
+// Rows are independent, so they are split across threads without any
+// synchronization, and every row is accumulated in the same order as the
+// serial loop.
+Tensor& addmm_out_sparse_csr_dense_cpu(
+    Tensor& r,
+    const Tensor& t,
+    const SparseCsrTensor& sparse,
+    const Tensor& dense,
+    Scalar beta,
+    Scalar alpha) {
+  check_sparse_csr_matmul_args("addmm", sparse, dense);
+  TORCH_CHECK(!r.is_cuda(), "addmm: expected 'out' to be CPU tensor, but got CUDA tensor");
+  TORCH_CHECK(dense.dim() == 2, "addmm: matrices expected, got ", dense.dim(), "D tensor");
+
+  // ixj * jxk = ixk
+  int64_t dim_i = sparse.size(0);
+  int64_t dim_j = sparse.size(1);
+  int64_t dim_k = dense.size(1);
+  TORCH_CHECK(dense.size(0) == dim_j,
+      "addmm: Argument #3 (dense): Expected dim 0 size ", dim_j, ", got ", dense.size(0));
+
+  Tensor b_t;
+  std::tie(b_t) = expand_size(t, {dim_i, dim_k}, "addmm_out");
+  r.resize_({dim_i, dim_k});
+
+  auto impl = get_sparse_csr_impl(sparse);
+  int64_t nnz = impl->nnz();
+  const int64_t* crow_ptr = impl->crow_indices().data_ptr<int64_t>();
+  const int64_t* col_ptr = impl->col_indices().data_ptr<int64_t>();
+
+  AT_DISPATCH_ALL_TYPES(sparse.scalar_type(), "addmm_sparse_csr_dense", [&] {
+    scalar_t cast_alpha = alpha.to<scalar_t>();
+    scalar_t cast_beta = beta.to<scalar_t>();
+    if (cast_beta == 0) {
+      r.zero_();
+    } else if (cast_beta == 1) {
+      if (!r.is_same(b_t)) {
+        r.copy_(b_t);
+      }
+    } else {
+      at::mul_out(r, b_t, scalar_to_tensor(beta));
+    }
+    if (nnz == 0 || dim_k == 0) {
+      return;
+    }
+
+    const scalar_t* values_ptr = impl->values().data_ptr<scalar_t>();
+    scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
+    scalar_t* r_ptr = r.data_ptr<scalar_t>();
+    int64_t dense_stride0 = dense.stride(0);
+    int64_t dense_stride1 = dense.stride(1);
+    int64_t r_stride0 = r.stride(0);
+    int64_t r_stride1 = r.stride(1);
+
+    at::parallel_for(0, dim_i, rows_per_task(dim_i, nnz, dim_k), [&](int64_t start, int64_t end) {
+      for (int64_t row = start; row < end; row++) {
+        for (int64_t p = crow_ptr[row]; p < crow_ptr[row + 1]; p++) {
+          int64_t col = col_ptr[p];
+          TORCH_CHECK(col >= 0 && col < dim_j, "addmm: index out of column bound: ", col, " not between 0 and ", dim_j);
+          THBlas_axpy<scalar_t>(dim_k,
+                cast_alpha * values_ptr[p],
+                dense_ptr + col * dense_stride0, dense_stride1,
+                r_ptr + row * r_stride0, r_stride1);
+        }
+      }
+    });
+  });
+  return r;
+}
+
+Tensor addmm_sparse_csr_dense_cpu(
+    const Tensor& self,
+    const SparseCsrTensor& sparse,
+    const Tensor& dense,
+    Scalar beta,
+    Scalar alpha) {
+  Tensor r = at::empty({0}, dense.options());
+  return addmm_out_sparse_csr_dense_cpu(r, self, sparse, dense, beta, alpha);
+}
+
+// --------------------------------------------------------------------
+// mm(SparseCsrTensor, Tensor)
+// --------------------------------------------------------------------
+
+Tensor& sparse_csr_mm_out(Tensor& result, const SparseCsrTensor& sparse, const Tensor& dense) {
+  Tensor t = at::zeros({}, dense.options());
+  return addmm_out_sparse_csr_dense_cpu(result, t, sparse, dense, 0, 1);
+}
+
+Tensor sparse_csr_mm(const SparseCsrTensor& sparse, const Tensor& dense) {
+  Tensor result = at::empty({0}, dense.options());
+  return sparse_csr_mm_out(result, sparse, dense);
+}
+
+// --------------------------------------------------------------------
+// mv(SparseCsrTensor, Tensor)
+// --------------------------------------------------------------------
+
+Tensor& sparse_csr_mv_out(Tensor& result, const SparseCsrTensor& sparse, const Tensor& vec) {
+  check_sparse_csr_matmul_args("mv", sparse, vec);
+  TORCH_CHECK(!result.is_cuda(), "mv: expected 'out' to be CPU tensor, but got CUDA tensor");
+  TORCH_CHECK(vec.dim() == 1, "mv: vector expected, got ", vec.dim(), "D tensor");
+  int64_t nrows = sparse.size(0);
+  int64_t ncols = sparse.size(1);
+  TORCH_CHECK(vec.size(0) == ncols, "mv: size mismatch, got matrix of size ", sparse.sizes(), " and vector of size ", vec.size(0));
+
+  result.resize_({nrows});
+  auto impl = get_sparse_csr_impl(sparse);
+  const int64_t* crow_ptr = impl->crow_indices().data_ptr<int64_t>();
+  const int64_t* col_ptr = impl->col_indices().data_ptr<int64_t>();
+
+  AT_DISPATCH_ALL_TYPES(sparse.scalar_type(), "sparse_csr_mv", [&] {
+    const scalar_t* values_ptr = impl->values().data_ptr<scalar_t>();
+    const scalar_t* vec_ptr = vec.data_ptr<scalar_t>();
+    scalar_t* result_ptr = result.data_ptr<scalar_t>();
+    int64_t vec_stride = vec.stride(0);
+    int64_t result_stride = result.stride(0);
+    at::parallel_for(0, nrows, rows_per_task(nrows, impl->nnz(), 1), [&](int64_t start, int64_t end) {
+      for (int64_t row = start; row < end; row++) {
+        scalar_t sum = 0;
+        for (int64_t p = crow_ptr[row]; p < crow_ptr[row + 1]; p++) {
+          int64_t col = col_ptr[p];
+          TORCH_CHECK(col >= 0 && col < ncols, "mv: index out of column bound: ", col, " not between 0 and ", ncols);
+          sum += values_ptr[p] * vec_ptr[col * vec_stride];
+        }
+        result_ptr[row * result_stride] = sum;
+      }
+    });
+  });
+  return result;
+}
+
+Tensor sparse_csr_mv(const SparseCsrTensor& sparse, const Tensor& vec) {
+  Tensor result = at::empty({0}, vec.options());
+  return sparse_csr_mv_out(result, sparse, vec);
+}
+
+}} // namespace at::native
@@ -10,6 +10,9 @@
 
 #include <TH/THBlasUtils.h>
 
+#include <algorithm>
+#include <numeric>
+
 namespace at { namespace native {
 
 using namespace at::sparse;
@@ -352,6 +355,80 @@ SparseTensor& copy_sparse_(SparseTensor& self, const SparseTensor& src, bool non
   return self._coalesced_(src.is_coalesced());
 }
 
+namespace {
+
+constexpr int kRadixBits = 8;
+constexpr int64_t kRadix = 1 << kRadixBits;
+
+// Stable LSD radix sort of non-negative keys, 8 bits per pass. Returns the
+// sorted keys and the permutation that sorts them. Every pass histograms and
+// scatters contiguous chunks of the keys in parallel; the chunks are visited
+// in order when computing the scatter offsets, which keeps the sort stable.
+std::tuple<LongTensor, LongTensor> radix_sort_indices(const LongTensor& indices_scalar, int64_t max_key) {
+  int64_t n = indices_scalar.numel();
+  LongTensor keys = at::empty({n}, indices_scalar.options());
+  keys.copy_(indices_scalar);
+  LongTensor perm = at::arange(n, indices_scalar.options());
+  LongTensor keys_tmp = at::empty({n}, indices_scalar.options());
+  LongTensor perm_tmp = at::empty({n}, indices_scalar.options());
+
+  int64_t* keys_ptr = keys.data_ptr<int64_t>();
+  int64_t* perm_ptr = perm.data_ptr<int64_t>();
+  int64_t* keys_tmp_ptr = keys_tmp.data_ptr<int64_t>();
+  int64_t* perm_tmp_ptr = perm_tmp.data_ptr<int64_t>();
+
+  int64_t chunk_size = std::max<int64_t>(internal::GRAIN_SIZE, divup(n, at::get_num_threads()));
+  int64_t num_chunks = divup(n, chunk_size);
+  std::vector<int64_t> histogram(num_chunks * kRadix);
+
+  int num_passes = 0;
+  for (int shift = 0; shift < 64 && (max_key >> shift) > 0; shift += kRadixBits) {
+    std::fill(histogram.begin(), histogram.end(), 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        int64_t* chunk_histogram = histogram.data() + chunk * kRadix;
+        int64_t chunk_end = std::min(n, (chunk + 1) * chunk_size);
+        for (int64_t i = chunk * chunk_size; i < chunk_end; i++) {
+          chunk_histogram[(keys_ptr[i] >> shift) & (kRadix - 1)]++;
+        }
+      }
+    });
+
+    // Exclusive prefix sum over (digit, chunk) gives every chunk the offset
+    // at which to write its keys with a given digit.
+    int64_t offset = 0;
+    for (int64_t digit = 0; digit < kRadix; digit++) {
+      for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+        int64_t count = histogram[chunk * kRadix + digit];
+        histogram[chunk * kRadix + digit] = offset;
+        offset += count;
+      }
+    }
+
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        int64_t* chunk_offsets = histogram.data() + chunk * kRadix;
+        int64_t chunk_end = std::min(n, (chunk + 1) * chunk_size);
+        for (int64_t i = chunk * chunk_size; i < chunk_end; i++) {
+          int64_t pos = chunk_offsets[(keys_ptr[i] >> shift) & (kRadix - 1)]++;
+          keys_tmp_ptr[pos] = keys_ptr[i];
+          perm_tmp_ptr[pos] = perm_ptr[i];
+        }
+      }
+    });
+    std::swap(keys_ptr, keys_tmp_ptr);
+    std::swap(perm_ptr, perm_tmp_ptr);
+    num_passes++;
+  }
+
+  if (num_passes % 2 == 1) {
+    return std::make_tuple(keys_tmp, perm_tmp);
+  }
+  return std::make_tuple(keys, perm);
+}
+
+} // namespace
+
 SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
   AT_ASSERT(self.defined());
   TORCH_INTERNAL_ASSERT(at::impl::variable_excluded_from_dispatch());
@@ -385,42 +462,79 @@ SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
 
   LongTensor indicesBuffer;
   LongTensor indicesPermutation;
-  std::tie(indicesBuffer, indicesPermutation) = indices_scalar.sort(0);
+  int64_t min_index = indices_scalar.min().item<int64_t>();
+  if (min_index >= 0) {
+    int64_t max_index = indices_scalar.max().item<int64_t>();
+    std::tie(indicesBuffer, indicesPermutation) = radix_sort_indices(indices_scalar, max_index);
+  } else {
+    // Out-of-range indices are only rejected later, by whoever consumes the
+    // tensor; keep sorting them the way a comparison sort would.
+    std::tie(indicesBuffer, indicesPermutation) = indices_scalar.sort(0);
+  }
   // NB: The accessor accesses here rely on self._nnz() > 0 (tested earlier in this function)
   auto newIndicesAccessor = newIndices.accessor<int64_t, 2>();
   auto indicesAccessor = indices.accessor<int64_t, 2>();
   auto indicesPermutationAccessor = indicesPermutation.accessor<int64_t, 1>();
   auto indicesBufferAccessor = indicesBuffer.accessor<int64_t, 1>();
 
-  int64_t i = -1;
+  // Find where every run of equal indices starts. Runs may cross chunk
+  // boundaries, so runs are located first and then merged independently.
+  int64_t chunk_size = std::max<int64_t>(internal::GRAIN_SIZE, divup(nnz, at::get_num_threads()));
+  int64_t num_chunks = divup(nnz, chunk_size);
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      int64_t count = 0;
+      int64_t chunk_end = std::min(nnz, (chunk + 1) * chunk_size);
+      for (int64_t j = chunk * chunk_size; j < chunk_end; j++) {
+        count += (j == 0 || indicesBufferAccessor[j] != indicesBufferAccessor[j - 1]);
+      }
+      chunk_offsets[chunk + 1] = count;
+    }
+  });
+  std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(), chunk_offsets.begin());
+  int64_t newNnz = chunk_offsets[num_chunks];
+
+  std::vector<int64_t> run_starts(newNnz + 1);
+  run_starts[newNnz] = nnz;
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      int64_t i = chunk_offsets[chunk];
+      int64_t chunk_end = std::min(nnz, (chunk + 1) * chunk_size);
+      for (int64_t j = chunk * chunk_size; j < chunk_end; j++) {
+        if (j == 0 || indicesBufferAccessor[j] != indicesBufferAccessor[j - 1]) {
+          run_starts[i++] = j;
+        }
+      }
+    }
+  });
+
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "coalesce", [&] {
-        int64_t prev = -1;
         int64_t blockSize = values.stride(0);
         scalar_t* values_ptr = values.data_ptr<scalar_t>();
         scalar_t* newValues_ptr = newValues.data_ptr<scalar_t>();
-        for (int64_t j = 0; j < nnz; j++) {
-          int64_t pos = indicesPermutationAccessor[j];
-          int64_t curr = indicesBufferAccessor[j];
-          if (curr == prev) {
-            if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
-              THBlas_axpy<scalar_t>(blockSize, 1, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
-            }
-          } else {
-            ++i;
+        int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(1, blockSize));
+        at::parallel_for(0, newNnz, grain_size, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            int64_t pos = indicesPermutationAccessor[run_starts[i]];
             for (int64_t d = 0; d < sparse_dim; d++) {
               newIndicesAccessor[d][i] = indicesAccessor[d][pos];
             }
-            if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
-              THBlas_copy<scalar_t>(blockSize, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
+            if (values.numel() == 0) {  // if values is an empty tensor, there are no elements to copy
+              continue;
+            }
+            THBlas_copy<scalar_t>(blockSize, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
+            for (int64_t j = run_starts[i] + 1; j < run_starts[i + 1]; j++) {
+              pos = indicesPermutationAccessor[j];
+              THBlas_axpy<scalar_t>(blockSize, 1, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
             }
           }
-          prev = curr;
-        }
+        });
     });
 
   dst._coalesced_(true);
-  get_sparse_impl(dst)->set_nnz_and_narrow(i + 1);
+  get_sparse_impl(dst)->set_nnz_and_narrow(newNnz);
 
   return dst;
 }
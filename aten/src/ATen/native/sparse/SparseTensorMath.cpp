@@ -12,6 +12,8 @@
 
 #include <TH/THBlasUtils.h>
 
+#include <numeric>
+
 namespace at { namespace native {
 
 using namespace at::sparse;
@@ -41,6 +43,38 @@ namespace {
     return csr;
   }
 
+  // Groups the entries of a 2-D sparse matrix by row. Returns the row pointers
+  // of the matrix in CSR format and the order in which to visit the entries so
+  // that each row's entries are contiguous, keeping the original order within a
+  // row. The order is left undefined if the entries are already sorted by row.
+  std::tuple<LongTensor, LongTensor> _to_csr_order(const LongTensor& indices, int64_t dim, int64_t nnz, bool sorted) {
+    LongTensor rows = indices.select(0, 0).contiguous();
+    const int64_t* rows_ptr = rows.data_ptr<int64_t>();
+    if (sorted) {
+      TORCH_CHECK(rows_ptr[0] >= 0, "addmm: index out of row bound: ", rows_ptr[0], " not between 1 and ", dim);
+      TORCH_CHECK(rows_ptr[nnz - 1] < dim, "addmm: index out of row bound: ", rows_ptr[nnz - 1], " not between 1 and ", dim);
+      return std::make_tuple(_to_csr(rows_ptr, dim, nnz), LongTensor());
+    }
+
+    // Counting sort on the row index.
+    LongTensor csr = native::zeros({dim + 1}, kLong);
+    int64_t* csr_ptr = csr.data_ptr<int64_t>();
+    for (int64_t i = 0; i < nnz; i++) {
+      int64_t row = rows_ptr[i];
+      TORCH_CHECK(row >= 0 && row < dim, "addmm: index out of row bound: ", row, " not between 1 and ", dim);
+      csr_ptr[row + 1]++;
+    }
+    std::partial_sum(csr_ptr, csr_ptr + dim + 1, csr_ptr);
+
+    LongTensor order = at::empty({nnz}, kLong);
+    int64_t* order_ptr = order.data_ptr<int64_t>();
+    std::vector<int64_t> next(csr_ptr, csr_ptr + dim);
+    for (int64_t i = 0; i < nnz; i++) {
+      order_ptr[next[rows_ptr[i]]++] = i;
+    }
+    return std::make_tuple(csr, order);
+  }
+
 }
 
 // --------------------------------------------------------------------
@@ -608,9 +642,7 @@ SparseTensor& mul_out_sparse_cpu(SparseTensor& r, const Tensor& t_, const Tensor
 // --------------------------------------------------------------------
 
 template <typename scalar_t>
-void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const Tensor& indices, const Tensor& values, const Tensor& dense) {
-  int64_t i;
-
+void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const Tensor& indices, const Tensor& values, const Tensor& dense, bool coalesced) {
   // r_ = alpha * sparse * dense
   scalar_t cast_alpha = alpha.to<scalar_t>();
   scalar_t cast_beta = beta.to<scalar_t>();
@@ -624,6 +656,14 @@ void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j,
     at::mul_out(r, t, scalar_to_tensor(beta));
   }
 
+  // Partition the entries by output row so that every row of r is only
+  // updated by one thread.
+  LongTensor csr;
+  LongTensor order;
+  std::tie(csr, order) = _to_csr_order(indices, dim_i, nnz, coalesced);
+  const int64_t* csr_ptr = csr.data_ptr<int64_t>();
+  const int64_t* order_ptr = order.defined() ? order.data_ptr<int64_t>() : nullptr;
+
   auto indices_accessor = indices.accessor<int64_t, 2>();
 
   auto values_accessor = values.accessor<scalar_t, 1>();
@@ -634,23 +674,24 @@ void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j,
   int64_t dense_stride1 = dense.stride(1);
   int64_t r_stride0 = r.stride(0);
   int64_t r_stride1 = r.stride(1);
-  for (i = 0; i < nnz; i++) {
-    scalar_t val = values_accessor[i];
-    int64_t row = indices_accessor[0][i];
-    int64_t col = indices_accessor[1][i];
-    if (col >= 0 && col < dim_j && row >= 0 && row < dim_i) {
-      THBlas_axpy<scalar_t>(dim_k,
-            cast_alpha * val,
-            dense_ptr + col * dense_stride0, dense_stride1,
-            r_ptr + row * r_stride0, r_stride1);
-    } else {
-      if (col < 0 || col >= dim_j) {
-        AT_ERROR("addmm: index out of column bound: ", col, " not between 1 and ", dim_j);
-      } else {
-        AT_ERROR("addmm: index out of row bound: ", row, " not between 1 and ", dim_i);
+  int64_t work_per_row = std::max<int64_t>(1, divup(nnz, dim_i) * dim_k);
+  int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / work_per_row);
+  at::parallel_for(0, dim_i, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t row = start; row < end; row++) {
+      for (int64_t p = csr_ptr[row]; p < csr_ptr[row + 1]; p++) {
+        int64_t i = order_ptr ? order_ptr[p] : p;
+        scalar_t val = values_accessor[i];
+        int64_t col = indices_accessor[1][i];
+        if (col < 0 || col >= dim_j) {
+          AT_ERROR("addmm: index out of column bound: ", col, " not between 1 and ", dim_j);
+        }
+        THBlas_axpy<scalar_t>(dim_k,
+              cast_alpha * val,
+              dense_ptr + col * dense_stride0, dense_stride1,
+              r_ptr + row * r_stride0, r_stride1);
       }
     }
-  }
+  });
 };
 
 Tensor& s_addmm_out_sparse_dense_cpu(
@@ -697,7 +738,7 @@ Tensor& s_addmm_out_sparse_dense_cpu(
 
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "addmm_sparse_dense", [&] {
-        s_addmm_out_sparse_dense_worker<scalar_t>(nnz, dim_i, dim_j, dim_k, r, beta, t, alpha, indices, values, dense);
+        s_addmm_out_sparse_dense_worker<scalar_t>(nnz, dim_i, dim_j, dim_k, r, beta, t, alpha, indices, values, dense, sparse_.is_coalesced());
       }
   );
 
@@ -224,3 +224,17 @@ TEST(TensorIteratorTest, FailNonPromotingBinaryOp) {
   iter.add_input(at::ones({1,1}, at::dtype(at::kInt)));
   ASSERT_ANY_THROW(iter.build());
 }
+
+TEST(TensorIteratorTest, ForEachWithGrainSize) {
+  // Every element has to be visited exactly once whatever the grain size.
+  for (int64_t grain_size : {int64_t(1), int64_t(7), int64_t(1) << 20}) {
+    auto out = at::zeros({100, 37}, at::kLong);
+    auto iter = TensorIterator::nullary_op(out);
+    iter.for_each([](char** data, const int64_t* strides, int64_t n) {
+      for (int64_t i = 0; i < n; i++) {
+        *reinterpret_cast<int64_t*>(data[0] + i * strides[0]) += 1;
+      }
+    }, grain_size);
+    ASSERT_TRUE(out.eq(1).all().item<bool>());
+  }
+}
@@ -69,3 +69,42 @@ TEST(TestParallel, IntraOpLaunchFuture) {
 
   ASSERT_TRUE(v1 == 1 && v2 == 2);
 }
+
+TEST(TestParallel, GrainSizeForCost) {
+  // One cycle per element is what GRAIN_SIZE was tuned for.
+  ASSERT_EQ(at::internal::grain_size_for_cost(1), at::internal::GRAIN_SIZE);
+  ASSERT_EQ(at::internal::grain_size_for_cost(0.5), 2 * at::internal::GRAIN_SIZE);
+  ASSERT_EQ(at::internal::grain_size_for_cost(32), at::internal::GRAIN_SIZE / 32);
+  // Never drops below one element, and falls back to the default without a
+  // usable hint.
+  ASSERT_EQ(at::internal::grain_size_for_cost(1e9), 1);
+  ASSERT_EQ(at::internal::grain_size_for_cost(0), at::internal::GRAIN_SIZE);
+  // Scales a different base grain size the same way.
+  ASSERT_EQ(at::internal::grain_size_for_cost(4, 2048), 512);
+  ASSERT_EQ(at::internal::grain_size_for_cost(0, 2048), 2048);
+}
+
+// The native thread pool can't be resized once it has started, so this
+// needs one of the other backends.
+#if !AT_PARALLEL_NATIVE
+TEST(TestParallel, ReductionsIndependentOfNumThreads) {
+  manual_seed(123);
+  int num_threads = get_num_threads();
+  // Large enough for several levels of blocks in a full reduction.
+  Tensor a = randn({1 << 22});
+  Tensor b = randn({1 << 16, 7});
+
+  set_num_threads(1);
+  auto sum = a.sum();
+  auto std = a.std();
+  auto rows = b.sum(1);
+
+  for (int threads : {2, 3, 4}) {
+    set_num_threads(threads);
+    ASSERT_TRUE(a.sum().equal(sum));
+    ASSERT_TRUE(a.std().equal(std));
+    ASSERT_TRUE(b.sum(1).equal(rows));
+  }
+  set_num_threads(num_threads);
+}
+#endif
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include <ATen/native/DispatchStub.h>
+
+// This file is compiled without AVX-512 flags, so this copy of the tests
+// checks the emulated fallback in vec512_base.h.
+#define VEC512_TEST_NAMESPACE fallback
+#include <ATen/test/vec512_test_cases.h>
+
+namespace {
+
+// Whether the copy of the tests in vec512_test_avx512.cpp can run.
+bool canRunAvx512Tests() {
+#if defined(HAVE_VEC512_AVX512_TEST)
+  return at::native::get_cpu_capability() == at::native::CPUCapability::AVX512;
+#else
+  return false;
+#endif
+}
+
+} // namespace
+
+#define VEC512_TESTS(name)                                           \
+  TEST(Vec512FallbackTest, name) {                                   \
+    vec512_test::fallback::test##name();                             \
+  }                                                                  \
+  TEST(Vec512Avx512Test, name) {                                     \
+    if (!canRunAvx512Tests()) {                                      \
+      GTEST_SKIP() << "not built with AVX-512 or the CPU lacks it";  \
+    }                                                                \
+    vec512_test::avx512::test##name();                               \
+  }
+
+FORALL_VEC512_TESTS(VEC512_TESTS)
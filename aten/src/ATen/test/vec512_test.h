@@ -0,0 +1,32 @@
+#pragma once
+
+// The Vec512 tests, see vec512_test_cases.h. They are compiled twice into
+// vec512_test: once without AVX-512 flags, which checks the emulated
+// fallback in vec512_base.h, and once with them (vec512_test_avx512.cpp),
+// which checks the intrinsics in vec512_{float,double,int}.h.
+
+#define FORALL_VEC512_TESTS(_) \
+  _(LoadStore)                 \
+  _(ArangeBlendAndSet)         \
+  _(Arithmetic)                \
+  _(MinMaxClamp)               \
+  _(Comparisons)               \
+  _(Division)                  \
+  _(UnaryMath)                 \
+  _(ReduceAll)
+
+#define DECLARE_VEC512_TEST(name) void test##name();
+
+namespace vec512_test {
+namespace fallback {
+FORALL_VEC512_TESTS(DECLARE_VEC512_TEST)
+} // namespace fallback
+
+// Only defined in builds with AVX-512 support (HAVE_VEC512_AVX512_TEST),
+// and only to be called on CPUs that support it.
+namespace avx512 {
+FORALL_VEC512_TESTS(DECLARE_VEC512_TEST)
+} // namespace avx512
+} // namespace vec512_test
+
+#undef DECLARE_VEC512_TEST
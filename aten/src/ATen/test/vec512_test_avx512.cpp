@@ -0,0 +1,7 @@
+// The Vec512 tests compiled with AVX-512 flags (see caffe2/CMakeLists.txt),
+// which check the intrinsics. Everything in this file may use AVX-512
+// instructions, so vec512_test.cpp only calls into it on CPUs that support
+// them.
+
+#define VEC512_TEST_NAMESPACE avx512
+#include <ATen/test/vec512_test_cases.h>
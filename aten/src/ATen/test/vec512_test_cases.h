@@ -0,0 +1,257 @@
+// Compares the Vec512 operations against the same operations applied to one
+// element at a time.
+//
+// Included by the files that compile the tests, see vec512_test.h, after
+// defining VEC512_TEST_NAMESPACE. The helpers live in an anonymous namespace,
+// like Vec512 itself, so that the copies compiled with and without AVX-512
+// flags don't mix.
+
+#include <ATen/test/vec512_test.h>
+
+#include <gtest/gtest.h>
+
+#include <ATen/cpu/vec512/functional.h>
+#include <ATen/cpu/vec512/vec512.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#ifndef VEC512_TEST_NAMESPACE
+#error "define VEC512_TEST_NAMESPACE before including vec512_test_cases.h"
+#endif
+
+namespace vec512_test {
+namespace VEC512_TEST_NAMESPACE {
+namespace {
+
+using namespace at::vec512;
+
+template <typename T>
+struct Inputs {
+  static constexpr int kSize = Vec512<T>::size();
+  __at_align64__ T a[kSize];
+  __at_align64__ T b[kSize];
+
+  Inputs() {
+    for (int i = 0; i < kSize; i++) {
+      a[i] = sample(i);
+      b[i] = sample(kSize - 1 - i) + static_cast<T>(1);
+    }
+  }
+
+  // A mix of negative, zero and positive values that are small enough for
+  // products of two of them to be exact in every type.
+  static T sample(int i) {
+    return std::is_floating_point<T>::value
+        ? static_cast<T>(i * 0.75 - 3.5)
+        : static_cast<T>(i - 5);
+  }
+};
+
+template <typename T>
+void expectClose(T expected, T actual, int i) {
+  EXPECT_EQ(expected, actual) << "at index " << i;
+}
+
+template <>
+void expectClose<float>(float expected, float actual, int i) {
+  EXPECT_NEAR(expected, actual, 1e-5f * std::max(1.0f, std::abs(expected)))
+      << "at index " << i;
+}
+
+template <>
+void expectClose<double>(double expected, double actual, int i) {
+  EXPECT_NEAR(expected, actual, 1e-12 * std::max(1.0, std::abs(expected)))
+      << "at index " << i;
+}
+
+template <typename T>
+void expectVec(const Vec512<T>& vec, const std::function<T(int)>& expected) {
+  __at_align64__ T out[Vec512<T>::size()];
+  vec.store(out);
+  for (int i = 0; i < Vec512<T>::size(); i++) {
+    expectClose(expected(i), out[i], i);
+  }
+}
+
+template <typename T>
+void checkLoadStore() {
+  using Vec = Vec512<T>;
+  Inputs<T> in;
+  expectVec<T>(Vec::loadu(in.a), [&](int i) { return in.a[i]; });
+  for (int64_t count = 0; count <= Vec::size(); count++) {
+    auto vec = Vec::loadu(in.a, count);
+    __at_align64__ T out[Vec::size()];
+    std::fill(out, out + Vec::size(), static_cast<T>(42));
+    vec.store(out, count);
+    for (int i = 0; i < Vec::size(); i++) {
+      expectClose(i < count ? in.a[i] : static_cast<T>(42), out[i], i);
+    }
+  }
+}
+
+template <typename T>
+void checkArangeBlendAndSet() {
+  using Vec = Vec512<T>;
+  Inputs<T> in;
+  const auto a = Vec::loadu(in.a);
+  const auto b = Vec::loadu(in.b);
+  expectVec<T>(Vec::arange(static_cast<T>(3), static_cast<T>(2)),
+               [](int i) { return static_cast<T>(3 + 2 * i); });
+  expectVec<T>(Vec(static_cast<T>(7)), [](int) { return static_cast<T>(7); });
+  for (int64_t count = 0; count <= Vec::size(); count++) {
+    expectVec<T>(Vec::set(a, b, count),
+                 [&](int i) { return i < count ? in.b[i] : in.a[i]; });
+  }
+  // Selects b wherever a < b, i.e. computes the elementwise maximum.
+  expectVec<T>(Vec::blendv(a, b, a < b),
+               [&](int i) { return in.a[i] < in.b[i] ? in.b[i] : in.a[i]; });
+}
+
+template <typename T>
+void checkArithmetic() {
+  using Vec = Vec512<T>;
+  Inputs<T> in;
+  const auto a = Vec::loadu(in.a);
+  const auto b = Vec::loadu(in.b);
+  expectVec<T>(a + b, [&](int i) { return static_cast<T>(in.a[i] + in.b[i]); });
+  expectVec<T>(a - b, [&](int i) { return static_cast<T>(in.a[i] - in.b[i]); });
+  expectVec<T>(a * b, [&](int i) { return static_cast<T>(in.a[i] * in.b[i]); });
+  expectVec<T>(a.neg(), [&](int i) { return static_cast<T>(-in.a[i]); });
+  expectVec<T>(a.abs(), [&](int i) {
+    return static_cast<T>(in.a[i] < 0 ? -in.a[i] : in.a[i]);
+  });
+}
+
+template <typename T>
+void checkMinMaxClamp() {
+  using Vec = Vec512<T>;
+  Inputs<T> in;
+  const auto a = Vec::loadu(in.a);
+  const auto b = Vec::loadu(in.b);
+  const T lo = static_cast<T>(-2);
+  const T hi = static_cast<T>(3);
+  expectVec<T>(maximum(a, b), [&](int i) { return std::max(in.a[i], in.b[i]); });
+  expectVec<T>(minimum(a, b), [&](int i) { return std::min(in.a[i], in.b[i]); });
+  expectVec<T>(clamp(a, Vec(lo), Vec(hi)),
+               [&](int i) { return std::min(hi, std::max(lo, in.a[i])); });
+  expectVec<T>(clamp_min(a, Vec(lo)), [&](int i) { return std::max(lo, in.a[i]); });
+  expectVec<T>(clamp_max(a, Vec(hi)), [&](int i) { return std::min(hi, in.a[i]); });
+}
+
+template <typename T>
+void checkComparisons() {
+  using Vec = Vec512<T>;
+  Inputs<T> in;
+  const auto a = Vec::loadu(in.a);
+  const auto b = Vec::loadu(in.b);
+  const Vec one(static_cast<T>(1));
+  // The comparisons return all-ones masks, which select `one` when and-ed.
+  auto check = [&](const Vec& mask, const std::function<bool(T, T)>& op) {
+    expectVec<T>(mask & one, [&](int i) {
+      return static_cast<T>(op(in.a[i], in.b[i]) ? 1 : 0);
+    });
+  };
+  check(a == b, std::equal_to<T>());
+  check(a != b, std::not_equal_to<T>());
+  check(a < b, std::less<T>());
+  check(a <= b, std::less_equal<T>());
+  check(a > b, std::greater<T>());
+  check(a >= b, std::greater_equal<T>());
+}
+
+template <typename T>
+void checkDivision() {
+  using Vec = Vec512<T>;
+  Inputs<T> in;
+  const auto a = Vec::loadu(in.a);
+  const auto b = Vec::loadu(in.b);
+  expectVec<T>(a / b, [&](int i) { return in.a[i] / in.b[i]; });
+  expectVec<T>(b.reciprocal(), [&](int i) { return static_cast<T>(1) / in.b[i]; });
+  expectVec<T>(fmadd(a, b, a), [&](int i) { return in.a[i] * in.b[i] + in.a[i]; });
+}
+
+template <typename T>
+void checkUnaryMath() {
+  using Vec = Vec512<T>;
+  Inputs<T> in;
+  const auto a = Vec::loadu(in.a);
+  const auto positive = a.abs() + Vec(static_cast<T>(0.25));
+  auto pos = [&](int i) { return std::abs(in.a[i]) + static_cast<T>(0.25); };
+  expectVec<T>(positive.sqrt(), [&](int i) { return std::sqrt(pos(i)); });
+  expectVec<T>(positive.rsqrt(), [&](int i) { return 1 / std::sqrt(pos(i)); });
+  expectVec<T>(positive.log(), [&](int i) { return std::log(pos(i)); });
+  expectVec<T>(a.exp(), [&](int i) { return std::exp(in.a[i]); });
+  expectVec<T>(a.tanh(), [&](int i) { return std::tanh(in.a[i]); });
+  expectVec<T>(a.sin(), [&](int i) { return std::sin(in.a[i]); });
+  expectVec<T>(a.floor(), [&](int i) { return std::floor(in.a[i]); });
+  expectVec<T>(a.ceil(), [&](int i) { return std::ceil(in.a[i]); });
+  expectVec<T>(a.trunc(), [&](int i) { return std::trunc(in.a[i]); });
+  expectVec<T>(a.frac(), [&](int i) { return in.a[i] - std::trunc(in.a[i]); });
+}
+
+template <typename T>
+void checkReduceAll() {
+  using Vec = Vec512<T>;
+  // Covers a partial vector, whole vectors and a tail.
+  for (int64_t size : {int64_t{3}, int64_t{Vec::size()}, int64_t{Vec::size() * 3 + 5}}) {
+    std::vector<T> data(size);
+    T expected = 0;
+    for (int64_t i = 0; i < size; i++) {
+      data[i] = Inputs<T>::sample(i % 11);
+      expected += data[i];
+    }
+    const T actual = reduce_all<T>(
+        [](Vec& x, Vec& y) { return x + y; }, data.data(), size);
+    expectClose(expected, actual, static_cast<int>(size));
+  }
+}
+
+template <typename T>
+const char* typeName();
+template <> const char* typeName<float>() { return "float"; }
+template <> const char* typeName<double>() { return "double"; }
+template <> const char* typeName<int64_t>() { return "int64_t"; }
+template <> const char* typeName<int32_t>() { return "int32_t"; }
+template <> const char* typeName<int16_t>() { return "int16_t"; }
+
+template <typename... Ts>
+struct ForTypes {
+  template <typename Check>
+  static void run(Check check) {
+    // Evaluates check for every type in order.
+    int unused[] = {0, (check(Ts()), 0)...};
+    (void)unused;
+  }
+};
+
+using AllTypes = ForTypes<float, double, int64_t, int32_t, int16_t>;
+using FloatingTypes = ForTypes<float, double>;
+
+} // namespace
+
+#define DEFINE_VEC512_TEST(name, types)      \
+  void test##name() {                        \
+    types::run([](auto t) {                  \
+      using T = decltype(t);                 \
+      SCOPED_TRACE(typeName<T>());           \
+      check##name<T>();                      \
+    });                                      \
+  }
+
+DEFINE_VEC512_TEST(LoadStore, AllTypes)
+DEFINE_VEC512_TEST(ArangeBlendAndSet, AllTypes)
+DEFINE_VEC512_TEST(Arithmetic, AllTypes)
+DEFINE_VEC512_TEST(MinMaxClamp, AllTypes)
+DEFINE_VEC512_TEST(Comparisons, AllTypes)
+DEFINE_VEC512_TEST(Division, FloatingTypes)
+DEFINE_VEC512_TEST(UnaryMath, FloatingTypes)
+DEFINE_VEC512_TEST(ReduceAll, FloatingTypes)
+
+#undef DEFINE_VEC512_TEST
+
+} // namespace VEC512_TEST_NAMESPACE
+} // namespace vec512_test
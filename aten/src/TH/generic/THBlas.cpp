@@ -384,6 +384,44 @@ void THBlas_(gemm)(
   }
 #endif
 
+#if defined(TH_REAL_IS_BFLOAT16)
+  {
+    // There is no bf16 gemm in BLAS, and accumulating the k products of each
+    // output in bf16 loses most of its 8 bits of mantissa. Widen the operands
+    // to float, run the float gemm (sgemm when BLAS is available) and round
+    // the result once. The copies are O(mk + kn + mn) against O(mnk) flops.
+    int64_t a_rows = transa_ ? k : m;
+    int64_t a_cols = transa_ ? m : k;
+    int64_t b_rows = transb_ ? n : k;
+    int64_t b_cols = transb_ ? k : n;
+    float *a_f = (float*)THAlloc(sizeof(float) * a_rows * a_cols);
+    float *b_f = (float*)THAlloc(sizeof(float) * b_rows * b_cols);
+    float *c_f = (float*)THAlloc(sizeof(float) * m * n);
+    for (int64_t j = 0; j < a_cols; j++)
+      for (int64_t i = 0; i < a_rows; i++)
+        a_f[j * a_rows + i] = static_cast<float>(a[j * lda + i]);
+    for (int64_t j = 0; j < b_cols; j++)
+      for (int64_t i = 0; i < b_rows; i++)
+        b_f[j * b_rows + i] = static_cast<float>(b[j * ldb + i]);
+    if (beta != 0) {
+      for (int64_t j = 0; j < n; j++)
+        for (int64_t i = 0; i < m; i++)
+          c_f[j * m + i] = static_cast<float>(c[j * ldc + i]);
+    }
+    THFloatBlas_gemm(
+        transa, transb, m, n, k, static_cast<float>(alpha),
+        a_f, THMax(1, a_rows), b_f, THMax(1, b_rows),
+        static_cast<float>(beta), c_f, THMax(1, m));
+    for (int64_t j = 0; j < n; j++)
+      for (int64_t i = 0; i < m; i++)
+        c[j * ldc + i] = c_f[j * m + i];
+    THFree(a_f);
+    THFree(b_f);
+    THFree(c_f);
+    return;
+  }
+#endif
+
 #if defined(USE_FBGEMM) && defined(TH_REAL_IS_LONG)
   if (alpha == 1 && (beta == 0 || beta == 1)) {
     // In FBGEMM, we assume row-major ordering; However, here we assume the
@@ -0,0 +1,83 @@
+"""Peak memory of CPU conv2d inference, with and without the im2col buffer.
+
+Each configuration is run in a fresh process so that the reported maximum
+resident set size only covers that convolution. The "im2col" column forces
+the thnn_conv2d path by requiring grad on the input; the "inference" column
+runs under torch.no_grad() with torch.backends.winograd enabled, where
+stride-1 3x3 convolutions use the Winograd kernel and other small kernels the
+direct kernel.
+
+  python benchmarks/conv2d_cpu/peak_memory.py
+"""
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import argparse
+import resource
+import subprocess
+import sys
+import time
+
+import torch
+import torch.nn as nn
+
+# (N, in_c, out_c, kernel, stride, H, W)
+CONFIGS = [
+    (1, 64, 64, 3, 1, 56, 56),
+    (1, 128, 128, 3, 1, 28, 28),
+    (8, 16, 32, 3, 1, 56, 56),
+    (1, 3, 32, 3, 2, 224, 224),
+    (8, 16, 16, 3, 2, 56, 56),
+]
+
+
+def run_one(config, no_grad, iters):
+    N, in_c, out_c, kernel, stride, H, W = config
+    torch.backends.mkldnn.enabled = False
+    torch.backends.winograd.enabled = True
+    conv = nn.Conv2d(in_c, out_c, kernel, stride=stride, padding=1)
+    x = torch.rand(N, in_c, H, W)
+    base_kb = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    if no_grad:
+        with torch.no_grad():
+            conv(x)
+            start = time.time()
+            for _ in range(iters):
+                conv(x)
+    else:
+        x.requires_grad_()
+        conv(x)
+        start = time.time()
+        for _ in range(iters):
+            conv(x)
+    elapsed_ms = (time.time() - start) / iters * 1e3
+    peak_kb = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    print('{} {:.3f}'.format(peak_kb - base_kb, elapsed_ms))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--iters', type=int, default=20)
+    parser.add_argument('--child', type=str, default=None, help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.child is not None:
+        index, no_grad = args.child.split(',')
+        run_one(CONFIGS[int(index)], no_grad == '1', args.iters)
+        return
+
+    print('{:<32} {:>14} {:>14} {:>12} {:>12}'.format(
+        'N,in_c,out_c,k,s,H,W', 'im2col KiB', 'inference KiB', 'im2col ms', 'inference ms'))
+    for i, config in enumerate(CONFIGS):
+        results = []
+        for no_grad in ('0', '1'):
+            out = subprocess.check_output([
+                sys.executable, __file__, '--iters', str(args.iters),
+                '--child', '{},{}'.format(i, no_grad)])
+            results.append(out.decode().split())
+        print('{:<32} {:>14} {:>14} {:>12} {:>12}'.format(
+            ','.join(str(c) for c in config),
+            results[0][0], results[1][0], results[0][1], results[1][1]))
+
+
+if __name__ == '__main__':
+    main()
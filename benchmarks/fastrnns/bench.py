@@ -6,6 +6,7 @@ import gc
 import sys
 import json
 import copy
+import time
 
 from .runner import get_nn_runners
 
@@ -42,15 +43,31 @@ def pretty_print(benchresult, colwidth=16, sep=' '):
     return sep.join(items)
 
 
+class CPUEvent(object):
+    """Mimics the part of torch.cuda.Event used below with a host clock."""
+
+    def __init__(self, enable_timing=True):
+        self.time = None
+
+    def record(self):
+        self.time = time.time()
+
+    def elapsed_time(self, end_event):
+        # milliseconds, like torch.cuda.Event.elapsed_time
+        return (end_event.time - self.time) * 1000
+
+
 def trainbench(name, rnn_creator, nloops=100, warmup=10,
                seqLength=100, numLayers=1, inputSize=512, hiddenSize=512,
                miniBatch=64, device='cuda', seed=None):
+    Event = torch.cuda.Event if device == 'cuda' else CPUEvent
+
     def train_batch(modeldef):
-        # CUDA events for timing
-        fwd_start_event = torch.cuda.Event(enable_timing=True)
-        fwd_end_event = torch.cuda.Event(enable_timing=True)
-        bwd_start_event = torch.cuda.Event(enable_timing=True)
-        bwd_end_event = torch.cuda.Event(enable_timing=True)
+        # CUDA events (or host timestamps on CPU) for timing
+        fwd_start_event = Event(enable_timing=True)
+        fwd_end_event = Event(enable_timing=True)
+        bwd_start_event = Event(enable_timing=True)
+        bwd_end_event = Event(enable_timing=True)
 
         gc.collect()
 
@@ -78,13 +95,14 @@ def trainbench(name, rnn_creator, nloops=100, warmup=10,
                 assert param.grad is not None
                 param.grad.data.zero_()
 
-        torch.cuda.synchronize()
+        if device == 'cuda':
+            torch.cuda.synchronize()
 
         fwd_time = fwd_start_event.elapsed_time(fwd_end_event)
         bwd_time = bwd_start_event.elapsed_time(bwd_end_event)
         return fwd_time, bwd_time
 
-    assert device == 'cuda'
+    assert device in ('cuda', 'cpu')
     creator_args = dict(seqLength=seqLength, numLayers=numLayers,
                         inputSize=inputSize, hiddenSize=hiddenSize,
                         miniBatch=miniBatch, device=device, seed=seed)
@@ -184,7 +202,7 @@ if __name__ == '__main__':
     parser.add_argument('--miniBatch', default='64', type=int)
     parser.add_argument('--warmup', default='10', type=int)
     parser.add_argument('--nloops', default='100', type=int)
-    parser.add_argument('--device', default='cuda', type=str)
+    parser.add_argument('--device', default='cuda', type=str, choices=['cuda', 'cpu'])
     parser.add_argument('--variable_lstms', action='store_true',
                         help='Also benchmark variable sequence length lstms '
                         'Note that some of these run really slowly '
@@ -198,8 +216,13 @@ if __name__ == '__main__':
     parser.add_argument('--group', nargs='*', default=default_groups, help='Which group to run. cnns, rnns, etc.')
 
     args = parser.parse_args()
-    rnns = args.rnns or ['cudnn', 'aten', 'jit', 'jit_premul', 'jit_premul_bias', 'jit_simple',
-                         'jit_multilayer', 'py']
+    if args.device == 'cpu':
+        # cudnn and the premul variants only differ from these on CUDA
+        default_rnns = ['aten', 'aten_cell', 'jit', 'py']
+    else:
+        default_rnns = ['cudnn', 'aten', 'jit', 'jit_premul', 'jit_premul_bias', 'jit_simple',
+                        'jit_multilayer', 'py']
+    rnns = args.rnns or default_rnns
     cnns = args.cnns or ['resnet18', 'resnet18_jit', 'resnet50', 'resnet50_jit']
     # TODO: Maybe add a separate section for the layernorm/dropout lstms
     # 'cudnn_layernorm', jit_layernorm', 'jit_layernom_decom',
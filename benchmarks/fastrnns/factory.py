@@ -62,6 +62,29 @@ def pytorch_lstm_creator(**kwargs):
         backward=simple_backward)
 
 
+def pytorch_lstm_cell_creator(**kwargs):
+    # Steps an nn.LSTMCell over the sequence from Python, so every timestep
+    # goes through the aten lstm_cell op (and its fused cell kernel).
+    input, hidden, _, module = lstm_inputs(return_module=True, **kwargs)
+    assert module.num_layers == 1, 'pytorch_lstm_cell_creator only supports one layer'
+    cell = torch.nn.LSTMCell(module.input_size, module.hidden_size).to(input.device)
+
+    def forward(input, hidden):
+        hx, cx = hidden[0][0], hidden[1][0]
+        outputs = []
+        for step_input in input.unbind(0):
+            hx, cx = cell(step_input, (hx, cx))
+            outputs += [hx]
+        return torch.stack(outputs), (hx.unsqueeze(0), cx.unsqueeze(0))
+
+    return ModelDef(
+        inputs=[input, hidden],
+        params=list(cell.parameters()),
+        forward=forward,
+        backward_setup=lstm_backward_setup,
+        backward=simple_backward)
+
+
 def lstm_creator(script=True, **kwargs):
     input, hidden, params, _ = lstm_inputs(return_module=False, **kwargs)
     inputs = [input, hidden] + params[0]
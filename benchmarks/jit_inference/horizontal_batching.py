@@ -0,0 +1,80 @@
+"""Latency of a multi-tower model with independent linear layers per tower.
+
+The scripted model goes through the graph executor's BatchMM pass, which,
+with horizontal batching enabled, batches the same-shaped layers of all towers
+into one baddbmm per layer (see Note [Horizontal batching] in
+torch/csrc/jit/passes/batch_mm.cpp). Horizontal batching is off by default and
+enabled by this script. The "eager" column runs the same model without
+TorchScript.
+
+  python benchmarks/jit_inference/horizontal_batching.py
+"""
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import argparse
+import time
+
+import torch
+import torch.nn as nn
+
+
+class Tower(nn.Module):
+    def __init__(self, in_features, hidden, depth):
+        super(Tower, self).__init__()
+        self.layers = nn.ModuleList(
+            [nn.Linear(in_features if i == 0 else hidden, hidden) for i in range(depth)])
+
+    def forward(self, x):
+        for layer in self.layers:
+            x = torch.relu(layer(x))
+        return x
+
+
+class MultiTower(nn.Module):
+    def __init__(self, towers, in_features, hidden, depth):
+        super(MultiTower, self).__init__()
+        self.towers = nn.ModuleList([Tower(in_features, hidden, depth) for _ in range(towers)])
+
+    def forward(self, x):
+        outputs = []
+        for tower in self.towers:
+            outputs.append(tower(x))
+        return torch.cat(outputs, 1)
+
+
+def time_ms(module, x, iters):
+    with torch.no_grad():
+        for _ in range(3):
+            module(x)
+        start = time.time()
+        for _ in range(iters):
+            module(x)
+    return (time.time() - start) / iters * 1e3
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--iters', type=int, default=200)
+    parser.add_argument('--towers', type=int, nargs='+', default=[4, 8, 16])
+    parser.add_argument('--batch-size', type=int, default=32)
+    parser.add_argument('--in-features', type=int, default=64)
+    parser.add_argument('--hidden', type=int, default=64)
+    parser.add_argument('--depth', type=int, default=3)
+    args = parser.parse_args()
+    torch._C._jit_override_horizontal_mm_batching(True)
+
+    print('{:<8} {:>10} {:>12} {:>10} {:>8}'.format('towers', 'eager ms', 'scripted ms', 'speedup', 'batched'))
+    for towers in args.towers:
+        model = MultiTower(towers, args.in_features, args.hidden, args.depth).eval()
+        scripted = torch.jit.script(model)
+        x = torch.rand(args.batch_size, args.in_features)
+        with torch.no_grad():
+            torch.testing.assert_allclose(scripted(x), model(x))
+            batched = 'prim::MMBatchHorizontal' in str(scripted.graph_for(x))
+        base = time_ms(model, x, args.iters)
+        opt = time_ms(scripted, x, args.iters)
+        print('{:<8} {:>10.3f} {:>12.3f} {:>9.2f}x {:>8}'.format(towers, base, opt, base / opt, str(batched)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,94 @@
+"""Latency of a ResNet-style TorchScript model before and after optimize_for_inference.
+
+The "scripted" column runs the eval-mode scripted module, the "optimized" column
+the module returned by torch._C._optimize_for_inference, which freezes it, folds
+batch norms into convolutions, prepacks convolution weights for MKL-DNN and
+applies ReLUs in place.
+
+  python benchmarks/jit_inference/optimize_for_inference.py
+"""
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import argparse
+import time
+
+import torch
+import torch.nn as nn
+import torch.nn.functional as F
+from torch.jit._recursive import wrap_cpp_module
+
+
+class BasicBlock(nn.Module):
+    def __init__(self, in_c, out_c, stride):
+        super(BasicBlock, self).__init__()
+        self.conv1 = nn.Conv2d(in_c, out_c, 3, stride=stride, padding=1, bias=False)
+        self.bn1 = nn.BatchNorm2d(out_c)
+        self.conv2 = nn.Conv2d(out_c, out_c, 3, padding=1, bias=False)
+        self.bn2 = nn.BatchNorm2d(out_c)
+        self.downsample = nn.Sequential()
+        if stride != 1 or in_c != out_c:
+            self.downsample = nn.Sequential(
+                nn.Conv2d(in_c, out_c, 1, stride=stride, bias=False),
+                nn.BatchNorm2d(out_c))
+
+    def forward(self, x):
+        out = F.relu(self.bn1(self.conv1(x)))
+        out = self.bn2(self.conv2(out))
+        return F.relu(out + self.downsample(x))
+
+
+class ResNet(nn.Module):
+    def __init__(self, widths=(64, 128, 256, 512), blocks=2, num_classes=1000):
+        super(ResNet, self).__init__()
+        self.conv1 = nn.Conv2d(3, widths[0], 7, stride=2, padding=3, bias=False)
+        self.bn1 = nn.BatchNorm2d(widths[0])
+        layers = []
+        in_c = widths[0]
+        for i, width in enumerate(widths):
+            for j in range(blocks):
+                stride = 2 if i > 0 and j == 0 else 1
+                layers.append(BasicBlock(in_c, width, stride))
+                in_c = width
+        self.layers = nn.Sequential(*layers)
+        self.fc = nn.Linear(in_c, num_classes)
+
+    def forward(self, x):
+        x = F.relu(self.bn1(self.conv1(x)))
+        x = F.max_pool2d(x, 3, 2, 1)
+        x = self.layers(x)
+        x = torch.flatten(F.adaptive_avg_pool2d(x, 1), 1)
+        return self.fc(x)
+
+
+def time_ms(module, x, iters):
+    with torch.no_grad():
+        for _ in range(3):
+            module(x)
+        start = time.time()
+        for _ in range(iters):
+            module(x)
+    return (time.time() - start) / iters * 1e3
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--iters', type=int, default=20)
+    parser.add_argument('--batch-sizes', type=int, nargs='+', default=[1, 8])
+    parser.add_argument('--image-size', type=int, default=224)
+    args = parser.parse_args()
+
+    scripted = torch.jit.script(ResNet()).eval()
+    optimized = wrap_cpp_module(torch._C._optimize_for_inference(scripted._c))
+
+    print('{:<8} {:>14} {:>14} {:>10}'.format('N', 'scripted ms', 'optimized ms', 'speedup'))
+    for n in args.batch_sizes:
+        x = torch.rand(n, 3, args.image_size, args.image_size)
+        with torch.no_grad():
+            torch.testing.assert_allclose(optimized(x), scripted(x), rtol=1e-3, atol=1e-3)
+        base = time_ms(scripted, x, args.iters)
+        opt = time_ms(optimized, x, args.iters)
+        print('{:<8} {:>14.3f} {:>14.3f} {:>9.2f}x'.format(n, base, opt, base / opt))
+
+
+if __name__ == '__main__':
+    main()
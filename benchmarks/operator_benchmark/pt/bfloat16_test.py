@@ -0,0 +1,119 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""
+Microbenchmarks for the CPU bfloat16 kernels, with float32 as the baseline.
+
+Elementwise ops use Vec256<BFloat16>, which converts to float and back in
+registers; sum, softmax, layer_norm and addmm accumulate in float.
+"""
+
+
+bfloat16_configs_short = op_bench.config_list(
+    attr_names=['M', 'N'],
+    attrs=[
+        [512, 512],
+    ],
+    cross_product_configs={
+        'dtype': [torch.float, torch.bfloat16],
+    },
+    tags=['short']
+)
+
+
+bfloat16_configs_long = op_bench.cross_product_configs(
+    M=[64, 1024],
+    N=[64, 1000, 4096],
+    dtype=[torch.float, torch.bfloat16],
+    tags=['long']
+)
+
+
+bfloat16_unary_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['neg', torch.neg],
+        ['exp', torch.exp],
+        ['log', torch.log],
+        ['sqrt', torch.sqrt],
+        ['rsqrt', torch.rsqrt],
+        ['sigmoid', torch.sigmoid],
+        ['tanh', torch.tanh],
+        ['clamp', lambda x: torch.clamp(x, 0.25, 0.75)],
+        ['sum', torch.sum],
+        ['sum_dim0', lambda x: torch.sum(x, 0)],
+        ['sum_dim1', lambda x: torch.sum(x, 1)],
+        ['softmax', lambda x: torch.softmax(x, -1)],
+        ['log_softmax', lambda x: torch.log_softmax(x, -1)],
+        ['layer_norm', lambda x: torch.nn.functional.layer_norm(x, x.shape[-1:])],
+    ],
+)
+
+
+class BFloat16UnaryBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dtype, op_func):
+        self.input_one = torch.rand(M, N).to(dtype) + 0.5
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one)
+
+
+bfloat16_binary_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['add', torch.add],
+        ['mul', torch.mul],
+        ['div', torch.div],
+    ],
+)
+
+
+class BFloat16BinaryBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dtype, op_func):
+        self.input_one = torch.rand(M, N).to(dtype) + 0.5
+        self.input_two = torch.rand(M, N).to(dtype) + 0.5
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one, self.input_two)
+
+
+bfloat16_addmm_configs = op_bench.cross_product_configs(
+    M=[64, 256],
+    N=[256, 1024],
+    K=[256, 1024],
+    dtype=[torch.float, torch.bfloat16],
+    tags=['short', 'long']
+)
+
+
+class BFloat16AddmmBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, K, dtype):
+        self.input_one = torch.rand(M, N).to(dtype)
+        self.mat1 = torch.rand(M, K).to(dtype)
+        self.mat2 = torch.rand(K, N).to(dtype)
+        self.set_module_name('addmm')
+
+    def forward(self):
+        return torch.addmm(self.input_one, self.mat1, self.mat2)
+
+
+op_bench.generate_pt_tests_from_op_list(bfloat16_unary_ops_list,
+                                        bfloat16_configs_short + bfloat16_configs_long,
+                                        BFloat16UnaryBenchmark)
+op_bench.generate_pt_tests_from_op_list(bfloat16_binary_ops_list,
+                                        bfloat16_configs_short + bfloat16_configs_long,
+                                        BFloat16BinaryBenchmark)
+op_bench.generate_pt_test(bfloat16_addmm_configs, BFloat16AddmmBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
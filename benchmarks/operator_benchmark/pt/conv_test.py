@@ -125,6 +125,59 @@ op_bench.generate_pt_test(conv_2d_configs_short + conv_2d_configs_long,
                           ConvTranspose2dBenchmark)
 
 
+# Inference configs for the CPU conv2d paths that run without grad: Winograd
+# for stride-1 3x3 kernels when torch.backends.winograd is enabled, and direct
+# convolution for other small kernels.
+# Compare with Conv2d on the same configs, which always uses im2col + GEMM
+# because its parameters require grad.
+conv_2d_inference_configs = op_bench.config_list(
+    attr_names=[
+        'in_c', 'out_c', 'kernel', 'stride', 'N', 'H', 'W'
+    ],
+    attrs=[
+        [64, 64, 3, 1, 1, 56, 56],
+        [128, 128, 3, 1, 1, 28, 28],
+        [16, 32, 3, 1, 1, 14, 14],
+        [3, 32, 3, 2, 1, 224, 224],
+        [16, 16, 3, 2, 1, 56, 56],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+    },
+    tags=['short']
+)
+
+conv_2d_inference_winograd_configs = op_bench.cross_product_configs(
+    in_c=[64],
+    out_c=[64],
+    kernel=[3],
+    stride=[1],
+    N=[1],
+    H=[56],
+    W=[56],
+    device=['cpu'],
+    winograd=[False, True],
+    tags=['short']
+)
+
+
+class Conv2dInferenceBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, in_c, out_c, kernel, stride, N, H, W, device, winograd=False):
+        self.input = torch.rand(N, in_c, H, W, device=device)
+        self.conv2d = nn.Conv2d(in_c, out_c, kernel, stride=stride).to(device=device)
+        self.winograd = winograd
+        self.set_module_name('Conv2dInference')
+
+    def forward(self):
+        with torch.no_grad(), torch.backends.winograd.flags(enabled=self.winograd):
+            return self.conv2d(self.input)
+
+
+op_bench.generate_pt_test(conv_2d_inference_configs + conv_2d_inference_winograd_configs,
+                          Conv2dInferenceBenchmark)
+op_bench.generate_pt_test(conv_2d_inference_configs, Conv2dBenchmark)
+
+
 """
 Microbenchmarks for Conv3d and ConvTranspose3d operators.
 """
@@ -0,0 +1,133 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""
+Microbenchmarks for the CPU kernels that have an AVX512 implementation.
+
+The kernel is chosen once per process, so compare the capabilities by running
+this file once for each of them, e.g.
+
+  ATEN_CPU_CAPABILITY=avx2 python -m pt.cpu_capability_test
+  ATEN_CPU_CAPABILITY=avx512 python -m pt.cpu_capability_test
+
+On machines without AVX512, or builds without the AVX512 kernels, the second
+run falls back to AVX2.
+"""
+
+
+cpu_capability_configs_short = op_bench.config_list(
+    attr_names=['M', 'N'],
+    attrs=[
+        [512, 512],
+    ],
+    cross_product_configs={
+        'dtype': [torch.float, torch.double],
+    },
+    tags=['short']
+)
+
+
+cpu_capability_configs_long = op_bench.cross_product_configs(
+    M=[64, 1024],
+    N=[64, 1000, 4096],
+    dtype=[torch.float, torch.double],
+    tags=['long']
+)
+
+
+cpu_capability_int_configs_long = op_bench.cross_product_configs(
+    M=[1024],
+    N=[1000, 4096],
+    dtype=[torch.int32, torch.int64],
+    tags=['long']
+)
+
+
+cpu_capability_unary_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['neg', torch.neg],
+        ['reciprocal', torch.reciprocal],
+        ['rsqrt', torch.rsqrt],
+        ['sigmoid', torch.sigmoid],
+        ['clamp', lambda x: torch.clamp(x, 0.25, 0.75)],
+        ['sum', torch.sum],
+        ['sum_dim0', lambda x: torch.sum(x, 0)],
+        ['sum_dim1', lambda x: torch.sum(x, 1)],
+        ['softmax', lambda x: torch.softmax(x, -1)],
+        ['log_softmax', lambda x: torch.log_softmax(x, -1)],
+    ],
+)
+
+
+class CpuCapabilityUnaryBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dtype, op_func):
+        self.input_one = torch.rand(M, N, dtype=dtype) + 0.5
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one)
+
+
+cpu_capability_binary_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['add', torch.add],
+        ['sub', torch.sub],
+        ['mul', torch.mul],
+        ['div', torch.div],
+    ],
+)
+
+
+class CpuCapabilityBinaryBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dtype, op_func):
+        if dtype.is_floating_point:
+            self.input_one = torch.rand(M, N, dtype=dtype) + 0.5
+            self.input_two = torch.rand(M, N, dtype=dtype) + 0.5
+        else:
+            self.input_one = torch.randint(1, 100, (M, N), dtype=dtype)
+            self.input_two = torch.randint(1, 100, (M, N), dtype=dtype)
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one, self.input_two)
+
+
+qrelu_configs = op_bench.cross_product_configs(
+    M=[512],
+    N=[512, 4096],
+    dtype=[torch.quint8, torch.qint8],
+    tags=['short', 'long']
+)
+
+
+class CpuCapabilityQReLUBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dtype):
+        f_input = torch.randn(M, N)
+        self.q_input = torch.quantize_per_tensor(f_input, scale=0.05, zero_point=10, dtype=dtype)
+        self.set_module_name('qrelu')
+
+    def forward(self):
+        return torch.relu(self.q_input)
+
+
+op_bench.generate_pt_tests_from_op_list(cpu_capability_unary_ops_list,
+                                        cpu_capability_configs_short + cpu_capability_configs_long,
+                                        CpuCapabilityUnaryBenchmark)
+op_bench.generate_pt_tests_from_op_list(cpu_capability_binary_ops_list,
+                                        cpu_capability_configs_short + cpu_capability_configs_long +
+                                        cpu_capability_int_configs_long,
+                                        CpuCapabilityBinaryBenchmark)
+op_bench.generate_pt_test(qrelu_configs, CpuCapabilityQReLUBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
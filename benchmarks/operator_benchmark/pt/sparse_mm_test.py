@@ -0,0 +1,75 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+"""Microbenchmarks for sparse x dense mm and mv, comparing the CSR and COO layouts."""
+
+sparse_mm_configs_short = op_bench.cross_product_configs(
+    M=[512],
+    N=[512],
+    K=[64],
+    density=[0.01, 0.1],
+    layout=['coo', 'csr'],
+    tags=['short'],
+)
+
+sparse_mm_configs_long = op_bench.cross_product_configs(
+    M=[4096],
+    N=[4096, 1024],
+    K=[1, 128],
+    density=[0.001, 0.01, 0.1],
+    layout=['coo', 'csr'],
+    tags=['long'],
+)
+
+sparse_mv_configs = op_bench.cross_product_configs(
+    M=[512, 4096],
+    N=[512, 4096],
+    density=[0.001, 0.01, 0.1],
+    layout=['coo', 'csr'],
+    tags=['short'],
+)
+
+
+def make_sparse(M, N, density, layout):
+    dense = torch.rand(M, N)
+    dense = dense * (torch.rand(M, N) < density).float()
+    if layout == 'csr':
+        return dense.to_sparse_csr()
+    return dense.to_sparse().coalesce()
+
+
+class SparseMMBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, K, density, layout):
+        self.sparse = make_sparse(M, N, density, layout)
+        self.dense = torch.rand(N, K)
+        self.set_module_name('sparse_mm')
+
+    def forward(self):
+        return torch.mm(self.sparse, self.dense)
+
+
+# COO has no mv kernel, so its baseline is mm with a single column.
+class SparseMVBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, density, layout):
+        self.sparse = make_sparse(M, N, density, layout)
+        self.layout = layout
+        self.vec = torch.rand(N) if layout == 'csr' else torch.rand(N, 1)
+        self.set_module_name('sparse_mv')
+
+    def forward(self):
+        if self.layout == 'csr':
+            return torch.mv(self.sparse, self.vec)
+        return torch.mm(self.sparse, self.vec)
+
+
+op_bench.generate_pt_test(sparse_mm_configs_short + sparse_mm_configs_long, SparseMMBenchmark)
+op_bench.generate_pt_test(sparse_mv_configs, SparseMVBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
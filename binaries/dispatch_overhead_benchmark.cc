@@ -0,0 +1,84 @@
+#include "benchmark/benchmark.h"
+
+#include <ATen/ATen.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <torch/csrc/autograd/variable.h>
+
+// Measures the overhead of calling a trivial operator through the c10
+// dispatcher, with and without a per-callsite DispatchCache, for kernels
+// found in the dispatch table and for catch-all kernels. The last case calls
+// a generated at:: function on a Variable, whose VariableType kernel
+// dispatches through the same callsite again with the backend key.
+
+namespace {
+
+void noopKernel(at::Tensor) {}
+
+auto registry = c10::RegisterOperators()
+    .op("_bench::dispatched(Tensor dummy) -> ()", c10::RegisterOperators::options()
+        .kernel<decltype(noopKernel), &noopKernel>(c10::TensorTypeId::CPUTensorId))
+    .op("_bench::catchall(Tensor dummy) -> ()", c10::RegisterOperators::options()
+        .catchAllKernel<decltype(noopKernel), &noopKernel>());
+
+c10::OperatorHandle findOp(const char* name) {
+  return c10::Dispatcher::singleton().findSchema({name, ""}).value();
+}
+
+void callUnboxed(benchmark::State& state, const char* name) {
+  auto op = findOp(name);
+  auto tensor = at::empty({1});
+  for (auto _ : state) {
+    op.callUnboxed<void, at::Tensor>(tensor);
+  }
+}
+
+void callUnboxedWithCache(benchmark::State& state, const char* name) {
+  auto op = findOp(name);
+  auto tensor = at::empty({1});
+  c10::DispatchCache cache;
+  for (auto _ : state) {
+    op.callUnboxedWithCache<void, at::Tensor>(cache, tensor);
+  }
+}
+
+void callBoxed(benchmark::State& state, const char* name) {
+  auto op = findOp(name);
+  auto tensor = at::empty({1});
+  c10::Stack stack;
+  for (auto _ : state) {
+    stack.emplace_back(tensor);
+    op.callBoxed(&stack);
+  }
+}
+
+void callBoxedWithCache(benchmark::State& state, const char* name) {
+  auto op = findOp(name);
+  auto tensor = at::empty({1});
+  c10::Stack stack;
+  c10::DispatchCache cache;
+  for (auto _ : state) {
+    stack.emplace_back(tensor);
+    op.callBoxedWithCache(cache, &stack);
+  }
+}
+
+void callGeneratedOnVariable(benchmark::State& state) {
+  auto variable = torch::autograd::make_variable(at::empty({1}));
+  for (auto _ : state) {
+    at::zero_(variable);
+  }
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(callUnboxed, dispatched, "_bench::dispatched");
+BENCHMARK_CAPTURE(callUnboxedWithCache, dispatched, "_bench::dispatched");
+BENCHMARK_CAPTURE(callBoxed, dispatched, "_bench::dispatched");
+BENCHMARK_CAPTURE(callBoxedWithCache, dispatched, "_bench::dispatched");
+BENCHMARK_CAPTURE(callUnboxed, catchall, "_bench::catchall");
+BENCHMARK_CAPTURE(callUnboxedWithCache, catchall, "_bench::catchall");
+BENCHMARK_CAPTURE(callBoxed, catchall, "_bench::catchall");
+BENCHMARK_CAPTURE(callBoxedWithCache, catchall, "_bench::catchall");
+BENCHMARK(callGeneratedOnVariable);
+
+BENCHMARK_MAIN();
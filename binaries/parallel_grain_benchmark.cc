@@ -0,0 +1,350 @@
+#include "ATen/ATen.h"
+#include "ATen/Parallel.h"
+#include "ATen/cpu/vml.h"
+#include "ATen/native/cpu/CostHints.h"
+
+#include "c10/util/Flags.h"
+#include "caffe2/core/init.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Calibrates the cost hints used to pick the grain size of element-wise
+// TensorIterator kernels (see at::internal::grain_size_for_cost).
+//
+// For every op this measures the single-threaded cost per element and the
+// overhead of entering a parallel region, and from those derives the input
+// size at which splitting the op across threads starts to pay off on this
+// host. It prints the grain size the kernel is compiled with next to the one
+// the measured cost would give. It then times the op on a range of sizes with one and with all
+// intra-op threads to show where the current hints actually parallelize.
+//
+// Finally it compares the at::vml loops, which split their work according to
+// the same hints (see at::vml::vml_grain_size), with the fixed chunks of
+// 2048 elements they used before.
+
+C10_DEFINE_int(intra_op_threads, 0, "Number of intra-op threads");
+C10_DEFINE_double(ghz, 2.5, "Core clock in GHz, used to convert time to cycles");
+C10_DEFINE_int(min_size_pow, 8, "Smallest tensor size swept, 2^N elements");
+C10_DEFINE_int(max_size_pow, 22, "Largest tensor size swept, 2^N elements");
+C10_DEFINE_int(
+    calibration_size_pow,
+    20,
+    "Size used to measure the per-element cost, 2^N elements");
+C10_DEFINE_double(min_time_ms, 20, "Minimum time spent timing each point");
+C10_DEFINE_string(ops, "", "Comma separated list of ops to run, all if empty");
+C10_DEFINE_bool(sweep, true, "Time every size of the sweep with 1 and N threads");
+C10_DEFINE_bool(vml, true, "Compare the at::vml loops with their old grain size");
+
+namespace {
+
+using op_fn = std::function<void(at::Tensor&, const at::Tensor&, const at::Tensor&)>;
+
+struct OpCase {
+  std::string name;
+  op_fn fn;
+  // Range of the inputs; some ops are only defined on part of the real line.
+  double low;
+  double high;
+  // The cost hint compiled into the kernel, and whether the kernel is
+  // computed by the at::vml loops, which derive their grain size from it
+  // differently.
+  double cost;
+  bool vml;
+};
+
+// The grain size a kernel with the given cost hint passes to
+// TensorIterator::for_each or, for the at::vml loops, to parallel_for.
+int64_t grain_size(const OpCase& op, double cost) {
+  return op.vml ? at::vml::vml_grain_size(cost)
+                : at::internal::grain_size_for_cost(cost);
+}
+
+std::vector<OpCase> all_ops() {
+  return {
+      {"add", [](at::Tensor& out, const at::Tensor& a, const at::Tensor& b) {
+         at::add_out(out, a, b);
+       }, -1, 1,
+       at::native::kAddCost, false},
+      {"mul", [](at::Tensor& out, const at::Tensor& a, const at::Tensor& b) {
+         at::mul_out(out, a, b);
+       }, -1, 1,
+       at::native::kMulCost, false},
+      {"div", [](at::Tensor& out, const at::Tensor& a, const at::Tensor& b) {
+         at::div_out(out, a, b);
+       }, 1, 2,
+       // no hint, i.e. GRAIN_SIZE
+       1, false},
+      {"exp", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::exp_out(out, a);
+       }, -1, 1,
+       at::vml::vexp_cost, true},
+      {"log", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::log_out(out, a);
+       }, 1, 2,
+       at::vml::vlog_cost, true},
+      {"sin", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::sin_out(out, a);
+       }, -1, 1,
+       at::vml::vsin_cost, true},
+      {"tanh", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::tanh_out(out, a);
+       }, -1, 1,
+       at::vml::vtanh_cost, true},
+      {"sigmoid", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::sigmoid_out(out, a);
+       }, -1, 1,
+       at::native::kSigmoidCost, false},
+      {"sinh", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::sinh_out(out, a);
+       }, -1, 1,
+       at::native::kHyperbolicCost, false},
+      {"erf", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::erf_out(out, a);
+       }, -1, 1,
+       at::vml::verf_cost, true},
+      {"erfinv", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::erfinv_out(out, a);
+       }, -0.9, 0.9,
+       at::vml::verfinv_cost, true},
+      {"lgamma", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::lgamma_out(out, a);
+       }, 1, 2,
+       at::vml::vlgamma_cost, true},
+      {"digamma", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::digamma_out(out, a);
+       }, 1, 2,
+       at::native::kPolygammaCost, false},
+      {"pow", [](at::Tensor& out, const at::Tensor& a, const at::Tensor&) {
+         at::pow_out(out, a, 2.5);
+       }, 1, 2,
+       at::native::kPowCost, false},
+      {"atan2", [](at::Tensor& out, const at::Tensor& a, const at::Tensor& b) {
+         at::atan2_out(out, a, b);
+       }, -1, 1,
+       at::native::kAtan2Cost, false},
+  };
+}
+
+using vml_fn = void (*)(float*, const float*, int64_t);
+
+struct VmlCase {
+  std::string name;
+  vml_fn fn;
+  // the cost compiled into the loop
+  double cost;
+  double low;
+  double high;
+};
+
+std::vector<VmlCase> all_vml_ops() {
+  return {
+      {"abs", at::vml::vabs<float>, at::vml::vabs_cost, -1, 1},
+      {"floor", at::vml::vfloor<float>, at::vml::vfloor_cost, -1, 1},
+      {"sqrt", at::vml::vsqrt<float>, at::vml::vsqrt_cost, 1, 2},
+      {"exp", at::vml::vexp<float>, at::vml::vexp_cost, -1, 1},
+      {"log", at::vml::vlog<float>, at::vml::vlog_cost, 1, 2},
+      {"tanh", at::vml::vtanh<float>, at::vml::vtanh_cost, -1, 1},
+      {"sin", at::vml::vsin<float>, at::vml::vsin_cost, -1, 1},
+      {"erfinv", at::vml::verfinv<float>, at::vml::verfinv_cost, -0.9, 0.9},
+      {"lgamma", at::vml::vlgamma<float>, at::vml::vlgamma_cost, 1, 2},
+  };
+}
+
+bool op_selected(const std::string& name) {
+  if (FLAGS_ops.empty()) {
+    return true;
+  }
+  std::stringstream ss(FLAGS_ops);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (item == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the average wall time of `fn` in nanoseconds.
+double time_ns(const std::function<void()>& fn) {
+  typedef std::chrono::high_resolution_clock clock;
+  // Warm up caches and the thread pool.
+  fn();
+  int64_t iters = 1;
+  while (true) {
+    auto start = clock::now();
+    for (int64_t i = 0; i < iters; ++i) {
+      fn();
+    }
+    double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         clock::now() - start)
+                         .count();
+    if (elapsed >= FLAGS_min_time_ms * 1e6 || iters >= (1 << 24)) {
+      return elapsed / iters;
+    }
+    iters *= 2;
+  }
+}
+
+double measure_parallel_overhead_ns(int num_threads) {
+  at::set_num_threads(num_threads);
+  std::vector<int64_t> sink(num_threads);
+  return time_ns([&]() {
+    at::parallel_for(0, num_threads, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        sink[i] += i;
+      }
+    });
+  });
+}
+
+double run_ns(const OpCase& op, int64_t size, int num_threads) {
+  at::set_num_threads(num_threads);
+  auto a = at::empty({size}, at::kFloat).uniform_(op.low, op.high);
+  auto b = at::empty({size}, at::kFloat).uniform_(op.low, op.high);
+  auto out = at::empty({size}, at::kFloat);
+  return time_ns([&]() { op.fn(out, a, b); });
+}
+
+void sweep(const std::vector<OpCase>& ops, int num_threads) {
+  std::cout << std::endl
+            << "Speedup of " << num_threads
+            << " threads over 1 thread with the hints compiled into the "
+               "kernels:"
+            << std::endl;
+  std::cout << std::left << std::setw(10) << "op" << std::right;
+  for (int p = FLAGS_min_size_pow; p <= FLAGS_max_size_pow; p += 2) {
+    std::cout << std::setw(8) << ("2^" + std::to_string(p));
+  }
+  std::cout << std::endl;
+  for (const auto& op : ops) {
+    std::cout << std::left << std::setw(10) << op.name << std::right;
+    for (int p = FLAGS_min_size_pow; p <= FLAGS_max_size_pow; p += 2) {
+      const int64_t size = int64_t(1) << p;
+      const double serial_ns = run_ns(op, size, 1);
+      const double parallel_ns = run_ns(op, size, num_threads);
+      std::cout << std::setw(8) << std::fixed << std::setprecision(2)
+                << serial_ns / parallel_ns;
+    }
+    std::cout << std::defaultfloat << std::endl;
+  }
+}
+
+// Speedup of the hinted grain sizes over the old fixed grain size, both
+// with all threads. Nested parallel_for calls run serially, so running the
+// loop on chunks of 2048 elements reproduces the old behavior.
+void compare_vml(int num_threads) {
+  at::set_num_threads(num_threads);
+  std::cout << std::endl
+            << "Speedup of the at::vml loops with their hinted grain size "
+               "over a grain size of "
+            << at::vml::kVmlGrainSize << ", " << num_threads << " threads:"
+            << std::endl;
+#if AT_MKL_ENABLED()
+  std::cout << "(built with MKL, whose float loops ignore the grain size)"
+            << std::endl;
+#endif
+  std::cout << std::left << std::setw(10) << "op" << std::right
+            << std::setw(8) << "grain";
+  for (int p = FLAGS_min_size_pow; p <= FLAGS_max_size_pow; p += 2) {
+    std::cout << std::setw(8) << ("2^" + std::to_string(p));
+  }
+  std::cout << std::endl;
+  for (const auto& op : all_vml_ops()) {
+    if (!op_selected(op.name)) {
+      continue;
+    }
+    std::cout << std::left << std::setw(10) << op.name << std::right
+              << std::setw(8) << at::vml::vml_grain_size(op.cost);
+    for (int p = FLAGS_min_size_pow; p <= FLAGS_max_size_pow; p += 2) {
+      const int64_t size = int64_t(1) << p;
+      auto in = at::empty({size}, at::kFloat).uniform_(op.low, op.high);
+      auto out = at::empty({size}, at::kFloat);
+      const float* in_data = in.data_ptr<float>();
+      float* out_data = out.data_ptr<float>();
+      const double hinted_ns =
+          time_ns([&]() { op.fn(out_data, in_data, size); });
+      const double fixed_ns = time_ns([&]() {
+        at::parallel_for(
+            0, size, at::vml::kVmlGrainSize, [&](int64_t begin, int64_t end) {
+              op.fn(out_data + begin, in_data + begin, end - begin);
+            });
+      });
+      std::cout << std::setw(8) << std::fixed << std::setprecision(2)
+                << fixed_ns / hinted_ns;
+    }
+    std::cout << std::defaultfloat << std::endl;
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (!c10::ParseCommandLineFlags(&argc, &argv)) {
+    std::cout << "Failed to parse command line flags" << std::endl;
+    return -1;
+  }
+  caffe2::unsafeRunCaffe2InitFunction("registerThreadPools");
+  at::init_num_threads();
+
+  if (FLAGS_intra_op_threads > 0) {
+    at::set_num_threads(FLAGS_intra_op_threads);
+  }
+  const int num_threads = at::get_num_threads();
+  if (num_threads < 2) {
+    std::cout << "Need at least two intra-op threads to calibrate, got "
+              << num_threads << std::endl;
+    return -1;
+  }
+
+  const double overhead_ns = measure_parallel_overhead_ns(num_threads);
+  std::cout << "Intra-op threads: " << num_threads
+            << ", parallel region overhead: " << overhead_ns << " ns ("
+            << overhead_ns * FLAGS_ghz << " cycles at " << FLAGS_ghz
+            << " GHz), default grain size: " << at::internal::GRAIN_SIZE
+            << std::endl
+            << std::endl;
+
+  std::cout << std::left << std::setw(10) << "op" << std::right
+            << std::setw(14) << "ns/elem" << std::setw(16) << "cycles/elem"
+            << std::setw(16) << "break-even" << std::setw(16)
+            << "kernel grain" << std::setw(16) << "measured grain"
+            << std::endl;
+
+  const int64_t calibration_size = int64_t(1) << FLAGS_calibration_size_pow;
+  std::vector<OpCase> ops;
+  for (const auto& op : all_ops()) {
+    if (!op_selected(op.name)) {
+      continue;
+    }
+    ops.push_back(op);
+    const double serial_ns = run_ns(op, calibration_size, 1);
+    const double ns_per_element = serial_ns / calibration_size;
+    const double cycles_per_element = ns_per_element * FLAGS_ghz;
+    // Smallest n for which overhead + n * c / T < n * c.
+    const double break_even = overhead_ns /
+        (ns_per_element * (1.0 - 1.0 / num_threads));
+    std::cout << std::left << std::setw(10) << op.name << std::right
+              << std::setw(14) << std::setprecision(4) << ns_per_element
+              << std::setw(16) << cycles_per_element << std::setw(16)
+              << static_cast<int64_t>(break_even) << std::setw(16)
+              << grain_size(op, op.cost) << std::setw(16)
+              << grain_size(op, cycles_per_element)
+              << std::endl;
+  }
+
+  if (FLAGS_sweep) {
+    sweep(ops, num_threads);
+  }
+  if (FLAGS_vml) {
+    compare_vml(num_threads);
+  }
+  return 0;
+}
+
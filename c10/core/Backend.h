@@ -25,7 +25,7 @@ namespace c10 {
  * or "SparseCUDA"; backend in torch.backends is something like "MKL" or
  * "CUDNN".
  */
-enum class Backend { CPU, CUDA, HIP, SparseCPU, SparseCUDA, SparseHIP, MSNPU, XLA, QuantizedCPU, ComplexCPU, ComplexCUDA, Undefined, MkldnnCPU, NumOptions };
+enum class Backend { CPU, CUDA, HIP, SparseCPU, SparseCUDA, SparseHIP, MSNPU, XLA, QuantizedCPU, ComplexCPU, ComplexCUDA, Undefined, MkldnnCPU, SparseCsrCPU, NumOptions };
 
 static inline Backend toSparse(Backend b) {
   switch (b) {
@@ -64,6 +64,8 @@ static inline Backend toDense(Backend b) {
       return Backend::CUDA;
     case Backend::SparseHIP:
       return Backend::HIP;
+    case Backend::SparseCsrCPU:
+      return Backend::CPU;
     case Backend::QuantizedCPU:
       return Backend::QuantizedCPU;
     case Backend::ComplexCPU:
@@ -92,6 +94,8 @@ static inline Backend tensorTypeIdToBackend(TensorTypeId t) {
     return Backend::SparseCUDA;
   } else if (t == TensorTypeId::SparseHIPTensorId) {
     return Backend::SparseHIP;
+  } else if (t == TensorTypeId::SparseCsrCPUTensorId) {
+    return Backend::SparseCsrCPU;
   } else if (t == TensorTypeId::MkldnnCPUTensorId) {
     return Backend::MkldnnCPU;
   } else if (t == TensorTypeId::QuantizedCPUTensorId) {
@@ -125,6 +129,8 @@ static inline TensorTypeId backendToTensorTypeId(Backend b) {
       return TensorTypeId::SparseCUDATensorId;
     case Backend::SparseHIP:
       return TensorTypeId::SparseHIPTensorId;
+    case Backend::SparseCsrCPU:
+      return TensorTypeId::SparseCsrCPUTensorId;
     case Backend::MkldnnCPU:
       return TensorTypeId::MkldnnCPUTensorId;
     case Backend::QuantizedCPU:
@@ -158,6 +164,7 @@ static inline DeviceType backendToDeviceType(Backend b) {
       return DeviceType::CUDA;
     case Backend::SparseHIP:
       return DeviceType::HIP;
+    case Backend::SparseCsrCPU:
     case Backend::MkldnnCPU:
     case Backend::QuantizedCPU:
     case Backend::ComplexCPU:
@@ -188,6 +195,8 @@ static inline Backend backendToCPU(Backend b) {
     case Backend::MSNPU:
     case Backend::XLA:
       return Backend::CPU;
+    case Backend::SparseCsrCPU:
+      return Backend::SparseCsrCPU;
     case Backend::MkldnnCPU:
       return Backend::MkldnnCPU;
     case Backend::QuantizedCPU:
@@ -262,6 +271,8 @@ static inline const char* toString(Backend b) {
       return "SparseCUDA";
     case Backend::SparseHIP:
       return "SparseHIP";
+    case Backend::SparseCsrCPU:
+      return "SparseCsrCPU";
     case Backend::MkldnnCPU:
       return "MkldnnCPU";
     case Backend::QuantizedCPU:
@@ -6,11 +6,12 @@
 #include <iostream>
 
 namespace c10 {
-enum class Layout : int8_t { Strided, Sparse, Mkldnn };
+enum class Layout : int8_t { Strided, Sparse, Mkldnn, SparseCsr };
 
 constexpr auto kStrided = Layout::Strided;
 constexpr auto kSparse = Layout::Sparse;
 constexpr auto kMkldnn = Layout::Mkldnn;
+constexpr auto kSparseCsr = Layout::SparseCsr;
 
 inline Layout layout_from_backend(Backend backend) {
   switch (backend) {
@@ -18,6 +19,8 @@ inline Layout layout_from_backend(Backend backend) {
     case Backend::SparseCUDA:
     case Backend::SparseHIP:
       return Layout::Sparse;
+    case Backend::SparseCsrCPU:
+      return Layout::SparseCsr;
     case Backend::MkldnnCPU:
       return Layout::Mkldnn;
     default:
@@ -33,6 +36,8 @@ inline std::ostream& operator<<(std::ostream& stream, at::Layout layout) {
       return stream << "Sparse";
     case at::kMkldnn:
       return stream << "Mkldnn";
+    case at::kSparseCsr:
+      return stream << "SparseCsr";
     default:
       AT_ERROR("Unknown layout");
   }
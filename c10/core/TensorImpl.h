@@ -449,6 +449,11 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     return type_set_.has(TensorTypeId::MkldnnCPUTensorId);
   }
 
+  bool is_sparse_csr() const {
+    // NB: This method is not virtual and avoid dispatches for performance reasons.
+    return type_set_.has(TensorTypeId::SparseCsrCPUTensorId);
+  }
+
   int64_t get_device() const {
     TORCH_CHECK(
         device_opt_.has_value(),
@@ -471,6 +476,8 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
       return kSparse;
     } else if (is_mkldnn()) {
       return kMkldnn;
+    } else if (is_sparse_csr()) {
+      return kSparseCsr;
     } else {
       return kStrided;
     }
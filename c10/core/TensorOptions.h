@@ -394,6 +394,13 @@ struct C10_API TensorOptions {
           default:
             AT_ERROR("Unsupported device type for mkldnn layout: ", device().type());
         }
+      case Layout::SparseCsr:
+        switch (device().type()) {
+          case DeviceType::CPU:
+            return TensorTypeId::SparseCsrCPUTensorId;
+          default:
+            AT_ERROR("Unsupported device type for sparse CSR layout: ", device().type());
+        }
       default:
         AT_ERROR("Unsupported layout: ", layout());
     }
@@ -591,6 +598,8 @@ inline DeviceType computeDeviceType(TensorTypeId tid) {
     return DeviceType::CUDA;
   } else if (tid == TensorTypeId::SparseHIPTensorId) {
     return DeviceType::HIP;
+  } else if (tid == TensorTypeId::SparseCsrCPUTensorId) {
+    return DeviceType::CPU;
   } else if (tid == TensorTypeId::MkldnnCPUTensorId) {
     return DeviceType::CPU;
   } else if (tid == TensorTypeId::ComplexCPUTensorId) {
@@ -14,6 +14,8 @@ const char* toString(TensorTypeId t) {
       return "SparseCPUTensorId";
     case TensorTypeId::SparseCUDATensorId:
       return "SparseCUDATensorId";
+    case TensorTypeId::SparseCsrCPUTensorId:
+      return "SparseCsrCPUTensorId";
     case TensorTypeId::MKLDNNTensorId:
       return "MKLDNNTensorId";
     case TensorTypeId::OpenGLTensorId:
@@ -1,6 +1,9 @@
 #include "caffe2/perfkernels/fused_8bit_rowwise_embedding_lookup_idx.h"
 
-#include "caffe2/core/types.h"
+#include <cstring>
+
+#include "caffe2/core/common.h"
+#include "caffe2/core/logging.h"
 #include "caffe2/perfkernels/common.h"
 #include "caffe2/utils/cpuid.h"
 
@@ -105,6 +105,11 @@ class CAFFE2_API PyTorchStreamReader final {
   // return dataptr, size
   std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
   size_t getRecordOffset(const std::string& name);
+  // size of the record once it is uncompressed
+  size_t getRecordSize(const std::string& name);
+  // whether the data at getRecordOffset needs to be uncompressed, i.e. the
+  // record can only be read with getRecord
+  bool isRecordCompressed(const std::string& name);
   bool hasRecord(const std::string& name);
   std::vector<std::string> getAllRecords();
 
@@ -119,6 +119,15 @@ if (INTERN_BUILD_ATEN_OPS)
     ENDIF(MSVC)
   ENDIF(CXX_AVX2_FOUND)
 
+  # Only the kernels that opt in with ALSO_REGISTER_AVX512_DISPATCH are
+  # compiled for AVX512 (see Note [AVX512 opt-in] in DispatchStub.h). The
+  # Vec512 intrinsics are not implemented for MSVC.
+  IF(CXX_AVX512_FOUND AND NOT MSVC)
+    SET(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DHAVE_AVX512_CPU_DEFINITION")
+    LIST(APPEND CPU_CAPABILITY_NAMES "AVX512")
+    LIST(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma ${CPU_NO_AVX256_SPLIT_FLAGS}")
+  ENDIF(CXX_AVX512_FOUND AND NOT MSVC)
+
   list(LENGTH CPU_CAPABILITY_NAMES NUM_CPU_CAPABILITY_NAMES)
   math(EXPR NUM_CPU_CAPABILITY_NAMES "${NUM_CPU_CAPABILITY_NAMES}-1")
 
@@ -126,6 +135,12 @@ if (INTERN_BUILD_ATEN_OPS)
     FOREACH(IMPL ${cpu_kernel_cpp_in})
       string(REPLACE "${CMAKE_CURRENT_LIST_DIR}/../aten/src/ATen/" "" NAME ${IMPL})
       LIST(GET CPU_CAPABILITY_NAMES ${i} CPU_CAPABILITY)
+      IF(CPU_CAPABILITY STREQUAL "AVX512")
+        FILE(STRINGS ${IMPL} AVX512_REGISTRATIONS REGEX "ALSO_REGISTER_AVX512_DISPATCH")
+        IF(NOT AVX512_REGISTRATIONS)
+          CONTINUE()
+        ENDIF()
+      ENDIF()
       SET(NEW_IMPL ${CMAKE_BINARY_DIR}/aten/src/ATen/${NAME}.${CPU_CAPABILITY}.cpp)
       CONFIGURE_FILE(${IMPL} ${NEW_IMPL} COPYONLY)
       SET(cpu_kernel_cpp ${NEW_IMPL} ${cpu_kernel_cpp}) # Create list of copies
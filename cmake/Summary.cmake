@@ -132,6 +132,9 @@ function (caffe2_print_configuration_summary)
   if(NOT "${SELECTED_OP_LIST}" STREQUAL "")
     message(STATUS "  SELECTED_OP_LIST    : ${SELECTED_OP_LIST}")
   endif()
+  if(NOT "${MOBILE_PRELINKED_OPS_MODELS}" STREQUAL "")
+    message(STATUS "  MOBILE_PRELINKED_OPS_MODELS : ${MOBILE_PRELINKED_OPS_MODELS}")
+  endif()
   message(STATUS "  Public Dependencies  : ${Caffe2_PUBLIC_DEPENDENCY_LIBS}")
   message(STATUS "  Private Dependencies : ${Caffe2_DEPENDENCY_LIBS}")
 endfunction()
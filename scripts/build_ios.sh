@@ -27,6 +27,10 @@ if [ -n "${BUILD_PYTORCH_MOBILE:-}" ]; then
   if [ -n "${SELECTED_OP_LIST}" ]; then
     CMAKE_ARGS+=("-DSELECTED_OP_LIST=${SELECTED_OP_LIST}")
   fi
+  # call the operators of these models through a prelinked table
+  if [ -n "${MOBILE_PRELINKED_OPS_MODELS}" ]; then
+    CMAKE_ARGS+=("-DMOBILE_PRELINKED_OPS_MODELS=${MOBILE_PRELINKED_OPS_MODELS}")
+  fi
   # bitcode
   if [ "${ENABLE_BITCODE:-}" == '1' ]; then
     CMAKE_ARGS+=("-DCMAKE_C_FLAGS=-fembed-bitcode")
@@ -31,6 +31,10 @@ CMAKE_ARGS+=("-DBUILD_SHARED_LIBS=OFF")
 if [ -n "${SELECTED_OP_LIST}" ]; then
   CMAKE_ARGS+=("-DSELECTED_OP_LIST=${SELECTED_OP_LIST}")
 fi
+# call the operators of these models through a prelinked table
+if [ -n "${MOBILE_PRELINKED_OPS_MODELS}" ]; then
+  CMAKE_ARGS+=("-DMOBILE_PRELINKED_OPS_MODELS=${MOBILE_PRELINKED_OPS_MODELS}")
+fi
 
 # If Ninja is installed, prefer it to Make
 if [ -x "$(command -v ninja)" ]; then
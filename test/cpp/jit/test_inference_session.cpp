@@ -0,0 +1,69 @@
+#include <test/cpp/jit/test_base.h>
+#include <test/cpp/jit/test_utils.h>
+#include <torch/csrc/jit/script/inference_session.h>
+#include <torch/torch.h>
+
+#include <atomic>
+#include <thread>
+
+namespace torch {
+namespace jit {
+
+using namespace torch::jit::script;
+
+void testInferenceSession() {
+  Module m("m");
+  m.register_parameter("weight", torch::ones({4, 4}), false);
+  m.define(R"(
+    def forward(self, x):
+        return torch.relu(torch.mm(x, self.weight))
+  )");
+
+  std::vector<std::vector<IValue>> example_inputs = {{torch::randn({2, 4})}};
+  InferenceSessionOptions options;
+  options.num_instances = 2;
+  InferenceSession session(m, example_inputs, options);
+  ASSERT_EQ(session.num_instances(), 2);
+  // warmup isn't part of the stats
+  ASSERT_EQ(session.stats().num_runs, 0);
+
+  constexpr size_t kThreads = 4;
+  constexpr size_t kRunsPerThread = 8;
+  auto input = torch::randn({2, 4});
+  auto expected = m.forward({input}).toTensor();
+  std::vector<std::thread> threads;
+  std::atomic<size_t> num_mismatches{0};
+  for (size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&] {
+      for (size_t run = 0; run < kRunsPerThread; ++run) {
+        auto output = session.run({input}).toTensor();
+        if (!output.allclose(expected)) {
+          num_mismatches++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(num_mismatches, 0);
+
+  auto stats = session.stats();
+  ASSERT_EQ(stats.num_runs, kThreads * kRunsPerThread);
+  ASSERT_TRUE(stats.max_ms >= stats.p99_ms);
+  ASSERT_TRUE(stats.p99_ms >= stats.p50_ms);
+  session.resetStats();
+  ASSERT_EQ(session.stats().num_runs, 0);
+
+  // the instances share the module's weights
+  m.attr("weight").toTensor().data().mul_(2);
+  ASSERT_TRUE(session.run({input}).toTensor().allclose(expected * 2));
+
+  InferenceSessionOptions missing_method;
+  missing_method.method_name = "predict";
+  ASSERT_THROWS_WITH(
+      InferenceSession(m, example_inputs, missing_method), "predict");
+}
+
+} // namespace jit
+} // namespace torch
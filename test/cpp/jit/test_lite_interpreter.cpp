@@ -3,7 +3,18 @@
 #include <torch/csrc/autograd/generated/variable_factories.h>
 #include <torch/csrc/jit/mobile/import.h>
 #include <torch/csrc/jit/mobile/module.h>
+#include <torch/csrc/jit/mobile/prelinked_ops.h>
 #include <torch/csrc/jit/import.h>
+#include <caffe2/serialize/inline_container.h>
+#include <c10/util/tempfile.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 // Tests go in torch::jit
 namespace torch {
@@ -127,5 +138,126 @@ void testLiteInterpreterPrimOverload() {
   auto output = bc.run_method("forward", inputs);
   AT_ASSERT(output.toIntList()[2] == 3);
 }
+
+namespace {
+size_t num_prelinked_adds = 0;
+
+int prelinkedAdd(Stack& stack) {
+  num_prelinked_adds++;
+  auto result = at::add(
+      peek(stack, 0, 3).toTensor(),
+      peek(stack, 1, 3).toTensor(),
+      peek(stack, 2, 3).toScalar());
+  drop(stack, 3);
+  pack(stack, std::move(result));
+  return 0;
+}
+
+const mobile::PrelinkedOperator prelinked_add_table[] = {
+    {"aten::add", "Tensor", prelinkedAdd},
+};
+} // namespace
+
+void testLiteInterpreterPrelinkedOps() {
+  script::Module m("m");
+  m.register_parameter("foo", torch::ones({}), false);
+  m.define(R"(
+    def add_it(self, x):
+      b = 4
+      return self.foo + x + b
+  )");
+  auto minput = 5 * torch::ones({});
+  auto ref = m.run_method("add_it", minput);
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+
+  num_prelinked_adds = 0;
+  {
+    mobile::RegisterPrelinkedOperators reg(prelinked_add_table);
+    ss.seekg(0);
+    mobile::Module bc = _load_for_mobile(ss);
+    // aten::add.Scalar isn't in the table and goes through the dispatcher
+    std::vector<IValue> inputs{minput};
+    auto res = bc.run_method("add_it", inputs);
+    ASSERT_EQ(num_prelinked_adds, 1);
+    ASSERT_TRUE(res.toTensor().equal(ref.toTensor()));
+  }
+
+  // the table is gone once reg is destroyed
+  ss.seekg(0);
+  mobile::Module bc = _load_for_mobile(ss);
+  std::vector<IValue> inputs{minput};
+  bc.run_method("add_it", inputs);
+  ASSERT_EQ(num_prelinked_adds, 1);
+}
+
+namespace {
+#ifdef __linux__
+// resident set size of this process in bytes
+size_t residentMemory() {
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+#endif
+} // namespace
+
+void testLiteInterpreterMmapLoad() {
+  // 16 MB of weights
+  auto weight = torch::rand({1024, 4096});
+  size_t weight_bytes = weight.numel() * weight.element_size();
+  script::Module m("m");
+  m.register_parameter("weight", weight, false);
+  m.define(R"(
+    def forward(self, x):
+      return self.weight + x
+
+    def get_weight(self):
+      return self.weight
+  )");
+  auto tempfile = c10::make_tempfile();
+  m._save_for_mobile(tempfile.name);
+
+#ifdef __linux__
+  size_t before = residentMemory();
+#endif
+  mobile::Module bc = _load_for_mobile_mmap(tempfile.name);
+#ifdef __linux__
+  size_t after = residentMemory();
+  std::cout << "resident memory before mmap load: " << before
+            << " bytes, after: " << after << " bytes, weights: "
+            << weight_bytes << " bytes" << std::endl;
+  // the weights haven't been paged in
+  ASSERT_TRUE(after < before + weight_bytes / 2);
+#endif
+
+  auto mapped_weight = bc.run_method("get_weight", {}).toTensor();
+  // the weight's storage is released by unmapping the file, and its data
+  // is the weight's record in the file
+  const void* mapped_file =
+      _mapped_file_base(mapped_weight.storage().data_ptr());
+  ASSERT_TRUE(mapped_file != nullptr);
+  size_t offset = static_cast<const char*>(mapped_weight.data_ptr()) -
+      static_cast<const char*>(mapped_file);
+  std::ifstream file(tempfile.name, std::ios::binary | std::ios::ate);
+  ASSERT_TRUE(offset + weight_bytes <= static_cast<size_t>(file.tellg()));
+  caffe2::serialize::PyTorchStreamReader reader(tempfile.name);
+  auto records = reader.getAllRecords();
+  auto record = std::find_if(
+      records.begin(), records.end(), [&](const std::string& name) {
+        return reader.getRecordOffset(name) == offset;
+      });
+  ASSERT_TRUE(record != records.end());
+  ASSERT_EQ(reader.getRecordSize(*record), weight_bytes);
+  ASSERT_TRUE(mapped_weight.equal(weight));
+  auto x = torch::ones({1024, 4096});
+  ASSERT_TRUE(bc.forward({x}).toTensor().equal(weight + x));
+
+  // the mapping is copy-on-write
+  mapped_weight.mul_(2);
+  mobile::Module reloaded = _load_for_mobile_mmap(tempfile.name);
+  ASSERT_TRUE(reloaded.run_method("get_weight", {}).toTensor().equal(weight));
+}
 } // namespace torch
 } // namespace jit
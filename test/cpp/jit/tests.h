@@ -59,6 +59,7 @@ namespace jit {
   _(SubgraphRewriter)                  \
   _(ModuleCloneInstance)               \
   _(ModuleDefine)                      \
+  _(InferenceSession)                  \
   _(QualifiedName)                     \
   _(ClassImport)                       \
   _(ProfiledTensorTypeHashing)         \
@@ -75,6 +76,8 @@ namespace jit {
   _(LiteInterpreterInline)             \
   _(LiteInterpreterTuple)              \
   _(LiteInterpreterPrimOverload)       \
+  _(LiteInterpreterPrelinkedOps)       \
+  _(LiteInterpreterMmapLoad)           \
   _(CommonAncestor)                    \
   _(AutogradSymbols)                   \
   _(MobileTypeParser)
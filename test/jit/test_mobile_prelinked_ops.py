@@ -0,0 +1,78 @@
+import os
+import shutil
+import sys
+import tempfile
+import unittest
+
+import torch
+import yaml
+
+# Make the helper files in test/ importable
+pytorch_test_dir = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+sys.path.append(pytorch_test_dir)
+from jit_utils import JitTestCase
+
+# The generator lives in tools/, which is only there in a source checkout
+pytorch_root_dir = os.path.dirname(pytorch_test_dir)
+sys.path.append(pytorch_root_dir)
+try:
+    from tools.jit.gen_mobile_prelinked_ops import gen_mobile_prelinked_ops
+    HAS_GENERATOR = True
+except ImportError:
+    HAS_GENERATOR = False
+
+DECLARATIONS_PATH = os.path.join(os.path.dirname(torch.__file__), 'share', 'ATen', 'Declarations.yaml')
+TEMPLATE_PATH = os.path.join(pytorch_root_dir, 'tools', 'jit', 'templates')
+
+if __name__ == '__main__':
+    raise RuntimeError("This test file is not meant to be run directly, use:\n\n"
+                       "\tpython test/test_jit.py TESTNAME\n\n"
+                       "instead.")
+
+@unittest.skipIf(not HAS_GENERATOR or not os.path.exists(DECLARATIONS_PATH),
+                 "needs tools/ and Declarations.yaml of a source build")
+class TestMobilePrelinkedOps(JitTestCase):
+    def setUp(self):
+        super(TestMobilePrelinkedOps, self).setUp()
+        self.out_dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.out_dir)
+        super(TestMobilePrelinkedOps, self).tearDown()
+
+    def save_for_mobile(self, module):
+        path = os.path.join(self.out_dir, 'model.bc')
+        torch.jit.script(module)._c._save_for_mobile(path)
+        return path
+
+    def test_generates_table_and_op_list(self):
+        class M(torch.nn.Module):
+            def forward(self, x):
+                return torch.relu(x) + 1
+
+        model = self.save_for_mobile(M())
+        op_list = os.path.join(self.out_dir, 'ops.yaml')
+        gen_mobile_prelinked_ops(DECLARATIONS_PATH, self.out_dir, TEMPLATE_PATH, [model],
+                                 op_list_out=op_list)
+
+        with open(os.path.join(self.out_dir, 'prelinked_mobile_ops.cpp')) as f:
+            source = f.read()
+        self.assertIn('model.bc', source)
+        # the table is sorted by name and overload name
+        add = source.find('{"aten::add", "Scalar",')
+        relu = source.find('{"aten::relu", "",')
+        self.assertNotEqual(add, -1)
+        self.assertGreater(relu, add)
+
+        with open(op_list) as f:
+            self.assertEqual(yaml.safe_load(f), ['aten::add.Scalar', 'aten::relu'])
+
+    def test_rejects_unknown_ops(self):
+        class M(torch.nn.Module):
+            def forward(self, x):
+                # aten::__getitem__ is registered by the JIT, not by ATen
+                return [x, x][0]
+
+        model = self.save_for_mobile(M())
+        with self.assertRaisesRegex(RuntimeError, 'neither ATen operators nor registered .*aten::__getitem__'):
+            gen_mobile_prelinked_ops(DECLARATIONS_PATH, self.out_dir, TEMPLATE_PATH, [model])
@@ -21,6 +21,7 @@ from jit.test_custom_operators import TestCustomOperators  # noqa: F401
 from jit.test_export_modes import TestExportModes  # noqa: F401
 from jit.test_class_type import TestClassType  # noqa: F401
 from jit.test_builtins import TestBuiltins  # noqa: F401
+from jit.test_mobile_prelinked_ops import TestMobilePrelinkedOps  # noqa: F401
 from jit.unsupported_ops import TestUnsupportedOps  # noqa: F401
 
 # Torch
@@ -1485,6 +1486,142 @@ graph(%packed_params_module, %a, %a_scale, %a_zero_point, %a_dtype, %r_scale, %r
         FileCheck().check_count("prim::CallMethod[name=\"forward\"]", 1, exactly=True) \
             .run(str(get_forward_graph(m.sub._c)))
 
+    def test_freeze_module(self):
+        class SubModule(torch.nn.Module):
+            def __init__(self):
+                super(SubModule, self).__init__()
+                self.conv = torch.nn.Conv2d(1, 4, 3)
+                self.scale = 2.0
+
+            def forward(self, x):
+                return self.conv(x) * self.scale
+
+        class TestModule(torch.nn.Module):
+            def __init__(self):
+                super(TestModule, self).__init__()
+                self.sub = SubModule()
+                self.unused = torch.nn.Linear(2, 2)
+
+            def forward(self, x):
+                return self.sub(x) + 1
+
+            @torch.jit.export
+            def other(self, x):
+                return self.unused(x)
+
+        m = torch.jit.script(TestModule()).eval()
+        frozen = wrap_cpp_module(torch._C._freeze_module(m._c))
+        FileCheck().check_not("prim::GetAttr").check_not("prim::CallMethod") \
+            .run(frozen.graph)
+        self.assertFalse(frozen._c._has_method("other"))
+        self.assertFalse(hasattr(frozen, "sub"))
+        self.assertFalse(hasattr(frozen, "unused"))
+        # the original module is left untouched
+        self.assertTrue(m._c._has_method("other"))
+
+        x = torch.randn(2, 1, 8, 8)
+        self.assertEqual(frozen(x), m(x))
+
+    def test_freeze_module_mutated_attributes(self):
+        class TestModule(torch.nn.Module):
+            def __init__(self):
+                super(TestModule, self).__init__()
+                self.register_buffer("total", torch.zeros(3))
+                self.count = 0
+                self.offset = 1
+
+            def forward(self, x):
+                self.total.add_(x)
+                self.count = self.count + self.offset
+                return self.total * self.count
+
+        m = torch.jit.script(TestModule()).eval()
+        frozen = wrap_cpp_module(torch._C._freeze_module(m._c))
+        # attributes that forward writes stay on the module, the others are
+        # folded into constants
+        FileCheck().check("prim::GetAttr[name=\"total\"]") \
+            .check("prim::SetAttr[name=\"count\"]") \
+            .check_not("prim::GetAttr[name=\"offset\"]") \
+            .run(frozen.graph)
+        x = torch.ones(3)
+        self.assertEqual(frozen(x), torch.ones(3))
+        self.assertEqual(frozen(x), torch.full((3,), 4))
+        # the mutated attributes were copied, so the input module is unchanged
+        self.assertEqual(m.total, torch.zeros(3))
+        self.assertEqual(m.count, 0)
+
+        with self.assertRaisesRegex(RuntimeError, "training mode"):
+            torch._C._freeze_module(torch.jit.script(TestModule())._c)
+
+    def test_freeze_module_mutated_input(self):
+        class TestModule(torch.nn.Module):
+            def __init__(self):
+                super(TestModule, self).__init__()
+                self.linear = torch.nn.Linear(3, 3)
+                self.register_buffer("total", torch.zeros(3))
+
+            def forward(self, x):
+                # writes to the input must not keep the weights on the module
+                x.add_(1)
+                self.total.add_(x)
+                return self.linear(x)
+
+        m = torch.jit.script(TestModule()).eval()
+        frozen = wrap_cpp_module(torch._C._freeze_module(m._c))
+        FileCheck().check("prim::GetAttr[name=\"total\"]") \
+            .check_not("prim::GetAttr[name=\"weight\"]") \
+            .check_not("prim::GetAttr[name=\"bias\"]") \
+            .run(frozen.graph)
+        self.assertFalse(hasattr(frozen, "linear"))
+        x = torch.randn(3)
+        self.assertEqual(frozen(x.clone()), m(x.clone()))
+        self.assertEqual(m.total, x + 1)
+
+    def test_optimize_for_inference(self):
+        class Block(torch.nn.Module):
+            def __init__(self):
+                super(Block, self).__init__()
+                self.conv1 = torch.nn.Conv2d(4, 4, 3, padding=1, bias=False)
+                self.bn1 = torch.nn.BatchNorm2d(4)
+                self.conv2 = torch.nn.Conv2d(4, 4, 3, padding=1)
+                self.bn2 = torch.nn.BatchNorm2d(4)
+
+            def forward(self, x):
+                out = torch.relu(self.bn1(self.conv1(x)))
+                out = self.bn2(self.conv2(out))
+                return torch.relu(out + x)
+
+        class Net(torch.nn.Module):
+            def __init__(self):
+                super(Net, self).__init__()
+                self.block = Block()
+                self.fc = torch.nn.Linear(4, 2)
+
+            def forward(self, x):
+                x = self.block(x)
+                x = torch.flatten(torch.nn.functional.adaptive_avg_pool2d(x, 1), 1)
+                return torch.relu(self.fc(x))
+
+        net = Net().float()
+        # make the batch norms non-trivial
+        for bn in (net.block.bn1, net.block.bn2):
+            bn.running_mean.uniform_()
+            bn.running_var.uniform_(0.5, 1.5)
+            bn.weight.data.uniform_()
+            bn.bias.data.uniform_()
+        m = torch.jit.script(net).eval()
+        optimized = wrap_cpp_module(torch._C._optimize_for_inference(m._c))
+
+        FileCheck().check_not("aten::batch_norm").check_not("prim::GetAttr") \
+            .check("aten::relu_").run(optimized.graph)
+        if torch._C.has_mkldnn:
+            FileCheck().check_count("aten::mkldnn_convolution", 2, exactly=True) \
+                .run(optimized.graph)
+
+        x = torch.rand(2, 4, 8, 8, dtype=torch.float)
+        with torch.no_grad():
+            self.assertEqual(optimized(x), m(x), prec=1e-4)
+
     def test_fuse_linear(self):
         input_strs = ["""
 graph(%input, %weight, %bias, %4):
@@ -1795,6 +1932,54 @@ graph(%Ra, %Rb):
         torch._C._jit_pass_complete_shape_analysis(graph, (x, y), False)
         FileCheck().check("Double(4, 3, 8, 5)").run(str(graph))
 
+    def test_plan_memory(self):
+        def fn(x, y):
+            a = x + y
+            b = torch.sigmoid(a)
+            c = torch.mm(b, y)
+            d = c * y
+            return torch.tanh(d) + x
+
+        x = torch.randn(8, 8)
+        y = torch.randn(8, 8)
+        graph = torch.jit.script(fn).graph.copy()
+        torch._C._jit_pass_complete_shape_analysis(graph, (x, y), False)
+        arena_bytes, intermediate_bytes = torch._C._jit_pass_plan_memory(graph)
+        # a, b and c, d, tanh(d) each share one buffer, and the two buffers
+        # are live at the same time only at the mm
+        self.assertEqual(intermediate_bytes, 5 * x.numel() * x.element_size())
+        self.assertEqual(arena_bytes, 2 * x.numel() * x.element_size())
+        FileCheck().check("prim::AllocateStorage") \
+            .check_count("prim::AllocateTensor", 5, exactly=True).run(str(graph))
+
+        planned = torch._C._create_function_from_graph("forward", graph)
+        with torch.no_grad():
+            # the second run reuses the arena of the first one
+            for _ in range(2):
+                self.assertEqual(planned(x, y), fn(x, y))
+
+    def test_fork_independent_regions(self):
+        def fn(x, w1, w2, w3):
+            a = torch.relu(torch.mm(x, w1))
+            b = torch.relu(torch.mm(x, w2))
+            c = torch.tanh(torch.mm(x, w3))
+            return torch.cat([a, b, c], 1)
+
+        inputs = [torch.randn(16, 16) for _ in range(4)]
+        graph = torch.jit.script(fn).graph.copy()
+        torch._C._jit_pass_fork_independent_regions(graph, min_cost=0)
+        # the first tower always runs inline, the others are forked as far as
+        # there are inter-op threads for them
+        FileCheck().check("prim::fork").check("aten::wait").check("aten::cat").run(str(graph))
+        forked = torch._C._create_function_from_graph("forward", graph)
+        self.assertEqual(forked(*inputs), fn(*inputs))
+
+        # small branches are not worth a fork
+        graph = torch.jit.script(fn).graph.copy()
+        torch._C._jit_pass_complete_shape_analysis(graph, inputs, False)
+        torch._C._jit_pass_fork_independent_regions(graph, min_cost=10 ** 6)
+        FileCheck().check_not("prim::fork").run(str(graph))
+
     # TODO: update verify to work with GraphExecutors
     @unittest.skip("verify needs to be updated to work with GraphExecutors")
     def test_verify(self):
@@ -5928,16 +6113,78 @@ a")
             # this call is optimized for
             # the given shape of (2, 3)
             def_in_one_branch(a, False)
-            # change shape to (3)
+            # change shape to (2, 4), which is in the same
+            # class of shapes as (2, 3) and uses its plan,
             # so we go down a bailout path
-            a = torch.ones(3)
+            a = torch.ones(2, 4)
             # check prim::BailOuts are inserted
             bailout_graph_str = str(def_in_one_branch.graph_for(a, True))
             FileCheck().check_count("prim::BailOut", 3).run(bailout_graph_str)
             # this triggers all 3 bailouts
-            self.assertEqual(def_in_one_branch(a, False), 6.0)
+            self.assertEqual(def_in_one_branch(a, False), 16.0)
             # this triggers 2 bailouts
-            self.assertEqual(def_in_one_branch(a, True), 3.0)
+            self.assertEqual(def_in_one_branch(a, True), 8.0)
+
+    @unittest.skipIf(GRAPH_EXECUTOR != ProfilingMode.PROFILING, "skip if profiling isn't enabled")
+    def test_profiling_graph_executor_plan_cache(self):
+        @torch.jit.script
+        def fn(x):
+            return (x * 2).sum()
+
+        with enable_profiling_mode():
+            # profile and optimize a plan for each class of shapes
+            for size in [4, 100, 4, 100]:
+                fn(torch.ones(size))
+            state = fn.get_debug_state()
+            self.assertEqual(state.num_specialized_plans, 2)
+            self.assertEqual(state.num_bailouts, 0)
+
+            # 3 shares the class of 4 but fails its guards
+            self.assertEqual(fn(torch.ones(3)), 6.0)
+            state = fn.get_debug_state()
+            self.assertGreater(state.num_guard_failures, 0)
+            self.assertGreater(state.num_bailouts, 0)
+
+            # repeated bailouts make the executor profile the class again,
+            # this time over sizes 3 and 4
+            while fn.get_debug_state().num_recompilations == 0:
+                fn(torch.ones(3))
+            for _ in range(2):
+                fn(torch.ones(3))
+                fn(torch.ones(4))
+            bailouts = fn.get_debug_state().num_bailouts
+            self.assertEqual(fn(torch.ones(3)), 6.0)
+            self.assertEqual(fn(torch.ones(4)), 8.0)
+            self.assertEqual(fn.get_debug_state().num_bailouts, bailouts)
+
+            old_size = torch._C._jit_set_profiling_plan_cache_size(1)
+            try:
+                fn(torch.ones(1000))
+                fn(torch.ones(1000))
+                self.assertEqual(fn.get_debug_state().num_specialized_plans, 1)
+            finally:
+                torch._C._jit_set_profiling_plan_cache_size(old_size)
+
+    @unittest.skipIf(GRAPH_EXECUTOR != ProfilingMode.PROFILING, "skip if profiling isn't enabled")
+    def test_profiling_graph_executor_frees_retired_profiles(self):
+        @torch.jit.script
+        def fn(x):
+            return (x * 2).sum()
+
+        with enable_profiling_mode():
+            old_size = torch._C._jit_set_profiling_plan_cache_size(8)
+            try:
+                # every rank is a class of shapes of its own, so this keeps
+                # evicting plans once the cache is full
+                for rank in range(1, 13):
+                    x = torch.ones([2] * rank)
+                    self.assertEqual(fn(x), 2 ** (rank + 1))
+                    self.assertEqual(fn(x), 2 ** (rank + 1))
+                    state = fn.get_debug_state()
+                    self.assertLessEqual(state.num_profiling_records, 8)
+                self.assertEqual(fn.get_debug_state().num_specialized_plans, 8)
+            finally:
+                torch._C._jit_set_profiling_plan_cache_size(old_size)
 
     def test_resize_input_ops(self):
         # resize_ and resize_as resize the input tensor. because our shape analysis
@@ -11672,6 +11919,44 @@ a")
             self.assertEqual(torch.autograd.grad(slstm(*inputs).sum(), inputs),
                              torch.autograd.grad(lstm(*inputs).sum(), inputs))
 
+    def test_mm_batching_horizontal(self):
+        def towers(x0, x1, x2, x3, w0, w1, w2, w3, b0, b1, b2, b3):
+            y0 = torch.relu(torch.addmm(b0, x0, w0.t()))
+            y1 = torch.relu(torch.addmm(b1, x1, w1.t()))
+            y2 = torch.relu(torch.addmm(b2, x2, w2.t()))
+            y3 = torch.relu(torch.addmm(b3, x3, w3.t()))
+            return y0 + y1 + y2 + y3
+
+        # BatchMM runs in the default pipeline, so it only batches
+        # independent multiplies when asked to
+        self.assertFalse(torch._C._jit_horizontal_mm_batching_enabled())
+        graph = torch.jit.script(towers).graph.copy()
+        self.run_pass('batch_mm', graph)
+        FileCheck().check_not("prim::MMBatchHorizontal").check_count("aten::addmm", 4, exactly=True) \
+            .run(str(graph))
+
+        torch._C._jit_override_horizontal_mm_batching(True)
+        try:
+            graph = torch.jit.script(towers).graph.copy()
+            self.run_pass('batch_mm', graph)
+        finally:
+            torch._C._jit_override_horizontal_mm_batching(False)
+        FileCheck().check_count("prim::MMBatchHorizontal", 1, exactly=True) \
+            .check_not("aten::addmm").check_not("aten::relu").run(str(graph))
+        batched = torch._C._create_function_from_graph("forward", graph)
+
+        xs = [torch.randn(4, 6) for _ in range(4)]
+        ws = [torch.randn(5, 6) for _ in range(4)]
+        bs = [torch.randn(5) for _ in range(4)]
+        # the second run reuses the stacked weights and biases
+        for _ in range(2):
+            self.assertEqual(batched(*(xs + ws + bs)), towers(*(xs + ws + bs)))
+        ws[0].add_(1)
+        self.assertEqual(batched(*(xs + ws + bs)), towers(*(xs + ws + bs)))
+        # differently shaped towers are multiplied one by one
+        xs[3] = torch.randn(1, 6)
+        self.assertEqual(batched(*(xs + ws + bs)), towers(*(xs + ws + bs)))
+
     def test_loop_unrolling(self):
         def fn(x):
             y = 0
@@ -48,7 +48,7 @@ from common_nn import NNTestCase, ModuleTest, CriterionTest, TestBase, \
     ctcloss_reference, new_module_tests
 from common_device_type import instantiate_device_type_tests, dtypes, \
     dtypesIfCUDA, skipCUDAIfNoCudnn, skipCUDAIfCudnnVersionLessThan, onlyCUDA, \
-    skipCUDAIfRocm, skipCUDAIf
+    skipCUDAIfRocm, skipCUDAIf, onlyCPU
 
 from torch.nn import MultiheadAttention
 
@@ -3597,6 +3597,82 @@ class TestNN(NNTestCase):
         self.assertTrue(ref_out.is_contiguous())
         self.assertEqual(out, ref_out)
 
+    def test_pooling_upsample_nhwc_cpu(self):
+        modules = [
+            torch.nn.MaxPool2d(3, stride=2, padding=1),
+            torch.nn.MaxPool2d(2, dilation=2, ceil_mode=True),
+            torch.nn.AvgPool2d(3, stride=2, padding=1),
+            torch.nn.AvgPool2d(3, stride=2, padding=1, count_include_pad=False),
+            torch.nn.AvgPool2d(2, divisor_override=3),
+            torch.nn.AdaptiveAvgPool2d((3, 5)),
+            torch.nn.AdaptiveAvgPool2d(1),
+            torch.nn.AdaptiveMaxPool2d((3, 5)),
+            torch.nn.Upsample(scale_factor=2, mode='nearest'),
+            torch.nn.Upsample(size=(5, 13), mode='nearest'),
+            torch.nn.Upsample(scale_factor=2, mode='bilinear', align_corners=False),
+            torch.nn.Upsample(size=(5, 13), mode='bilinear', align_corners=True),
+        ]
+        # 19 channels covers both the vectorized loop and its tail
+        for dtype in [torch.float, torch.double]:
+            for module in modules:
+                input = torch.randn(2, 19, 7, 9, dtype=dtype)
+                input[0, 3, 2, 2] = float('nan')
+                input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+                ref_input = input.detach().clone().contiguous().requires_grad_()
+
+                out = module(input)
+                ref_out = module(ref_input)
+                self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+                self.assertTrue(ref_out.is_contiguous())
+                self.assertEqual(torch.isnan(out), torch.isnan(ref_out))
+                self.assertEqual(out[~torch.isnan(out)], ref_out[~torch.isnan(ref_out)])
+
+                grad = torch.randn_like(ref_out)
+                out.backward(grad)
+                ref_out.backward(grad)
+                self.assertEqual(input.grad, ref_input.grad)
+
+        input = torch.randn(2, 19, 7, 9).contiguous(memory_format=torch.channels_last)
+        out, indices = F.max_pool2d(input, 3, stride=2, return_indices=True)
+        ref_out, ref_indices = F.max_pool2d(input.contiguous(), 3, stride=2, return_indices=True)
+        self.assertEqual(out, ref_out)
+        self.assertEqual(indices, ref_indices)
+        out, indices = F.adaptive_max_pool2d(input, (3, 4), return_indices=True)
+        ref_out, ref_indices = F.adaptive_max_pool2d(input.contiguous(), (3, 4), return_indices=True)
+        self.assertEqual(out, ref_out)
+        self.assertEqual(indices, ref_indices)
+
+    def test_batchnorm_train_nhwc_cpu(self):
+        for dtype in [torch.float, torch.double]:
+            for affine in [True, False]:
+                bn = torch.nn.BatchNorm2d(19, affine=affine).to(dtype)
+                if affine:
+                    bn.weight.data.uniform_(0.5, 1.5)
+                    bn.bias.data.uniform_()
+                ref_bn = deepcopy(bn)
+                input = torch.randn(4, 19, 6, 5, dtype=dtype)
+                input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+                ref_input = input.detach().clone().contiguous().requires_grad_()
+
+                out = bn(input)
+                ref_out = ref_bn(ref_input)
+                self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+                self.assertEqual(out, ref_out)
+                self.assertEqual(bn.running_mean, ref_bn.running_mean)
+                self.assertEqual(bn.running_var, ref_bn.running_var)
+
+                grad = torch.randn_like(ref_out)
+                out.backward(grad)
+                ref_out.backward(grad)
+                self.assertEqual(input.grad, ref_input.grad)
+                if affine:
+                    self.assertEqual(bn.weight.grad, ref_bn.weight.grad)
+                    self.assertEqual(bn.bias.grad, ref_bn.bias.grad)
+
+                bn.eval()
+                ref_bn.eval()
+                self.assertEqual(bn(input), ref_bn(ref_input))
+
     @unittest.skipIf(not TEST_MULTIGPU, "multi-GPU not supported")
     def test_broadcast_double_backwards_gpu(self):
         tensors = (torch.randn(4, 4, device='cuda', requires_grad=True),
@@ -4160,6 +4236,35 @@ class TestNN(NNTestCase):
                              torch.cat([m1.weight.grad.data, m2.weight.grad.data], 0),
                              1e-1 if dtype == torch.half else dtype2prec[dtype])
 
+    def test_Conv2d_cpu_inference_paths(self):
+        # Without grad, CPU conv2d may take the direct or, when enabled, the
+        # Winograd kernels instead of im2col + GEMM. Compare them against the
+        # grad-enabled path, which always uses thnn_conv2d.
+        self.assertFalse(torch.backends.winograd.enabled)
+        torch.manual_seed(0)
+        configs = [
+            # (in_c, out_c, kernel, stride, padding, H, W, dtype)
+            (16, 16, 3, 1, 1, 12, 12, torch.float),   # Winograd F(4x4, 3x3)
+            (8, 12, 3, 1, 0, 7, 9, torch.float),      # Winograd F(2x2, 3x3)
+            (16, 8, 3, 1, 1, 5, 11, torch.float),     # Winograd, partial tiles
+            (3, 16, 3, 2, 1, 15, 17, torch.float),    # direct, strided
+            (4, 5, 3, 1, 1, 9, 23, torch.double),     # direct, double
+            (6, 7, (1, 3), 1, (0, 1), 6, 20, torch.float),
+            (5, 6, 1, 2, 0, 9, 9, torch.float),       # direct, pointwise strided
+        ]
+        for winograd in [False, True]:
+            with torch.backends.mkldnn.flags(enabled=False), torch.backends.winograd.flags(enabled=winograd):
+                for in_c, out_c, kernel, stride, padding, H, W, dtype in configs:
+                    for bias in [True, False]:
+                        m = nn.Conv2d(in_c, out_c, kernel, stride=stride, padding=padding,
+                                      bias=bias).to(dtype)
+                        x = torch.randn(2, in_c, H, W, dtype=dtype)
+                        expected = m(x.requires_grad_()).detach()
+                        with torch.no_grad():
+                            actual = m(x)
+                        self.assertEqual(actual, expected, 1e-4)
+                        self.assertFalse(actual.requires_grad)
+
     # Very similar to test_Conv2d_naive_groups but with special care to handle
     # the number of groups == number of input channels
     @unittest.skipIf(not TEST_CUDA, 'CUDA not available')
@@ -4642,6 +4747,92 @@ class TestNN(NNTestCase):
 
             (hx + cx).sum().backward()
 
+    def test_cpu_rnn_fused_cells(self):
+        # hidden size is not a multiple of the vector width to cover the tails
+        batch, hidden_size = 5, 19
+
+        def lstm_ref(igates, hgates, cx, b_ih, b_hh):
+            gates = igates + hgates
+            if b_ih is not None:
+                gates = gates + b_ih + b_hh
+            i, f, g, o = gates.chunk(4, 1)
+            cy = f.sigmoid() * cx + i.sigmoid() * g.tanh()
+            return o.sigmoid() * cy.tanh(), cy
+
+        def gru_ref(igates, hgates, hx, b_ih, b_hh):
+            if b_ih is not None:
+                igates = igates + b_ih
+                hgates = hgates + b_hh
+            ir, ii, i_n = igates.chunk(3, 1)
+            hr, hi, h_n = hgates.chunk(3, 1)
+            r = (ir + hr).sigmoid()
+            z = (ii + hi).sigmoid()
+            n = (i_n + r * h_n).tanh()
+            return n + z * (hx - n)
+
+        for dtype, bias in product((torch.float, torch.double), (True, False)):
+            for fused, ref, gates in ((torch._thnn_fused_lstm_cell, lstm_ref, 4),
+                                      (torch._thnn_fused_gru_cell, gru_ref, 3)):
+                inputs = [torch.randn(batch, gates * hidden_size, dtype=dtype),
+                          torch.randn(batch, gates * hidden_size, dtype=dtype),
+                          torch.randn(batch, hidden_size, dtype=dtype)]
+                if bias:
+                    inputs += [torch.randn(gates * hidden_size, dtype=dtype),
+                               torch.randn(gates * hidden_size, dtype=dtype)]
+                inputs = [t.requires_grad_() for t in inputs]
+                args = inputs if bias else inputs + [None, None]
+                prec = 1e-5 if dtype == torch.float else 1e-10
+
+                out = fused(*args)
+                out = out[:2] if gates == 4 else out[:1]
+                expected = ref(*args)
+                expected = expected if gates == 4 else (expected,)
+                grads = [torch.randn_like(o) for o in expected]
+                for o, e in zip(out, expected):
+                    self.assertEqual(o, e, prec)
+
+                actual_grads = torch.autograd.grad(out, inputs, grads)
+                expected_grads = torch.autograd.grad(expected, inputs, grads)
+                for a, e in zip(actual_grads, expected_grads):
+                    self.assertEqual(a, e, prec)
+
+                if dtype == torch.double:
+                    self.assertTrue(gradcheck(lambda *i: fused(*(i if bias else i + (None, None))),
+                                              inputs))
+
+        # nn.LSTM / nn.GRU go through the fused cells on CPU
+        for module in (nn.LSTM, nn.GRU):
+            rnn = module(7, hidden_size)
+            input = torch.randn(11, 1, 7)
+            output, _ = rnn(input)
+            self.assertEqual(output.size(), (11, 1, hidden_size))
+            output.sum().backward()
+
+    def test_cpu_rnn_no_grad_matches_grad(self):
+        # Without autograd the CPU layers step in place into preallocated
+        # buffers; they have to agree with the recorded per-step path.
+        lengths = [7, 7, 4, 2, 1]
+        for module, bidirectional, packed in product((nn.LSTM, nn.GRU), (False, True), (False, True)):
+            rnn = module(5, 9, num_layers=2, bidirectional=bidirectional)
+            num_directions = 2 if bidirectional else 1
+            input = torch.randn(max(lengths), len(lengths), 5)
+            h0 = torch.randn(2 * num_directions, len(lengths), 9)
+            hx = (h0, torch.randn_like(h0)) if module is nn.LSTM else h0
+            hx_copy = tuple(h.clone() for h in hx) if module is nn.LSTM else hx.clone()
+            if packed:
+                input = rnn_utils.pack_padded_sequence(input, lengths)
+
+            expected_output, expected_hy = rnn(input, hx)
+            with torch.no_grad():
+                output, hy = rnn(input, hx)
+
+            if packed:
+                output, expected_output = output.data, expected_output.data
+            self.assertEqual(output, expected_output)
+            self.assertEqual(hy, expected_hy)
+            # the initial states must not be overwritten
+            self.assertEqual(hx, hx_copy)
+
     @unittest.skipIf(not TEST_CUDA, 'CUDA not available')
     def test_pack_sequence_batch_sizes_throw(self):
         with self.assertRaisesRegex(ValueError, r"batch_sizes should always be on CPU"):
@@ -8995,6 +9186,41 @@ class TestNNDeviceType(NNTestCase):
         if self.device_type == 'cuda':
             self._test_GroupNorm_cuda_half()
 
+    @onlyCPU
+    def test_GroupNorm_native_cpu(self, device):
+        # CPU runs group_norm through the native_group_norm kernel; check it
+        # against the reference formula, for channels last input, and its
+        # first and second derivatives.
+        for shape, g in [((2, 6, 5, 7), 3), ((3, 8, 20), 2), ((2, 4, 1, 1), 4)]:
+            x = torch.randn(*shape, device=device, dtype=torch.double)
+            weight = torch.rand(shape[1], device=device, dtype=torch.double) + 0.5
+            bias = torch.randn(shape[1], device=device, dtype=torch.double)
+            x_g = x.view(shape[0], g, -1)
+            mean = x_g.mean(-1, keepdim=True)
+            var = x_g.var(-1, unbiased=False, keepdim=True)
+            param_shape = [1, shape[1]] + [1] * (len(shape) - 2)
+            expected = ((x_g - mean) / (var + 1e-5).sqrt()).view(shape) * \
+                weight.view(param_shape) + bias.view(param_shape)
+            self.assertEqual(F.group_norm(x, g, weight, bias), expected)
+            if x.dim() == 4:
+                x_cl = x.contiguous(memory_format=torch.channels_last)
+                out_cl = F.group_norm(x_cl, g, weight, bias)
+                self.assertTrue(out_cl.is_contiguous(memory_format=torch.channels_last))
+                self.assertEqual(out_cl, expected)
+
+            inputs = (x.clone().requires_grad_(), weight.clone().requires_grad_(),
+                      bias.clone().requires_grad_())
+            fn = lambda x, w, b: F.group_norm(x, g, w, b)
+            self.assertTrue(gradcheck(fn, inputs))
+            self.assertTrue(gradgradcheck(fn, inputs))
+            if x.dim() == 4:
+                x_cl = x.contiguous(memory_format=torch.channels_last).requires_grad_()
+                x_ref = x.clone().requires_grad_()
+                grad = torch.randn(shape, device=device, dtype=torch.double)
+                F.group_norm(x_cl, g, weight, bias).backward(grad)
+                F.group_norm(x_ref, g, weight, bias).backward(grad)
+                self.assertEqual(x_cl.grad, x_ref.grad)
+
     def test_BatchNorm_empty(self, device):
         mod = torch.nn.BatchNorm2d(3).to(device)
         inp = torch.randn(0, 3, 2, 2, device=device)
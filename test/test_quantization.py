@@ -11,7 +11,7 @@ from torch.quantization import \
     QConfigDynamic, get_observer_dict, default_weight_observer, \
     quantize, prepare, convert, prepare_qat, quantize_qat, fuse_modules, \
     quantize_dynamic, default_qconfig, default_debug_qconfig, default_qat_qconfig, \
-    default_dynamic_qconfig, per_channel_dynamic_qconfig, HistogramObserver, MinMaxObserver, \
+    default_dynamic_qconfig, per_channel_dynamic_qconfig, float16_dynamic_qconfig, HistogramObserver, MinMaxObserver, \
     PerChannelMinMaxObserver, RecordingObserver, MovingAverageMinMaxObserver, \
     MovingAveragePerChannelMinMaxObserver, QuantWrapper, default_eval_fn
 
@@ -721,6 +721,54 @@ class PostTrainingDynamicQuantTest(QuantizationTestCase):
 
         y, (h, c) = cell_dq(x, (h, c))
 
+    def test_quantized_gru(self):
+        seq_len, batch, input_size, hidden_size = 5, 3, 4, 6
+        ref = torch.nn.GRU(input_size, hidden_size, num_layers=2, bidirectional=True).eval()
+        model = torch.nn.Sequential(copy.deepcopy(ref))
+
+        x = torch.randn(seq_len, batch, input_size)
+        hx = torch.randn(4, batch, hidden_size)
+        ref_out, ref_hid = ref(x, hx)
+
+        for dtype, qconfig in [(torch.qint8, default_dynamic_qconfig),
+                               (torch.qint8, per_channel_dynamic_qconfig),
+                               (torch.float16, float16_dynamic_qconfig)]:
+            model_q = quantize_dynamic(model, {torch.nn.GRU: qconfig}, dtype=dtype)
+            cell_q = model_q[0]
+            self.assertEqual(type(cell_q), torch.nn.quantized.dynamic.GRU)
+            self.assertTrue('DynamicQuantizedGRU' in str(model_q))
+
+            out, hid = cell_q(x, hx)
+            self.assertEqual(out, ref_out, prec=0.1)
+            self.assertEqual(hid, ref_hid, prec=0.1)
+
+            # Default hidden state is all zeros
+            out_default, _ = cell_q(x)
+            out_zeros, _ = cell_q(x, torch.zeros_like(hx))
+            self.assertEqual(out_default, out_zeros)
+
+            packed_input = torch.nn.utils.rnn.pack_padded_sequence(x, torch.tensor([5, 3, 2]))
+            ref_out_packed, ref_hid_packed = ref(packed_input, hx)
+            out_packed, hid_packed = cell_q(packed_input, hx)
+            self.assertEqual(out_packed.data, ref_out_packed.data, prec=0.1)
+            self.assertEqual(hid_packed, ref_hid_packed, prec=0.1)
+
+    def test_quantized_rnn_per_channel(self):
+        ref = torch.nn.LSTM(4, 6).eval()
+        model = torch.nn.Sequential(copy.deepcopy(ref))
+        model_q = quantize_dynamic(model, {torch.nn.LSTM: per_channel_dynamic_qconfig})
+
+        # Every gate row of every weight gets its own scale
+        for packed in model_q[0]._all_weight_values:
+            weight = torch.ops.quantized.linear_unpack(packed.param)[0]
+            self.assertEqual(weight.qscheme(), torch.per_channel_affine)
+            self.assertEqual(weight.q_per_channel_scales().numel(), 4 * 6)
+
+        x = torch.randn(5, 3, 4)
+        ref_out, _ = ref(x)
+        out, _ = model_q[0](x)
+        self.assertEqual(out, ref_out, prec=0.1)
+
 
 @unittest.skipUnless('fbgemm' in torch.backends.quantized.supported_engines,
                      " Quantized operations require FBGEMM. FBGEMM is only optimized for CPUs"
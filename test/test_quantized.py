@@ -940,6 +940,68 @@ class TestQuantizedOps(TestCase):
 
         self.assertEqual(Y, qY.dequantize())
 
+    """Tests the correctness of the quantized layer_norm op."""
+    @given(shape=st.sampled_from([(4, 8), (2, 3, 40), (3, 2, 5, 7)]),
+           torch_type=st.sampled_from([torch.quint8, torch.qint8]),
+           affine=st.booleans())
+    def test_qlayer_norm(self, shape, torch_type, affine):
+        zero_point = 128 if torch_type == torch.quint8 else 0
+        X = torch.randn(*shape) * 3 + 1
+        qX = torch.quantize_per_tensor(X, 0.05, zero_point, torch_type)
+        normalized_shape = shape[-2:]
+        weight = torch.rand(normalized_shape) + 0.5 if affine else None
+        bias = torch.randn(normalized_shape) if affine else None
+        Y_scale, Y_zero_point = 0.05, zero_point
+
+        qY = torch.ops.quantized.layer_norm(qX, normalized_shape, weight, bias,
+                                            1e-5, Y_scale, Y_zero_point)
+        Y = F.layer_norm(qX.dequantize(), normalized_shape, weight, bias, 1e-5)
+        qY_ref = torch.quantize_per_tensor(Y, Y_scale, Y_zero_point, torch_type)
+
+        self.assertEqual(qY.q_scale(), Y_scale)
+        self.assertEqual(qY.q_zero_point(), Y_zero_point)
+        # Allow off-by-one from rounding of the float moments
+        self.assertEqual(qY.int_repr().float(), qY_ref.int_repr().float(), prec=1)
+
+    """Tests the correctness of the quantized group_norm op."""
+    @given(shape=st.sampled_from([(2, 4, 3, 5), (1, 6, 40), (3, 8)]),
+           num_groups=st.sampled_from([1, 2]),
+           torch_type=st.sampled_from([torch.quint8, torch.qint8]),
+           affine=st.booleans())
+    def test_qgroup_norm(self, shape, num_groups, torch_type, affine):
+        zero_point = 128 if torch_type == torch.quint8 else 0
+        X = torch.randn(*shape) * 3 - 1
+        qX = torch.quantize_per_tensor(X, 0.05, zero_point, torch_type)
+        C = shape[1]
+        weight = torch.rand(C) + 0.5 if affine else None
+        bias = torch.randn(C) if affine else None
+        Y_scale, Y_zero_point = 0.05, zero_point
+
+        qY = torch.ops.quantized.group_norm(qX, num_groups, weight, bias,
+                                            1e-5, Y_scale, Y_zero_point)
+        Y = F.group_norm(qX.dequantize(), num_groups, weight, bias, 1e-5)
+        qY_ref = torch.quantize_per_tensor(Y, Y_scale, Y_zero_point, torch_type)
+
+        self.assertEqual(qY.int_repr().float(), qY_ref.int_repr().float(), prec=1)
+
+    """Tests the correctness of the quantized softmax op."""
+    @given(shape=st.sampled_from([(4, 8), (2, 3, 50), (3, 40, 5), (7,)]),
+           dim=st.integers(-1, 0),
+           torch_type=st.sampled_from([torch.quint8, torch.qint8]))
+    def test_qsoftmax(self, shape, dim, torch_type):
+        zero_point = 100 if torch_type == torch.quint8 else -20
+        X = torch.randn(*shape) * 4
+        qX = torch.quantize_per_tensor(X, 0.1, zero_point, torch_type)
+        # The output of softmax lies in [0, 1]
+        Y_scale = 1.0 / 256
+        Y_zero_point = 0 if torch_type == torch.quint8 else -128
+
+        qY = torch.ops.quantized.softmax(qX, dim, Y_scale, Y_zero_point)
+        Y = torch.softmax(qX.dequantize(), dim)
+        qY_ref = torch.quantize_per_tensor(Y, Y_scale, Y_zero_point, torch_type)
+
+        self.assertEqual(qY.int_repr().float(), qY_ref.int_repr().float(), prec=1)
+
     """Tests the correctness of the quantized equal op."""
     @given(X=hu.tensor(shapes=hu.array_shapes(1, 5, 1, 5),
                        qparams=hu.qparams()),
@@ -1128,6 +1190,45 @@ class TestDynamicQuantizedLinear(TestCase):
         self.assertEqual(Y_fp32, Y_fp32_ref,
                          message="torch.ops.quantized.linear_dynamic (fbgemm) results are off")
 
+    """Tests the dynamic quantized linear op with calibrated input qparams."""
+    @given(
+        batch_size=st.integers(1, 4),
+        input_channels=st.integers(16, 32),
+        output_channels=st.integers(4, 8),
+        use_relu=st.booleans(),
+        use_channelwise=st.booleans())
+    def test_qlinear_calibrated(self, batch_size, input_channels, output_channels,
+                                use_relu, use_channelwise):
+        if use_relu:
+            qlinear_dynamic = torch.ops.quantized.linear_relu_dynamic
+            qlinear_calibrated = torch.ops.quantized.linear_relu_dynamic_calibrated
+        else:
+            qlinear_dynamic = torch.ops.quantized.linear_dynamic
+            qlinear_calibrated = torch.ops.quantized.linear_dynamic_calibrated
+
+        X = torch.rand(batch_size, input_channels) * 4 - 2
+        W = torch.rand(output_channels, input_channels) - 0.5
+        b = torch.rand(output_channels)
+        if use_channelwise:
+            W_q = torch.quantize_per_channel(
+                W, scales=torch.rand(output_channels).double() / 64 + 1e-3,
+                zero_points=torch.zeros(output_channels, dtype=torch.long),
+                axis=0, dtype=torch.qint8)
+        else:
+            W_q = torch.quantize_per_tensor(W, 1.0 / 128, 0, torch.qint8)
+        W_prepack = torch.ops.quantized.linear_prepack(W_q, b)
+
+        # With the qparams the dynamic op would choose, both ops agree up to
+        # rounding of the computed scale.
+        X_scale, X_zp = _calculate_dynamic_qparams(X, torch.quint8)
+        self.assertEqual(qlinear_calibrated(X, W_prepack, X_scale, X_zp),
+                         qlinear_dynamic(X, W_prepack), prec=0.05)
+
+        # Inputs outside of a narrower calibrated range saturate.
+        X_scale, X_zp = 2.0 / 255, 128
+        self.assertEqual(qlinear_calibrated(X, W_prepack, X_scale, X_zp),
+                         qlinear_calibrated(X.clamp(-1, 1), W_prepack, X_scale, X_zp))
+
     """Tests the correctness of the legacy dynamic quantized linear op."""
     @given(
         batch_size=st.integers(1, 4),
@@ -1994,6 +2095,99 @@ class TestQNNPackOps(TestCase):
             qY = torch.mean(qX, dim)
             np.testing.assert_array_almost_equal(Y.int_repr().numpy(), qY.int_repr().numpy(), decimal=0)
 
+"""Tests the row-wise quantized embedding_bag ops."""
+class TestQuantizedEmbeddingBag(TestCase):
+    def _random_bags(self, num_embeddings, num_bags, max_bag_size):
+        lengths = np.random.randint(0, max_bag_size + 1, size=num_bags)
+        offsets = np.concatenate(([0], np.cumsum(lengths)[:-1]))
+        indices = np.random.randint(0, num_embeddings, size=int(lengths.sum()))
+        return torch.from_numpy(indices).long(), torch.from_numpy(offsets).long()
+
+    @given(num_embeddings=st.integers(10, 100),
+           embedding_dim=st.integers(1, 64),
+           bit_rate=st.sampled_from([4, 8]))
+    def test_embedding_bag_prepack_unpack(self, num_embeddings, embedding_dim, bit_rate):
+        if bit_rate == 8:
+            prepack = torch.ops.quantized.embedding_bag_byte_prepack
+            unpack = torch.ops.quantized.embedding_bag_byte_unpack
+            packed_dim = embedding_dim + 8
+        else:
+            prepack = torch.ops.quantized.embedding_bag_4bit_prepack
+            unpack = torch.ops.quantized.embedding_bag_4bit_unpack
+            packed_dim = (embedding_dim + 1) // 2 + 4
+
+        weight = torch.randn(num_embeddings, embedding_dim)
+        packed = prepack(weight)
+        self.assertEqual(packed.dtype, torch.uint8)
+        self.assertEqual(packed.size(), (num_embeddings, packed_dim))
+
+        unpacked = unpack(packed)[:, :embedding_dim]
+        # Every element is off by at most half a quantization step.
+        row_range = weight.max(dim=1, keepdim=True)[0] - weight.min(dim=1, keepdim=True)[0]
+        tolerance = row_range / (2 ** bit_rate - 1) * 0.5 + 1e-2
+        self.assertTrue(((unpacked - weight).abs() <= tolerance).all())
+
+    @given(num_embeddings=st.integers(10, 100),
+           embedding_dim=st.integers(1, 64),
+           num_bags=st.integers(1, 16),
+           bit_rate=st.sampled_from([4, 8]),
+           mode=st.sampled_from(['sum', 'mean']),
+           use_per_sample_weights=st.booleans(),
+           use_int32_indices=st.booleans())
+    def test_embedding_bag_rowwise_offsets(self, num_embeddings, embedding_dim, num_bags,
+                                           bit_rate, mode, use_per_sample_weights,
+                                           use_int32_indices):
+        assume(mode == 'sum' or not use_per_sample_weights)
+        if bit_rate == 8:
+            prepack = torch.ops.quantized.embedding_bag_byte_prepack
+            unpack = torch.ops.quantized.embedding_bag_byte_unpack
+            qembedding_bag = torch.ops.quantized.embedding_bag_byte_rowwise_offsets
+        else:
+            prepack = torch.ops.quantized.embedding_bag_4bit_prepack
+            unpack = torch.ops.quantized.embedding_bag_4bit_unpack
+            qembedding_bag = torch.ops.quantized.embedding_bag_4bit_rowwise_offsets
+
+        weight = torch.randn(num_embeddings, embedding_dim)
+        packed = prepack(weight)
+        # The reference runs the float embedding_bag on the dequantized table,
+        # so only the accumulation order differs.
+        weight_ref = unpack(packed)[:, :embedding_dim]
+
+        indices, offsets = self._random_bags(num_embeddings, num_bags, 10)
+        per_sample_weights = torch.randn(indices.numel()) if use_per_sample_weights else None
+        mode_enum = {'sum': 0, 'mean': 1}[mode]
+
+        Y_ref = F.embedding_bag(indices, weight_ref, offsets, mode=mode,
+                                per_sample_weights=per_sample_weights)
+        if use_int32_indices:
+            indices = indices.int()
+        Y = qembedding_bag(packed, indices, offsets, False, mode_enum, False,
+                           per_sample_weights)[:, :embedding_dim]
+        self.assertEqual(Y, Y_ref, prec=1e-4)
+
+    def test_embedding_bag_rowwise_offsets_errors(self):
+        packed = torch.ops.quantized.embedding_bag_byte_prepack(torch.randn(10, 8))
+        qembedding_bag = torch.ops.quantized.embedding_bag_byte_rowwise_offsets
+        indices = torch.tensor([0, 2, 4, 5, 4, 3, 2, 9])
+        offsets = torch.tensor([0, 4])
+        with self.assertRaisesRegex(RuntimeError, "only the 'sum'"):
+            qembedding_bag(packed, indices, offsets, False, 2, False, None)
+        with self.assertRaisesRegex(RuntimeError, "per_sample_weights is only supported"):
+            qembedding_bag(packed, indices, offsets, False, 1, False, torch.randn(8))
+        with self.assertRaisesRegex(RuntimeError, "offsets\\[0\\] has to be 0"):
+            qembedding_bag(packed, indices, torch.tensor([1, 4]), False, 0, False, None)
+
+        for fmt in ('byte', '4bit'):
+            prepack = getattr(torch.ops.quantized, 'embedding_bag_{}_prepack'.format(fmt))
+            lookup = getattr(torch.ops.quantized, 'embedding_bag_{}_rowwise_offsets'.format(fmt))
+            packed = prepack(torch.randn(10, 8))
+            for bad_index in (10, -1):
+                bad_indices = torch.tensor([0, 2, 4, 5, 4, bad_index, 2, 9])
+                with self.assertRaisesRegex(RuntimeError, "index 5 is out of bounds"):
+                    lookup(packed, bad_indices, offsets, False, 0, False, None)
+            with self.assertRaisesRegex(RuntimeError, "offsets have to be non-decreasing"):
+                lookup(packed, indices, torch.tensor([0, 6, 3]), False, 0, False, None)
+
 """Tests the correctness of the tensor comparators."""
 class TestComparatorOps(TestCase):
     """Tests the element-wise equality ops."""
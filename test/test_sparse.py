@@ -707,6 +707,30 @@ class TestSparse(TestCase):
         test_shape(10, 20, 0, 0)
         test_shape(10, 20, 0, 20)
 
+    @cpu_only
+    def test_coalesce_mm_large_nnz(self):
+        # enough entries to be split across threads, with many duplicates
+        def test_shape(di, dj, dk, nnz):
+            i = torch.stack([torch.randint(di, (nnz,)), torch.randint(dj, (nnz,))])
+            v = torch.randn(nnz, dtype=torch.double)
+            x = self.sparse_tensor(i, v, torch.Size([di, dj]))
+            self.assertFalse(x.is_coalesced())
+            y = torch.randn(dj, dk, dtype=torch.double)
+
+            x_coalesced = x.coalesce()
+            self.assertTrue(x_coalesced.is_coalesced())
+            self.assertEqual(self.safeToDense(x_coalesced), self.safeToDense(x))
+            indices = x_coalesced._indices()
+            flat = indices[0] * dj + indices[1]
+            self.assertTrue((flat[1:] > flat[:-1]).all())
+
+            expected = torch.mm(self.safeToDense(x), y)
+            self.assertEqual(torch.mm(x, y), expected)
+            self.assertEqual(torch.mm(x_coalesced, y), expected)
+
+        test_shape(100, 300, 20, 100000)
+        test_shape(2000, 3000, 3, 100000)
+
     def test_t_empty(self):
         def test_in_place(x):
             shape_original = x.shape
@@ -2185,5 +2209,123 @@ class TestSparseOneOff(TestCase):
             x + sparse_y
 
 
+class TestSparseCSR(TestCase):
+    def _gen_csr(self, nrows, ncols, density=0.3):
+        dense = torch.randn(nrows, ncols)
+        dense[torch.rand(nrows, ncols) > density] = 0
+        return dense.to_sparse_csr(), dense
+
+    def test_csr_layout(self):
+        csr, dense = self._gen_csr(5, 7)
+        self.assertEqual(csr.layout, torch.sparse_csr)
+        self.assertEqual(csr.shape, dense.shape)
+        self.assertEqual(csr._nnz(), (dense != 0).sum().item())
+        self.assertEqual(csr.crow_indices().numel(), 6)
+        self.assertEqual(csr.crow_indices()[-1].item(), csr._nnz())
+        str(csr)
+
+    def test_csr_conversions(self):
+        for shape in [(5, 7), (1, 10), (10, 1), (0, 4), (4, 0)]:
+            csr, dense = self._gen_csr(*shape)
+            self.assertEqual(csr.to_dense(), dense)
+            self.assertEqual(csr.to_sparse().to_dense(), dense)
+            self.assertEqual(dense.to_sparse().to_sparse_csr().to_dense(), dense)
+
+        # uncoalesced COO input is summed per entry
+        i = torch.tensor([[2, 0, 2], [1, 3, 1]])
+        v = torch.tensor([1., 2., 3.])
+        coo = torch.sparse_coo_tensor(i, v, (3, 4))
+        csr = coo.to_sparse_csr()
+        self.assertEqual(csr.crow_indices(), torch.tensor([0, 1, 1, 2]))
+        self.assertEqual(csr.col_indices(), torch.tensor([3, 1]))
+        self.assertEqual(csr.to_dense(), coo.to_dense())
+
+    def test_csr_constructor(self):
+        crow = torch.tensor([0, 2, 2, 3])
+        col = torch.tensor([0, 3, 1])
+        values = torch.tensor([1., 2., 3.])
+        csr = torch.sparse_csr_tensor(crow, col, values, [3, 4])
+        expected = torch.tensor([[1., 0., 0., 2.], [0., 0., 0., 0.], [0., 3., 0., 0.]])
+        self.assertEqual(csr.to_dense(), expected)
+
+        with self.assertRaisesRegex(RuntimeError, "must be 2-D"):
+            torch.sparse_csr_tensor(crow, col, values, [3, 4, 1])
+        with self.assertRaisesRegex(RuntimeError, "crow_indices must have shape"):
+            torch.sparse_csr_tensor(crow, col, values, [2, 4])
+        with self.assertRaisesRegex(RuntimeError, "crow_indices must end at"):
+            torch.sparse_csr_tensor(torch.tensor([0, 2, 2, 2]), col, values, [3, 4])
+        with self.assertRaisesRegex(RuntimeError, "non-decreasing"):
+            torch.sparse_csr_tensor(torch.tensor([0, 2, 1, 3]), col, values, [3, 4])
+        with self.assertRaisesRegex(RuntimeError, "inconsistent with col_indices"):
+            torch.sparse_csr_tensor(crow, col, values, [3, 3])
+
+    def test_csr_mm(self):
+        for nrows, ncols, k in [(5, 7, 3), (100, 30, 20), (0, 4, 2), (4, 3, 0)]:
+            csr, dense = self._gen_csr(nrows, ncols)
+            mat = torch.randn(ncols, k)
+            self.assertEqual(torch.mm(csr, mat), dense.mm(mat))
+            self.assertEqual(csr.mm(mat.t().contiguous().t()), dense.mm(mat))
+            out = torch.empty(0)
+            torch.mm(csr, mat, out=out)
+            self.assertEqual(out, dense.mm(mat))
+
+            t = torch.randn(nrows, k)
+            self.assertEqual(torch.addmm(t, csr, mat, beta=0.5, alpha=2),
+                             torch.addmm(t, dense, mat, beta=0.5, alpha=2))
+            t = torch.randn(k)
+            self.assertEqual(torch.addmm(t, csr, mat), torch.addmm(t, dense, mat))
+
+        csr, _ = self._gen_csr(4, 5)
+        with self.assertRaisesRegex(RuntimeError, "Expected dim 0 size 5"):
+            csr.mm(torch.randn(4, 3))
+
+    def test_csr_mv(self):
+        for nrows, ncols in [(5, 7), (100, 30), (0, 4), (4, 0)]:
+            csr, dense = self._gen_csr(nrows, ncols)
+            vec = torch.randn(ncols)
+            self.assertEqual(csr.mv(vec), dense.mv(vec))
+            vec = torch.randn(ncols * 2)[::2]
+            self.assertEqual(torch.mv(csr, vec), dense.mv(vec))
+
+    def test_csr_mm_backward(self):
+        csr, _ = self._gen_csr(6, 5)
+        values = csr.values().clone().requires_grad_(True)
+        mat = torch.randn(5, 3, requires_grad=True)
+        out = torch.sparse_csr_tensor(csr.crow_indices(), csr.col_indices(), values, csr.shape).mm(mat)
+        grad = torch.randn(6, 3)
+        out.backward(grad)
+
+        dense = csr.to_dense().requires_grad_(True)
+        mat_ref = mat.detach().clone().requires_grad_(True)
+        dense.mm(mat_ref).backward(grad)
+        mask = csr.to_dense() != 0
+        self.assertEqual(values.grad, dense.grad[mask])
+        self.assertEqual(mat.grad, mat_ref.grad)
+
+    def test_csr_mv_backward(self):
+        csr, _ = self._gen_csr(6, 5)
+        values = csr.values().clone().requires_grad_(True)
+        vec = torch.randn(5, requires_grad=True)
+        out = torch.sparse_csr_tensor(csr.crow_indices(), csr.col_indices(), values, csr.shape).mv(vec)
+        grad = torch.randn(6)
+        out.backward(grad)
+
+        dense = csr.to_dense().requires_grad_(True)
+        vec_ref = vec.detach().clone().requires_grad_(True)
+        dense.mv(vec_ref).backward(grad)
+        mask = csr.to_dense() != 0
+        self.assertEqual(values.grad, dense.grad[mask])
+        self.assertEqual(vec.grad, vec_ref.grad)
+
+    def test_csr_to_dense_backward(self):
+        csr, _ = self._gen_csr(4, 6)
+        values = csr.values().clone().requires_grad_(True)
+
+        def fn(v):
+            return torch.sparse_csr_tensor(csr.crow_indices(), csr.col_indices(), v, csr.shape).to_dense()
+
+        gradcheck(fn, (values,))
+
+
 if __name__ == '__main__':
     run_tests()
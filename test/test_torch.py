@@ -13080,6 +13080,105 @@ class TestTorchDeviceType(TestCase):
         x *= y
         self.assertEqual(x, 4.5)
 
+    @onlyCPU
+    def test_bfloat16_elementwise_ops(self, device):
+        x = torch.rand(1000, device=device) + 0.5
+        y = torch.rand(1000, device=device) + 0.5
+        xb, yb = x.bfloat16(), y.bfloat16()
+        # add/sub/mul/div are computed in float and rounded once, so they
+        # match the float result rounded to bfloat16 exactly.
+        for op in (torch.add, torch.sub, torch.mul, torch.div):
+            expected = op(xb.float(), yb.float()).bfloat16()
+            self.assertEqual(op(xb, yb), expected, 0)
+            self.assertEqual(op(xb[::2], yb[::2]), expected[::2], 0)
+
+        ops = [torch.neg, torch.abs, torch.sqrt, torch.rsqrt, torch.reciprocal,
+               torch.exp, torch.log, torch.sigmoid, torch.tanh, torch.floor,
+               torch.ceil, torch.trunc, torch.sin, torch.cos,
+               lambda t: torch.clamp(t, 0.75, 1.25)]
+        for op in ops:
+            for t in (xb, xb[::2]):
+                expected = op(t.float())
+                rel = (op(t).float() - expected).abs() / expected.abs().clamp(min=1e-3)
+                self.assertLessEqual(rel.max().item(), 2 ** -7)
+
+    @onlyCPU
+    def test_bfloat16_reduction_accuracy(self, device):
+        # A running bfloat16 sum stops growing once it is 256x larger than
+        # the elements; the result must be the float sum rounded once.
+        x = torch.ones(100000, dtype=torch.bfloat16, device=device)
+        self.assertEqual(x.sum(), torch.tensor(100000.).bfloat16(), 0)
+        self.assertEqual(x.mean(), torch.tensor(1.).bfloat16(), 0)
+
+        def assertClose(actual, expected):
+            # The float results may be summed in a different order, so they
+            # can round to neighboring bfloat16 values.
+            self.assertEqual(actual.dtype, torch.bfloat16)
+            rel = (actual.float() - expected).abs() / expected.abs()
+            self.assertLessEqual(rel.max().item(), 2 ** -8)
+
+        x = torch.rand(64, 1000, device=device).bfloat16()
+        near_one = (1 + torch.rand(64, 1000, device=device) / 64).bfloat16()
+        # Covers reductions over the contiguous dimension, over the outer
+        # dimension and over a strided input.
+        for t, u in ((x, near_one), (x.t(), near_one.t()), (x[:, ::3], near_one[:, ::3])):
+            for dim in (0, 1):
+                assertClose(t.sum(dim), t.float().sum(dim))
+                assertClose(t.mean(dim), t.float().mean(dim))
+                assertClose(u.prod(dim), u.float().prod(dim))
+            assertClose(t.sum(), t.float().sum())
+            assertClose(t.mean(), t.float().mean())
+        assertClose(near_one[:8].prod(), near_one[:8].float().prod())
+
+        # Full reductions of more than 32768 elements reduce float partial
+        # results of each block of the bfloat16 input.
+        x = torch.rand(3, 100000, device=device).bfloat16()
+        assertClose(x.sum(), x.float().sum())
+        assertClose(x[:, ::3].sum(), x[:, ::3].float().sum())
+        near_one = torch.tensor([1 + 2 ** -7, 1 - 2 ** -7], device=device).repeat(50000).bfloat16()
+        assertClose(near_one.prod(), near_one.float().prod())
+
+        for dim in (0, 1):
+            for fn in (torch.softmax, torch.log_softmax):
+                xf = x.float().requires_grad_()
+                xb = x.clone().requires_grad_()
+                expected = fn(xf, dim)
+                actual = fn(xb, dim)
+                self.assertEqual(actual.float(), expected, 2e-2)
+                grad = torch.rand_like(expected)
+                expected.backward(grad)
+                actual.backward(grad.bfloat16())
+                self.assertEqual(xb.grad.float(), xf.grad, 2e-2)
+
+        weight = torch.rand(1000, device=device).bfloat16()
+        bias = torch.rand(1000, device=device).bfloat16()
+        xf = x.float().requires_grad_()
+        xb = x.clone().requires_grad_()
+        weightf = weight.float().requires_grad_()
+        biasf = bias.float().requires_grad_()
+        weight.requires_grad_()
+        bias.requires_grad_()
+        expected = torch.nn.functional.layer_norm(xf, (1000,), weightf, biasf)
+        actual = torch.nn.functional.layer_norm(xb, (1000,), weight, bias)
+        self.assertEqual(actual.float(), expected, 5e-2)
+        grad = torch.rand_like(expected)
+        expected.backward(grad)
+        actual.backward(grad.bfloat16())
+        self.assertEqual(xb.grad.float(), xf.grad, 5e-2)
+        # dgamma and dbeta sum over the 64 rows, which bfloat16 accumulation
+        # would get wrong by far more than the rounding of the result.
+        for actual_grad, expected_grad in ((weight.grad, weightf.grad), (bias.grad, biasf.grad)):
+            rel = (actual_grad.float() - expected_grad).abs() / expected_grad.abs().clamp(min=1)
+            self.assertLessEqual(rel.max().item(), 2 ** -6)
+
+        a = torch.rand(64, 256, device=device).bfloat16()
+        b = torch.rand(256, 32, device=device).bfloat16()
+        c = torch.rand(64, 32, device=device).bfloat16()
+        expected = torch.addmm(c.float(), a.float(), b.float(), beta=0.5, alpha=2)
+        for actual in (torch.addmm(c, a, b, beta=0.5, alpha=2),
+                       torch.addmm(c, a.t().contiguous().t(), b.t().contiguous().t(), beta=0.5, alpha=2)):
+            self.assertLessEqual(((actual.float() - expected).abs() / expected).max().item(), 2 ** -7)
+
     @onlyCPU
     @dtypes(torch.float, torch.double)
     def test_hardshrink(self, device, dtype):
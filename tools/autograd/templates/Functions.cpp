@@ -503,7 +503,23 @@ Tensor clamp_backward(const Tensor & grad, const Tensor &self, const optional<Sc
   }
 }
 
+// Gradient with respect to the stored entries of a sparse CSR matrix `self`
+// that was multiplied with `b`, given the gradient `a` of the product: entry
+// (i, j) gets a[i] . b[j] (or a[i] * b[j] for vectors). The result keeps the
+// sparsity pattern of `self`, so only nnz dot products are computed.
+Tensor sparse_csr_sampled_grad(const Tensor& self, const Tensor& a, const Tensor& b) {
+  auto indices = self.to_sparse()._indices();
+  auto values = a.index_select(0, indices[0]) * b.index_select(0, indices[1]);
+  if (values.dim() == 2) {
+    values = values.sum(1);
+  }
+  return at::_sparse_csr_tensor_unsafe(self.crow_indices(), self.col_indices(), values, self.sizes());
+}
+
 Tensor mm_mat1_backward(const Tensor & grad, const Tensor & mat2, const Tensor & mat1, const Scalar & alpha) {
+  if (mat1.is_sparse_csr()) {
+    return sparse_csr_sampled_grad(mat1, maybe_multiply(grad, alpha), mat2);
+  }
   // if input was column-major, return grad as column-order for efficiency
   if (mat1.is_sparse()) {
     throw std::runtime_error("calculating the gradient of a sparse Tensor argument to mm is not supported.");
@@ -518,6 +534,10 @@ Tensor mm_mat1_backward(const Tensor & grad, const Tensor & mat2, const Tensor &
 }
 
 Tensor mm_mat2_backward(const Tensor & grad, const Tensor & mat1, IntArrayRef sizes, IntArrayRef strides, const Scalar & alpha) {
+  if (mat1.is_sparse_csr()) {
+    // There is no kernel for a transposed CSR matrix; the COO one handles it.
+    return maybe_multiply(mat1.to_sparse().t().mm(grad), alpha);
+  }
   // if input was column-major, return grad as column-order for efficiency
   if (strides[0] == 1 && strides[1] == sizes[0]) {
     if (mat1.is_sparse()) {
@@ -537,6 +557,20 @@ Tensor mm_mat2_backward(const Tensor & grad, const Tensor & mat1, IntArrayRef si
   }
 }
 
+Tensor mv_self_backward(const Tensor& grad, const Tensor& vec, const Tensor& self) {
+  if (self.is_sparse_csr()) {
+    return sparse_csr_sampled_grad(self, grad, vec);
+  }
+  return grad.ger(vec);
+}
+
+Tensor mv_vec_backward(const Tensor& grad, const Tensor& self) {
+  if (self.is_sparse_csr()) {
+    return self.to_sparse().t().mm(grad.unsqueeze(1)).squeeze(1);
+  }
+  return self.t().mv(grad);
+}
+
 Tensor _sparse_addmm_sparse_backward(const Tensor& grad, const Tensor& sparse_, const Tensor& dense, const Scalar& alpha) {
   AT_ASSERT(sparse_.is_sparse());
   auto sparse = sparse_.coalesce();
@@ -2422,6 +2456,101 @@ infinitely_differentiable_native_layer_norm_backward(
   return std::make_tuple(dX, dgamma, dbeta);
 }
 
+std::tuple<Tensor, Tensor, Tensor>
+infinitely_differentiable_native_group_norm_backward(
+    const Tensor& dY,
+    const Tensor& dmean,
+    const Tensor& drstd,
+    const Tensor& X,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps,
+    std::array<bool, 3> grad_input_mask) {
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const double s = 1.0 / static_cast<double>(D * HxW);
+  Tensor dX;
+  Tensor dgamma;
+  Tensor dbeta;
+
+  const Tensor X_tensor = X.reshape({N, G, D, HxW});
+  const Tensor mean_tensor = mean.reshape({N, G, 1, 1});
+  const Tensor rstd_tensor = rstd.reshape({N, G, 1, 1});
+
+  Tensor dY_tensor;
+  Tensor ds;
+  Tensor db;
+  if (dY.defined()) {
+    dY_tensor = dY.reshape({N, G, D, HxW});
+    ds = (dY_tensor * X_tensor).sum(3).unsqueeze_(-1);
+    db = dY_tensor.sum(3).unsqueeze_(-1);
+  }
+
+  if (grad_input_mask[0]) {
+    Tensor gamma_tensor;
+    if (gamma.defined()) {
+      gamma_tensor = gamma.reshape({1, G, D, 1});
+    }
+    const Tensor rstd_cube = rstd_tensor * rstd_tensor * rstd_tensor;
+    Tensor var;
+    Tensor dvar;
+    if (drstd.defined()) {
+      var = ((rstd_tensor * rstd_tensor).reciprocal_() - eps).clamp_min(0);
+      dvar = -0.5 * rstd_cube * drstd.view({N, G, 1, 1});
+    }
+    if (dY.defined()) {
+      const Tensor a =
+          gamma.defined() ? rstd_tensor * gamma_tensor : rstd_tensor;
+      Tensor b = (gamma.defined() ? ds * gamma_tensor : ds)
+                     .sum(2)
+                     .unsqueeze_(-2);
+      Tensor c = (gamma.defined() ? db * gamma_tensor : db)
+                     .sum(2)
+                     .unsqueeze_(-2);
+      b = (c * mean_tensor - b) * rstd_cube * s;
+      c = -b * mean_tensor - c * rstd_tensor * s;
+      dX = a * dY_tensor + b * X_tensor + c;
+      if (dmean.defined() && drstd.defined()) {
+        dX += var_std_mean_backward(
+            {dvar, dmean.view({N, G, 1, 1})},
+            X_tensor,
+            var,
+            mean_tensor,
+            {2, 3},
+            false,
+            true,
+            false);
+      }
+      dX = dX.reshape_as(X);
+    } else if (dmean.defined() && drstd.defined()) {
+      dX = var_std_mean_backward(
+               {dvar, dmean.view({N, G, 1, 1})},
+               X_tensor,
+               var,
+               mean_tensor,
+               {2, 3},
+               false,
+               true,
+               false)
+               .reshape_as(X);
+    }
+  }
+
+  if (grad_input_mask[1] && dY.defined()) {
+    dgamma = ((ds - db * mean_tensor) * rstd_tensor).sum(0).reshape_as(gamma);
+  }
+  if (grad_input_mask[2] && dY.defined()) {
+    dbeta = db.sum(0).reshape_as(gamma);
+  }
+
+  return std::make_tuple(dX, dgamma, dbeta);
+}
+
 std::tuple<Tensor, Tensor, Tensor> _trilinear_backward(const Tensor& grad_out, const Tensor& i1, const Tensor& i2, const Tensor& i3,
                                                        IntArrayRef expand1, IntArrayRef expand2, IntArrayRef expand3,
                                                        IntArrayRef sumdim, int64_t unroll_dim, std::array<bool, 3> grad_mask) {
@@ -2446,6 +2575,42 @@ Tensor log1p_backward(const Tensor& grad, const Tensor& self) {
   return grad / (self + 1);
 }
 
+Tensor sparse_csr_constructor_values_backward(const Tensor& grad, const Tensor& crow_indices, const Tensor& col_indices) {
+  // Gradients computed by the sparse CSR backward functions keep the sparsity
+  // pattern of their input, i.e. share its index tensors.
+  if (grad.is_sparse_csr() &&
+      grad.crow_indices().data_ptr() == crow_indices.data_ptr() &&
+      grad.col_indices().data_ptr() == col_indices.data_ptr()) {
+    return grad.values();
+  }
+  auto dense_grad = grad.layout() == at::kStrided ? grad : grad.to_dense();
+  int64_t nrows = crow_indices.size(0) - 1;
+  auto row_counts = crow_indices.narrow(0, 1, nrows) - crow_indices.narrow(0, 0, nrows);
+  auto rows = at::repeat_interleave(row_counts);
+  return dense_grad.index({rows, col_indices});
+}
+
+Tensor values_backward(const Tensor& grad, const Tensor& self) {
+  if (self.is_sparse_csr()) {
+    return at::_sparse_csr_tensor_unsafe(self.crow_indices(), self.col_indices(), grad, self.sizes());
+  }
+  return at::_sparse_coo_tensor_unsafe(self.indices(), grad, self.sizes())._coalesced_(true);
+}
+
+Tensor to_sparse_backward(const Tensor& grad, const Tensor& self) {
+  if (self.is_sparse_csr()) {
+    return at::to_dense_backward(grad.to_dense(), self);
+  }
+  return grad.to_dense();
+}
+
+Tensor to_sparse_csr_backward(const Tensor& grad, const Tensor& self) {
+  if (self.is_sparse()) {
+    return grad.to_sparse();
+  }
+  return grad.to_dense();
+}
+
 Tensor sparse_constructor_values_backward(const Tensor& sparse_grad_out, const Tensor& indices, IntArrayRef values_shape) {
   // TODO: improve this backward by writing a kernel (maybe)
   auto dense_grad = sparse_grad_out.is_sparse() ? sparse_grad_out.to_dense() : sparse_grad_out;
@@ -272,116 +272,71 @@ def load_op_list(path):
     return op_list
 
 
-def gen_jit_dispatch(declarations, out, template_path, disable_autograd=False, selected_op_list_path=None):
-    REGISTER_ATEN_OPS_CPP = CodeTemplate.from_file(template_path + '/register_aten_ops.cpp')
-
-    ops = []
-
-    def get_invocation(decl, args, num_inputs):
-
-        # because the arg list can get lengthy we put them on a separate line
-        def pack_arguments(args):
-            return ',\n'.join(args)
-        is_namespace_function = 'namespace' in decl['method_of']
-        tensor_options_arg_index = decl.get('tensor_options_arg_index', None)
-        if tensor_options_arg_index is not None:
-            dtype = args[tensor_options_arg_index]
-            layout = args[tensor_options_arg_index + 1]
-            device = args[tensor_options_arg_index + 2]
-            pin_memory = args[tensor_options_arg_index + 3]
-            args_with_tensor_options = args[:tensor_options_arg_index] + \
-                ['options'] + args[(tensor_options_arg_index + 4):]
-            if is_namespace_function:
-                return CALL_NAMESPACE_WITH_TENSOR_OPTIONS.substitute(
-                    name=decl['name'], dtype=dtype, layout=layout,
-                    device=device, pin_memory=pin_memory,
-                    args_with_tensor_options=pack_arguments(args_with_tensor_options))
-            else:
-                return CALL_METHOD_WITH_TENSOR_OPTIONS.substitute(
-                    name=decl['name'], dtype=dtype, layout=layout,
-                    device=device, pin_memory=pin_memory,
-                    args_with_tensor_options=pack_arguments(args_with_tensor_options[1:]),
-                    first=args_with_tensor_options[0], num_inputs=num_inputs)
+def get_invocation(decl, args, num_inputs):
+
+    # because the arg list can get lengthy we put them on a separate line
+    def pack_arguments(args):
+        return ',\n'.join(args)
+    is_namespace_function = 'namespace' in decl['method_of']
+    tensor_options_arg_index = decl.get('tensor_options_arg_index', None)
+    if tensor_options_arg_index is not None:
+        dtype = args[tensor_options_arg_index]
+        layout = args[tensor_options_arg_index + 1]
+        device = args[tensor_options_arg_index + 2]
+        pin_memory = args[tensor_options_arg_index + 3]
+        args_with_tensor_options = args[:tensor_options_arg_index] + \
+            ['options'] + args[(tensor_options_arg_index + 4):]
+        if is_namespace_function:
+            return CALL_NAMESPACE_WITH_TENSOR_OPTIONS.substitute(
+                name=decl['name'], dtype=dtype, layout=layout,
+                device=device, pin_memory=pin_memory,
+                args_with_tensor_options=pack_arguments(args_with_tensor_options))
         else:
-            if is_namespace_function:
-                return CALL_NAMESPACE.substitute(name=decl['name'],
-                                                 args=pack_arguments(args),
-                                                 num_inputs=num_inputs)
-            else:
-                return CALL_METHOD.substitute(
-                    name=decl['name'], first=args[0],
-                    args=pack_arguments(args[1:]), num_inputs=num_inputs)
-
-    def requires_lvalue(arg):
-        return 'jit_type' in arg and arg['jit_type'] in {"Tensor!", "Tensor(a!)"}
+            return CALL_METHOD_WITH_TENSOR_OPTIONS.substitute(
+                name=decl['name'], dtype=dtype, layout=layout,
+                device=device, pin_memory=pin_memory,
+                args_with_tensor_options=pack_arguments(args_with_tensor_options[1:]),
+                first=args_with_tensor_options[0], num_inputs=num_inputs)
+    else:
+        if is_namespace_function:
+            return CALL_NAMESPACE.substitute(name=decl['name'],
+                                             args=pack_arguments(args),
+                                             num_inputs=num_inputs)
+        else:
+            return CALL_METHOD.substitute(
+                name=decl['name'], first=args[0],
+                args=pack_arguments(args[1:]), num_inputs=num_inputs)
 
-    def emit_decl_variant(decl):
-        if ('emit_dummy_placeholder' in decl):
-            return "DUMMY_OPERATION"
-        kw_assignments = []
-
-        # mutable arguments in aten are passed as non const references
-        # these must be lvalues, so we have to put them in variables
-        # before calling the function
-        lvalues = []
-
-        arguments = []
-        num_inputs = len(decl['arguments'])
-        op_capture = ''
-        order = argument_order(decl)
-        for i, arg in enumerate(decl['arguments']):
-            value = from_ivalue(arg, '(std::move(peek(stack, {}, {})))'.format(order[i], num_inputs))
-            if requires_lvalue(arg):
-                lvalues.append('auto {} = {};\n'.format(arg['name'], value))
-                value = arg['name']
-            arguments.append(value)
-
-        call = get_invocation(decl, arguments, num_inputs)
-
-        returns = decl['returns']
-
-        constructor = CONSTRUCTOR.substitute(name=decl['name'],
-                                             call=call,
-                                             kw_assignments=kw_assignments,
-                                             num_inputs=num_inputs,
-                                             op_capture=op_capture,
-                                             lvalues=lvalues)
-        return constructor
 
-    def filter_decls(jit_decls, disable_autograd, selected_op_list):
-        result = []
-        for decl in jit_decls:
-            if disable_autograd and is_backward_op(decl):
-                continue
-            if selected_op_list and signature_without_args(decl) not in selected_op_list:
-                decl['emit_dummy_placeholder'] = True
-            result.append(decl)
-        return result
+def requires_lvalue(arg):
+    return 'jit_type' in arg and arg['jit_type'] in {"Tensor!", "Tensor(a!)"}
 
-    # This function declares an order on declarations. This is necessary because
-    # there is some ambiguity in the choice of overload: if an argument is overloaded
-    # to accept both Scalar and Tensor, the schema with the Tensor should come first
-    # TODO: this can (probably) be removed when we remove the implicit conversion
-    # from Tensor -> Number.
-    def sort_decls(jit_decls):
-        def declkey(decl):
-            # key = sum_{i < len(args)} {1 if arg is tensor else 2} * (3 ** i)
-            # This is a ternary encoding where
-            # 0: No argument at this position
-            # 1: Tensor argument at this position
-            # 2: Some other argument at this position.
-            args = decl['arguments']
-            result = 0
-            for i in range(len(args)):
-                result += (3 ** i) * (1 if args[i]['simple_type'] == 'Tensor' else 2)
-            return result
 
-        # NB: itertools.groupby requires the list be sorted.
-        sorted_decls = sorted(jit_decls, key=lambda decl: decl['name'])
-        grouped_decls = [list(g) for _, g in
-                         groupby(sorted_decls, key=lambda decl: decl['name'])]
-        return [sorted(g, key=declkey) for g in grouped_decls]
+def emit_call(decl):
+    """Returns the statements that unpack the arguments of decl from the
+    stack and call it, as (lvalues, call, num_inputs)."""
+    # mutable arguments in aten are passed as non const references
+    # these must be lvalues, so we have to put them in variables
+    # before calling the function
+    lvalues = []
+
+    arguments = []
+    num_inputs = len(decl['arguments'])
+    order = argument_order(decl)
+    for i, arg in enumerate(decl['arguments']):
+        value = from_ivalue(arg, '(std::move(peek(stack, {}, {})))'.format(order[i], num_inputs))
+        if requires_lvalue(arg):
+            lvalues.append('auto {} = {};\n'.format(arg['name'], value))
+            value = arg['name']
+        arguments.append(value)
+
+    call = get_invocation(decl, arguments, num_inputs)
+    return lvalues, call, num_inputs
 
+
+def load_jit_decls(declarations):
+    """Loads the declarations in Declarations.yaml that are exposed as JIT
+    operators, with TensorOptions expanded and alias annotations added."""
     # We need to add methods implemented manually in TensorImpl
     # TODO: This seems to claim sizes() returns an int64_t.  Really?
     tensor_impl_methods = [{
@@ -444,6 +399,55 @@ def gen_jit_dispatch(declarations, out, template_path, disable_autograd=False, s
                 additional_jit_decls.append(decl_copy)
 
     jit_decls.extend(additional_jit_decls)
+    return jit_decls
+
+
+def gen_jit_dispatch(declarations, out, template_path, disable_autograd=False, selected_op_list_path=None):
+    REGISTER_ATEN_OPS_CPP = CodeTemplate.from_file(template_path + '/register_aten_ops.cpp')
+
+    def emit_decl_variant(decl):
+        if ('emit_dummy_placeholder' in decl):
+            return "DUMMY_OPERATION"
+        lvalues, call, num_inputs = emit_call(decl)
+        return CONSTRUCTOR.substitute(call=call,
+                                      num_inputs=num_inputs,
+                                      lvalues=lvalues)
+
+    def filter_decls(jit_decls, disable_autograd, selected_op_list):
+        result = []
+        for decl in jit_decls:
+            if disable_autograd and is_backward_op(decl):
+                continue
+            if selected_op_list and signature_without_args(decl) not in selected_op_list:
+                decl['emit_dummy_placeholder'] = True
+            result.append(decl)
+        return result
+
+    # This function declares an order on declarations. This is necessary because
+    # there is some ambiguity in the choice of overload: if an argument is overloaded
+    # to accept both Scalar and Tensor, the schema with the Tensor should come first
+    # TODO: this can (probably) be removed when we remove the implicit conversion
+    # from Tensor -> Number.
+    def sort_decls(jit_decls):
+        def declkey(decl):
+            # key = sum_{i < len(args)} {1 if arg is tensor else 2} * (3 ** i)
+            # This is a ternary encoding where
+            # 0: No argument at this position
+            # 1: Tensor argument at this position
+            # 2: Some other argument at this position.
+            args = decl['arguments']
+            result = 0
+            for i in range(len(args)):
+                result += (3 ** i) * (1 if args[i]['simple_type'] == 'Tensor' else 2)
+            return result
+
+        # NB: itertools.groupby requires the list be sorted.
+        sorted_decls = sorted(jit_decls, key=lambda decl: decl['name'])
+        grouped_decls = [list(g) for _, g in
+                         groupby(sorted_decls, key=lambda decl: decl['name'])]
+        return [sorted(g, key=declkey) for g in grouped_decls]
+
+    jit_decls = load_jit_decls(declarations)
     selected_op_list = load_op_list(selected_op_list_path) if selected_op_list_path else None
     jit_decls = filter_decls(jit_decls, disable_autograd, selected_op_list)
 
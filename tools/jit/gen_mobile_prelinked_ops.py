@@ -0,0 +1,179 @@
+"""
+Generates a table of prelinked operators for the lite interpreter that
+contains only the ATen operators used by a set of bytecode models, see
+torch/csrc/jit/mobile/prelinked_ops.h.
+
+To run this file by hand from the root of the PyTorch
+repository, run:
+
+python -m tools.jit.gen_mobile_prelinked_ops \
+       build/aten/src/ATen/Declarations.yaml \
+       $OUTPUT_DIR \
+       tools/jit/templates \
+       model1.bc model2.bc
+
+Where $OUTPUT_DIR is where you would like the files to be
+generated.  In the full build system, OUTPUT_DIR is
+torch/csrc/jit/generated/
+
+The models are the files written by torch::jit::script::Module::_save_for_mobile.
+Pass --op-list-out to also write the operators in the format of
+SELECTED_OP_LIST, so that the rest of the build can be stripped to them.
+tools/setup_helpers/generate_code.py does this when the build sets
+MOBILE_PRELINKED_OPS_MODELS but not SELECTED_OP_LIST.
+"""
+
+import argparse
+import os
+import pickle
+import zipfile
+import yaml
+from ..autograd.utils import CodeTemplate, write
+from .gen_jit_dispatch import emit_call, load_jit_decls, signature_without_args
+
+# Operators that torch/csrc/jit/mobile/register_mobile_ops.cpp always
+# registers with the dispatcher, because they aren't ATen functions. Keep in
+# sync with the registry there.
+MOBILE_DISPATCHER_OPS = {
+    'aten::Int',
+    'aten::__is__',
+    'aten::append',
+    'aten::eq',
+    'aten::format',
+    'aten::warn',
+    'prim::ListConstruct',
+    'prim::NumToTensor',
+    'prim::TupleConstruct',
+    'prim::TupleUnpack',
+    'prim::unchecked_cast',
+}
+
+PRELINKED_OPERATOR = CodeTemplate("""\
+{"${name}", "${overload_name}", [](Stack& stack) {
+#ifdef USE_STATIC_DISPATCH
+    at::AutoNonVariableTypeMode non_var_type_mode(true);
+#endif
+    ${lvalues}
+    ${call}
+    drop(stack, ${num_inputs});
+    pack(stack, std::move(result_));
+    return 0;
+}},
+""")
+
+
+class _Unresolved(object):
+    """Stands in for the classes and functions a bytecode archive refers to,
+    e.g. the ones that rebuild its tensors, which we don't need."""
+
+    def __init__(self, *args, **kwargs):
+        pass
+
+    def __call__(self, *args, **kwargs):
+        return None
+
+    def __setstate__(self, state):
+        pass
+
+
+class _BytecodeUnpickler(pickle.Unpickler):
+    def find_class(self, module, name):
+        return _Unresolved
+
+    def persistent_load(self, pid):
+        return None
+
+
+def load_model_ops(path):
+    """Returns the (name, overload_name) pairs of the operators that the
+    methods of a bytecode model call."""
+    with zipfile.ZipFile(path) as archive:
+        records = [n for n in archive.namelist() if n.endswith('/bytecode.pkl')]
+        if len(records) != 1:
+            raise RuntimeError('{} is not a bytecode model'.format(path))
+        with archive.open(records[0]) as f:
+            methods = _BytecodeUnpickler(f).load()
+
+    ops = set()
+    for _, method in methods:
+        for section, value in method:
+            if section == 'operators':
+                ops.update((name, overload_name) for name, overload_name in value)
+    return ops
+
+
+def gen_mobile_prelinked_ops(declarations, out, template_path, model_paths, op_list_out=None):
+    PRELINKED_MOBILE_OPS_CPP = CodeTemplate.from_file(template_path + '/prelinked_mobile_ops.cpp')
+
+    ops = set()
+    for path in model_paths:
+        ops |= load_model_ops(path)
+
+    # There may be several declarations with the signature of an operator,
+    # e.g. the variants taking lists of optional tensors. The first one is
+    # the one that matches its schema.
+    decls_by_signature = {}
+    for decl in load_jit_decls(declarations):
+        decls_by_signature.setdefault(signature_without_args(decl), decl)
+
+    def qualified_name(op):
+        name, overload_name = op
+        return name + '.' + overload_name if overload_name else name
+
+    prelinked = []
+    unknown = []
+    for op in ops:
+        if qualified_name(op) in decls_by_signature:
+            prelinked.append(op)
+        elif op[0] not in MOBILE_DISPATCHER_OPS:
+            unknown.append(qualified_name(op))
+    if unknown:
+        raise RuntimeError(
+            'Operators used by the models are neither ATen operators nor registered '
+            'by register_mobile_ops.cpp: {}'
+            .format(', '.join(sorted(unknown))))
+
+    # RegisterPrelinkedOperators requires the table to be sorted like
+    # strcmp() would, i.e. by bytes.
+    prelinked.sort(key=lambda op: (op[0].encode('utf-8'), op[1].encode('utf-8')))
+
+    operators = []
+    for op in prelinked:
+        lvalues, call, num_inputs = emit_call(decls_by_signature[qualified_name(op)])
+        operators.append(PRELINKED_OPERATOR.substitute(name=op[0],
+                                                       overload_name=op[1],
+                                                       lvalues=lvalues,
+                                                       call=call,
+                                                       num_inputs=num_inputs))
+
+    env = {
+        'models': [os.path.basename(p) for p in model_paths],
+        'operators': operators,
+    }
+    write(out, 'prelinked_mobile_ops.cpp', PRELINKED_MOBILE_OPS_CPP, env)
+
+    if op_list_out:
+        with open(op_list_out, 'w') as f:
+            yaml.dump(sorted(qualified_name(op) for op in prelinked), f, default_flow_style=False)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generate prelinked operators for the lite interpreter')
+    parser.add_argument('declarations', metavar='DECL',
+                        help='path to Declarations.yaml')
+    parser.add_argument('out', metavar='OUT',
+                        help='path to output directory')
+    parser.add_argument('template_path', metavar='TEMPLATE_PATH',
+                        help='path to templates directory')
+    parser.add_argument('models', metavar='MODEL', nargs='+',
+                        help='paths to bytecode models')
+    parser.add_argument('--op-list-out',
+                        help='path to write the prelinked operators to, in the format of SELECTED_OP_LIST')
+    args = parser.parse_args()
+    gen_mobile_prelinked_ops(args.declarations, args.out, args.template_path,
+                             args.models, args.op_list_out)
+
+
+if __name__ == '__main__':
+    main()
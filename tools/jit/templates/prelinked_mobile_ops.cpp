@@ -0,0 +1,65 @@
+#include "torch/csrc/jit/mobile/prelinked_ops.h"
+#include "torch/csrc/autograd/generated/variable_factories.h"
+
+#include <ATen/ATen.h>
+#include <ATen/core/stack.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// ${generated_comment}
+
+// Prelinked operators of the lite interpreter for the models
+// ${models}
+
+namespace torch { namespace jit { namespace mobile {
+
+using at::Scalar;
+using at::ScalarType;
+using at::Tensor;
+using at::TensorOptions;
+using at::MemoryFormat;
+
+namespace {
+
+// XXX: This function is to specialize IValue for tensor type in
+// interpreter, it should only be used in this file
+at::Tensor toOptionalTensor(const IValue& v) {
+  if (v.isNone()) {
+    return at::Tensor();
+  }
+  return v.toTensor();
+}
+
+// XXX: This function is to specialize IValue for list of optional
+// tensor type in interpreter, it should only be used in this file
+std::vector<Tensor> toListOfOptionalTensor(const IValue& v) {
+  // v is a list of optional tensor, loop over as generic list
+  auto vlist = v.toGenericListRef();
+  std::vector<Tensor> res;
+
+  for (const IValue &v: vlist) {
+    res.emplace_back(toOptionalTensor(v));
+  }
+  return res;
+}
+
+template<size_t N>
+std::array<bool, N> as_bool_array(const c10::List<bool>& list) {
+  std::array<bool, N> res;
+  AT_ASSERT(list.size() == N);
+  std::copy(list.begin(), list.end(), res.begin());
+  return res;
+}
+
+// sorted by name and overload name
+const PrelinkedOperator prelinked_operators[] = {
+    ${operators}
+};
+
+RegisterPrelinkedOperators reg(prelinked_operators);
+
+} // namespace
+
+}}} // namespace torch::jit::mobile
@@ -25,12 +25,14 @@ def generate_code(ninja_global=None,
                   install_dir=None,
                   subset=None,
                   disable_autograd=False,
-                  selected_op_list_path=None):
+                  selected_op_list_path=None,
+                  mobile_prelinked_models=None):
     # cwrap depends on pyyaml, so we can't import it earlier
     root = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
     sys.path.insert(0, root)
     from tools.autograd.gen_autograd import gen_autograd, gen_autograd_python
     from tools.jit.gen_jit_dispatch import gen_jit_dispatch
+    from tools.jit.gen_mobile_prelinked_ops import gen_mobile_prelinked_ops
 
     # Build ATen based Variable classes
     autograd_gen_dir = install_dir or 'torch/csrc/autograd/generated'
@@ -49,6 +51,17 @@ def generate_code(ninja_global=None,
             'tools/autograd',
             disable_autograd=disable_autograd,
         )
+        if mobile_prelinked_models:
+            # Unless a list is given explicitly, only register the operators
+            # that the models use.
+            prelinked_op_list_path = os.path.join(jit_gen_dir, 'prelinked_mobile_ops.yaml')
+            gen_mobile_prelinked_ops(
+                declarations_path or DECLARATIONS_PATH,
+                jit_gen_dir,
+                'tools/jit/templates',
+                mobile_prelinked_models.split(','),
+                op_list_out=prelinked_op_list_path)
+            selected_op_list_path = selected_op_list_path or prelinked_op_list_path
         gen_jit_dispatch(
             declarations_path or DECLARATIONS_PATH,
             jit_gen_dir,
@@ -75,7 +88,12 @@ def main():
     )
     parser.add_argument(
         '--selected-op-list-path',
-        help='Path to the yaml file that contains the list of operators to include for custom build.',
+        help='Path to the yaml file that contains the list of operators to include for custom build. '
+             'Defaults to the operators of --mobile-prelinked-models when those are given.',
+    )
+    parser.add_argument(
+        '--mobile-prelinked-models',
+        help='Comma separated paths to the bytecode models whose operators to prelink for the lite interpreter.',
     )
     options = parser.parse_args()
     generate_code(
@@ -86,6 +104,7 @@ def main():
         options.subset,
         options.disable_autograd,
         options.selected_op_list_path,
+        options.mobile_prelinked_models,
     )
 
 
@@ -319,6 +319,7 @@ import torch.backends.cuda
 import torch.backends.mkl
 import torch.backends.openmp
 import torch.backends.quantized
+import torch.backends.winograd
 import torch.quantization
 import torch.utils.data
 import torch.__config__
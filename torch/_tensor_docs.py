@@ -1228,6 +1228,27 @@ See also :meth:`Tensor.values`.
   :meth:`Tensor.coalesce` for details.
 """)
 
+add_docstr_all('crow_indices',
+               r"""
+crow_indices() -> Tensor
+
+If :attr:`self` is a sparse CSR tensor (i.e., with ``torch.sparse_csr`` layout),
+this returns a view of the row pointers: entry ``i`` is the offset of the first
+entry of row ``i`` in :meth:`Tensor.col_indices` and :meth:`Tensor.values`.
+Otherwise, this throws an error.
+""")
+
+add_docstr_all('col_indices',
+               r"""
+col_indices() -> Tensor
+
+If :attr:`self` is a sparse CSR tensor (i.e., with ``torch.sparse_csr`` layout),
+this returns a view of the column indices of its entries. Otherwise, this throws
+an error.
+
+See also :meth:`Tensor.crow_indices`.
+""")
+
 add_docstr_all('get_device',
                r"""
 get_device() -> Device ordinal (Integer)
@@ -2955,6 +2976,23 @@ Example::
            size=(3, 3), nnz=1, layout=torch.sparse_coo)
 """)
 
+add_docstr_all('to_sparse_csr',
+               r"""
+to_sparse_csr() -> Tensor
+Returns a copy of the matrix in compressed sparse row format, i.e. with
+``torch.sparse_csr`` layout. :attr:`self` must be a 2-D strided tensor or a
+sparse COO tensor with two sparse dimensions and no dense dimensions.
+
+Example::
+
+    >>> d = torch.tensor([[0., 0., 0.], [9., 0., 10.], [0., 0., 0.]])
+    >>> d.to_sparse_csr()
+    tensor(crow_indices=tensor([0, 0, 2, 2]),
+           col_indices=tensor([0, 2]),
+           values=tensor([ 9., 10.]), size=(3, 3), nnz=2,
+           layout=torch.sparse_csr)
+""")
+
 add_docstr_all('to_mkldnn',
                r"""
 to_mkldnn() -> Tensor
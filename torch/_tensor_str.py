@@ -277,6 +277,20 @@ def _str(self):
         if values.numel() == 0:
             values_str += ', size=' + str(tuple(values.shape))
         tensor_str = indices_prefix + indices_str + '),\n' + ' ' * indent + values_prefix + values_str + ')'
+    elif self.layout == torch.sparse_csr:
+        suffixes.append('size=' + str(tuple(self.shape)))
+        suffixes.append('nnz=' + str(self._nnz()))
+        if not has_default_dtype:
+            suffixes.append('dtype=' + str(self.dtype))
+        strs = []
+        for name in ('crow_indices', 'col_indices', 'values'):
+            prefix = name + '=tensor('
+            member = getattr(self, name)().detach()
+            member_str = _tensor_str(member, indent + len(prefix))
+            if member.numel() == 0:
+                member_str += ', size=' + str(tuple(member.shape))
+            strs.append(prefix + member_str + ')')
+        tensor_str = (',\n' + ' ' * indent).join(strs)
     elif self.is_quantized:
         suffixes.append('size=' + str(tuple(self.shape)))
         if not has_default_dtype:
@@ -5068,6 +5068,35 @@ Example::
 .. _torch.sparse: https://pytorch.org/docs/stable/sparse.html
 """.format(**factory_common_args))
 
+add_docstr(torch.sparse_csr_tensor,
+           r"""
+sparse_csr_tensor(crow_indices, col_indices, values, size) -> Tensor
+
+Constructs a 2-D sparse tensor in compressed sparse row (CSR) format. The entries
+of row ``i`` are ``values[crow_indices[i]:crow_indices[i + 1]]``, in the columns
+given by the same slice of :attr:`col_indices`. Only CPU tensors with scalar
+values are supported.
+
+Args:
+    crow_indices (Tensor): 1-D int64 tensor of size ``size[0] + 1`` holding the
+        offset of the first entry of every row. It must start at 0, be
+        non-decreasing and end at the number of entries.
+    col_indices (Tensor): 1-D int64 tensor with the column of every entry.
+    values (Tensor): 1-D tensor with the value of every entry.
+    size (list, tuple, or :class:`torch.Size`): Size of the sparse tensor.
+
+Example::
+
+    >>> crow_indices = torch.tensor([0, 2, 2, 3])
+    >>> col_indices = torch.tensor([0, 3, 1])
+    >>> values = torch.tensor([1., 2., 3.])
+    >>> torch.sparse_csr_tensor(crow_indices, col_indices, values, [3, 4])
+    tensor(crow_indices=tensor([0, 2, 2, 3]),
+           col_indices=tensor([0, 3, 1]),
+           values=tensor([1., 2., 3.]), size=(3, 4), nnz=3,
+           layout=torch.sparse_csr)
+""")
+
 add_docstr(torch.sqrt,
            r"""
 sqrt(input, out=None) -> Tensor
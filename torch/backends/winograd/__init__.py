@@ -0,0 +1,31 @@
+import sys
+import torch
+from contextlib import contextmanager
+from torch.backends import ContextProp, PropModule, __allow_nonbracketed_mutation
+
+# Whether 3x3 stride-1 float convolutions on CPU may use the Winograd kernel
+# when no gradient is required. It is faster for layers with many channels,
+# but rounds differently from the default kernels, so it is off by default.
+
+def set_flags(_enabled):
+    orig_flags = (torch._C._get_winograd_conv_enabled(),)
+    torch._C._set_winograd_conv_enabled(_enabled)
+    return orig_flags
+
+@contextmanager
+def flags(enabled=False):
+    with __allow_nonbracketed_mutation():
+        orig_flags = set_flags(enabled)
+    try:
+        yield
+    finally:
+        with __allow_nonbracketed_mutation():
+            set_flags(orig_flags[0])
+
+class WinogradModule(PropModule):
+    def __init__(self, m, name):
+        super(WinogradModule, self).__init__(m, name)
+
+    enabled = ContextProp(torch._C._get_winograd_conv_enabled, torch._C._set_winograd_conv_enabled)
+
+sys.modules[__name__] = WinogradModule(sys.modules[__name__], __name__)
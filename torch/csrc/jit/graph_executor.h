@@ -35,6 +35,15 @@ struct GraphExecutorState {
   const Graph* graph = nullptr;
   ExecutionPlan fallback; // XXX: members of this field are optional
   std::unordered_map<ArgumentSpec, ExecutionPlan> execution_plans;
+  // Only set by the profiling executor, which keeps one optimized plan per
+  // class of input shapes; execution_plans holds the most recently used one.
+  size_t num_specialized_plans = 0;
+  size_t num_guard_failures = 0;
+  size_t num_bailouts = 0;
+  size_t num_recompilations = 0;
+  // profiling records still alive, including retired ones whose profiling
+  // plans are still running
+  size_t num_profiling_records = 0;
 };
 
 struct GraphExecutorImplBase;
@@ -62,6 +71,8 @@ TORCH_API std::shared_ptr<Graph> lastExecutedOptimizedGraph();
 
 TORCH_API std::atomic<bool> &getProfilingMode();
 TORCH_API std::atomic<bool>& getExecutorMode();
+// Maximum number of shape-specialized plans a profiling executor keeps.
+TORCH_API std::atomic<size_t>& getProfilingPlanCacheSize();
 
 struct TORCH_API GraphOptimizerEnabledGuard {
   GraphOptimizerEnabledGuard(bool state)
@@ -9,6 +9,7 @@
 #include <torch/csrc/jit/import.h>
 #include <torch/csrc/jit/irparser.h>
 #include <torch/csrc/jit/operator.h>
+#include <torch/csrc/jit/passes/batch_mm.h>
 #include <torch/csrc/jit/passes/canonicalize.h>
 #include <torch/csrc/jit/passes/canonicalize_ops.h>
 #include <torch/csrc/jit/passes/common_subexpression_elimination.h>
@@ -18,6 +19,8 @@
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
 #include <torch/csrc/jit/passes/decompose_ops.h>
 #include <torch/csrc/jit/passes/erase_number_types.h>
+#include <torch/csrc/jit/passes/fork_independent_regions.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
 #include <torch/csrc/jit/passes/fuse_linear.h>
 #include <torch/csrc/jit/passes/graph_fuser.h>
 #include <torch/csrc/jit/passes/inline_fork_wait.h>
@@ -25,6 +28,8 @@
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_graph.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/memory_planning.h>
+#include <torch/csrc/jit/passes/optimize_for_inference.h>
 #include <torch/csrc/jit/passes/onnx.h>
 #include <torch/csrc/jit/passes/onnx/cast_all_constant_to_floating.h>
 #include <torch/csrc/jit/passes/onnx/constant_fold.h>
@@ -192,6 +197,17 @@ void initJITBindings(PyObject* module) {
           [](std::shared_ptr<Graph>& g) { return QuantFusion(g); })
       .def("_jit_pass_fold_convbn", &FoldConvBatchNorm2d)
       .def("_jit_pass_fuse_linear", &FuseLinear)
+      .def(
+          "_freeze_module",
+          [](const script::Module& module) { return freeze_module(module); })
+      .def("_jit_pass_fold_frozen_conv_bn", &FoldFrozenConvBatchNorm)
+      .def("_jit_pass_fuse_conv_linear_relu", &FuseConvLinearRelu)
+      .def("_jit_pass_prepack_conv_weights", &PrepackConvWeights)
+      .def(
+          "_optimize_for_inference",
+          [](const script::Module& module) {
+            return optimize_for_inference(module);
+          })
       .def(
           "_jit_pass_fold_quantize",
           [](script::Module& module, const std::string& method_name) {
@@ -262,9 +278,30 @@ void initJITBindings(PyObject* module) {
             }
             PropagateInputShapes(graph);
           })
+      .def(
+          "_jit_pass_plan_memory",
+          [](std::shared_ptr<Graph>& graph) {
+            auto stats = PlanMemory(graph);
+            return std::make_pair(
+                stats.arena_bytes, stats.intermediate_bytes);
+          })
       .def("_jit_pass_remove_expands", RemoveExpands)
       .def("_jit_pass_erase_number_types", EraseNumberTypes)
+      .def("_jit_pass_batch_mm", BatchMM)
+      .def(
+          "_jit_override_horizontal_mm_batching",
+          &overrideHorizontalMMBatching)
+      .def(
+          "_jit_horizontal_mm_batching_enabled",
+          &horizontalMMBatchingEnabled)
       .def("_jit_pass_inline_fork_wait", InlineForkWait)
+      .def(
+          "_jit_pass_fork_independent_regions",
+          [](std::shared_ptr<Graph>& graph, int64_t min_cost) {
+            ForkIndependentRegions(graph, min_cost);
+          },
+          py::arg("graph"),
+          py::arg("min_cost") = kDefaultForkMinCost)
       .def("_jit_pass_inline", Inline)
       .def("_jit_pass_prepare_division_for_onnx", PrepareDivisionForONNX)
       .def(
@@ -340,6 +377,13 @@ void initJITBindings(PyObject* module) {
             getExecutorMode() = profiling_flag;
             return oldState;
           })
+      .def(
+          "_jit_set_profiling_plan_cache_size",
+          [](size_t size) {
+            size_t oldSize = getProfilingPlanCacheSize();
+            getProfilingPlanCacheSize() = size;
+            return oldSize;
+          })
       .def(
           "_jit_set_inline_everything_mode",
           [](bool enabled) { script::getInlineEverythingMode() = enabled; })
@@ -419,7 +463,17 @@ void initJITBindings(PyObject* module) {
           "execution_plans",
           [](GraphExecutorState& s) { return s.execution_plans; })
       .def_property_readonly(
-          "fallback", [](GraphExecutorState& s) { return s.fallback; });
+          "fallback", [](GraphExecutorState& s) { return s.fallback; })
+      .def_readonly(
+          "num_specialized_plans", &GraphExecutorState::num_specialized_plans)
+      .def_readonly(
+          "num_guard_failures", &GraphExecutorState::num_guard_failures)
+      .def_readonly("num_bailouts", &GraphExecutorState::num_bailouts)
+      .def_readonly(
+          "num_recompilations", &GraphExecutorState::num_recompilations)
+      .def_readonly(
+          "num_profiling_records",
+          &GraphExecutorState::num_profiling_records);
 
   py::class_<PyTorchStreamWriter>(m, "PyTorchFileWriter")
       .def(py::init<std::string>())
@@ -47,6 +47,10 @@ struct TORCH_API Code {
   const std::vector<Instruction>& instructions() const;
   const std::vector<Node*>& instructions_source() const;
   size_t register_size() const;
+  // Number of failed prim::Guard checks and of bailouts to the unoptimized
+  // graph, summed over all runs of this code.
+  size_t num_guard_failures() const;
+  size_t num_bailouts() const;
 
  private:
   std::shared_ptr<CodeImpl> pImpl;
@@ -158,7 +158,9 @@ void Node::printAttrValue(std::ostream& out, const Symbol& name) const {
     case AttributeKind::t: {
       at::Tensor tensor = t(name);
       // 1-elem tensors are usually boxed scalars, so print them like it
-      if (tensor.numel() == 1) {
+      if (tensor.is_mkldnn()) {
+        out << "<Tensor>";
+      } else if (tensor.numel() == 1) {
         auto scalar_tensor = tensor.view({}).item();
         out << "{";
         if (scalar_tensor.isFloatingPoint()) {
@@ -36,12 +36,18 @@ void Function::append_operator(const std::string& name,
   // Keep the original opname in code_
   code_->op_names_.emplace_back(name, overload_name);
   auto opname = code_->op_names_.back();
+  if (auto prelinked_op = findPrelinkedOperator(opname)) {
+    code_->operators_.emplace_back(c10::nullopt);
+    code_->prelinked_operators_.emplace_back(prelinked_op);
+    return;
+  }
   // Add "_" prefix to work around the double registration both of jit/generated
   // and here. TODO: remove it when we have separate build for lite interpreter.
   opname.name = "_" + opname.name;
   auto op = c10::Dispatcher::singleton().findSchema(opname);
   TORCH_CHECK(op.has_value(), opname.name, ".", opname.overload_name, " cannot be found.");
   code_->operators_.emplace_back(op);
+  code_->prelinked_operators_.emplace_back(nullptr);
 }
 
 void Function::build_vararg_operator_table() {
@@ -4,6 +4,7 @@
 #include <torch/csrc/jit/unpickler.h>
 #include <caffe2/serialize/inline_container.h>
 #include <torch/csrc/jit/instruction.h>
+#include <TH/THAllocator.h>
 
 
 #include <fstream>
@@ -37,6 +38,7 @@ namespace jit {
 using caffe2::serialize::PyTorchStreamReader;
 using caffe2::serialize::IStreamAdapter;
 using caffe2::serialize::ReadAdapterInterface;
+using caffe2::serialize::kFieldAlignment;
 
 OpCode parseOpCode(const char *str);
 namespace {
@@ -106,19 +108,38 @@ void parseMethods(const std::vector<IValue>& vals, std::shared_ptr<mobile::Compi
 class BytecodeDeserializer final {
  public:
   explicit BytecodeDeserializer(std::unique_ptr<PyTorchStreamReader> reader);
+  // mapped_file is the whole file that reader reads, mapped into memory
+  BytecodeDeserializer(
+      std::unique_ptr<PyTorchStreamReader> reader,
+      at::DataPtr mapped_file,
+      size_t mapped_size);
   mobile::Module deserialize(c10::optional<at::Device> device);
 
  private:
   c10::IValue readArchive(const std::string& archive_name);
+  std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
   std::shared_ptr<script::CompilationUnit> compilation_unit_;
   std::unordered_set<std::string> imported_libs_;
   std::unique_ptr<PyTorchStreamReader> reader_;
   c10::optional<at::Device> device_;
+  // Shared by the records that alias the mapping, which is unmapped once the
+  // last of them is freed.
+  std::shared_ptr<at::DataPtr> mapped_file_;
+  size_t mapped_size_ = 0;
 };
 
 BytecodeDeserializer::BytecodeDeserializer(std::unique_ptr<PyTorchStreamReader> reader)
     : compilation_unit_(std::make_shared<script::CompilationUnit>()), reader_(std::move(reader)) {}
 
+BytecodeDeserializer::BytecodeDeserializer(
+    std::unique_ptr<PyTorchStreamReader> reader,
+    at::DataPtr mapped_file,
+    size_t mapped_size)
+    : compilation_unit_(std::make_shared<script::CompilationUnit>()),
+      reader_(std::move(reader)),
+      mapped_file_(std::make_shared<at::DataPtr>(std::move(mapped_file))),
+      mapped_size_(mapped_size) {}
+
 mobile::Module BytecodeDeserializer::deserialize(c10::optional<at::Device> device) {
   device_ = device;
   auto bvals = readArchive("bytecode").toTuple()->elements();
@@ -133,7 +154,7 @@ c10::IValue BytecodeDeserializer::readArchive(const std::string& archive_name) {
   picklename << archive_name << ".pkl";
   at::DataPtr pickle_ptr;
   size_t pickle_size;
-  std::tie(pickle_ptr, pickle_size) = reader_->getRecord(picklename.str());
+  std::tie(pickle_ptr, pickle_size) = getRecord(picklename.str());
 
   size_t bytes_read = 0;
   auto data = reinterpret_cast<const char*>(pickle_ptr.get());
@@ -173,7 +194,7 @@ c10::IValue BytecodeDeserializer::readArchive(const std::string& archive_name) {
   auto read_record = [&](const std::string& name) {
     std::stringstream ss;
     ss << archive_name << "/" << name;
-    return std::get<0>(reader_->getRecord(ss.str()));
+    return std::get<0>(getRecord(ss.str()));
   };
 
   Unpickler unpickler(reader, std::move(class_resolver),
@@ -181,8 +202,35 @@ c10::IValue BytecodeDeserializer::readArchive(const std::string& archive_name) {
   return unpickler.parse_ivalue();
 }
 
+void releaseMappedFile(void* ctx) {
+  delete static_cast<std::shared_ptr<at::DataPtr>*>(ctx);
+}
+
+std::tuple<at::DataPtr, size_t> BytecodeDeserializer::getRecord(const std::string& name) {
+  // PyTorchStreamWriter stores records uncompressed and aligned to
+  // kFieldAlignment, which is enough for any tensor, so such records of a
+  // mapped file are used in place. Others are read into memory.
+  if (mapped_file_ && !reader_->isRecordCompressed(name)) {
+    size_t offset = reader_->getRecordOffset(name);
+    size_t size = reader_->getRecordSize(name);
+    if (offset % kFieldAlignment == 0 && offset + size <= mapped_size_) {
+      auto data = static_cast<char*>(mapped_file_->get()) + offset;
+      auto ctx = new std::shared_ptr<at::DataPtr>(mapped_file_);
+      return std::make_tuple(
+          at::DataPtr(data, ctx, releaseMappedFile, at::kCPU), size);
+    }
+  }
+  return reader_->getRecord(name);
+}
+
 } // namespace
 
+const void* _mapped_file_base(const at::DataPtr& data_ptr) {
+  auto mapped_file =
+      data_ptr.cast_context<std::shared_ptr<at::DataPtr>>(releaseMappedFile);
+  return mapped_file ? (*mapped_file)->get() : nullptr;
+}
+
 mobile::Module _load_for_mobile(
     std::istream& in,
     c10::optional<at::Device> device) {
@@ -208,5 +256,26 @@ mobile::Module _load_for_mobile(
   return deserializer.deserialize(device);
 }
 
+mobile::Module _load_for_mobile_mmap(
+    const std::string& filename,
+    c10::optional<at::Device> device) {
+  auto rai = std::make_unique<FileAdapter>(filename);
+  size_t file_size = rai->size();
+  TORCH_CHECK(file_size > 0, "cannot map empty file ", filename);
+  // THMapAllocator maps nothing when asked for 0 bytes, so the size of the
+  // file must be given explicitly. Private mappings are copy-on-write, so
+  // tensors that are modified after loading don't change the file.
+  size_t mapped_size = 0;
+  auto mapped_file = THMapAllocator::makeDataPtr(
+      filename.c_str(), /*flags=*/0, file_size, &mapped_size);
+  TORCH_CHECK(
+      mapped_file.get() != nullptr && mapped_size == file_size,
+      "unable to map ", filename, " into memory");
+  auto reader = torch::make_unique<PyTorchStreamReader>(std::move(rai));
+  BytecodeDeserializer deserializer(
+      std::move(reader), std::move(mapped_file), mapped_size);
+  return deserializer.deserialize(device);
+}
+
 } // namespace jit
 } // namespace torch
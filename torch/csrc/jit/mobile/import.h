@@ -23,5 +23,17 @@ TORCH_API mobile::Module _load_for_mobile(
 TORCH_API mobile::Module _load_for_mobile(
     std::unique_ptr<ReadAdapterInterface> rai,
     c10::optional<c10::Device> device = c10::nullopt);
+
+// Maps the file into memory instead of reading it. Tensors whose data is
+// stored suitably aligned, which it is in files written by _save_for_mobile,
+// alias the mapping, so their data is only paged in once it is used and can
+// be dropped from memory again by the OS as long as it isn't modified.
+TORCH_API mobile::Module _load_for_mobile_mmap(
+    const std::string& filename,
+    c10::optional<at::Device> device = c10::nullopt);
+
+// Returns the start of the mapping made by _load_for_mobile_mmap that the
+// data of a tensor aliases, or nullptr if the tensor doesn't alias one.
+TORCH_API const void* _mapped_file_base(const at::DataPtr& data_ptr);
 } // namespace jit
 } // namespace torch
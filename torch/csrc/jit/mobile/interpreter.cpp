@@ -57,7 +57,12 @@ bool InterpreterState::run(Stack& stack) {
         RECORD_FUNCTION(code_->op_names_[inst.X].name, stack);
 #endif
 
-        c10::Dispatcher::singleton().callBoxed(*code_->operators_[inst.X], &stack);
+        if (auto prelinked_op = code_->prelinked_operators_[inst.X]) {
+          prelinked_op(stack);
+        } else {
+          c10::Dispatcher::singleton().callBoxed(
+              *code_->operators_[inst.X], &stack);
+        }
         ++pc;
       } break;
       case OPN: {
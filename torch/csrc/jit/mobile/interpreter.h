@@ -3,6 +3,7 @@
 #include <ATen/core/operator_name.h>
 #include <torch/csrc/jit/instruction.h>
 #include <ATen/core/dispatch/Dispatcher.h>
+#include <torch/csrc/jit/mobile/prelinked_ops.h>
 
 namespace torch{
 namespace jit{
@@ -13,6 +14,8 @@ struct Code {
   std::vector<Instruction> instructions_;
   std::vector<c10::OperatorName> op_names_;
   std::vector<c10::optional<c10::OperatorHandle>> operators_;
+  // operators_[i] is nullopt if prelinked_operators_[i] is set
+  std::vector<PrelinkedOperation> prelinked_operators_;
   std::vector<VarargFuncton> vararg_operators_;
   std::vector<c10::IValue> constants_;
   size_t register_size_; // Aggregated output size.
@@ -0,0 +1,82 @@
+#include "prelinked_ops.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace torch {
+namespace jit {
+namespace mobile {
+
+namespace {
+
+std::mutex& tablesMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::vector<c10::ArrayRef<PrelinkedOperator>>& tables() {
+  static std::vector<c10::ArrayRef<PrelinkedOperator>> tables;
+  return tables;
+}
+
+int compare(
+    const PrelinkedOperator& op,
+    const char* name,
+    const char* overload_name) {
+  int result = std::strcmp(op.name, name);
+  return result != 0 ? result : std::strcmp(op.overload_name, overload_name);
+}
+
+} // namespace
+
+RegisterPrelinkedOperators::RegisterPrelinkedOperators(
+    c10::ArrayRef<PrelinkedOperator> table)
+    : table_(table) {
+  for (size_t i = 1; i < table.size(); ++i) {
+    TORCH_INTERNAL_ASSERT(
+        compare(table[i - 1], table[i].name, table[i].overload_name) < 0,
+        "Prelinked operator table is not sorted at ",
+        table[i].name,
+        ".",
+        table[i].overload_name);
+  }
+  std::lock_guard<std::mutex> guard(tablesMutex());
+  tables().push_back(table_);
+}
+
+RegisterPrelinkedOperators::~RegisterPrelinkedOperators() {
+  std::lock_guard<std::mutex> guard(tablesMutex());
+  auto& all = tables();
+  auto it = std::find_if(
+      all.begin(), all.end(), [this](c10::ArrayRef<PrelinkedOperator> table) {
+        return table.data() == table_.data();
+      });
+  if (it != all.end()) {
+    all.erase(it);
+  }
+}
+
+PrelinkedOperation findPrelinkedOperator(const c10::OperatorName& opname) {
+  const char* name = opname.name.c_str();
+  const char* overload_name = opname.overload_name.c_str();
+  std::lock_guard<std::mutex> guard(tablesMutex());
+  // Later registrations take precedence.
+  for (auto table = tables().rbegin(); table != tables().rend(); ++table) {
+    auto it = std::lower_bound(
+        table->begin(),
+        table->end(),
+        opname,
+        [&](const PrelinkedOperator& op, const c10::OperatorName&) {
+          return compare(op, name, overload_name) < 0;
+        });
+    if (it != table->end() && compare(*it, name, overload_name) == 0) {
+      return it->op;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace mobile
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,49 @@
+#pragma once
+#include <ATen/core/ivalue.h>
+#include <ATen/core/operator_name.h>
+#include <c10/util/ArrayRef.h>
+
+#include <vector>
+
+// Prelinked operators are called by the lite interpreter through a plain
+// function pointer instead of being looked up in and dispatched through the
+// c10 dispatcher. A build can prelink the operators used by a set of models
+// with tools/jit/gen_mobile_prelinked_ops.py, which generates a table with
+// just these operators and registers it with RegisterPrelinkedOperators.
+
+namespace torch {
+namespace jit {
+namespace mobile {
+using Stack = std::vector<c10::IValue>;
+using PrelinkedOperation = int (*)(Stack&);
+
+struct PrelinkedOperator {
+  // e.g. "aten::add" and "Tensor", as in the operator table of a bytecode
+  // method
+  const char* name;
+  const char* overload_name;
+  PrelinkedOperation op;
+};
+
+// Makes the operators of a table available to the lite interpreter for as
+// long as this object lives. The table must outlive it too and must be
+// sorted by name and overload name.
+struct TORCH_API RegisterPrelinkedOperators {
+  explicit RegisterPrelinkedOperators(c10::ArrayRef<PrelinkedOperator> table);
+  ~RegisterPrelinkedOperators();
+
+  RegisterPrelinkedOperators(const RegisterPrelinkedOperators&) = delete;
+  RegisterPrelinkedOperators& operator=(const RegisterPrelinkedOperators&) =
+      delete;
+
+ private:
+  c10::ArrayRef<PrelinkedOperator> table_;
+};
+
+// Returns nullptr if no registered table has the operator.
+TORCH_API PrelinkedOperation
+findPrelinkedOperator(const c10::OperatorName& opname);
+
+} // namespace mobile
+} // namespace jit
+} // namespace torch
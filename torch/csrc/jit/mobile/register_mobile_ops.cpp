@@ -130,7 +130,11 @@ void listAppend(const c10::OperatorHandle& op, Stack* stack) {
   push(*stack, std::move(list));
 }
 
-static auto registry = torch::RegisterOperators().op(
+#ifndef TORCH_MOBILE_PRELINKED_OPS
+// Operators backed by ATen functions. Prelinked builds call the operators
+// used by their models through the generated prelinked operator table
+// instead, see torch/csrc/jit/mobile/prelinked_ops.h.
+static auto aten_registry = torch::RegisterOperators().op(
   "_aten::add.Tensor",
   torch::RegisterOperators::options().kernel(c10::TensorTypeId::CPUTensorId,
   [](at::Tensor a, at::Tensor b, at::Scalar c) -> at::Tensor {
@@ -259,12 +263,6 @@ static auto registry = torch::RegisterOperators().op(
   [](at::Tensor a) -> int64_t {
    return a.dim();
   })
-).op(
-  "_aten::eq",
-  torch::RegisterOperators::options().catchAllKernel(
-    [](int64_t a, int64_t b) -> bool {
-      return a == b;
-    })
 ).op(
   "_aten::log_softmax",
   torch::RegisterOperators::options().kernel(c10::TensorTypeId::CPUTensorId,
@@ -284,46 +282,6 @@ static auto registry = torch::RegisterOperators().op(
   #endif
      return at::flatten(self, start_dim, end_dim);
   })
-).op(
-  "_aten::Int",
-  torch::RegisterOperators::options().kernel(c10::TensorTypeId::CPUTensorId,
-                                           [](at::Tensor a) -> int64_t {
-                                             return a.item<int64_t>();
-  })
-).op(
-  "_prim::NumToTensor",
-  torch::RegisterOperators::options().catchAllKernel(
-  [](at::Scalar s) -> at::Tensor {
-      return at::scalar_to_tensor(s);
-  })
-).op(
-  // Dummy operator that does nothing. Used to reserve a location of an operator table.
-  "_prim::ListConstruct.int",
-  torch::RegisterOperators::options().catchAllKernel(
-  []() {
-  })
-).op(
-  "_prim::ListConstruct.float",
-  torch::RegisterOperators::options().catchAllKernel(
-  []() {
-  })
-).op(
-  "_prim::ListConstruct.bool",
-  torch::RegisterOperators::options().catchAllKernel(
-  []() {
-  })
-).op(
-  "_prim::ListConstruct.Tensor",
-  torch::RegisterOperators::options().catchAllKernel(
-  []() {
-  })
-).op(
-  "_prim::ListConstruct.generic",
-  torch::RegisterOperators::options().catchAllKernel(
-  []() {
-  })
-
-// Pytext operators
 ).op(
   "_aten::embedding(Tensor weight, Tensor indices, int padding_idx=-1, bool scale_grad_by_freq=False, bool sparse=False) -> Tensor",
   torch::RegisterOperators::options().kernel(c10::TensorTypeId::CPUTensorId,
@@ -368,15 +326,65 @@ static auto registry = torch::RegisterOperators().op(
 ).op(
   "_aten::cat(Tensor[] tensors, int dim=0) -> Tensor",
   torch::RegisterOperators::options().kernel<&cat_kernel>(c10::TensorTypeId::CPUTensorId)
-).op(
-  "_aten::__is__(t1 self, t2 obj) -> bool",
-  torch::RegisterOperators::options().catchAllKernel<&__is__kernel>()
 ).op(
   "_aten::log_softmax.int(Tensor self, int dim, ScalarType? dtype=None) -> Tensor",
   torch::RegisterOperators::options().kernel<&log_softmax_kernel>(c10::TensorTypeId::CPUTensorId)
 ).op(
   "_aten::softmax.int(Tensor self, int dim, ScalarType? dtype=None) -> Tensor",
   torch::RegisterOperators::options().kernel<&softmax_kernel>(c10::TensorTypeId::CPUTensorId)
+);
+#endif
+
+// Operators that are not ATen functions, which prelinked builds register
+// too. Keep in sync with MOBILE_DISPATCHER_OPS in
+// tools/jit/gen_mobile_prelinked_ops.py.
+static auto registry = torch::RegisterOperators().op(
+  "_aten::eq",
+  torch::RegisterOperators::options().catchAllKernel(
+    [](int64_t a, int64_t b) -> bool {
+      return a == b;
+    })
+).op(
+  "_aten::Int",
+  torch::RegisterOperators::options().kernel(c10::TensorTypeId::CPUTensorId,
+                                           [](at::Tensor a) -> int64_t {
+                                             return a.item<int64_t>();
+  })
+).op(
+  "_prim::NumToTensor",
+  torch::RegisterOperators::options().catchAllKernel(
+  [](at::Scalar s) -> at::Tensor {
+      return at::scalar_to_tensor(s);
+  })
+).op(
+  // Dummy operator that does nothing. Used to reserve a location of an operator table.
+  "_prim::ListConstruct.int",
+  torch::RegisterOperators::options().catchAllKernel(
+  []() {
+  })
+).op(
+  "_prim::ListConstruct.float",
+  torch::RegisterOperators::options().catchAllKernel(
+  []() {
+  })
+).op(
+  "_prim::ListConstruct.bool",
+  torch::RegisterOperators::options().catchAllKernel(
+  []() {
+  })
+).op(
+  "_prim::ListConstruct.Tensor",
+  torch::RegisterOperators::options().catchAllKernel(
+  []() {
+  })
+).op(
+  "_prim::ListConstruct.generic",
+  torch::RegisterOperators::options().catchAllKernel(
+  []() {
+  })
+).op(
+  "_aten::__is__(t1 self, t2 obj) -> bool",
+  torch::RegisterOperators::options().catchAllKernel<&__is__kernel>()
 ).op(
   "_aten::warn() -> void",
   torch::RegisterOperators::options().catchAllKernel<&warn_kernel>()
@@ -322,10 +322,12 @@ void AliasDb::analyzeImpl(Node* node) {
     case prim::FusedConcat:
     case prim::MMTreeReduce:
     case prim::MMBatchSide:
+    case prim::MMBatchHorizontal:
     case prim::BroadcastSizes:
     case prim::ChunkSizes:
     case prim::Function:
     case prim::CreateObject:
+    case prim::AllocateStorage:
       return analyzeCreator(node);
     case prim::DictConstruct:
     case prim::ListConstruct:
@@ -355,6 +357,7 @@ void AliasDb::analyzeImpl(Node* node) {
       makePointerTo(node->output(), node->inputs().at(1));
       return;
     case prim::Guard:
+    case prim::AllocateTensor:
       makePointerTo(node->output(), node->inputs().at(0));
       return;
     case prim::CallFunction:
@@ -1234,6 +1237,7 @@ bool aliasAnalysisHasSpecialCaseFor(Symbol symbol) {
       prim::GradOf,
       prim::MMTreeReduce,
       prim::MMBatchSide,
+      prim::MMBatchHorizontal,
       prim::BroadcastSizes,
       prim::ChunkSizes,
       prim::Function,
@@ -1256,6 +1260,8 @@ bool aliasAnalysisHasSpecialCaseFor(Symbol symbol) {
       aten::wait,
       prim::isinstance,
       prim::unchecked_cast,
+      prim::AllocateStorage,
+      prim::AllocateTensor,
   };
 
   // Operators that should not be used by alias analysis
@@ -1,6 +1,7 @@
 #include <torch/csrc/jit/passes/batch_mm.h>
 
 #include <ATen/core/functional.h>
+#include <ATen/core/grad_mode.h>
 #include <ATen/core/interned_strings.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/jit/constants.h>
@@ -11,6 +12,8 @@
 
 #include <ATen/ATen.h>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 
 namespace torch {
@@ -459,6 +462,421 @@ void BatchMMSide(Block* block, AliasDb& alias_db) {
   }
 }
 
+// Note [Horizontal batching]
+// BatchMMSide only batches multiplies that share an operand. Multi-task and
+// recommendation models also run many independent small linear layers, e.g.
+// one per tower, on inputs of the same shape:
+//
+//   o_i = epilogue(a_i @ b_i + bias_i)    for i = 1..n
+//
+// BatchMMHorizontal replaces such a group with a single MMBatchHorizontal
+// node, which stacks the operands, computes all of them with one baddbmm (or
+// bmm if there are no biases), applies the epilogue once to the batched result
+// and returns its slices. mm, addmm with unit scalars and linear with 2-D
+// inputs are batched. Bias adds and unary pointwise ops (relu, sigmoid, tanh)
+// that are applied to every result are folded into the node. Standalone
+// pointwise ops aren't stacked, as copying their inputs together costs as much
+// as running them.
+//
+// Stacking the weights on every run would double the memory traffic of small
+// layers, so stacked weights and biases are cached while the same tensors are
+// passed in unmodified and autograd doesn't need to see the stack.
+
+// Tunable parameter, like min_fusion_size.
+static constexpr size_t min_horizontal_batch_size = 4;
+
+using Epilogue = void (*)(at::Tensor&);
+
+Epilogue getEpilogue(const std::string& name) {
+  if (name == "aten::relu") {
+    return [](at::Tensor& t) { t.relu_(); };
+  } else if (name == "aten::sigmoid") {
+    return [](at::Tensor& t) { t.sigmoid_(); };
+  } else if (name == "aten::tanh") {
+    return [](at::Tensor& t) { t.tanh_(); };
+  }
+  AT_ERROR("Unsupported epilogue in prim::MMBatchHorizontal: ", name);
+}
+
+bool have_same_type(at::TensorList inputs, const at::Tensor& expected) {
+  return std::all_of(inputs.begin(), inputs.end(), [&](const at::Tensor& t) {
+    return t.scalar_type() == expected.scalar_type() &&
+        t.device() == expected.device();
+  });
+}
+
+// Caches at::stack of operands that are usually the same tensors on every run.
+// The sources are kept alive, so their memory can't be reused by another
+// tensor while they are cached.
+class StackCache {
+ public:
+  at::Tensor stack(at::TensorList inputs) {
+    if (at::GradMode::is_enabled() &&
+        std::any_of(inputs.begin(), inputs.end(), [](const at::Tensor& t) {
+          return t.requires_grad();
+        })) {
+      return at::stack(inputs);
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!isCached(inputs)) {
+      sources_ = inputs.vec();
+      versions_ =
+          fmap(inputs, [](const at::Tensor& t) { return t._version(); });
+      stacked_ = at::stack(inputs);
+    }
+    return stacked_;
+  }
+
+ private:
+  bool isCached(at::TensorList inputs) const {
+    if (inputs.size() != sources_.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const at::Tensor& t = inputs[i];
+      const at::Tensor& s = sources_[i];
+      if (t.data_ptr() != s.data_ptr() || t.sizes() != s.sizes() ||
+          t.strides() != s.strides() || t.scalar_type() != s.scalar_type() ||
+          t.device() != s.device() || t._version() != versions_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::mutex mutex_;
+  std::vector<at::Tensor> sources_;
+  std::vector<int64_t> versions_;
+  at::Tensor stacked_;
+};
+
+RegisterOperators mm_batch_horizontal_reg({Operator(
+    prim::MMBatchHorizontal,
+    [](const Node* node) -> Operation {
+      // Inputs are a_1..a_n, b_1..b_n and bias_1..bias_n, where biases are
+      // either all None or all tensors.
+      size_t n = node->inputs().size() / 3;
+      auto epilogue = fmap(node->ss(Symbol::attr("epilogue")), getEpilogue);
+      auto b_cache = std::make_shared<StackCache>();
+      auto bias_cache = std::make_shared<StackCache>();
+      return [n, epilogue, b_cache, bias_cache](Stack& stack) {
+        std::vector<at::Tensor> as, bs, biases;
+        as.reserve(n);
+        bs.reserve(n);
+        auto inputs = last(stack, 3 * n);
+        for (size_t i = 0; i < n; ++i) {
+          as.push_back(inputs[i].toTensor());
+          bs.push_back(inputs[n + i].toTensor());
+          if (!inputs[2 * n + i].isNone()) {
+            biases.push_back(inputs[2 * n + i].toTensor());
+          }
+        }
+        drop(stack, 3 * n);
+
+        bool batch = as[0].dim() == 2 && bs[0].dim() == 2 &&
+            have_same_shape(as) && have_same_shape(bs) &&
+            have_same_type(as, as[0]) && have_same_type(bs, as[0]);
+        if (!biases.empty()) {
+          batch = batch && biases[0].dim() <= 2 && have_same_shape(biases) &&
+              have_same_type(biases, as[0]);
+        }
+
+        if (batch) {
+          const int64_t num = n;
+          at::Tensor out;
+          if (biases.empty()) {
+            out = at::bmm(at::stack(as), b_cache->stack(bs));
+          } else {
+            at::Tensor bias = bias_cache->stack(biases);
+            if (bias.dim() == 1) {
+              bias = bias.view({num, 1, 1});
+            } else if (bias.dim() == 2) {
+              bias = bias.unsqueeze(1);
+            }
+            out = at::baddbmm(
+                bias.expand({num, as[0].size(0), bs[0].size(1)}),
+                at::stack(as),
+                b_cache->stack(bs));
+          }
+          for (Epilogue fn : epilogue) {
+            fn(out);
+          }
+          auto outputs = out.unbind(0);
+          stack.insert(
+              stack.end(),
+              std::make_move_iterator(outputs.begin()),
+              std::make_move_iterator(outputs.end()));
+        } else {
+          for (size_t i = 0; i < n; ++i) {
+            at::Tensor out = as[i].mm(bs[i]);
+            if (!biases.empty()) {
+              out = at::add(out, biases[i]);
+            }
+            for (Epilogue fn : epilogue) {
+              fn(out);
+            }
+            stack.emplace_back(std::move(out));
+          }
+        }
+        return 0;
+      };
+    },
+    aliasAnalysisIsSpecialCase())});
+
+// A multiply that can be batched horizontally, computing a @ b (+ bias).
+struct HorizontalMM {
+  Node* node;
+  Value* a;
+  Value* b;
+  Value* bias; // nullptr if there is none
+  bool transpose_b; // b is the weight of a linear node
+};
+
+bool isConstantOne(Value* v) {
+  auto ivalue = toIValue(v);
+  return ivalue &&
+      ((ivalue->isInt() && ivalue->toInt() == 1) ||
+       (ivalue->isDouble() && ivalue->toDouble() == 1.0));
+}
+
+c10::optional<HorizontalMM> asHorizontalMM(Node* n) {
+  if (n->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
+    return HorizontalMM{n, n->inputs()[0], n->inputs()[1], nullptr, false};
+  }
+  if (n->matches(
+          "aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta, Scalar alpha) -> Tensor") &&
+      isConstantOne(n->namedInput(attr::beta)) &&
+      isConstantOne(n->namedInput(attr::alpha))) {
+    return HorizontalMM{
+        n, n->inputs()[1], n->inputs()[2], n->inputs()[0], false};
+  }
+  if (n->matches(
+          "aten::linear(Tensor input, Tensor weight, Tensor? bias=None) -> Tensor")) {
+    // linear on other inputs is a matmul, not an mm
+    auto input_type = n->inputs()[0]->type()->cast<TensorType>();
+    if (!input_type || !input_type->dim() || *input_type->dim() != 2) {
+      return c10::nullopt;
+    }
+    Value* bias = n->inputs()[2];
+    if (bias->type()->isSubtypeOf(NoneType::get())) {
+      bias = nullptr;
+    }
+    return HorizontalMM{n, n->inputs()[0], n->inputs()[1], bias, true};
+  }
+  return c10::nullopt;
+}
+
+// Whether two values are known to have different shapes or dtypes.
+bool knownToDiffer(Value* v, Value* u) {
+  auto v_type = v->type()->cast<TensorType>();
+  auto u_type = u->type()->cast<TensorType>();
+  if (!v_type || !u_type) {
+    return false;
+  }
+  auto v_sizes = v_type->sizes().concrete_sizes();
+  auto u_sizes = u_type->sizes().concrete_sizes();
+  if (v_sizes && u_sizes && *v_sizes != *u_sizes) {
+    return true;
+  }
+  return v_type->scalarType() && u_type->scalarType() &&
+      *v_type->scalarType() != *u_type->scalarType();
+}
+
+bool canBatchWith(const HorizontalMM& mm, const HorizontalMM& other) {
+  return mm.node->kind() == other.node->kind() &&
+      (mm.bias == nullptr) == (other.bias == nullptr) &&
+      !knownToDiffer(mm.a, other.a) && !knownToDiffer(mm.b, other.b);
+}
+
+// If every output of `batch` is only used by the same kind of node, which
+// `fold` can merge into `batch`, folds them and returns true.
+template <typename Fold>
+bool foldUses(Node* batch, const Fold& fold) {
+  std::vector<Node*> users;
+  for (Value* output : batch->outputs()) {
+    if (output->uses().size() != 1) {
+      return false;
+    }
+    Node* user = output->uses()[0].user;
+    if (user->owningBlock() != batch->owningBlock() ||
+        user->kind() != batch->outputs()[0]->uses()[0].user->kind()) {
+      return false;
+    }
+    users.push_back(user);
+  }
+  if (!fold(users, /*check_only=*/true)) {
+    return false;
+  }
+  fold(users, /*check_only=*/false);
+  for (size_t i = 0; i < users.size(); ++i) {
+    batch->outputs()[i]->setType(users[i]->output()->type());
+    users[i]->output()->replaceAllUsesWith(batch->outputs()[i]);
+    users[i]->destroy();
+  }
+  return true;
+}
+
+void foldEpilogues(Node* batch) {
+  const size_t n = batch->outputs().size();
+  auto bias_is_none = [&](size_t i) {
+    return batch->inputs()[2 * n + i]->type()->isSubtypeOf(NoneType::get());
+  };
+
+  // o_i = a_i @ b_i, followed by o_i + bias_i
+  if (bias_is_none(0)) {
+    foldUses(batch, [&](const std::vector<Node*>& adds, bool check_only) {
+      for (size_t i = 0; i < n; ++i) {
+        Node* add = adds[i];
+        if (!add->matches(
+                "aten::add(Tensor self, Tensor other, *, Scalar alpha) -> Tensor") ||
+            !isConstantOne(add->namedInput(attr::alpha))) {
+          return false;
+        }
+        Value* output = batch->outputs()[i];
+        Value* bias = add->inputs()[0] == output ? add->inputs()[1]
+                                                 : add->inputs()[0];
+        if (bias == output ||
+            (bias->node()->kind() != prim::Param &&
+             !bias->node()->isBefore(batch))) {
+          return false;
+        }
+        if (!check_only) {
+          batch->replaceInput(2 * n + i, bias);
+        }
+      }
+      return true;
+    });
+  }
+
+  while (foldUses(batch, [&](const std::vector<Node*>& users, bool check_only) {
+    const char* schema = nullptr;
+    switch (users[0]->kind()) {
+      case aten::relu:
+        schema = "aten::relu(Tensor self) -> Tensor";
+        break;
+      case aten::sigmoid:
+        schema = "aten::sigmoid(Tensor self) -> Tensor";
+        break;
+      case aten::tanh:
+        schema = "aten::tanh(Tensor self) -> Tensor";
+        break;
+      default:
+        return false;
+    }
+    if (!std::all_of(users.begin(), users.end(), [&](Node* user) {
+          return user->matches(schema);
+        })) {
+      return false;
+    }
+    if (!check_only) {
+      auto epilogue = batch->ss(Symbol::attr("epilogue"));
+      epilogue.push_back(users[0]->kind().toQualString());
+      batch->ss_(Symbol::attr("epilogue"), std::move(epilogue));
+    }
+    return true;
+  })) {
+  }
+}
+
+void batchHorizontal(const std::vector<HorizontalMM>& mms, AliasDb& alias_db) {
+  // Bring the multiplies next to each other, so the operands of all of them
+  // are available at the first one.
+  for (int64_t i = static_cast<int64_t>(mms.size()) - 2; i >= 0; --i) {
+    bool move_ok =
+        alias_db.moveBeforeTopologicallyValid(mms[i].node, mms[i + 1].node);
+    AT_ASSERT(move_ok);
+  }
+  WithInsertPoint insert_guard{mms[0].node};
+  Graph* graph = mms[0].node->owningGraph();
+  Value* none = graph->insertConstant(IValue());
+  Node* batch = graph->create(
+      prim::MMBatchHorizontal, /*inputs=*/{}, /*num_outputs=*/mms.size());
+  for (const HorizontalMM& mm : mms) {
+    batch->addInput(mm.a);
+  }
+  for (const HorizontalMM& mm : mms) {
+    batch->addInput(mm.transpose_b ? graph->insert(aten::t, {mm.b}) : mm.b);
+  }
+  for (const HorizontalMM& mm : mms) {
+    batch->addInput(mm.bias ? mm.bias : none);
+  }
+  batch->ss_(Symbol::attr("epilogue"), {});
+  graph->insertNode(batch);
+  for (size_t i = 0; i < mms.size(); ++i) {
+    batch->outputs()[i]->copyMetadata(mms[i].node->output());
+    mms[i].node->output()->replaceAllUsesWith(batch->outputs()[i]);
+    mms[i].node->destroy();
+  }
+  foldEpilogues(batch);
+}
+
+// Batches the first group of enough independent multiplies found in `block`
+// or its sub-blocks. Returns false if there is none.
+bool BatchMMHorizontalOnce(Block* block, AliasDb& alias_db) {
+  std::vector<std::vector<HorizontalMM>> groups;
+  for (Node* node : block->nodes()) {
+    for (Block* subblock : node->blocks()) {
+      if (BatchMMHorizontalOnce(subblock, alias_db)) {
+        return true;
+      }
+    }
+    auto mm = asHorizontalMM(node);
+    if (!mm) {
+      continue;
+    }
+    auto group = std::find_if(
+        groups.begin(),
+        groups.end(),
+        [&](const std::vector<HorizontalMM>& group) {
+          return canBatchWith(*mm, group[0]) &&
+              std::all_of(
+                     group.begin(),
+                     group.end(),
+                     [&](const HorizontalMM& other) {
+                       return alias_db.couldMoveBeforeTopologically(
+                           node, other.node);
+                     });
+        });
+    if (group != groups.end()) {
+      group->push_back(*mm);
+    } else {
+      groups.push_back({*mm});
+    }
+  }
+  for (const auto& group : groups) {
+    if (group.size() >= min_horizontal_batch_size) {
+      batchHorizontal(group, alias_db);
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace {
+// Off by default, see batch_mm.h.
+std::atomic<bool> horizontal_mm_batching_enabled{false};
+} // namespace
+
+void overrideHorizontalMMBatching(bool value) {
+  horizontal_mm_batching_enabled = value;
+}
+
+bool horizontalMMBatchingEnabled() {
+  return horizontal_mm_batching_enabled;
+}
+
+void BatchMMHorizontal(std::shared_ptr<Graph>& graph) {
+  // Batching moves and replaces nodes, so alias analysis is redone before
+  // looking for the next group.
+  while (true) {
+    AliasDb alias_db(graph);
+    if (!BatchMMHorizontalOnce(graph->block(), alias_db)) {
+      break;
+    }
+  }
+  EliminateDeadCode(graph);
+}
+
 bool hasMutableOperators(Block* block) {
   for (auto n : block->nodes()) {
     if (n->kind().is_aten() && n->schema().is_mutable())
@@ -480,6 +898,9 @@ void BatchMM(std::shared_ptr<Graph>& graph) {
   BatchMMTreeReduce(graph->block());
   BatchMMSide(graph->block(), alias_db);
   EliminateDeadCode(graph);
+  if (horizontalMMBatchingEnabled()) {
+    BatchMMHorizontal(graph);
+  }
   // It's possible that transpose rearrangements have created sequences of
   // consecutive transposes that didn't exist before.
   PeepholeOptimize(graph);
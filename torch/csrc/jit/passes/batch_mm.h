@@ -7,5 +7,12 @@ namespace jit {
 
 TORCH_API void BatchMM(std::shared_ptr<Graph>& graph);
 
+// Whether BatchMM also batches independent multiplies of the same shape into
+// one baddbmm (see Note [Horizontal batching] in batch_mm.cpp). The batched
+// kernel may round differently from the separate multiplies, so BatchMM, which
+// runs in the default optimization pipeline, only does it when enabled.
+TORCH_API void overrideHorizontalMMBatching(bool value);
+TORCH_API bool horizontalMMBatchingEnabled();
+
 }
 } // namespace torch
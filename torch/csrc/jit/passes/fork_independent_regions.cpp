@@ -0,0 +1,383 @@
+#include <torch/csrc/jit/passes/fork_independent_regions.h>
+
+#include <ATen/Parallel.h>
+#include <ATen/core/functional.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Per-op estimates for when shapes are unknown: a moderately sized matrix
+// product or convolution, and an elementwise op on a moderately sized tensor.
+constexpr int64_t kHeavyOpCost = 1 << 20;
+constexpr int64_t kLightOpCost = 1 << 12;
+
+bool isHeavyOp(Node* n) {
+  static const std::unordered_set<Symbol> heavy = {
+      aten::conv1d,
+      aten::conv2d,
+      aten::conv3d,
+      aten::_convolution,
+      aten::mkldnn_convolution,
+      aten::linear,
+      aten::matmul,
+      aten::mm,
+      aten::bmm,
+      aten::addmm,
+      aten::lstm,
+      aten::gru,
+      aten::embedding_bag,
+  };
+  return heavy.count(n->kind());
+}
+
+c10::optional<std::vector<int64_t>> concreteSizes(Value* v) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type) {
+    return c10::nullopt;
+  }
+  return type->sizes().concrete_sizes();
+}
+
+int64_t numel(const std::vector<int64_t>& sizes) {
+  int64_t n = 1;
+  for (int64_t s : sizes) {
+    n *= s;
+  }
+  return n;
+}
+
+// Multiply-adds per output element of a convolution or matrix product, or
+// nullopt if the shapes involved are unknown.
+c10::optional<int64_t> macsPerOutput(Node* n) {
+  switch (n->kind()) {
+    case aten::conv1d:
+    case aten::conv2d:
+    case aten::conv3d:
+    case aten::_convolution:
+    case aten::mkldnn_convolution: {
+      auto weight = concreteSizes(n->inputs().at(1));
+      if (!weight || weight->empty() || (*weight)[0] == 0) {
+        return c10::nullopt;
+      }
+      return numel(*weight) / (*weight)[0];
+    }
+    case aten::linear: {
+      auto weight = concreteSizes(n->inputs().at(1));
+      if (!weight || weight->size() != 2) {
+        return c10::nullopt;
+      }
+      return (*weight)[1];
+    }
+    case aten::matmul:
+    case aten::mm:
+    case aten::bmm: {
+      auto self = concreteSizes(n->inputs().at(0));
+      if (!self || self->empty()) {
+        return c10::nullopt;
+      }
+      return self->back();
+    }
+    case aten::addmm: {
+      auto mat1 = concreteSizes(n->inputs().at(1));
+      if (!mat1 || mat1->empty()) {
+        return c10::nullopt;
+      }
+      return mat1->back();
+    }
+    default:
+      return c10::nullopt;
+  }
+}
+
+int64_t estimateCost(Node* n) {
+  if (n->kind().is_prim()) {
+    return 0;
+  }
+  c10::optional<std::vector<int64_t>> sizes;
+  if (n->outputs().size() == 1) {
+    sizes = concreteSizes(n->output());
+  }
+  if (!sizes) {
+    return isHeavyOp(n) ? kHeavyOpCost : kLightOpCost;
+  }
+  if (!isHeavyOp(n)) {
+    return numel(*sizes);
+  }
+  auto macs = macsPerOutput(n);
+  return macs ? numel(*sizes) * *macs : kHeavyOpCost;
+}
+
+struct Branch {
+  // nodes in the order they appear in the block
+  std::vector<Node*> nodes;
+  // values of `nodes` the join node uses
+  std::vector<Value*> outputs;
+  int64_t cost = 0;
+};
+
+class RegionForker {
+ public:
+  RegionForker(std::shared_ptr<Graph> graph, int64_t min_cost)
+      : graph_(std::move(graph)), min_cost_(min_cost) {}
+
+  void run() {
+    // Every fork changes the graph, so alias analysis is redone and the
+    // search starts over until no node has branches worth forking.
+    while (forkOne()) {
+    }
+    GRAPH_DUMP("After ForkIndependentRegions", graph_);
+  }
+
+ private:
+  bool isMovable(Node* n, const AliasDb& aliasDb) const {
+    return n->owningBlock() == graph_->block() && n->kind() != prim::Param &&
+        n->kind() != prim::Constant && n->kind() != prim::fork &&
+        n->kind() != aten::wait && n->blocks().empty() &&
+        !n->hasSideEffects() && !n->isNondeterministic() &&
+        !aliasDb.hasWriters(n);
+  }
+
+  bool forkOne() {
+    AliasDb aliasDb(graph_);
+    for (Node* join : graph_->nodes()) {
+      if (join->kind() == prim::fork || join->inputs().size() < 2 ||
+          forked_joins_.count(join)) {
+        continue;
+      }
+      auto branches = findBranches(join, aliasDb);
+      if (forkBranches(join, branches)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<Branch> findBranches(Node* join, const AliasDb& aliasDb) {
+    std::vector<Value*> inputs;
+    for (Value* v : join->inputs()) {
+      if (std::find(inputs.begin(), inputs.end(), v) == inputs.end()) {
+        inputs.push_back(v);
+      }
+    }
+
+    // Assign each movable ancestor to the input it leads to, or mark it as
+    // shared if it leads to several.
+    constexpr size_t kShared = std::numeric_limits<size_t>::max();
+    std::unordered_map<Node*, size_t> owner;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      std::vector<Node*> stack = {inputs[i]->node()};
+      std::unordered_set<Node*> visited;
+      while (!stack.empty()) {
+        Node* n = stack.back();
+        stack.pop_back();
+        if (!visited.insert(n).second || !isMovable(n, aliasDb)) {
+          continue;
+        }
+        auto it = owner.find(n);
+        if (it == owner.end()) {
+          owner[n] = i;
+        } else if (it->second != i) {
+          it->second = kShared;
+        }
+        for (Value* input : n->inputs()) {
+          stack.push_back(input->node());
+        }
+      }
+    }
+
+    std::vector<std::unordered_set<Node*>> members(inputs.size());
+    for (const auto& entry : owner) {
+      if (entry.second != kShared) {
+        members[entry.second].insert(entry.first);
+      }
+    }
+
+    // A branch can only be moved as a whole if nothing but the join node and
+    // the branch itself uses its results.
+    for (auto& nodes : members) {
+      bool changed = true;
+      while (changed) {
+        changed = false;
+        for (auto it = nodes.begin(); it != nodes.end();) {
+          bool escapes = false;
+          for (Value* output : (*it)->outputs()) {
+            for (const Use& use : output->uses()) {
+              if (use.user != join && !nodes.count(use.user)) {
+                escapes = true;
+              }
+            }
+          }
+          if (escapes) {
+            it = nodes.erase(it);
+            changed = true;
+          } else {
+            ++it;
+          }
+        }
+      }
+    }
+
+    std::vector<Branch> branches(inputs.size());
+    for (Node* n : graph_->nodes()) {
+      auto it = owner.find(n);
+      if (it == owner.end() || it->second == kShared ||
+          !members[it->second].count(n)) {
+        continue;
+      }
+      Branch& branch = branches[it->second];
+      branch.nodes.push_back(n);
+      branch.cost += estimateCost(n);
+      for (Value* output : n->outputs()) {
+        if (std::find(inputs.begin(), inputs.end(), output) != inputs.end()) {
+          branch.outputs.push_back(output);
+        }
+      }
+    }
+    branches.erase(
+        std::remove_if(
+            branches.begin(),
+            branches.end(),
+            [](const Branch& b) { return b.outputs.empty(); }),
+        branches.end());
+    return branches;
+  }
+
+  bool forkBranches(Node* join, std::vector<Branch>& branches) {
+    if (branches.size() < 2) {
+      return false;
+    }
+    std::stable_sort(
+        branches.begin(),
+        branches.end(),
+        [](const Branch& a, const Branch& b) { return a.cost > b.cost; });
+
+    // The most expensive branch runs on the calling thread, which would
+    // otherwise sit idle waiting for the others. Forking more branches than
+    // there are inter-op threads only queues them.
+    const size_t max_forks =
+        std::max<int64_t>(at::get_num_interop_threads(), 1);
+    std::vector<Branch*> to_fork;
+    for (size_t i = 1; i < branches.size() && to_fork.size() < max_forks;
+         ++i) {
+      if (branches[i].cost >= min_cost_) {
+        to_fork.push_back(&branches[i]);
+      }
+    }
+    if (to_fork.empty()) {
+      return false;
+    }
+    // Branches left inline stay inline; otherwise the next round would fork
+    // them and exceed the limit.
+    forked_joins_.insert(join);
+    for (Branch* branch : to_fork) {
+      forkBranch(join, *branch);
+    }
+    return true;
+  }
+
+  void forkBranch(Node* join, const Branch& branch) {
+    auto subgraph = std::make_shared<Graph>(graph_->current_scope());
+    std::unordered_map<Value*, Value*> env;
+    std::vector<Value*> fork_inputs;
+    auto value_map = [&](Value* v) -> Value* {
+      auto it = env.find(v);
+      if (it != env.end()) {
+        return it->second;
+      }
+      Value* mapped = nullptr;
+      if (v->node()->kind() == prim::Constant) {
+        mapped = subgraph
+                     ->insertNode(subgraph->createClone(
+                         v->node(), [](Value* v) { return v; }))
+                     ->output();
+      } else {
+        mapped = subgraph->addInput()->copyMetadata(v);
+        fork_inputs.push_back(v);
+      }
+      env[v] = mapped;
+      return mapped;
+    };
+    for (Node* n : branch.nodes) {
+      Node* clone = subgraph->insertNode(subgraph->createClone(n, value_map));
+      for (size_t i = 0; i < n->outputs().size(); ++i) {
+        env[n->outputs()[i]] = clone->outputs()[i];
+      }
+    }
+    auto sub_outputs =
+        fmap(branch.outputs, [&](Value* v) { return env.at(v); });
+    if (sub_outputs.size() == 1) {
+      subgraph->registerOutput(sub_outputs[0]);
+    } else {
+      subgraph->registerOutput(
+          subgraph->insertNode(subgraph->createTuple(sub_outputs))->output());
+    }
+    TypePtr result_type = subgraph->outputs().at(0)->type();
+
+    // Fork as early as the inputs of the branch allow, and wait right before
+    // the join node.
+    Node* fork = graph_->create(prim::fork, fork_inputs, 1);
+    fork->g_(attr::Subgraph, subgraph);
+    fork->output()->setType(FutureType::create(result_type));
+    Node* last_producer = nullptr;
+    for (Value* v : fork_inputs) {
+      Node* producer = v->node();
+      if (producer->kind() == prim::Param) {
+        continue;
+      }
+      if (!last_producer || producer->isAfter(last_producer)) {
+        last_producer = producer;
+      }
+    }
+    if (last_producer) {
+      fork->insertAfter(last_producer);
+    } else {
+      fork->insertBefore(*graph_->nodes().begin());
+    }
+
+    Node* wait = graph_->create(aten::wait, {fork->output()}, 1);
+    wait->output()->setType(result_type);
+    wait->insertBefore(join);
+    std::vector<Value*> results = {wait->output()};
+    if (branch.outputs.size() > 1) {
+      Node* unpack = graph_->createTupleUnpack(wait->output());
+      unpack->insertBefore(join);
+      results = unpack->outputs().vec();
+    }
+    for (size_t i = 0; i < branch.outputs.size(); ++i) {
+      join->replaceInputWith(branch.outputs[i], results[i]);
+    }
+
+    GRAPH_UPDATE(
+        "Forking ",
+        branch.nodes.size(),
+        " nodes with estimated cost ",
+        branch.cost,
+        " for ",
+        getHeader(join));
+    for (auto it = branch.nodes.rbegin(); it != branch.nodes.rend(); ++it) {
+      (*it)->destroy();
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  int64_t min_cost_;
+  std::unordered_set<Node*> forked_joins_;
+};
+
+} // namespace
+
+void ForkIndependentRegions(std::shared_ptr<Graph>& graph, int64_t min_cost) {
+  RegionForker(graph, min_cost).run();
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,38 @@
+/** \brief Run independent regions of a graph in parallel on inter-op threads.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Estimated cost below which a region is cheaper to run inline than to fork.
+// Costs are roughly in multiply-adds, see ForkIndependentRegions.
+constexpr int64_t kDefaultForkMinCost = 1 << 20;
+
+/** \brief Fork independent branches that meet at a common node.
+ *
+ * For every node of the top-level block that takes the results of two or
+ * more branches that don't depend on each other, e.g. the towers of an
+ * inception block feeding a cat, each branch is the set of nodes only that
+ * input depends on and whose results are used by nothing else. Branches are
+ * moved into prim::fork subgraphs, and the node waits for their results.
+ *
+ * A branch's cost is the sum of estimated costs of its nodes: multiply-adds
+ * for convolutions and matrix products and the number of elements for
+ * other ops when shapes are known, and a fixed per-op estimate otherwise.
+ * To keep the fork overhead down:
+ *  - branches that cost less than \p min_cost run inline,
+ *  - the most expensive branch always runs inline on the calling thread,
+ *  - at most at::get_num_interop_threads() branches are forked per node.
+ *
+ * Nodes with side effects, sub-blocks, nondeterminism or that may be
+ * involved in in-place writes are never moved.
+ */
+TORCH_API void ForkIndependentRegions(
+    std::shared_ptr<Graph>& graph,
+    int64_t min_cost = kDefaultForkMinCost);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,342 @@
+#include <torch/csrc/jit/passes/freeze_module.h>
+
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/constant_propagation.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/inliner.h>
+
+#include <stack>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+class AttributePropagator {
+ public:
+  explicit AttributePropagator(script::Module& module) : module_(module) {}
+
+  void run() {
+    auto graph = module_.get_method("forward").graph();
+    Inline(*graph);
+    GRAPH_DUMP("Before freezing", graph);
+    self_ = graph->inputs().at(0);
+
+    {
+      AliasDb aliasDb(graph);
+      recordMutatedAttributes(graph->block(), aliasDb);
+    }
+    propagateAttributes(graph);
+    EliminateDeadCode(graph);
+    ConstantPropagation(graph);
+    EliminateDeadCode(graph);
+    cleanupFrozenModule(graph);
+    GRAPH_DUMP("After freezing", graph);
+  }
+
+ private:
+  // Follows a chain of prim::GetAttr nodes from `v` back to the `self` input
+  // of forward and returns the object it names, or nullopt if `v` is not
+  // produced by such a chain.
+  c10::optional<script::Module> resolveObject(Value* v) {
+    std::vector<std::string> names;
+    while (v != self_) {
+      Node* n = v->node();
+      if (n->kind() != prim::GetAttr) {
+        return c10::nullopt;
+      }
+      names.push_back(n->s(attr::name));
+      v = n->input();
+    }
+    script::Module obj = module_;
+    for (auto it = names.rbegin(); it != names.rend(); ++it) {
+      obj = script::Module(obj.attr(*it).toObject());
+    }
+    return obj;
+  }
+
+  bool isMutated(const script::Module& obj, const std::string& name) const {
+    auto it = mutated_.find(obj._ivalue().get());
+    return it != mutated_.end() && it->second.count(name);
+  }
+
+  void recordMutatedAttributes(Block* block, const AliasDb& aliasDb) {
+    for (Node* n : block->nodes()) {
+      for (Block* sub_block : n->blocks()) {
+        recordMutatedAttributes(sub_block, aliasDb);
+      }
+      if (n->kind() == prim::SetAttr) {
+        auto obj = resolveObject(n->inputs().at(0));
+        if (obj) {
+          mutated_[obj->_ivalue().get()].insert(n->s(attr::name));
+        }
+        continue;
+      }
+      for (Value* v : writtenInputs(n, aliasDb)) {
+        std::unordered_set<Value*> visited;
+        recordWrittenValue(v, aliasDb, visited);
+      }
+    }
+  }
+
+  // Returns the inputs that `n` writes to. AliasDb cannot tell them apart
+  // once any of them is in the wildcard set, so prefer the schema of `n`.
+  static std::vector<Value*> writtenInputs(Node* n, const AliasDb& aliasDb) {
+    std::vector<Value*> written;
+    if (auto schema = n->maybeSchema()) {
+      const auto& args = schema->arguments();
+      for (size_t i = 0; i < args.size() && i < n->inputs().size(); ++i) {
+        if (args[i].alias_info() && args[i].alias_info()->isWrite()) {
+          written.push_back(n->inputs()[i]);
+        }
+      }
+    } else if (
+        n->blocks().empty() &&
+        aliasDb.writesToAlias(
+            n, ValueSet(n->inputs().begin(), n->inputs().end()))) {
+      written.insert(written.end(), n->inputs().begin(), n->inputs().end());
+    }
+    return written;
+  }
+
+  // Marks the attributes that the written value `v` may have been read from,
+  // following `v` back through the values it may alias or be contained in.
+  void recordWrittenValue(
+      Value* v,
+      const AliasDb& aliasDb,
+      std::unordered_set<Value*>& visited) {
+    if (!visited.insert(v).second || v == self_) {
+      return;
+    }
+    Node* n = v->node();
+    if (n->kind() == prim::GetAttr) {
+      auto obj = resolveObject(n->input());
+      if (obj) {
+        mutated_[obj->_ivalue().get()].insert(n->s(attr::name));
+      } else {
+        recordWrittenValue(n->input(), aliasDb, visited);
+      }
+      return;
+    }
+    if (n->kind() == prim::Param) {
+      Node* owner = n->owningBlock()->owningNode();
+      if (!owner) {
+        // an input of forward, which is not an attribute
+        return;
+      }
+      if (owner->kind() != prim::Loop) {
+        unknownWrites_ = true;
+        return;
+      }
+      // loop-carried values: body inputs are [iteration, carried...], body
+      // outputs are [condition, carried...] and loop inputs are
+      // [max_trip_count, condition, carried...]
+      if (v->offset() > 0) {
+        recordWrittenValue(owner->inputs().at(v->offset() + 1), aliasDb, visited);
+        recordWrittenValue(
+            n->owningBlock()->outputs().at(v->offset()), aliasDb, visited);
+      }
+      return;
+    }
+    if (n->kind() == prim::If || n->kind() == prim::Loop) {
+      size_t offset = n->kind() == prim::Loop ? 1 : 0;
+      for (Block* b : n->blocks()) {
+        recordWrittenValue(b->outputs().at(v->offset() + offset), aliasDb, visited);
+      }
+      if (n->kind() == prim::Loop) {
+        recordWrittenValue(n->inputs().at(v->offset() + 2), aliasDb, visited);
+      }
+      return;
+    }
+    if (!n->blocks().empty()) {
+      unknownWrites_ = true;
+      return;
+    }
+    for (Value* input : n->inputs()) {
+      if (aliasDb.mayContainAlias(input, v)) {
+        recordWrittenValue(input, aliasDb, visited);
+      }
+    }
+  }
+
+  // The clone shares the tensors and containers of its attributes with the
+  // input module. Attributes that forward mutates are replaced by copies, so
+  // that running the frozen module leaves the input module untouched.
+  void copyMutatedAttribute(script::Module& obj, const std::string& name) {
+    if (!copied_[obj._ivalue().get()].insert(name).second) {
+      return;
+    }
+    GRAPH_UPDATE("Copying mutated attribute ", name);
+    obj._ivalue()->setAttr(name, deepCopy(obj.attr(name)));
+  }
+
+  static IValue deepCopy(const IValue& value) {
+    if (value.isTensor()) {
+      auto t = value.toTensor();
+      if (!t.defined()) {
+        return value;
+      }
+      auto copy = t.detach().clone();
+      copy.set_requires_grad(t.requires_grad());
+      return copy;
+    } else if (value.isTensorList()) {
+      c10::List<at::Tensor> copy;
+      for (at::Tensor t : value.toTensorList()) {
+        copy.push_back(deepCopy(t).toTensor());
+      }
+      return copy;
+    } else if (value.isIntList()) {
+      return value.toIntList().copy();
+    } else if (value.isDoubleList()) {
+      return value.toDoubleList().copy();
+    } else if (value.isBoolList()) {
+      return value.toBoolList().copy();
+    } else if (value.isGenericList()) {
+      auto list = value.toGenericList();
+      auto copy = list.copy();
+      for (size_t i = 0; i < list.size(); ++i) {
+        copy.set(i, deepCopy(list.get(i)));
+      }
+      return copy;
+    } else if (value.isGenericDict()) {
+      auto dict = value.toGenericDict();
+      auto copy = dict.copy();
+      for (const auto& entry : dict) {
+        copy.insert_or_assign(entry.key(), deepCopy(entry.value()));
+      }
+      return copy;
+    } else if (value.isTuple()) {
+      std::vector<IValue> elements;
+      for (const IValue& element : value.toTuple()->elements()) {
+        elements.push_back(deepCopy(element));
+      }
+      return c10::ivalue::Tuple::create(std::move(elements));
+    }
+    return value;
+  }
+
+  // Constants cannot carry gradients; frozen modules are for inference only.
+  static IValue detachTensors(IValue attr) {
+    if (attr.isTensor()) {
+      auto t = attr.toTensor();
+      if (t.defined() && t.requires_grad()) {
+        return t.detach();
+      }
+    } else if (attr.isTensorList()) {
+      c10::List<at::Tensor> detached;
+      for (at::Tensor t : attr.toTensorList()) {
+        detached.push_back(t.requires_grad() ? t.detach() : t);
+      }
+      return detached;
+    }
+    return attr;
+  }
+
+  void propagateAttributes(std::shared_ptr<Graph>& graph) {
+    std::stack<Block*> blocks({graph->block()});
+    while (!blocks.empty()) {
+      Block* block = blocks.top();
+      blocks.pop();
+      for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+        Node* n = *it;
+        it++; // advance iterator bc the current node may be destroyed
+
+        for (Block* sub_block : n->blocks()) {
+          blocks.push(sub_block);
+        }
+        if (n->kind() != prim::GetAttr) {
+          continue;
+        }
+        auto name = n->s(attr::name);
+        auto obj = resolveObject(n->input());
+        if (!obj) {
+          continue;
+        }
+        IValue attr = obj->attr(name);
+        // Objects stay on the module; only the leaves of the chain are
+        // folded.
+        if (attr.isObject()) {
+          continue;
+        }
+        if (isMutated(*obj, name) ||
+            (unknownWrites_ && AliasDb::mutableType(n->output()))) {
+          GRAPH_DEBUG("Attribute ", name, " is mutated, skipping");
+          copyMutatedAttribute(*obj, name);
+          continue;
+        }
+        WithInsertPoint guard(*graph->block()->nodes().begin());
+        auto constant = tryInsertConstant(*graph, detachTensors(attr));
+        if (!constant) {
+          continue;
+        }
+        GRAPH_UPDATE(
+            "Folding ", getHeader(n), " into ", getHeader((*constant)->node()));
+        n->output()->replaceAllUsesWith(*constant);
+        n->destroy();
+      }
+    }
+  }
+
+  // Removes methods other than forward, and attributes of the top-level
+  // module that forward no longer reads. Types of submodules may be shared
+  // between several instances, so only the top-level module, whose type is
+  // unique to the clone, is rewritten.
+  void cleanupFrozenModule(std::shared_ptr<Graph>& graph) {
+    std::unordered_set<std::string> used = {"training"};
+    for (const Use& use : self_->uses()) {
+      Node* n = use.user;
+      if (n->kind() == prim::GetAttr || n->kind() == prim::SetAttr) {
+        used.insert(n->s(attr::name));
+      }
+    }
+
+    auto type = module_.type();
+    for (int64_t i = type->numAttributes() - 1; i >= 0; --i) {
+      const std::string name = type->getAttributeName(i);
+      if (used.count(name)) {
+        continue;
+      }
+      GRAPH_UPDATE("Removing attribute ", name);
+      module_._ivalue()->unsafeRemoveSlot(i);
+      type->unsafeRemoveAttribute(name);
+    }
+
+    std::vector<std::string> methods;
+    for (Function* fn : type->methods()) {
+      if (fn->name() != "forward") {
+        methods.push_back(fn->name());
+      }
+    }
+    for (const auto& name : methods) {
+      GRAPH_UPDATE("Removing method ", name);
+      type->unsafeRemoveMethod(name);
+    }
+  }
+
+  script::Module& module_;
+  Value* self_ = nullptr;
+  // Set when forward writes to a value that could not be traced back to the
+  // attributes it may alias; every mutable attribute is then kept.
+  bool unknownWrites_ = false;
+  std::unordered_map<c10::ivalue::Object*, std::unordered_set<std::string>>
+      mutated_;
+  std::unordered_map<c10::ivalue::Object*, std::unordered_set<std::string>>
+      copied_;
+};
+
+} // namespace
+
+script::Module freeze_module(const script::Module& module) {
+  auto moduleClone = module.clone();
+  TORCH_CHECK(
+      !moduleClone.is_training(),
+      "Freezing module in training mode is not yet supported");
+  AttributePropagator attrPropagator(moduleClone);
+  attrPropagator.run();
+  return moduleClone;
+}
+
+} // namespace jit
+} // namespace torch
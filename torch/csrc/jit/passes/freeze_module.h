@@ -0,0 +1,33 @@
+/** \brief This file defines freezing Torchscript module API.
+ *
+ * This API has python-binding and can be invoked directly or as a part of
+ * general optimization pipeline.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/script/module.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Freeze an eval-mode module for inference.
+ *
+ * Returns a clone of \p module whose forward method has every call inlined,
+ * and every attribute that forward reads but never writes replaced by a
+ * constant, followed by constant propagation. Attributes and submodules that
+ * are no longer used, and all methods other than forward, are removed from
+ * the clone.
+ *
+ * Attributes that forward writes, either with prim::SetAttr or through an
+ * in-place op on a value that may alias them, are kept on the module, as are
+ * attributes whose type cannot be encoded as a constant. The clone would
+ * share the tensors and containers of the kept attributes with \p module, so
+ * the ones that forward writes are deep-copied, and running the frozen module
+ * does not modify \p module. The constants still share their tensors with
+ * \p module.
+ */
+TORCH_API script::Module freeze_module(const script::Module& module);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,434 @@
+#include <torch/csrc/jit/passes/memory_planning.h>
+
+#include <torch/csrc/autograd/generated/variable_factories.h>
+#include <torch/csrc/jit/custom_operator.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/operator.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Same as the alignment of the CPU allocator, so a tensor placed in the arena
+// is aligned like a freshly allocated one.
+constexpr size_t kArenaAlignment = 64;
+
+c10::OperatorOptions aliasAnalysisIsSpecialCase() {
+  c10::OperatorOptions options;
+  options.setAliasAnalysis(AliasAnalysisKind::INTERNAL_SPECIAL_CASE);
+  return options;
+}
+
+struct ArenaCache {
+  std::mutex mutex;
+  at::Tensor arena;
+};
+
+RegisterOperators memory_planning_reg({
+    Operator(
+        prim::AllocateStorage,
+        [](const Node* node) -> Operation {
+          const int64_t size = node->i(attr::size);
+          // Runs of the graph reuse the same arena as long as no tensor
+          // placed in it by a previous run is still alive. Concurrent runs
+          // get an arena of their own.
+          auto cache = std::make_shared<ArenaCache>();
+          return [size, cache](Stack& stack) {
+            at::Tensor arena;
+            {
+              std::lock_guard<std::mutex> guard(cache->mutex);
+              if (!cache->arena.defined()) {
+                cache->arena = torch::empty({size}, at::dtype(at::kByte));
+              }
+              if (cache->arena.use_count() == 1) {
+                arena = cache->arena;
+              }
+            }
+            if (!arena.defined()) {
+              arena = torch::empty({size}, at::dtype(at::kByte));
+            }
+            push(stack, std::move(arena));
+            return 0;
+          };
+        },
+        aliasAnalysisIsSpecialCase()),
+    Operator(
+        prim::AllocateTensor,
+        [](const Node* node) -> Operation {
+          const int64_t offset = node->i(attr::offset);
+          const std::vector<int64_t> sizes = node->is(attr::size);
+          const std::vector<int64_t> strides = node->is(attr::stride);
+          const auto dtype = static_cast<at::ScalarType>(node->i(attr::dtype));
+          return [offset, sizes, strides, dtype](Stack& stack) {
+            at::Tensor arena = pop(stack).toTensor();
+            uint8_t* data = arena.data_ptr<uint8_t>() + offset;
+            // the deleter keeps the arena alive for as long as the tensor is
+            push(
+                stack,
+                torch::from_blob(
+                    data,
+                    sizes,
+                    strides,
+                    [arena](void*) {},
+                    at::dtype(dtype)));
+            return 0;
+          };
+        },
+        aliasAnalysisIsSpecialCase()),
+});
+
+// Elementwise ops whose out= variant may write to the same memory as one of
+// its inputs of the same layout.
+bool isElementwise(Node* n) {
+  static const std::unordered_set<Symbol> elementwise = {
+      aten::add,
+      aten::sub,
+      aten::mul,
+      aten::div,
+      aten::sigmoid,
+      aten::tanh,
+      aten::exp,
+      aten::log,
+      aten::neg,
+      aten::abs,
+      aten::sqrt,
+      aten::rsqrt,
+      aten::clamp,
+      aten::threshold,
+  };
+  return elementwise.count(n->kind());
+}
+
+// Nodes through which a value may escape the graph without alias analysis
+// relating it to the graph inputs or outputs.
+bool hasUntrackedEscapes(Block* block) {
+  for (Node* n : block->nodes()) {
+    switch (n->kind()) {
+      case prim::fork:
+      case prim::SetAttr:
+      case prim::CallFunction:
+      case prim::CallMethod:
+      case prim::PythonOp:
+        return true;
+      default:
+        break;
+    }
+    for (Block* sub_block : n->blocks()) {
+      if (hasUntrackedEscapes(sub_block)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+TensorTypePtr plannableType(Value* v) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type || !type->isComplete() || type->device()->type() != at::kCPU ||
+      type->requiresGrad() != false) {
+    return nullptr;
+  }
+  return type;
+}
+
+size_t storageBytes(const TensorTypePtr& type) {
+  const auto sizes = *type->sizes().concrete_sizes();
+  const auto strides = *type->strides().concrete_sizes();
+  int64_t numel = 1;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    if (sizes[i] == 0) {
+      return 0;
+    }
+    numel += (sizes[i] - 1) * strides[i];
+  }
+  return numel * elementSize(*type->scalarType());
+}
+
+bool sameLayout(const TensorTypePtr& a, const TensorTypePtr& b) {
+  return a->scalarType() == b->scalarType() && a->sizes() == b->sizes() &&
+      a->strides() == b->strides();
+}
+
+// Returns the out= overload of the op `n` calls, i.e. the one that takes the
+// same arguments plus a trailing `Tensor(a!) out`.
+std::shared_ptr<Operator> findOutVariant(Node* n) {
+  const FunctionSchema* schema = n->maybeSchema();
+  if (!schema || !n->kind().is_aten() || schema->returns().size() != 1 ||
+      schema->returns()[0].alias_info()) {
+    return nullptr;
+  }
+  const auto& args = schema->arguments();
+  for (const auto& op : getAllOperatorsFor(n->kind())) {
+    const auto& out_schema = op->schema();
+    const auto& out_args = out_schema.arguments();
+    if (out_schema.overload_name() != "out" ||
+        out_args.size() != args.size() + 1 ||
+        out_schema.returns().size() != 1) {
+      continue;
+    }
+    const auto& out_arg = out_args.back();
+    if (!out_arg.alias_info() || !out_arg.alias_info()->isWrite() ||
+        out_arg.type()->kind() != TypeKind::TensorType) {
+      continue;
+    }
+    bool matches = true;
+    for (size_t i = 0; i < args.size(); ++i) {
+      if (args[i].name() != out_args[i].name() ||
+          *args[i].type() != *out_args[i].type()) {
+        matches = false;
+        break;
+      }
+    }
+    if (matches) {
+      return op;
+    }
+  }
+  return nullptr;
+}
+
+// A range of the arena, live from the node at `begin` to the node at `end`
+// (both inclusive, as indices into the top-level block).
+struct Slot {
+  size_t bytes;
+  size_t begin;
+  size_t end;
+  size_t offset = 0;
+};
+
+struct Intermediate {
+  Node* node;
+  TensorTypePtr type;
+  size_t bytes;
+  size_t begin;
+  size_t end;
+  size_t slot;
+};
+
+class MemoryPlanner {
+ public:
+  explicit MemoryPlanner(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)), aliasDb_(graph_) {
+    size_t i = 0;
+    for (Node* n : graph_->nodes()) {
+      index_[n] = i++;
+    }
+    index_[graph_->return_node()] = i;
+  }
+
+  MemoryPlanStats run() {
+    collectIntermediates();
+    assignSlots();
+    assignOffsets();
+    rewrite();
+    GRAPH_DEBUG(
+        "Planned ",
+        stats_.num_planned,
+        " intermediates of ",
+        stats_.intermediate_bytes,
+        " bytes into an arena of ",
+        stats_.arena_bytes,
+        " bytes");
+    GRAPH_DUMP("After memory planning", graph_);
+    return stats_;
+  }
+
+ private:
+  // Index of the top-level node that contains `n`.
+  size_t topLevelIndex(Node* n) const {
+    while (n->owningBlock() != graph_->block()) {
+      n = n->owningBlock()->owningNode();
+    }
+    return index_.at(n);
+  }
+
+  size_t lastUse(Value* v) const {
+    size_t last = topLevelIndex(v->node());
+    for (const Use& use : v->uses()) {
+      last = std::max(last, topLevelIndex(use.user));
+    }
+    return last;
+  }
+
+  void collectIntermediates() {
+    std::vector<Value*> values;
+    for (Node* n : graph_->nodes()) {
+      for (Value* v : n->outputs()) {
+        values.push_back(v);
+      }
+    }
+    for (Node* n : graph_->nodes()) {
+      if (!n->blocks().empty() || n->outputs().size() != 1) {
+        continue;
+      }
+      Value* v = n->output();
+      auto type = plannableType(v);
+      if (!type || !findOutVariant(n)) {
+        continue;
+      }
+      if (aliasDb_.mayContainAlias(at::ArrayRef<Value*>(v), graph_->inputs()) ||
+          aliasDb_.mayContainAlias(
+              at::ArrayRef<Value*>(v), graph_->outputs())) {
+        continue;
+      }
+      const size_t bytes = storageBytes(type);
+      if (bytes == 0) {
+        continue;
+      }
+      // The memory must stay reserved until all views of it are dead.
+      size_t end = lastUse(v);
+      for (Value* w : values) {
+        if (w != v && aliasDb_.mayContainAlias(v, w)) {
+          end = std::max(end, lastUse(w));
+        }
+      }
+      intermediates_.push_back({n, type, bytes, index_.at(n), end, 0});
+    }
+  }
+
+  void assignSlots() {
+    std::unordered_map<Value*, size_t> planned;
+    for (auto& im : intermediates_) {
+      const size_t bytes =
+          (im.bytes + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+      bool reused = false;
+      if (isElementwise(im.node)) {
+        for (Value* input : im.node->inputs()) {
+          auto it = planned.find(input);
+          if (it == planned.end()) {
+            continue;
+          }
+          Slot& slot = slots_[it->second];
+          const auto& input_type = input->type()->expect<TensorType>();
+          if (slot.end == im.begin && slot.bytes == bytes &&
+              sameLayout(input_type, im.type)) {
+            GRAPH_DEBUG(
+                "Reusing memory of %",
+                input->debugName(),
+                " for %",
+                im.node->output()->debugName());
+            slot.end = im.end;
+            im.slot = it->second;
+            reused = true;
+            break;
+          }
+        }
+      }
+      if (!reused) {
+        im.slot = slots_.size();
+        slots_.push_back({bytes, im.begin, im.end});
+      }
+      planned[im.node->output()] = im.slot;
+      stats_.intermediate_bytes += im.bytes;
+      stats_.num_planned++;
+    }
+  }
+
+  // Greedy by size: place the largest slots first, each in the smallest gap
+  // between already placed slots that are live at the same time.
+  void assignOffsets() {
+    std::vector<size_t> order(slots_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return slots_[a].bytes > slots_[b].bytes;
+    });
+
+    std::vector<const Slot*> placed;
+    for (size_t s : order) {
+      Slot& slot = slots_[s];
+      std::vector<const Slot*> live;
+      for (const Slot* other : placed) {
+        if (other->begin <= slot.end && slot.begin <= other->end) {
+          live.push_back(other);
+        }
+      }
+      std::sort(live.begin(), live.end(), [](const Slot* a, const Slot* b) {
+        return a->offset < b->offset;
+      });
+
+      size_t best_offset = std::numeric_limits<size_t>::max();
+      size_t best_gap = std::numeric_limits<size_t>::max();
+      size_t prev_end = 0;
+      for (const Slot* other : live) {
+        if (other->offset >= prev_end) {
+          const size_t gap = other->offset - prev_end;
+          if (gap >= slot.bytes && gap < best_gap) {
+            best_offset = prev_end;
+            best_gap = gap;
+          }
+        }
+        prev_end = std::max(prev_end, other->offset + other->bytes);
+      }
+      slot.offset = best_offset == std::numeric_limits<size_t>::max()
+          ? prev_end
+          : best_offset;
+      stats_.arena_bytes =
+          std::max(stats_.arena_bytes, slot.offset + slot.bytes);
+      placed.push_back(&slot);
+    }
+  }
+
+  void rewrite() {
+    if (intermediates_.empty()) {
+      return;
+    }
+    Value* arena = nullptr;
+    {
+      WithInsertPoint guard(*graph_->nodes().begin());
+      Node* alloc = graph_->insertNode(graph_->create(prim::AllocateStorage));
+      alloc->i_(attr::size, stats_.arena_bytes);
+      arena = alloc->output()->setType(TensorType::createContiguous(
+          at::kByte, at::kCPU, {static_cast<int64_t>(stats_.arena_bytes)}));
+    }
+
+    for (const auto& im : intermediates_) {
+      Node* n = im.node;
+      Value* v = n->output();
+      WithInsertPoint guard(n);
+
+      Node* buffer = graph_->create(prim::AllocateTensor, {arena});
+      buffer->i_(attr::offset, slots_[im.slot].offset);
+      buffer->is_(attr::size, *im.type->sizes().concrete_sizes());
+      buffer->is_(attr::stride, *im.type->strides().concrete_sizes());
+      buffer->i_(attr::dtype, static_cast<int64_t>(*im.type->scalarType()));
+      buffer->output()->setType(im.type);
+      graph_->insertNode(buffer);
+
+      std::vector<Value*> inputs = n->inputs().vec();
+      inputs.push_back(buffer->output());
+      Node* out_node = graph_->insertNode(graph_->create(n->kind(), inputs));
+      out_node->setSourceRange(n->sourceRange());
+      out_node->output()->copyMetadata(v);
+      v->replaceAllUsesWith(out_node->output());
+      n->destroy();
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  AliasDb aliasDb_;
+  std::unordered_map<Node*, size_t> index_;
+  std::vector<Intermediate> intermediates_;
+  std::vector<Slot> slots_;
+  MemoryPlanStats stats_;
+};
+
+} // namespace
+
+MemoryPlanStats PlanMemory(std::shared_ptr<Graph>& graph) {
+  if (hasUntrackedEscapes(graph->block())) {
+    GRAPH_DEBUG("Graph has values escaping through untracked nodes, skipping");
+    return MemoryPlanStats();
+  }
+  MemoryPlanner planner(graph);
+  return planner.run();
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,41 @@
+/** \brief Static memory planning for graphs with fully specified shapes.
+ *
+ * Intermediate tensors whose sizes are known ahead of time are assigned to
+ * offsets in a single arena that is allocated once per run, and the ops that
+ * produce them are rewritten to their out= variants writing into that arena.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+struct MemoryPlanStats {
+  // Bytes of the arena allocated for each run of the graph.
+  size_t arena_bytes = 0;
+  // Sum of the sizes of all intermediates placed in the arena, i.e. what the
+  // graph allocated for them before planning.
+  size_t intermediate_bytes = 0;
+  // Number of intermediates placed in the arena.
+  size_t num_planned = 0;
+};
+
+/** \brief Place intermediate tensors of \p graph in a shared arena.
+ *
+ * Needs complete tensor types on the values to plan, e.g. from
+ * `_jit_pass_complete_shape_analysis` or profiling. Only outputs of ops in the
+ * top-level block that have an out= overload, live on the CPU and don't
+ * require grad are planned; values that may alias graph inputs or outputs
+ * are left alone.
+ *
+ * Two intermediates share memory if their lifetimes, extended by the
+ * lifetimes of everything that may alias them, don't overlap. The output of
+ * an elementwise op may reuse the slot of an input of the same layout that
+ * dies at that op. The planned graph is only valid for the shapes it was
+ * planned for.
+ */
+TORCH_API MemoryPlanStats PlanMemory(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
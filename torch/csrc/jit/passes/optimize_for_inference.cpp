@@ -0,0 +1,236 @@
+#include <torch/csrc/jit/passes/optimize_for_inference.h>
+
+#include <ATen/Context.h>
+#include <ATen/core/grad_mode.h>
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/passes/fuse_linear.h>
+#include <torch/csrc/jit/passes/inliner.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Calls `fn` on every node of `block` and its sub-blocks. `fn` may destroy
+// the node it is called on.
+template <typename Fn>
+void forEachNode(Block* block, const Fn& fn) {
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    Node* n = *it;
+    it++; // advance iterator bc the current node may be destroyed
+    for (Block* sub_block : n->blocks()) {
+      forEachNode(sub_block, fn);
+    }
+    fn(n);
+  }
+}
+
+// Returns true if `v` is a constant Tensor or None, and sets `t` to the
+// tensor, or leaves it undefined for None.
+bool constantOptionalTensor(Value* v, at::Tensor& t) {
+  auto ivalue = toIValue(v);
+  if (!ivalue) {
+    return false;
+  }
+  if (ivalue->isTensor()) {
+    t = ivalue->toTensor();
+    return true;
+  }
+  return ivalue->isNone();
+}
+
+bool constantTensor(Value* v, at::Tensor& t) {
+  return constantOptionalTensor(v, t) && t.defined();
+}
+
+void foldConvBatchNorm(Node* bn) {
+  // aten::batch_norm(input, weight, bias, running_mean, running_var,
+  //                  training, momentum, eps, cudnn_enabled)
+  Value* conv_output = bn->inputs().at(0);
+  Node* conv = conv_output->node();
+  if (conv->kind() != aten::conv1d && conv->kind() != aten::conv2d &&
+      conv->kind() != aten::conv3d) {
+    return;
+  }
+  if (conv_output->uses().size() != 1) {
+    return;
+  }
+  auto training = toIValue(bn->inputs().at(5));
+  auto eps = toIValue(bn->inputs().at(7));
+  if (!training || !training->isBool() || training->toBool() || !eps ||
+      !eps->isDouble()) {
+    return;
+  }
+  at::Tensor conv_w, conv_b, bn_w, bn_b, bn_mean, bn_var;
+  if (!constantTensor(conv->inputs().at(1), conv_w) ||
+      !constantOptionalTensor(conv->inputs().at(2), conv_b) ||
+      !constantOptionalTensor(bn->inputs().at(1), bn_w) ||
+      !constantOptionalTensor(bn->inputs().at(2), bn_b) ||
+      !constantTensor(bn->inputs().at(3), bn_mean) ||
+      !constantTensor(bn->inputs().at(4), bn_var)) {
+    return;
+  }
+
+  // y = (conv(x, W) + b - mean) / sqrt(var + eps) * gamma + beta
+  //   = conv(x, W * scale) + (b - mean) * scale + beta
+  // with scale = gamma / sqrt(var + eps), broadcast over output channels.
+  at::NoGradGuard no_grad;
+  at::Tensor scale = at::rsqrt(bn_var + eps->toDouble());
+  if (bn_w.defined()) {
+    scale = scale * bn_w;
+  }
+  std::vector<int64_t> scale_shape(conv_w.dim(), 1);
+  scale_shape[0] = -1;
+  at::Tensor new_w = conv_w * scale.reshape(scale_shape);
+  at::Tensor new_b =
+      ((conv_b.defined() ? conv_b : at::zeros_like(bn_mean)) - bn_mean) *
+      scale;
+  if (bn_b.defined()) {
+    new_b = new_b + bn_b;
+  }
+
+  GRAPH_UPDATE("Folding ", getHeader(bn), " into ", getHeader(conv));
+  WithInsertPoint guard(conv);
+  Graph* graph = conv->owningGraph();
+  conv->replaceInput(1, graph->insertConstant(new_w));
+  conv->replaceInput(2, graph->insertConstant(new_b));
+  bn->output()->replaceAllUsesWith(conv_output);
+  bn->destroy();
+}
+
+// Whether `v` is used only once and holds a tensor that was freshly
+// allocated by a convolution or linear op, so it can be overwritten in place.
+bool isFreshConvOrLinearOutput(Value* v) {
+  static const std::unordered_set<Symbol> producers = {
+      aten::conv1d,
+      aten::conv2d,
+      aten::conv3d,
+      aten::mkldnn_convolution,
+      aten::linear,
+      aten::addmm,
+      aten::matmul,
+  };
+  if (v->uses().size() != 1) {
+    return false;
+  }
+  Node* n = v->node();
+  if (producers.count(n->kind())) {
+    return true;
+  }
+  // e.g. the two branches of F.linear
+  if (n->kind() == prim::If) {
+    for (Block* block : n->blocks()) {
+      if (!isFreshConvOrLinearOutput(block->outputs().at(v->offset()))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+} // namespace
+
+void FoldFrozenConvBatchNorm(std::shared_ptr<Graph>& graph) {
+  forEachNode(graph->block(), [](Node* n) {
+    if (n->kind() == aten::batch_norm) {
+      foldConvBatchNorm(n);
+    }
+  });
+  EliminateDeadCode(graph);
+  GRAPH_DUMP("After FoldFrozenConvBatchNorm", graph);
+}
+
+void FuseConvLinearRelu(std::shared_ptr<Graph>& graph) {
+  forEachNode(graph->block(), [&](Node* n) {
+    if (n->kind() != aten::relu || n->inputs().size() != 1 ||
+        !isFreshConvOrLinearOutput(n->input())) {
+      return;
+    }
+    WithInsertPoint guard(n);
+    Value* relu = graph->insert(Symbol::aten("relu_"), {n->input()});
+    relu->copyMetadata(n->output());
+    GRAPH_UPDATE(
+        "Replacing ", getHeader(n), " with ", getHeader(relu->node()));
+    n->output()->replaceAllUsesWith(relu);
+    n->destroy();
+  });
+  GRAPH_DUMP("After FuseConvLinearRelu", graph);
+}
+
+void PrepackConvWeights(std::shared_ptr<Graph>& graph) {
+  if (!at::hasMKLDNN() || !at::globalContext().userEnabledMkldnn()) {
+    return;
+  }
+  forEachNode(graph->block(), [&](Node* n) {
+    // aten::conv2d(input, weight, bias, stride, padding, dilation, groups)
+    if (n->kind() != aten::conv2d) {
+      return;
+    }
+    at::Tensor weight;
+    if (!constantTensor(n->inputs().at(1), weight) || weight.dim() != 4 ||
+        weight.scalar_type() != at::kFloat || !weight.device().is_cpu() ||
+        weight.is_mkldnn()) {
+      return;
+    }
+    auto stride = toIValue(n->inputs().at(3));
+    auto padding = toIValue(n->inputs().at(4));
+    auto dilation = toIValue(n->inputs().at(5));
+    auto groups = toIValue(n->inputs().at(6));
+    if (!stride || !padding || !dilation || !groups) {
+      return;
+    }
+
+    at::Tensor packed;
+    {
+      at::NoGradGuard no_grad;
+      packed = at::mkldnn_reorder_conv2d_weight(
+          weight.contiguous(),
+          padding->toIntListRef(),
+          stride->toIntListRef(),
+          dilation->toIntListRef(),
+          groups->toInt());
+    }
+
+    WithInsertPoint guard(n);
+    // mkldnn_convolution reads dense inputs as contiguous NCHW
+    Value* input = graph->insert(aten::contiguous, {n->inputs().at(0)});
+    Value* output = graph->insert(
+        aten::mkldnn_convolution,
+        {input,
+         graph->insertConstant(packed),
+         n->inputs().at(2),
+         n->inputs().at(4),
+         n->inputs().at(3),
+         n->inputs().at(5),
+         n->inputs().at(6)});
+    output->copyMetadata(n->output());
+    GRAPH_UPDATE(
+        "Replacing ", getHeader(n), " with ", getHeader(output->node()));
+    n->output()->replaceAllUsesWith(output);
+    n->destroy();
+  });
+  GRAPH_DUMP("After PrepackConvWeights", graph);
+}
+
+script::Module optimize_for_inference(const script::Module& module) {
+  // FuseLinear matches aten::t on the weight, which freezing would fold into
+  // a constant, so it runs on the inlined graph before freezing.
+  auto prepared = module.clone();
+  auto graph = prepared.get_method("forward").graph();
+  Inline(*graph);
+  FuseLinear(graph);
+
+  auto frozen = freeze_module(prepared);
+  graph = frozen.get_method("forward").graph();
+  FoldFrozenConvBatchNorm(graph);
+  PrepackConvWeights(graph);
+  FuseConvLinearRelu(graph);
+  return frozen;
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,46 @@
+/** \brief This file defines passes that specialize frozen graphs for CPU
+ * inference, and a pipeline that runs them on a module.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/script/module.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Fold aten::batch_norm in eval mode into the weight and bias of the
+ * preceding aten::conv{1,2,3}d.
+ *
+ * The convolution and batch norm parameters must be constants, e.g. after
+ * freeze_module, and the convolution output must have no other uses.
+ */
+TORCH_API void FoldFrozenConvBatchNorm(std::shared_ptr<Graph>& graph);
+
+/** \brief Replace aten::relu of the result of a convolution or linear op with
+ * aten::relu_ when nothing else uses that result, so the activation is
+ * applied in place instead of allocating another output.
+ */
+TORCH_API void FuseConvLinearRelu(std::shared_ptr<Graph>& graph);
+
+/** \brief Replace aten::conv2d with constant float weights by
+ * aten::mkldnn_convolution on weights reordered to the MKL-DNN blocked layout
+ * once, at the time this pass runs.
+ *
+ * Does nothing if PyTorch is built without MKL-DNN or it is disabled. The
+ * reordered weights are opaque tensors, so the resulting graph cannot be
+ * serialized.
+ */
+TORCH_API void PrepackConvWeights(std::shared_ptr<Graph>& graph);
+
+/** \brief Freeze an eval-mode module and optimize its forward method for CPU
+ * inference.
+ *
+ * Runs FuseLinear, freeze_module, FoldFrozenConvBatchNorm, PrepackConvWeights
+ * and FuseConvLinearRelu, in that order, and returns the frozen module. The
+ * input module is not modified.
+ */
+TORCH_API script::Module optimize_for_inference(const script::Module& module);
+
+} // namespace jit
+} // namespace torch
@@ -1,3 +1,4 @@
+#include <ATen/core/grad_mode.h>
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/bailout_graph.h>
 #include <torch/csrc/jit/passes/canonicalize_ops.h>
@@ -32,12 +33,38 @@ static std::atomic<bool> profiling_mode{true};
 #endif
 
 
+static std::atomic<size_t> profiling_plan_cache_size{8};
+
 std::atomic<bool>& getProfilingMode() {
   return profiling_mode;
 }
 std::atomic<bool>& getExecutorMode() {
   return executor_mode;
 }
+std::atomic<size_t>& getProfilingPlanCacheSize() {
+  return profiling_plan_cache_size;
+}
+
+// A plan is profiled and optimized again once it bailed out this many times,
+// at most kMaxRecompilations times per class of input shapes.
+static constexpr size_t kBailoutsBeforeRecompile = 16;
+static constexpr size_t kMaxRecompilations = 2;
+// Recompiled plans are profiled over several runs, so that sizes that vary
+// within a class become unknown in the profile instead of failing guards.
+static constexpr size_t kRecompileProfilingRuns = 4;
+
+// Sizes 0 and 1 change broadcasting and get buckets of their own, other sizes
+// are rounded up to a power of two.
+static int64_t bucketSize(int64_t size) {
+  if (size <= 1) {
+    return size;
+  }
+  int64_t bucket = 2;
+  while (bucket < size) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
 
 static bool needsGradientInProfilingMode(Block* b) {
   for (auto n : b->nodes()) {
@@ -124,6 +151,103 @@ ProfilingGraphExecutorImpl::ProfilingGraphExecutorImpl(
     const std::shared_ptr<Graph>& graph)
     : GraphExecutorImplBase(graph) {}
 
+ProfilingGraphExecutorImpl::PlanKey ProfilingGraphExecutorImpl::planKeyFor(
+    Stack& stack) const {
+  PlanKey key;
+  for (const IValue& input : last(stack, num_inputs)) {
+    if (!input.isTensor()) {
+      key.push_back(0);
+      continue;
+    }
+    const at::Tensor& t = input.toTensor();
+    if (!t.defined()) {
+      key.push_back(1);
+      continue;
+    }
+    key.push_back(2);
+    key.push_back(static_cast<int64_t>(t.scalar_type()));
+    key.push_back(static_cast<int64_t>(t.device().type()));
+    key.push_back(t.device().index());
+    key.push_back(t.requires_grad() && at::GradMode::is_enabled());
+    key.push_back(t.dim());
+    for (int64_t size : t.sizes()) {
+      key.push_back(bucketSize(size));
+    }
+  }
+  return key;
+}
+
+ProfilingGraphExecutorImpl::SpecializedPlan& ProfilingGraphExecutorImpl::
+    specializedPlanFor(Stack& stack) {
+  auto key = planKeyFor(stack);
+  auto it = plan_index_.find(key);
+  if (it != plan_index_.end()) {
+    plans_.splice(plans_.begin(), plans_, it->second);
+    return plans_.front().second;
+  }
+
+  size_t capacity = std::max<size_t>(getProfilingPlanCacheSize(), 1);
+  while (plans_.size() >= capacity) {
+    GRAPH_DEBUG("Evicting the least recently used plan of ", this);
+    retire(plans_.back().second);
+    plan_index_.erase(plans_.back().first);
+    plans_.pop_back();
+  }
+  plans_.emplace_front(key, SpecializedPlan());
+  plan_index_.emplace(std::move(key), plans_.begin());
+  return plans_.front().second;
+}
+
+// The profiling nodes of a plan point into the record that instrumented it,
+// so their callbacks share ownership of the record. The record then lives as
+// long as the plan's Code, even after the executor retires it.
+static void shareProfilingRecord(
+    Block* b,
+    const std::shared_ptr<ProfilingRecord>& pr) {
+  for (auto n : b->nodes()) {
+    if (n->kind() == prim::profile) {
+      auto pn = n->cast<ProfileOp>();
+      auto callback = pn->getCallback();
+      pn->setCallback([pr, callback](Stack& stack) { callback(stack); });
+    }
+    for (auto ib : n->blocks()) {
+      shareProfilingRecord(ib, pr);
+    }
+  }
+}
+
+void ProfilingGraphExecutorImpl::startProfiling(
+    SpecializedPlan& plan,
+    size_t num_profiling_runs) {
+  plan.pr = ProfilingRecord::instrumentGraph(profiling_graph_);
+  plan.pr->profiling_count_ = num_profiling_runs;
+  auto pr_copy = plan.pr->graph()->copy();
+  shareProfilingRecord(pr_copy->block(), plan.pr);
+  GRAPH_DUMP("Profiled Graph: ", pr_copy);
+  plan.profiling_plan = ExecutionPlan(pr_copy);
+}
+
+void ProfilingGraphExecutorImpl::retire(SpecializedPlan& plan) {
+  if (plan.optimized_plan) {
+    retired_guard_failures_ += plan.optimized_plan->code.num_guard_failures();
+    retired_bailouts_ += plan.optimized_plan->code.num_bailouts();
+  }
+  if (plan.pr) {
+    retired_profiles_.erase(
+        std::remove_if(
+            retired_profiles_.begin(),
+            retired_profiles_.end(),
+            [](const std::weak_ptr<ProfilingRecord>& pr) {
+              return pr.expired();
+            }),
+        retired_profiles_.end());
+    retired_profiles_.emplace_back(plan.pr);
+    plan.pr.reset();
+  }
+  plan.profiling_plan.reset();
+  plan.optimized_plan.reset();
+}
+
 ExecutionPlan ProfilingGraphExecutorImpl::getPlanFor(Stack& stack) {
   std::lock_guard<std::mutex> lock(compile_mutex);
   GRAPH_DEBUG("Running ProfilingGraphExecutorImpl ", this);
@@ -141,34 +265,74 @@ ExecutionPlan ProfilingGraphExecutorImpl::getPlanFor(Stack& stack) {
     return *optimized_plan_;
   }
 
-  // if a profiling graph hasn't been created yet
-  if (!pr_) {
-    auto copy = graph->copy();
-    runProfilingInsensitiveOptimizations(copy);
-    pr_ = ProfilingRecord::instrumentGraph(copy);
-    auto pr_copy = pr_->graph()->copy();
-    GRAPH_DUMP("Profiled Graph: ", pr_copy);
-    profiling_plan_ = ExecutionPlan(pr_copy);
-    // fall-through
+  if (!profiling_graph_) {
+    profiling_graph_ = graph->copy();
+    runProfilingInsensitiveOptimizations(profiling_graph_);
+  }
+
+  // Guards of an optimized plan check the exact types seen while profiling,
+  // so inputs of different shapes would bail out to the unoptimized graph.
+  // Instead, each class of input shapes gets a plan of its own.
+  SpecializedPlan& plan = specializedPlanFor(stack);
+  if (plan.optimized_plan) {
+    size_t num_bailouts = plan.optimized_plan->code.num_bailouts();
+    if (num_bailouts < kBailoutsBeforeRecompile ||
+        plan.num_recompilations >= kMaxRecompilations) {
+      return *plan.optimized_plan;
+    }
+    // The profile was too specific, e.g. it saw only one of the sizes of
+    // this class.
+    GRAPH_DEBUG("Recompiling a plan after ", num_bailouts, " bailouts");
+    retire(plan);
+    plan.num_recompilations++;
+    num_recompilations_++;
+    startProfiling(plan, kRecompileProfilingRuns);
+  } else if (!plan.pr) {
+    startProfiling(plan, 1);
   }
 
   // profile until a graph is ready
-  if (!pr_->ready()) {
-    return *profiling_plan_;
+  if (!plan.pr->ready()) {
+    return *plan.profiling_plan;
   }
 
-  auto copy = pr_->graph()->copy();
+  auto copy = plan.pr->graph()->copy();
   runProfilingOptimizations(copy);
   // cache
-  optimized_plan_ = ExecutionPlan(copy);
-  return *optimized_plan_;
+  plan.optimized_plan = ExecutionPlan(copy);
+  return *plan.optimized_plan;
 }
 
 GraphExecutorState ProfilingGraphExecutorImpl::getDebugState() {
+  std::lock_guard<std::mutex> lock(compile_mutex);
   GraphExecutorState state;
-  TORCH_INTERNAL_ASSERT(optimized_plan_);
-  auto opt_plan = *optimized_plan_;
-  state.execution_plans.emplace(ArgumentSpec{0, 0}, opt_plan);
+  state.num_guard_failures = retired_guard_failures_;
+  state.num_bailouts = retired_bailouts_;
+  state.num_recompilations = num_recompilations_;
+  c10::optional<ExecutionPlan> opt_plan = optimized_plan_;
+  for (const auto& pr : retired_profiles_) {
+    if (!pr.expired()) {
+      state.num_profiling_records++;
+    }
+  }
+  for (const auto& entry : plans_) {
+    const SpecializedPlan& plan = entry.second;
+    if (plan.pr) {
+      state.num_profiling_records++;
+    }
+    if (!plan.optimized_plan) {
+      continue;
+    }
+    state.num_specialized_plans++;
+    state.num_guard_failures += plan.optimized_plan->code.num_guard_failures();
+    state.num_bailouts += plan.optimized_plan->code.num_bailouts();
+    // plans_ is ordered by most recent use
+    if (!opt_plan) {
+      opt_plan = plan.optimized_plan;
+    }
+  }
+  TORCH_INTERNAL_ASSERT(opt_plan);
+  state.execution_plans.emplace(ArgumentSpec{0, 0}, *opt_plan);
   return state;
 }
 
@@ -1,5 +1,8 @@
 #pragma once
 #include <torch/csrc/jit/graph_executor_impl.h>
+#include <torch/csrc/utils/hash.h>
+
+#include <list>
 
 namespace torch {
 namespace jit {
@@ -12,11 +15,46 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   ~ProfilingGraphExecutorImpl() override = default;
 
  private:
+  // Inputs whose tensors agree in dtype, device, requires_grad, rank and
+  // bucketed sizes share a PlanKey, and so a profiled and optimized plan.
+  using PlanKey = std::vector<int64_t>;
+
+  struct SpecializedPlan {
+    std::shared_ptr<ProfilingRecord> pr;
+    // plan to run in order to profile the code
+    c10::optional<ExecutionPlan> profiling_plan;
+    c10::optional<ExecutionPlan> optimized_plan;
+    // times this plan was profiled again because it kept bailing out
+    size_t num_recompilations = 0;
+  };
+
+  PlanKey planKeyFor(Stack& stack) const;
+  SpecializedPlan& specializedPlanFor(Stack& stack);
+  void startProfiling(SpecializedPlan& plan, size_t num_profiling_runs);
+  void retire(SpecializedPlan& plan);
+
   void runProfilingInsensitiveOptimizations(std::shared_ptr<Graph>& graph);
   void runProfilingOptimizations(std::shared_ptr<Graph>& graph);
-  std::unique_ptr<ProfilingRecord> pr_;
-  c10::optional<ExecutionPlan>
-      profiling_plan_; // plan to run in order to profiling the code
+
+  // graph after profiling insensitive optimizations, instrumented separately
+  // for each specialized plan
+  std::shared_ptr<Graph> profiling_graph_;
+  // specialized plans, most recently used first
+  std::list<std::pair<PlanKey, SpecializedPlan>> plans_;
+  std::unordered_map<
+      PlanKey,
+      std::list<std::pair<PlanKey, SpecializedPlan>>::iterator,
+      torch::hash<PlanKey>>
+      plan_index_;
+  // Profiling records of evicted and recompiled plans. The profiling plans
+  // own their records, so a record lives on only while a frame still runs
+  // its plan; these are kept to report how many are alive.
+  std::vector<std::weak_ptr<ProfilingRecord>> retired_profiles_;
+  // counters of plans that are no longer cached
+  size_t retired_guard_failures_ = 0;
+  size_t retired_bailouts_ = 0;
+  size_t num_recompilations_ = 0;
+  // the only plan of the simple executor
   c10::optional<ExecutionPlan> optimized_plan_;
 };
 
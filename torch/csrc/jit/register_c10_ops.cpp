@@ -14,7 +14,9 @@ namespace {
 // TODO This currently only handles tensors with requires_grad==False correctly.
 //      It should also handle autograd.
 Operator createOperatorFromC10(const c10::OperatorHandle& op) {
-  return Operator(op, [op](Stack& stack) {
+  // shared by all nodes, and so by all threads, calling this operator
+  auto cache = std::make_shared<c10::DispatchCache>();
+  return Operator(op, [op, cache](Stack& stack) {
       RECORD_FUNCTION(op.schema().name(), stack);
       const auto input_size = op.schema().arguments().size();
       const auto output_size = op.schema().returns().size();
@@ -106,10 +108,10 @@ Operator createOperatorFromC10(const c10::OperatorHandle& op) {
 #ifdef USE_STATIC_DISPATCH
       {
         at::AutoNonVariableTypeMode non_var_type_mode(true);
-        c10::Dispatcher::singleton().callBoxed(op, &stack);
+        c10::Dispatcher::singleton().callBoxedWithCache(op, *cache, &stack);
       }
 #else
-      c10::Dispatcher::singleton().callBoxed(op, &stack);
+      c10::Dispatcher::singleton().callBoxedWithCache(op, *cache, &stack);
 #endif // USE_STATIC_DISPATCH
 
       if (tracer_state) {
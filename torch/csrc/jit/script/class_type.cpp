@@ -81,6 +81,9 @@ void ClassType::unsafeRemoveAttribute(const std::string& name) {
   auto slot = getAttributeSlot(name);
   attributeNames_.erase(attributeNames_.begin() + slot);
   attributeTypes_.erase(attributeTypes_.begin() + slot);
+  if (is_module()) {
+    parameterSlots_->erase(parameterSlots_->begin() + slot);
+  }
 }
 
 void ClassType::addMethod(Function* method) {
@@ -102,6 +105,21 @@ Function* ClassType::getMethod(const std::string& name) const {
   return nullptr;
 }
 
+void ClassType::unsafeRemoveMethod(const std::string& name) {
+  for (auto it = methods_.begin(); it != methods_.end(); ++it) {
+    if ((*it)->name() == name) {
+      methods_.erase(it);
+      return;
+    }
+  }
+  TORCH_CHECK(
+      false,
+      "Can't delete undefined method ",
+      name,
+      " on class: ",
+      python_str());
+}
+
 size_t ClassType::addConstant(
       const std::string& name,
       const IValue& value) {
@@ -0,0 +1,172 @@
+#include <torch/csrc/jit/script/inference_session.h>
+
+#include <ATen/core/grad_mode.h>
+#include <torch/csrc/jit/import.h>
+
+#include <algorithm>
+
+namespace torch {
+namespace jit {
+namespace script {
+
+namespace {
+
+double percentile(const std::vector<double>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+InferenceSession::InferenceSession(
+    const Module& module,
+    const std::vector<std::vector<IValue>>& example_inputs,
+    InferenceSessionOptions options)
+    : options_(std::move(options)) {
+  TORCH_CHECK(
+      options_.num_instances > 0,
+      "InferenceSession needs at least one instance");
+  TORCH_CHECK(
+      module.find_method(options_.method_name),
+      "Module has no method '",
+      options_.method_name,
+      "' to run in an InferenceSession");
+
+  at::NoGradGuard no_grad;
+  instances_.reserve(options_.num_instances);
+  methods_.reserve(options_.num_instances);
+  for (size_t i = 0; i < options_.num_instances; ++i) {
+    // clone() copies the methods, so each instance gets its own graph
+    // executors, but not the tensors, so the weights are shared.
+    Module instance = module.clone();
+    instance.eval();
+    auto method = instance.get_method(options_.method_name);
+    for (size_t run = 0; run < options_.warmup_runs; ++run) {
+      for (const auto& inputs : example_inputs) {
+        method(inputs);
+      }
+    }
+    instances_.push_back(std::move(instance));
+    methods_.push_back(std::move(method));
+    free_instances_.push_back(i);
+  }
+  recent_ms_.reserve(options_.latency_window);
+}
+
+InferenceSession InferenceSession::load(
+    const std::string& filename,
+    const std::vector<std::vector<IValue>>& example_inputs,
+    InferenceSessionOptions options,
+    c10::optional<c10::Device> device) {
+  return InferenceSession(
+      torch::jit::load(filename, device), example_inputs, std::move(options));
+}
+
+InferenceSession::InferenceSession(InferenceSession&& other)
+    : options_(std::move(other.options_)),
+      instances_(std::move(other.instances_)),
+      methods_(std::move(other.methods_)) {
+  std::lock_guard<std::mutex> pool_guard(other.pool_mutex_);
+  std::lock_guard<std::mutex> stats_guard(other.stats_mutex_);
+  free_instances_ = std::move(other.free_instances_);
+  num_runs_ = other.num_runs_;
+  total_ms_ = other.total_ms_;
+  max_ms_ = other.max_ms_;
+  total_wait_ms_ = other.total_wait_ms_;
+  recent_ms_ = std::move(other.recent_ms_);
+  next_recent_ = other.next_recent_;
+}
+
+size_t InferenceSession::acquireInstance() {
+  std::unique_lock<std::mutex> lock(pool_mutex_);
+  instance_released_.wait(lock, [this] { return !free_instances_.empty(); });
+  size_t index = free_instances_.back();
+  free_instances_.pop_back();
+  return index;
+}
+
+void InferenceSession::releaseInstance(size_t index) {
+  {
+    std::lock_guard<std::mutex> guard(pool_mutex_);
+    free_instances_.push_back(index);
+  }
+  instance_released_.notify_one();
+}
+
+IValue InferenceSession::run(std::vector<IValue> inputs) {
+  auto start = Clock::now();
+  size_t index = acquireInstance();
+  double wait_ms = millisecondsSince(start);
+
+  IValue output;
+  try {
+    at::NoGradGuard no_grad;
+    output = methods_[index](std::move(inputs));
+  } catch (...) {
+    releaseInstance(index);
+    throw;
+  }
+  releaseInstance(index);
+  recordLatency(millisecondsSince(start), wait_ms);
+  return output;
+}
+
+void InferenceSession::recordLatency(double latency_ms, double wait_ms) {
+  std::lock_guard<std::mutex> guard(stats_mutex_);
+  num_runs_++;
+  total_ms_ += latency_ms;
+  total_wait_ms_ += wait_ms;
+  max_ms_ = std::max(max_ms_, latency_ms);
+  if (options_.latency_window == 0) {
+    return;
+  }
+  if (recent_ms_.size() < options_.latency_window) {
+    recent_ms_.push_back(latency_ms);
+  } else {
+    recent_ms_[next_recent_] = latency_ms;
+  }
+  next_recent_ = (next_recent_ + 1) % options_.latency_window;
+}
+
+InferenceSessionStats InferenceSession::stats() const {
+  std::vector<double> sorted;
+  InferenceSessionStats stats;
+  {
+    std::lock_guard<std::mutex> guard(stats_mutex_);
+    stats.num_runs = num_runs_;
+    if (num_runs_ > 0) {
+      stats.mean_ms = total_ms_ / num_runs_;
+      stats.mean_wait_ms = total_wait_ms_ / num_runs_;
+    }
+    stats.max_ms = max_ms_;
+    sorted = recent_ms_;
+  }
+  std::sort(sorted.begin(), sorted.end());
+  stats.p50_ms = percentile(sorted, 0.5);
+  stats.p90_ms = percentile(sorted, 0.9);
+  stats.p99_ms = percentile(sorted, 0.99);
+  return stats;
+}
+
+void InferenceSession::resetStats() {
+  std::lock_guard<std::mutex> guard(stats_mutex_);
+  num_runs_ = 0;
+  total_ms_ = 0;
+  max_ms_ = 0;
+  total_wait_ms_ = 0;
+  recent_ms_.clear();
+  next_recent_ = 0;
+}
+
+} // namespace script
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <torch/csrc/jit/script/module.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+namespace script {
+
+struct InferenceSessionOptions {
+  // Number of module instances, i.e. how many calls can run concurrently.
+  size_t num_instances = 1;
+  std::string method_name = "forward";
+  // Runs of each example input per instance during warmup. The profiling
+  // executor needs two runs to optimize a plan and fusers compile their
+  // kernels on the first optimized run.
+  size_t warmup_runs = 3;
+  // Number of most recent calls that latency percentiles are computed over.
+  size_t latency_window = 1024;
+};
+
+struct InferenceSessionStats {
+  size_t num_runs = 0;
+  // over all runs since the last resetStats()
+  double mean_ms = 0;
+  double max_ms = 0;
+  // over the last InferenceSessionOptions::latency_window runs
+  double p50_ms = 0;
+  double p90_ms = 0;
+  double p99_ms = 0;
+  // time spent waiting for a free instance, included in the latencies
+  double mean_wait_ms = 0;
+};
+
+/** \brief Serves a module from many threads.
+ *
+ * The module is put in eval mode and cloned into
+ * InferenceSessionOptions::num_instances instances, which share its
+ * parameters and buffers but have graph executors of their own. Each instance
+ * is warmed up with the example inputs, so that the execution plans for them
+ * are optimized before the first call, and run() doesn't contend for an
+ * executor's compilation lock with other threads. Calls run under
+ * torch::NoGradGuard on the first free instance.
+ *
+ * The shared weights must not be modified while the session is in use.
+ */
+struct TORCH_API InferenceSession {
+  InferenceSession(
+      const Module& module,
+      const std::vector<std::vector<IValue>>& example_inputs,
+      InferenceSessionOptions options = {});
+
+  static InferenceSession load(
+      const std::string& filename,
+      const std::vector<std::vector<IValue>>& example_inputs,
+      InferenceSessionOptions options = {},
+      c10::optional<c10::Device> device = c10::nullopt);
+
+  InferenceSession(const InferenceSession&) = delete;
+  InferenceSession& operator=(const InferenceSession&) = delete;
+  InferenceSession(InferenceSession&& other);
+
+  IValue run(std::vector<IValue> inputs);
+
+  size_t num_instances() const {
+    return instances_.size();
+  }
+
+  InferenceSessionStats stats() const;
+  void resetStats();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  size_t acquireInstance();
+  void releaseInstance(size_t index);
+  void recordLatency(double latency_ms, double wait_ms);
+
+  InferenceSessionOptions options_;
+  std::vector<Module> instances_;
+  // instances_[i].get_method(options_.method_name)
+  std::vector<Method> methods_;
+
+  std::mutex pool_mutex_;
+  std::condition_variable instance_released_;
+  std::vector<size_t> free_instances_;
+
+  mutable std::mutex stats_mutex_;
+  size_t num_runs_ = 0;
+  double total_ms_ = 0;
+  double max_ms_ = 0;
+  double total_wait_ms_ = 0;
+  // ring buffer of the latencies of the last latency_window runs
+  std::vector<double> recent_ms_;
+  size_t next_recent_ = 0;
+};
+
+} // namespace script
+} // namespace jit
+} // namespace torch
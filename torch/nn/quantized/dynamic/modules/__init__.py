@@ -1,9 +1,10 @@
 # @lint-ignore-every PYTHON3COMPATIMPORTS
 
 from .linear import Linear
-from .rnn import LSTM
+from .rnn import LSTM, GRU
 
 __all__ = [
     'Linear',
     'LSTM',
+    'GRU',
 ]